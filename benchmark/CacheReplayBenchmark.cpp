@@ -0,0 +1,225 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
+
+#include <fstream>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "util/Cache.h"
+#include "util/Exception.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Random.h"
+
+namespace ad_benchmark {
+
+namespace {
+// A single request from a query log: the cache key of a (sub)result, the size
+// of the result, and the time it took to compute it.
+struct Request {
+  std::string key_;
+  ad_utility::MemorySize size_;
+  double costInMs_;
+};
+
+// The value that is stored in the cache during the replay. We only need the
+// size and the cost of the result, not the result itself.
+struct ReplayValue {
+  ad_utility::MemorySize size_;
+  double costInMs_;
+};
+struct ReplayValueSizeGetter {
+  ad_utility::MemorySize operator()(const ReplayValue& value) const {
+    return value.size_;
+  }
+};
+struct ReplayValueCostGetter {
+  double operator()(const ReplayValue& value) const { return value.costInMs_; }
+};
+using ReplayCache =
+    ad_utility::CostAwareCache<std::string, ReplayValue, ReplayValueSizeGetter,
+                               ReplayValueCostGetter>;
+
+// The statistics of a single replay.
+struct ReplayStatistics {
+  size_t numHits_ = 0;
+  double savedCostInMs_ = 0;
+  double totalCostInMs_ = 0;
+};
+}  // namespace
+
+// Replay a query log against the `CostAwareCache` with each of the
+// `EvictionPolicy`s and compare the hit rates and the saved computation time.
+// The query log is a text file with one request per line of the form
+// `<cache key>\t<size of the result in bytes>\t<computation time in ms>` (this
+// information can be extracted from the `RuntimeInformation` of the server
+// log). If no query log is given, a synthetic log is used that mixes a small
+// set of frequently requested results that are small and expensive to compute
+// (e.g. the subresults of dashboard queries) with large one-off results that
+// are cheap to compute (e.g. bulk exports).
+class CacheReplayBenchmark : public BenchmarkInterface {
+  std::string queryLog_;
+  std::string cacheSize_;
+  size_t maxNumEntries_;
+  size_t numSyntheticRequests_;
+  size_t randomSeed_;
+
+ public:
+  CacheReplayBenchmark() {
+    ad_utility::ConfigManager& config = getConfigManager();
+    config.addOption("query-log",
+                     "The query log to replay (see the documentation of "
+                     "`CacheReplayBenchmark` for the format). If empty, a "
+                     "synthetic log is used.",
+                     &queryLog_, std::string{});
+    config.addOption("cache-size",
+                     "The maximal size of the cache. Example: 4kB, 8MB, 2GB.",
+                     &cacheSize_, std::string{"1GB"});
+    config.addOption("max-num-entries",
+                     "The maximal number of entries in the cache.",
+                     &maxNumEntries_, size_t{1000});
+    config.addOption("num-synthetic-requests",
+                     "The number of requests in the synthetic query log.",
+                     &numSyntheticRequests_, size_t{1'000'000});
+    config.addOption("random-seed",
+                     "The seed for the generation of the synthetic query log.",
+                     &randomSeed_, size_t{42});
+  }
+
+  std::string name() const final {
+    return "Replay of a query log against the query result cache";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    auto maxSize = ad_utility::MemorySize::parse(cacheSize_);
+    auto requests = queryLog_.empty() ? makeSyntheticLog(maxSize)
+                                      : readQueryLog(queryLog_);
+    BenchmarkResults results{};
+    std::vector<std::pair<std::string, ad_utility::EvictionPolicy>> policies{
+        {"lru", ad_utility::EvictionPolicy::LRU},
+        {"gdsf", ad_utility::EvictionPolicy::GDSF}};
+    std::vector<std::string> rowNames;
+    for (const auto& policy : policies) {
+      rowNames.push_back(policy.first);
+    }
+    auto& table = results.addTable(
+        absl::StrCat("Replay of ", requests.size(),
+                     " requests with a cache of ", maxSize.asString()),
+        rowNames,
+        {"Policy", "Replay time", "Hit rate (%)", "Saved computation time (%)",
+         "Saved computation time (s)"});
+    for (size_t row = 0; row < policies.size(); ++row) {
+      ReplayStatistics statistics;
+      table.addMeasurement(row, 1, [&]() {
+        statistics = replay(requests, policies[row].second, maxSize);
+      });
+      auto percentage = [](double part, double total) {
+        return static_cast<float>(total > 0 ? 100.0 * part / total : 0.0);
+      };
+      table.setEntry(row, 2,
+                     percentage(static_cast<double>(statistics.numHits_),
+                                static_cast<double>(requests.size())));
+      table.setEntry(row, 3,
+                     percentage(statistics.savedCostInMs_,
+                                statistics.totalCostInMs_));
+      table.setEntry(row, 4,
+                     static_cast<float>(statistics.savedCostInMs_ / 1000.0));
+    }
+    return results;
+  }
+
+ private:
+  // Replay the `requests` against a cache with the given `policy`.
+  ReplayStatistics replay(const std::vector<Request>& requests,
+                          ad_utility::EvictionPolicy policy,
+                          ad_utility::MemorySize maxSize) const {
+    ReplayCache cache{maxNumEntries_, maxSize, maxSize};
+    cache.setEvictionPolicy(policy);
+    ReplayStatistics statistics;
+    for (const auto& request : requests) {
+      statistics.totalCostInMs_ += request.costInMs_;
+      if (cache[request.key_]) {
+        ++statistics.numHits_;
+        statistics.savedCostInMs_ += request.costInMs_;
+      } else {
+        cache.insert(request.key_, ReplayValue{request.size_,
+                                               request.costInMs_});
+      }
+    }
+    return statistics;
+  }
+
+  // Read a query log in the format that is described above.
+  static std::vector<Request> readQueryLog(const std::string& filename) {
+    std::ifstream file{filename};
+    AD_CONTRACT_CHECK(file.is_open(), "Could not open the query log ",
+                      filename);
+    std::vector<Request> requests;
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty()) {
+        continue;
+      }
+      std::vector<std::string_view> fields = absl::StrSplit(line, '\t');
+      size_t sizeInBytes;
+      double costInMs;
+      AD_CONTRACT_CHECK(fields.size() == 3 &&
+                            absl::SimpleAtoi(fields[1], &sizeInBytes) &&
+                            absl::SimpleAtod(fields[2], &costInMs),
+                        "Invalid line in the query log: ", line);
+      requests.push_back({std::string{fields[0]},
+                          ad_utility::MemorySize::bytes(sizeInBytes),
+                          costInMs});
+    }
+    return requests;
+  }
+
+  // Create a synthetic query log (see the documentation of the class).
+  std::vector<Request> makeSyntheticLog(ad_utility::MemorySize maxSize) const {
+    using ad_utility::RandomSeed;
+    using ad_utility::SlowRandomIntGenerator;
+    auto seed = [this](size_t offset) {
+      return RandomSeed::make(static_cast<unsigned>(randomSeed_ + offset));
+    };
+    constexpr size_t numHotResults = 200;
+    constexpr size_t numWarmResults = 20'000;
+    size_t cacheBytes = std::max(maxSize.getBytes(), size_t{1000});
+    SlowRandomIntGenerator<size_t> kindOfRequest{0, 99, seed(0)};
+    // The frequently requested results are chosen with a skewed distribution:
+    // The smaller the index, the more frequent.
+    SlowRandomIntGenerator<size_t> hotIndex{0, numHotResults - 1, seed(1)};
+    SlowRandomIntGenerator<size_t> warmIndex{0, numWarmResults - 1, seed(2)};
+    ad_utility::RandomDoubleGenerator cost{0.0, 1.0, seed(3)};
+
+    std::vector<Request> requests;
+    requests.reserve(numSyntheticRequests_);
+    for (size_t i = 0; i < numSyntheticRequests_; ++i) {
+      size_t kind = kindOfRequest();
+      if (kind < 50) {
+        // Small and expensive results of dashboard queries.
+        size_t index = std::min(hotIndex(), hotIndex());
+        requests.push_back({absl::StrCat("hot", index),
+                            ad_utility::MemorySize::bytes(
+                                cacheBytes / 10'000 * (1 + index % 10)),
+                            500.0 + 5000.0 * cost()});
+      } else if (kind < 90) {
+        // Medium sized results of the remaining queries.
+        size_t index = warmIndex();
+        requests.push_back(
+            {absl::StrCat("warm", index),
+             ad_utility::MemorySize::bytes(cacheBytes / 1'000 *
+                                           (1 + index % 10)),
+             50.0 + 500.0 * cost()});
+      } else {
+        // Large one-off results that are cheap to compute (e.g. exports).
+        requests.push_back(
+            {absl::StrCat("bulk", i),
+             ad_utility::MemorySize::bytes(cacheBytes / 4), 100.0 * cost()});
+      }
+    }
+    return requests;
+  }
+};
+
+AD_REGISTER_BENCHMARK(CacheReplayBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,439 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/str_cat.h>
+
+#include <random>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "engine/sparqlExpressions/PrefilterExpressionIndex.h"
+#include "global/RuntimeParameters.h"
+#include "index/CompressedRelation.h"
+#include "index/LocatedTriples.h"
+#include "index/Vocabulary.h"
+#include "util/Exception.h"
+#include "util/File.h"
+#include "util/Generator.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Timer.h"
+
+namespace ad_benchmark {
+
+namespace {
+auto V = [](uint64_t index) {
+  return Id::makeFromVocabIndex(VocabIndex::make(index));
+};
+auto I = [](int64_t value) { return Id::makeFromInt(value); };
+
+// The number of distinct objects (the third column) in the permutation.
+constexpr uint64_t numObjects = 1'000'000;
+// The graph IDs start after the IDs of the objects, the IDs of the objects of
+// the inserted triples start after the IDs of the graphs (see
+// `updateObjectId`).
+constexpr uint64_t firstGraphId = numObjects;
+}  // namespace
+
+// Measure the read path of a single permutation: `CompressedRelationReader::
+// scan` and `lazyScan` for full scans and scans of a single relation, the
+// prefiltering of blocks by a `PrefilterExpression`, the filtering by graphs,
+// the merging of `LocatedTriples` (updates), the decompression cost per
+// column, and the effect of the runtime parameters
+// `lazy-index-scan-num-threads` and `lazy-index-scan-queue-size`.
+//
+// The permutation is synthetic and written with the same
+// `CompressedRelationWriter::createPermutationPair` as in the index builder.
+// The sizes of the relations (the distinct values of the first column) are
+// Zipf-distributed, the second column of each relation is a sequence of
+// integers (s.t. `FILTER`s on it can be used for the prefiltering of blocks),
+// the third column is random, and each relation belongs to one of the graphs.
+// All additional payload columns are random. The permutation is written once
+// for each of the configured block sizes.
+class IndexScanBenchmark : public BenchmarkInterface {
+  size_t numTriples_;
+  size_t numRelations_;
+  size_t numColumns_;
+  size_t numGraphs_;
+  float updateDensity_;
+  std::vector<std::string> blockSizes_;
+  std::vector<size_t> numThreads_;
+  std::vector<size_t> queueSizes_;
+  size_t randomSeed_;
+
+  // The number of triples for each of the `numRelations_` relations.
+  std::vector<size_t> relationSizes_;
+
+  // A permutation on disk together with its (augmented) block metadata and
+  // the located triples for it (either empty, or the updates).
+  struct PermutationAndUpdates {
+    std::string filename_;
+    std::vector<CompressedBlockMetadata> blocks_;
+    LocatedTriplesPerBlock noUpdates_;
+    LocatedTriplesPerBlock updates_;
+  };
+
+  using Handle = ad_utility::SharedCancellationHandle;
+  using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
+
+ public:
+  IndexScanBenchmark() {
+    ad_utility::ConfigManager& config = getConfigManager();
+    config.addOption("num-triples",
+                     "The (approximate) number of triples in the permutation.",
+                     &numTriples_, size_t{10'000'000});
+    config.addOption("num-relations",
+                     "The number of distinct IDs in the first column of the "
+                     "permutation.",
+                     &numRelations_, size_t{1000});
+    config.addOption("num-columns",
+                     "The number of columns of the permutation (the triple, "
+                     "the graph, and the additional payload columns). Must "
+                     "be at least 4.",
+                     &numColumns_, size_t{4});
+    config.addOption("num-graphs", "The number of named graphs.", &numGraphs_,
+                     size_t{10});
+    config.addOption("update-density",
+                     "The number of inserted triples (located triples), "
+                     "relative to the number of triples in the permutation.",
+                     &updateDensity_, 0.001f);
+    config.addOption("block-sizes",
+                     "The uncompressed sizes of the blocks (per column) for "
+                     "which the permutation is built. Example: 250kB, 4MB.",
+                     &blockSizes_, std::vector<std::string>{"250kB", "1MB"});
+    config.addOption("lazy-index-scan-num-threads",
+                     "The values of the runtime parameter of the same name "
+                     "for which a full lazy scan is measured.",
+                     &numThreads_, std::vector<size_t>{1, 2, 4, 10});
+    config.addOption("lazy-index-scan-queue-size",
+                     "The values of the runtime parameter of the same name "
+                     "for which a full lazy scan is measured.",
+                     &queueSizes_, std::vector<size_t>{1, 5, 20});
+    config.addOption("random-seed",
+                     "The seed for the generation of the permutation and the "
+                     "updates.",
+                     &randomSeed_, size_t{42});
+  }
+
+  std::string name() const final {
+    return "Benchmarks for scanning and decompressing a permutation";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    AD_CONTRACT_CHECK(numColumns_ >= 4, "A permutation has at least four ",
+                      "columns (the triple and the graph)");
+    AD_CONTRACT_CHECK(numRelations_ > 0 && numGraphs_ > 0);
+    BenchmarkResults results{};
+    computeRelationSizes();
+    for (const auto& blockSize : blockSizes_) {
+      auto permutation =
+          buildPermutation(ad_utility::MemorySize::parse(blockSize));
+      CompressedRelationReader reader{ad_utility::makeUnlimitedAllocator<Id>(),
+                                      ad_utility::File{permutation.filename_,
+                                                       "r"}};
+      auto description = absl::StrCat(permutation.blocks_.size(),
+                                      " blocks of ", blockSize, " per column");
+      measureScans(results, description, reader, permutation);
+      measureColumns(results, description, reader, permutation);
+      measureLazyScanParameters(results, description, reader, permutation);
+      ad_utility::deleteFile(permutation.filename_);
+      ad_utility::deleteFile(permutation.filename_ + ".switched");
+    }
+    return results;
+  }
+
+ private:
+  // Compute the number of triples of each relation (Zipf-like, see the class
+  // documentation).
+  void computeRelationSizes() {
+    double harmonic = 0;
+    for (size_t i = 0; i < numRelations_; ++i) {
+      harmonic += 1.0 / static_cast<double>(i + 1);
+    }
+    relationSizes_.clear();
+    for (size_t i = 0; i < numRelations_; ++i) {
+      double size = static_cast<double>(numTriples_) /
+                    (harmonic * static_cast<double>(i + 1));
+      relationSizes_.push_back(std::max(size_t{1}, static_cast<size_t>(size)));
+    }
+  }
+
+  Id graphId(size_t relation) const {
+    return V(firstGraphId + relation % numGraphs_);
+  }
+
+  // The object of the `i`-th inserted triple, which is disjoint from the
+  // existing objects and the graphs.
+  Id updateObjectId(size_t i) const {
+    return V(firstGraphId + numGraphs_ + i);
+  }
+
+  // The sorted triples of the permutation (see the class documentation) in
+  // blocks.
+  cppcoro::generator<IdTableStatic<0>> makeSortedTriples() const {
+    std::mt19937_64 gen{randomSeed_};
+    std::uniform_int_distribution<uint64_t> object{0, numObjects - 1};
+    std::uniform_int_distribution<uint64_t> payload{};
+    IdTableStatic<0> block{numColumns_,
+                           ad_utility::makeUnlimitedAllocator<Id>()};
+    std::vector<Id> row(numColumns_);
+    for (size_t relation = 0; relation < numRelations_; ++relation) {
+      for (size_t i = 0; i < relationSizes_[relation]; ++i) {
+        row[0] = V(relation);
+        row[1] = I(static_cast<int64_t>(i));
+        row[2] = V(object(gen));
+        row[ADDITIONAL_COLUMN_GRAPH_ID] = graphId(relation);
+        for (size_t column = 4; column < numColumns_; ++column) {
+          row[column] = V(payload(gen) % numObjects);
+        }
+        block.push_back(row);
+        if (block.numRows() >= 100'000) {
+          co_yield block;
+          block.clear();
+        }
+      }
+    }
+    if (!block.empty()) {
+      co_yield block;
+    }
+  }
+
+  // Write the permutation with the given `blockSize` and locate the updates
+  // in it.
+  PermutationAndUpdates buildPermutation(
+      ad_utility::MemorySize blockSize) const {
+    PermutationAndUpdates result;
+    result.filename_ = "indexScanBenchmark.permutation";
+    std::vector<CompressedBlockMetadata> blocks;
+    {
+      CompressedRelationWriter writer{numColumns_,
+                                      ad_utility::File{result.filename_, "w"},
+                                      blockSize};
+      CompressedRelationWriter switchedWriter{
+          numColumns_, ad_utility::File{result.filename_ + ".switched", "w"},
+          blockSize};
+      auto ignoreMetadata = [](ql::span<const CompressedRelationMetadata>) {};
+      blocks = CompressedRelationWriter::createPermutationPair(
+                   result.filename_, {writer, ignoreMetadata},
+                   {switchedWriter, ignoreMetadata}, makeSortedTriples(),
+                   qlever::KeyOrder{0, 1, 2, 3}, {})
+                   .blockMetadata_;
+    }
+
+    // The inserted triples are located in random relations, and their objects
+    // are disjoint from the existing objects.
+    std::mt19937_64 gen{randomSeed_ + 1};
+    std::uniform_int_distribution<size_t> relation{0, numRelations_ - 1};
+    auto numUpdates = static_cast<size_t>(static_cast<double>(updateDensity_) *
+                                          static_cast<double>(numTriples_));
+    std::vector<IdTriple<0>> updates;
+    for (size_t i = 0; i < numUpdates; ++i) {
+      size_t r = relation(gen);
+      std::uniform_int_distribution<int64_t> position{
+          0, static_cast<int64_t>(relationSizes_[r])};
+      updates.emplace_back(
+          std::array{V(r), I(position(gen)), updateObjectId(i), graphId(r)});
+    }
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    result.updates_.add(LocatedTriple::locateTriplesInPermutation(
+        updates, blocks, qlever::KeyOrder{0, 1, 2, 3}, true, handle));
+    result.updates_.setOriginalMetadata(blocks);
+    result.updates_.updateAugmentedMetadata();
+    result.noUpdates_.setOriginalMetadata(blocks);
+    result.noUpdates_.updateAugmentedMetadata();
+    result.blocks_ = std::move(blocks);
+    return result;
+  }
+
+  // A `BlockMetadataRanges` that consists of all the `blocks`.
+  static BlockMetadataRanges allBlocks(
+      const std::vector<CompressedBlockMetadata>& blocks) {
+    BlockMetadataSpan span{blocks};
+    return {{span.begin(), span.end()}};
+  }
+
+  // The additional columns `3, ..., numColumns - 1` of the permutation (the
+  // graph and the payload).
+  static CompressedRelationReader::ColumnIndices additionalColumns(
+      size_t numColumns) {
+    CompressedRelationReader::ColumnIndices columns;
+    for (ColumnIndex column = 3; column < numColumns; ++column) {
+      columns.push_back(column);
+    }
+    return columns;
+  }
+
+  // Consume the `lazyScan` for the `scanSpec` and the located triples and
+  // return the number of rows. The time until the first block is available
+  // is stored in `timeToFirstBlock`.
+  static size_t runLazyScan(const CompressedRelationReader& reader,
+                            const ScanSpecification& scanSpec,
+                            const LocatedTriplesPerBlock& locatedTriples,
+                            const Handle& handle, float& timeToFirstBlock) {
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    auto blocks = CompressedRelationReader::convertBlockMetadataRangesToVector(
+        CompressedRelationReader::getRelevantBlocks(
+            scanSpec, allBlocks(locatedTriples.getAugmentedMetadata())));
+    size_t numRows = 0;
+    bool isFirstBlock = true;
+    for (const auto& block : reader.lazyScan(scanSpec, std::move(blocks), {},
+                                             handle, locatedTriples)) {
+      if (isFirstBlock) {
+        timeToFirstBlock =
+            static_cast<float>(ad_utility::Timer::toSeconds(timer.value()));
+        isFirstBlock = false;
+      }
+      numRows += block.numRows();
+    }
+    return numRows;
+  }
+
+  // Full scans and scans of the largest relation with and without updates,
+  // prefiltering, and graph filters.
+  void measureScans(BenchmarkResults& results, const std::string& description,
+                    const CompressedRelationReader& reader,
+                    const PermutationAndUpdates& permutation) const {
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    // The prefilter on the second column only compares integers, so the
+    // vocabulary is never accessed.
+    RdfsVocabulary vocab;
+    ScanSpecification fullScan{std::nullopt, std::nullopt, std::nullopt};
+    ScanSpecification largestRelation{V(0), std::nullopt, std::nullopt};
+    ScanSpecification singleGraph{
+        std::nullopt, std::nullopt, std::nullopt, LocalVocab{},
+        ScanSpecification::Graphs{ad_utility::HashSet<Id>{graphId(0)}}};
+
+    std::vector<std::string> rowNames{
+        "Full scan",
+        "Full lazy scan",
+        "Full scan with updates",
+        "Full lazy scan with updates",
+        "Scan of the largest relation",
+        "Scan of the largest relation with a FILTER (10%)",
+        "Full scan of a single graph"};
+    auto& table = results.addTable(
+        absl::StrCat("Scans with ", description), rowNames,
+        {"Scan", "Rows", "Time", "Throughput (M rows/s)",
+         "Time to first block"});
+
+    // Measure `function` (which returns the number of rows) in the given row.
+    auto measure = [&table](size_t row, auto function) {
+      size_t numRows = 0;
+      table.addMeasurement(row, 2, [&]() { numRows = function(); });
+      table.setEntry(row, 1, numRows);
+      table.setEntry(row, 3,
+                     static_cast<float>(static_cast<double>(numRows) / 1e6 /
+                                        table.getEntry<float>(row, 2)));
+    };
+    auto scan = [&](const ScanSpecification& scanSpec,
+                    const LocatedTriplesPerBlock& locatedTriples) {
+      return reader
+          .scan(ScanSpecAndBlocks{scanSpec,
+                                  allBlocks(
+                                      locatedTriples.getAugmentedMetadata())},
+                {}, handle, locatedTriples)
+          .numRows();
+    };
+    auto lazyScan = [&](size_t row,
+                        const LocatedTriplesPerBlock& locatedTriples) {
+      float timeToFirstBlock = 0;
+      measure(row, [&]() {
+        return runLazyScan(reader, fullScan, locatedTriples, handle,
+                           timeToFirstBlock);
+      });
+      table.setEntry(row, 4, timeToFirstBlock);
+    };
+
+    measure(0, [&]() { return scan(fullScan, permutation.noUpdates_); });
+    lazyScan(1, permutation.noUpdates_);
+    measure(2, [&]() { return scan(fullScan, permutation.updates_); });
+    lazyScan(3, permutation.updates_);
+    measure(4, [&]() { return scan(largestRelation, permutation.noUpdates_); });
+    // The prefiltering of the blocks is part of the measurement.
+    measure(5, [&]() {
+      auto blocks =
+          CompressedRelationReader::convertBlockMetadataRangesToVector(
+              CompressedRelationReader::getRelevantBlocks(
+                  largestRelation, allBlocks(permutation.blocks_)));
+      prefilterExpressions::LessThanExpression filter{
+          I(static_cast<int64_t>(relationSizes_[0] / 10))};
+      auto prefiltered = filter.evaluate(vocab, blocks, 1);
+      return reader
+          .scan(ScanSpecAndBlocks{largestRelation, allBlocks(prefiltered)}, {},
+                handle, permutation.noUpdates_)
+          .numRows();
+    });
+    measure(6, [&]() { return scan(singleGraph, permutation.noUpdates_); });
+  }
+
+  // Full scans that read (and decompress) an increasing number of columns.
+  void measureColumns(BenchmarkResults& results,
+                      const std::string& description,
+                      const CompressedRelationReader& reader,
+                      const PermutationAndUpdates& permutation) const {
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    ScanSpecification fullScan{std::nullopt, std::nullopt, std::nullopt};
+    std::vector<std::string> rowNames;
+    for (size_t numColumns = 3; numColumns <= numColumns_; ++numColumns) {
+      rowNames.push_back(absl::StrCat(numColumns, " columns"));
+    }
+    auto& table = results.addTable(
+        absl::StrCat("Decompression of the columns with ", description),
+        rowNames, {"Columns", "Time", "Time of the last column"});
+    for (size_t row = 0; row < rowNames.size(); ++row) {
+      size_t numColumns = row + 3;
+      table.addMeasurement(row, 1, [&]() {
+        reader.scan(
+            ScanSpecAndBlocks{fullScan, allBlocks(permutation.blocks_)},
+            additionalColumns(numColumns), handle, permutation.noUpdates_);
+      });
+      // The marginal cost of the column that was added in this row.
+      if (row > 0) {
+        table.setEntry(row, 2,
+                       table.getEntry<float>(row, 1) -
+                           table.getEntry<float>(row - 1, 1));
+      }
+    }
+  }
+
+  // Full lazy scans for all combinations of the configured values of the
+  // runtime parameters `lazy-index-scan-num-threads` and
+  // `lazy-index-scan-queue-size`.
+  void measureLazyScanParameters(
+      BenchmarkResults& results, const std::string& description,
+      const CompressedRelationReader& reader,
+      const PermutationAndUpdates& permutation) const {
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    ScanSpecification fullScan{std::nullopt, std::nullopt, std::nullopt};
+    std::vector<std::pair<size_t, size_t>> parameters;
+    std::vector<std::string> rowNames;
+    for (size_t numThreads : numThreads_) {
+      for (size_t queueSize : queueSizes_) {
+        parameters.emplace_back(numThreads, queueSize);
+        rowNames.push_back(absl::StrCat(numThreads, " threads, queue size ",
+                                        queueSize));
+      }
+    }
+    auto& table = results.addTable(
+        absl::StrCat("Full lazy scan with ", description), rowNames,
+        {"Parameters", "Time", "Time to first block"});
+    auto originalNumThreads =
+        RuntimeParameters().get<"lazy-index-scan-num-threads">();
+    auto originalQueueSize =
+        RuntimeParameters().get<"lazy-index-scan-queue-size">();
+    for (size_t row = 0; row < parameters.size(); ++row) {
+      RuntimeParameters().set<"lazy-index-scan-num-threads">(
+          parameters[row].first);
+      RuntimeParameters().set<"lazy-index-scan-queue-size">(
+          parameters[row].second);
+      float timeToFirstBlock = 0;
+      table.addMeasurement(row, 1, [&]() {
+        runLazyScan(reader, fullScan, permutation.noUpdates_, handle,
+                    timeToFirstBlock);
+      });
+      table.setEntry(row, 2, timeToFirstBlock);
+    }
+    RuntimeParameters().set<"lazy-index-scan-num-threads">(originalNumThreads);
+    RuntimeParameters().set<"lazy-index-scan-queue-size">(originalQueueSize);
+  }
+};
+
+AD_REGISTER_BENCHMARK(IndexScanBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,108 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/container/node_hash_set.h>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/engine/ValuesForTesting.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "engine/Bind.h"
+#include "engine/LocalVocab.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/NaryExpression.h"
+#include "util/Log.h"
+
+namespace ad_benchmark {
+
+// Benchmarks for the `LocalVocab`, in particular for the case that many new
+// strings are created, as it happens e.g. for a `BIND` with a string function.
+class LocalVocabBenchmark : public BenchmarkInterface {
+  static constexpr size_t numWords = 5'000'000;
+  static constexpr size_t numDistinctWords[] = {5'000'000, 500'000, 5'000};
+
+  std::string name() const final { return "Benchmarks for the local vocab"; }
+
+  // Create `numWords` literals, of which `numDistinct` are distinct.
+  static std::vector<LocalVocabEntry> makeWords(size_t numDistinct) {
+    using ad_utility::triple_component::LiteralOrIri;
+    std::vector<LocalVocabEntry> words;
+    words.reserve(numWords);
+    for (size_t i = 0; i < numWords; ++i) {
+      words.emplace_back(LiteralOrIri::literalWithoutQuotes(
+          absl::StrCat("someLongerPrefixToAvoidSSO", i % numDistinct)));
+    }
+    return words;
+  }
+
+  // Compare the insertion of words into a `LocalVocab` with the insertion into
+  // an `absl::node_hash_set`, which was previously used as the underlying
+  // storage of the `LocalVocab`.
+  void insertionBenchmarks(BenchmarkResults& results) {
+    std::vector<std::string> rowNames;
+    for (size_t numDistinct : numDistinctWords) {
+      rowNames.push_back(absl::StrCat(numDistinct, " distinct words"));
+    }
+    auto& table = results.addTable(
+        absl::StrCat("Insertion of ", numWords, " words"), rowNames,
+        {"Number of distinct words", "absl::node_hash_set", "LocalVocab"});
+    for (size_t row = 0; row < rowNames.size(); ++row) {
+      auto words = makeWords(numDistinctWords[row]);
+      table.addMeasurement(row, 1, [&words]() {
+        absl::node_hash_set<LocalVocabEntry> set;
+        for (const auto& word : words) {
+          set.insert(word);
+        }
+        AD_CORRECTNESS_CHECK(!set.empty());
+      });
+      table.addMeasurement(row, 2, [&words]() {
+        LocalVocab localVocab;
+        for (const auto& word : words) {
+          (void)localVocab.getIndexAndAddIfNotContained(word);
+        }
+        AD_CORRECTNESS_CHECK(!localVocab.empty());
+      });
+    }
+  }
+
+  // Measure `BIND(STR(?a) AS ?b)` where `?a` is bound to integers, s.t. every
+  // row of the result creates a new string in the local vocab.
+  void bindBenchmarks(BenchmarkResults& results) {
+    using namespace sparqlExpression;
+    auto* qec = ad_utility::testing::getQec();
+    for (size_t numDistinct : numDistinctWords) {
+      IdTable table{1, qec->getAllocator()};
+      table.resize(numWords);
+      for (size_t i = 0; i < numWords; ++i) {
+        table(i, 0) = Id::makeFromInt(static_cast<int64_t>(i % numDistinct));
+      }
+      auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec, std::move(table),
+          std::vector<std::optional<Variable>>{Variable{"?a"}});
+      Bind bind{qec,
+                std::move(values),
+                {SparqlExpressionPimpl{
+                     makeStrExpression(
+                         std::make_unique<VariableExpression>(Variable{"?a"})),
+                     "STR(?a) as ?b"},
+                 Variable{"?b"}}};
+      results.addMeasurement(
+          absl::StrCat("BIND(STR(?a) AS ?b) with ", numWords, " rows and ",
+                       numDistinct, " distinct values"),
+          [&bind, qec]() {
+            qec->getQueryTreeCache().clearAll();
+            auto result =
+                bind.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+            LOG(INFO) << "size of local vocab was "
+                      << result->localVocab().size() << std::endl;
+          });
+    }
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    insertionBenchmarks(results);
+    bindBenchmarks(results);
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(LocalVocabBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,84 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/str_cat.h>
+
+#include <numeric>
+#include <random>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "util/BitPackingCode.h"
+#include "util/Log.h"
+#include "util/Simple8bCode.h"
+
+namespace ad_benchmark {
+
+// Compare the decoding of the posting lists of the text index (sorted text
+// record indices) with the `Simple8bCode` (gap encoded, the old codec) and the
+// `BitPackingCode` (delta encoded, the new codec).
+class PostingCodecBenchmark : public BenchmarkInterface {
+  static constexpr size_t numPostings = 10'000'000;
+  static constexpr size_t numRepetitions = 10;
+
+  std::string name() const final {
+    return "Benchmarks for decoding the posting lists of the text index";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    using ad_utility::BitPackingCode;
+    using ad_utility::Simple8bCode;
+
+    // The postings of a frequent word: sorted text records with small gaps
+    // (and some duplicates).
+    std::mt19937_64 gen{42};
+    std::geometric_distribution<uint64_t> gap{0.2};
+    std::vector<uint64_t> postings(numPostings);
+    uint64_t current = 0;
+    for (auto& posting : postings) {
+      current += gap(gen);
+      posting = current;
+    }
+
+    std::vector<uint64_t> gaps(numPostings);
+    std::adjacent_difference(postings.begin(), postings.end(), gaps.begin());
+    std::vector<uint64_t> simple8b(numPostings);
+    size_t simple8bBytes =
+        Simple8bCode::encode(gaps.data(), gaps.size(), simple8b.data());
+    auto bitPacked = BitPackingCode::encode<true>(postings.data(), numPostings);
+
+    auto& table = results.addTable(
+        absl::StrCat("Decoding ", numPostings, " postings ", numRepetitions,
+                     " times"),
+        {"Simple8b", "Bit packing"}, {"Codec", "Bytes", "Time"});
+    table.setEntry(0, 1, simple8bBytes);
+    table.setEntry(1, 1, bitPacked.size() * sizeof(uint64_t));
+
+    uint64_t checksum = 0;
+    std::vector<uint64_t> decoded;
+    table.addMeasurement(0, 2, [&]() {
+      for (size_t i = 0; i < numRepetitions; ++i) {
+        decoded.resize(numPostings + 250);
+        Simple8bCode::decode(simple8b.data(), numPostings, decoded.data());
+        uint64_t previous = 0;
+        for (size_t j = 0; j < numPostings; ++j) {
+          previous += decoded[j];
+          decoded[j] = previous;
+        }
+        checksum += decoded[numPostings - 1];
+      }
+    });
+    table.addMeasurement(1, 2, [&]() {
+      for (size_t i = 0; i < numRepetitions; ++i) {
+        decoded.resize(BitPackingCode::decodedSize(numPostings));
+        BitPackingCode::decode<true>(bitPacked.data(), numPostings,
+                                     decoded.data());
+        checksum += decoded[numPostings - 1];
+      }
+    });
+    AD_CORRECTNESS_CHECK(checksum == 2 * numRepetitions * postings.back());
+    LOG(INFO) << "Checksum: " << checksum << std::endl;
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(PostingCodecBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,410 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_replace.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <random>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/util/AllocatorTestHelpers.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "backports/algorithm.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryPlanner.h"
+#include "index/Index.h"
+#include "parser/SparqlParser.h"
+#include "util/Exception.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Timer.h"
+
+namespace ad_benchmark {
+
+namespace {
+// The shape of the synthetic dataset (per department of each university).
+constexpr size_t numDepartments = 15;
+constexpr size_t numProfessors = 20;
+constexpr size_t numCourses = 30;
+constexpr size_t numGraduateCourses = 10;
+constexpr size_t numUndergraduateStudents = 200;
+constexpr size_t numGraduateStudents = 50;
+constexpr size_t numPublicationsPerProfessor = 5;
+
+constexpr std::string_view prefixUb =
+    "PREFIX ub: <http://swat.cse.lehigh.edu/onto/univ-bench.owl#>\n";
+
+// The default query mix. The placeholders `{u}` and `{d}` are replaced by a
+// random university and a random department, s.t. some of the queries (and
+// many of their subresults) are repeated and can be answered from the cache.
+// The queries are modelled after the LUBM queries, but without the inference.
+const std::vector<std::string> defaultQueryMix{
+    // Selective star with a constant.
+    "SELECT ?x WHERE { ?x a ub:GraduateStudent . ?x ub:takesCourse "
+    "<http://www.Department{d}.University{u}.edu/GraduateCourse0> }",
+    // Cyclic pattern over the whole dataset.
+    "SELECT ?x ?y ?z WHERE { ?x a ub:GraduateStudent . ?y a ub:University . "
+    "?z a ub:Department . ?x ub:memberOf ?z . ?z ub:subOrganizationOf ?y . "
+    "?x ub:undergraduateDegreeFrom ?y }",
+    // Star with several attributes.
+    "SELECT ?x ?name ?email ?age WHERE { ?x ub:worksFor "
+    "<http://www.Department{d}.University{u}.edu> . ?x ub:name ?name . "
+    "?x ub:emailAddress ?email . ?x ub:age ?age }",
+    // Path from a constant.
+    "SELECT ?x ?y WHERE { "
+    "<http://www.Department{d}.University{u}.edu/Professor0> ub:teacherOf ?y "
+    ". ?x ub:takesCourse ?y }",
+    // Triangle over the whole dataset.
+    "SELECT ?x ?y ?z WHERE { ?x ub:advisor ?y . ?y ub:teacherOf ?z . "
+    "?x ub:takesCourse ?z }",
+    // Aggregation.
+    "SELECT ?d (COUNT(?x) AS ?count) WHERE { ?x ub:memberOf ?d . "
+    "?d ub:subOrganizationOf <http://www.University{u}.edu> } GROUP BY ?d",
+    // Filter and sort.
+    "SELECT ?x ?age WHERE { ?x a ub:Professor . ?x ub:age ?age "
+    "FILTER(?age > 60) } ORDER BY DESC(?age) LIMIT 100",
+    // Join of a large and a small relation.
+    "SELECT ?p ?name WHERE { ?p ub:publicationAuthor ?a . ?a ub:worksFor "
+    "<http://www.Department{d}.University{u}.edu> . ?p ub:name ?name }"};
+
+// The statistics of a single run of the query mix.
+struct RunStatistics {
+  std::vector<double> latenciesInMs_;
+  size_t numCacheHits_ = 0;
+};
+
+// The `percentile` (in [0, 100]) of the sorted `values` (nearest rank).
+double percentile(const std::vector<double>& values, double percentile) {
+  AD_CONTRACT_CHECK(!values.empty());
+  auto rank = static_cast<size_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(values.size())));
+  return values[std::clamp(rank, size_t{1}, values.size()) - 1];
+}
+
+// The peak resident set size of this process so far.
+ad_utility::MemorySize peakMemory() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  // On Linux, `ru_maxrss` is given in kilobytes.
+  return ad_utility::MemorySize::kilobytes(
+      static_cast<size_t>(usage.ru_maxrss));
+}
+}  // namespace
+
+// Run a mix of SPARQL queries end-to-end (parsing, query planning, and the
+// computation of the result with `Operation::getResult`) against an index of
+// a synthetic, LUBM-like dataset with different numbers of concurrent clients,
+// which share the query result cache. For each number of clients, the cache
+// is cleared and the complete mix is run once. The queries are either taken
+// from a query log (a text file with one SPARQL query per line; empty lines
+// and lines that start with `#` are ignored), which is replayed in order, or
+// drawn randomly from a built-in mix of LUBM-like queries.
+class QueryBenchmark : public BenchmarkInterface {
+  size_t numUniversities_;
+  std::string queryLog_;
+  size_t numQueries_;
+  std::vector<size_t> numClients_;
+  size_t randomSeed_;
+
+ public:
+  QueryBenchmark() {
+    ad_utility::ConfigManager& config = getConfigManager();
+    config.addOption("num-universities",
+                     "The size of the synthetic dataset. Each university "
+                     "consists of roughly 40'000 triples.",
+                     &numUniversities_, size_t{10});
+    config.addOption("query-log",
+                     "The query log to replay (see the documentation of "
+                     "`QueryBenchmark` for the format). If empty, the "
+                     "built-in query mix is used.",
+                     &queryLog_, std::string{});
+    config.addOption("num-queries",
+                     "The number of queries that are drawn from the built-in "
+                     "query mix.",
+                     &numQueries_, size_t{1000});
+    config.addOption("num-clients",
+                     "The numbers of concurrent clients with which the query "
+                     "mix is run.",
+                     &numClients_, std::vector<size_t>{1, 2, 4, 8});
+    config.addOption("random-seed",
+                     "The seed for the generation of the dataset and the "
+                     "query mix.",
+                     &randomSeed_, size_t{42});
+  }
+
+  std::string name() const final {
+    return "End-to-end benchmark of a query mix on a synthetic dataset";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    AD_CONTRACT_CHECK(numUniversities_ > 0);
+    BenchmarkResults results{};
+    std::string basename = "queryBenchmark";
+    std::mt19937_64 gen{randomSeed_};
+    size_t numTriples = writeDataset(basename + ".ttl", gen);
+    results.addMeasurement(
+        absl::StrCat("Index build (", numTriples, " triples)"),
+        [&]() { buildIndex(basename); });
+    Index index{ad_utility::makeUnlimitedAllocator<Id>()};
+    index.createFromOnDiskIndex(basename, false);
+
+    auto queries =
+        queryLog_.empty() ? makeQueryMix(gen) : readQueryLog(queryLog_);
+    AD_CONTRACT_CHECK(!queries.empty(), "The query mix is empty");
+    std::vector<std::string> rowNames;
+    for (size_t n : numClients_) {
+      rowNames.push_back(absl::StrCat(n, n == 1 ? " client" : " clients"));
+    }
+    auto& table = results.addTable(
+        absl::StrCat(queries.size(), " queries on ", numTriples, " triples"),
+        rowNames,
+        {"Clients", "Total time", "Throughput (queries/s)", "p50 latency (ms)",
+         "p95 latency (ms)", "p99 latency (ms)", "Cache hit rate (%)",
+         "Peak memory (MB)"});
+
+    QueryResultCache cache;
+    for (size_t row = 0; row < numClients_.size(); ++row) {
+      cache.clearAll();
+      RunStatistics statistics;
+      ad_utility::Timer timer{ad_utility::Timer::Started};
+      table.addMeasurement(row, 1, [&]() {
+        statistics = runQueries(queries, numClients_[row], index, cache);
+      });
+      double totalSeconds = ad_utility::Timer::toSeconds(timer.value());
+      auto& latencies = statistics.latenciesInMs_;
+      ql::ranges::sort(latencies);
+      table.setEntry(row, 2,
+                     static_cast<float>(static_cast<double>(queries.size()) /
+                                        totalSeconds));
+      table.setEntry(row, 3, static_cast<float>(percentile(latencies, 50)));
+      table.setEntry(row, 4, static_cast<float>(percentile(latencies, 95)));
+      table.setEntry(row, 5, static_cast<float>(percentile(latencies, 99)));
+      table.setEntry(row, 6,
+                     static_cast<float>(
+                         100.0 * static_cast<double>(statistics.numCacheHits_) /
+                         static_cast<double>(queries.size())));
+      table.setEntry(row, 7, static_cast<float>(peakMemory().getMegabytes()));
+    }
+
+    for (const auto& filename :
+         ad_utility::testing::getAllIndexFilenames(basename)) {
+      ad_utility::deleteFile(filename, false);
+    }
+    return results;
+  }
+
+ private:
+  // Write the synthetic dataset with `numUniversities_` universities to the
+  // turtle file with the given `filename` and return the number of triples.
+  size_t writeDataset(const std::string& filename,
+                      std::mt19937_64& gen) const {
+    std::uniform_int_distribution<size_t> university{0, numUniversities_ - 1};
+    std::uniform_int_distribution<size_t> course{0, numCourses - 1};
+    std::uniform_int_distribution<size_t> graduateCourse{
+        0, numGraduateCourses - 1};
+    std::uniform_int_distribution<size_t> professor{0, numProfessors - 1};
+    std::uniform_int_distribution<size_t> age{25, 70};
+    std::uniform_int_distribution<size_t> percentage{0, 99};
+
+    std::ofstream file{filename};
+    AD_CONTRACT_CHECK(file.is_open(), "Could not open ", filename);
+    std::string buffer = "@prefix ub: "
+                         "<http://swat.cse.lehigh.edu/onto/univ-bench.owl#> "
+                         ".\n";
+    size_t numTriples = 0;
+    auto addTriple = [&](std::string_view s, std::string_view p,
+                         std::string_view o) {
+      absl::StrAppend(&buffer, s, " ", p, " ", o, " .\n");
+      ++numTriples;
+    };
+    auto literal = [](const auto&... parts) {
+      return absl::StrCat("\"", parts..., "\"");
+    };
+    // A person with a name, an email address and an age. The domain of the
+    // email address is the host of the `iri` (without the `<http://www.`).
+    auto addPerson = [&](const std::string& iri, std::string_view type,
+                         std::string_view name) {
+      constexpr size_t hostBegin = std::string_view{"<http://www."}.size();
+      addTriple(iri, "a", type);
+      addTriple(iri, "ub:name", literal(name));
+      addTriple(iri, "ub:emailAddress",
+                literal(name, "@",
+                        iri.substr(hostBegin,
+                                   iri.find('/', hostBegin) - hostBegin)));
+      addTriple(iri, "ub:age", std::to_string(age(gen)));
+    };
+
+    for (size_t u = 0; u < numUniversities_; ++u) {
+      auto universityIri = absl::StrCat("<http://www.University", u, ".edu>");
+      addTriple(universityIri, "a", "ub:University");
+      addTriple(universityIri, "ub:name", literal("University", u));
+      for (size_t d = 0; d < numDepartments; ++d) {
+        auto base = absl::StrCat("http://www.Department", d, ".University", u,
+                                 ".edu");
+        auto departmentIri = absl::StrCat("<", base, ">");
+        auto iri = [&base](std::string_view kind, size_t i) {
+          return absl::StrCat("<", base, "/", kind, i, ">");
+        };
+        addTriple(departmentIri, "a", "ub:Department");
+        addTriple(departmentIri, "ub:subOrganizationOf", universityIri);
+        addTriple(departmentIri, "ub:name", literal("Department", d));
+        for (size_t c = 0; c < numCourses; ++c) {
+          addTriple(iri("Course", c), "a", "ub:Course");
+          addTriple(iri("Course", c), "ub:name", literal("Course", c));
+        }
+        for (size_t c = 0; c < numGraduateCourses; ++c) {
+          addTriple(iri("GraduateCourse", c), "a", "ub:GraduateCourse");
+          addTriple(iri("GraduateCourse", c), "ub:name",
+                    literal("GraduateCourse", c));
+        }
+        for (size_t p = 0; p < numProfessors; ++p) {
+          auto professorIri = iri("Professor", p);
+          addPerson(professorIri, "ub:Professor", absl::StrCat("Professor", p));
+          addTriple(professorIri, "ub:worksFor", departmentIri);
+          addTriple(professorIri, "ub:teacherOf", iri("Course", p));
+          addTriple(professorIri, "ub:teacherOf",
+                    iri("GraduateCourse", p % numGraduateCourses));
+          for (size_t i = 0; i < numPublicationsPerProfessor; ++i) {
+            auto publicationIri =
+                iri("Publication", p * numPublicationsPerProfessor + i);
+            addTriple(publicationIri, "a", "ub:Publication");
+            addTriple(publicationIri, "ub:name",
+                      literal("Publication", i, " of Professor", p));
+            addTriple(publicationIri, "ub:publicationAuthor", professorIri);
+          }
+        }
+        for (size_t s = 0; s < numUndergraduateStudents; ++s) {
+          auto studentIri = iri("UndergraduateStudent", s);
+          addPerson(studentIri, "ub:UndergraduateStudent",
+                    absl::StrCat("UndergraduateStudent", s));
+          addTriple(studentIri, "ub:memberOf", departmentIri);
+          for (size_t i = 0; i < 3; ++i) {
+            addTriple(studentIri, "ub:takesCourse", iri("Course", course(gen)));
+          }
+          if (percentage(gen) < 20) {
+            addTriple(studentIri, "ub:advisor",
+                      iri("Professor", professor(gen)));
+          }
+        }
+        for (size_t s = 0; s < numGraduateStudents; ++s) {
+          auto studentIri = iri("GraduateStudent", s);
+          addPerson(studentIri, "ub:GraduateStudent",
+                    absl::StrCat("GraduateStudent", s));
+          addTriple(studentIri, "ub:memberOf", departmentIri);
+          addTriple(studentIri, "ub:undergraduateDegreeFrom",
+                    absl::StrCat("<http://www.University", university(gen),
+                                 ".edu>"));
+          addTriple(studentIri, "ub:advisor", iri("Professor", professor(gen)));
+          for (size_t i = 0; i < 2; ++i) {
+            addTriple(studentIri, "ub:takesCourse",
+                      iri("GraduateCourse", graduateCourse(gen)));
+          }
+          if (percentage(gen) < 30) {
+            addTriple(iri("Publication", professor(gen) *
+                                             numPublicationsPerProfessor),
+                      "ub:publicationAuthor", studentIri);
+          }
+        }
+      }
+      file << buffer;
+      buffer.clear();
+    }
+    return numTriples;
+  }
+
+  // Build the index from the turtle file `<basename>.ttl` with the default
+  // settings.
+  static void buildIndex(const std::string& basename) {
+    Index index{ad_utility::makeUnlimitedAllocator<Id>()};
+    index.setOnDiskBase(basename);
+    index.usePatterns() = true;
+    index.createFromFiles({qlever::InputFileSpecification{
+        basename + ".ttl", qlever::Filetype::Turtle, std::nullopt}});
+  }
+
+  // Draw `numQueries_` queries from the `defaultQueryMix`.
+  std::vector<std::string> makeQueryMix(std::mt19937_64& gen) const {
+    std::uniform_int_distribution<size_t> query{0, defaultQueryMix.size() - 1};
+    std::uniform_int_distribution<size_t> university{0, numUniversities_ - 1};
+    std::uniform_int_distribution<size_t> department{0, numDepartments - 1};
+    std::vector<std::string> queries;
+    queries.reserve(numQueries_);
+    for (size_t i = 0; i < numQueries_; ++i) {
+      queries.push_back(absl::StrCat(
+          prefixUb,
+          absl::StrReplaceAll(
+              defaultQueryMix[query(gen)],
+              {{"{u}", std::to_string(university(gen))},
+               {"{d}", std::to_string(department(gen))}})));
+    }
+    return queries;
+  }
+
+  // Read a query log in the format that is described above.
+  static std::vector<std::string> readQueryLog(const std::string& filename) {
+    std::ifstream file{filename};
+    AD_CONTRACT_CHECK(file.is_open(), "Could not open the query log ",
+                      filename);
+    std::vector<std::string> queries;
+    std::string line;
+    while (std::getline(file, line)) {
+      if (!line.empty() && !line.starts_with('#')) {
+        queries.push_back(std::move(line));
+      }
+    }
+    return queries;
+  }
+
+  // Run the `queries` with `numClients` concurrent clients, which share the
+  // `index` and the `cache`. Each client repeatedly takes the next query that
+  // has not been started yet, s.t. the queries are started in order.
+  static RunStatistics runQueries(const std::vector<std::string>& queries,
+                                  size_t numClients, const Index& index,
+                                  QueryResultCache& cache) {
+    AD_CONTRACT_CHECK(numClients > 0);
+    std::atomic<size_t> nextQuery = 0;
+    auto client = [&]() {
+      RunStatistics statistics;
+      // Like in the `Server`, each query gets its own execution context.
+      for (size_t i = nextQuery++; i < queries.size(); i = nextQuery++) {
+        ad_utility::Timer timer{ad_utility::Timer::Started};
+        QueryExecutionContext qec{index, &cache,
+                                  ad_utility::testing::makeAllocator(),
+                                  SortPerformanceEstimator{}};
+        auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+        QueryPlanner planner{&qec, handle};
+        auto parsedQuery = SparqlParser::parseQuery(queries[i]);
+        auto qet = planner.createExecutionTree(parsedQuery);
+        qet.isRoot() = true;
+        qet.getRootOperation()->recursivelySetCancellationHandle(handle);
+        auto result = qet.getResult();
+        statistics.latenciesInMs_.push_back(
+            1000.0 * ad_utility::Timer::toSeconds(timer.value()));
+        if (qet.getRootOperation()->runtimeInfo().cacheStatus_ !=
+            ad_utility::CacheStatus::computed) {
+          ++statistics.numCacheHits_;
+        }
+      }
+      return statistics;
+    };
+    std::vector<std::future<RunStatistics>> futures;
+    for (size_t i = 0; i < numClients; ++i) {
+      futures.push_back(std::async(std::launch::async, client));
+    }
+    RunStatistics statistics;
+    for (auto& future : futures) {
+      auto clientStatistics = future.get();
+      ql::ranges::copy(clientStatistics.latenciesInMs_,
+                       std::back_inserter(statistics.latenciesInMs_));
+      statistics.numCacheHits_ += clientStatistics.numCacheHits_;
+    }
+    return statistics;
+  }
+};
+
+AD_REGISTER_BENCHMARK(QueryBenchmark);
+}  // namespace ad_benchmark
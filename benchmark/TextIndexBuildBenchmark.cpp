@@ -0,0 +1,135 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/str_cat.h>
+
+#include <cmath>
+#include <random>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/WordsAndDocsFileLineCreator.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "index/TextIndexBuilder.h"
+#include "util/File.h"
+#include "util/Log.h"
+
+namespace ad_benchmark {
+
+// Measure the time for building the text index (the postings and the docsDB)
+// from a synthetic words file and docs file with different numbers of threads.
+class TextIndexBuildBenchmark : public BenchmarkInterface {
+  static constexpr size_t numRecords = 500'000;
+  static constexpr size_t numWordsPerRecord = 12;
+  static constexpr size_t numDistinctWords = 50'000;
+  static constexpr size_t numEntities = 1'000;
+
+  std::string name() const final {
+    return "Benchmarks for building the text index";
+  }
+
+  // A random lowercase word of four to ten letters.
+  static std::string makeWord(std::mt19937_64& gen) {
+    std::uniform_int_distribution<size_t> length{4, 10};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+    std::string word(length(gen), 'a');
+    for (char& c : word) {
+      c = static_cast<char>(letter(gen));
+    }
+    return word;
+  }
+
+  // Write the words file and the docs file with `numRecords` text records. The
+  // words are Zipf-like distributed, and every fourth record mentions one of
+  // the `numEntities` entities.
+  static void writeInputFiles(const std::string& wordsFileName,
+                              const std::string& docsFileName) {
+    std::mt19937_64 gen{42};
+    std::vector<std::string> words;
+    for (size_t i = 0; i < numDistinctWords; ++i) {
+      words.push_back(makeWord(gen));
+    }
+    std::uniform_real_distribution<double> uniform{0, 1};
+    auto randomWord = [&]() -> const std::string& {
+      return words[static_cast<size_t>(
+          std::pow(uniform(gen), 3) * static_cast<double>(words.size() - 1))];
+    };
+    ad_utility::File wordsFile{wordsFileName, "w"};
+    ad_utility::File docsFile{docsFileName, "w"};
+    std::string wordsLines;
+    std::string text;
+    for (size_t record = 1; record <= numRecords; ++record) {
+      text.clear();
+      for (size_t i = 0; i < numWordsPerRecord; ++i) {
+        const auto& word = randomWord();
+        absl::StrAppend(&wordsLines,
+                        createWordsFileLineAsString(word, false, record, 1));
+        absl::StrAppend(&text, i == 0 ? "" : " ", word);
+      }
+      if (record % 4 == 0) {
+        absl::StrAppend(&wordsLines,
+                        createWordsFileLineAsString(
+                            absl::StrCat("<e", record % numEntities, ">"),
+                            true, record, 0));
+      }
+      auto docsLine = createDocsFileLineAsString(record, text);
+      docsFile.write(docsLine.data(), docsLine.size());
+      if (wordsLines.size() > 1'000'000) {
+        wordsFile.write(wordsLines.data(), wordsLines.size());
+        wordsLines.clear();
+      }
+    }
+    wordsFile.write(wordsLines.data(), wordsLines.size());
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    std::string basename = "textIndexBuildBenchmark";
+    std::string wordsFileName = basename + ".wordsfile.tsv";
+    std::string docsFileName = basename + ".docsfile.tsv";
+
+    // The knowledge graph only contains the entities from the text.
+    std::string turtle;
+    for (size_t i = 0; i < numEntities; ++i) {
+      absl::StrAppend(&turtle, "<e", i, "> <p> <o> . ");
+    }
+    ad_utility::testing::TestIndexConfig config{std::move(turtle)};
+    config.addWordsFromLiterals = false;
+    ad_utility::testing::makeTestIndex(basename, std::move(config));
+    writeInputFiles(wordsFileName, docsFileName);
+
+    std::vector<size_t> numThreads{1, 2, 4, 8};
+    std::vector<std::string> rowNames;
+    for (size_t n : numThreads) {
+      rowNames.push_back(absl::StrCat(n, " threads"));
+    }
+    auto& table =
+        results.addTable(absl::StrCat("Text index with ", numRecords,
+                                      " records of ", numWordsPerRecord,
+                                      " words"),
+                         rowNames, {"Threads", "Build time"});
+    for (size_t row = 0; row < numThreads.size(); ++row) {
+      TextIndexBuilder builder{ad_utility::makeUnlimitedAllocator<Id>(),
+                               basename};
+      builder.setNumThreads(numThreads[row]);
+      table.addMeasurement(row, 1, [&]() {
+        builder.buildTextIndexFile(std::pair{wordsFileName, docsFileName},
+                                   false);
+      });
+    }
+    TextIndexBuilder builder{ad_utility::makeUnlimitedAllocator<Id>(),
+                             basename};
+    results.addMeasurement("DocsDB",
+                           [&]() { builder.buildDocsDB(docsFileName); });
+
+    for (const auto& filename :
+         ad_utility::testing::getAllIndexFilenames(basename)) {
+      ad_utility::deleteFile(filename, false);
+    }
+    ad_utility::deleteFile(basename + ".ttl");
+    ad_utility::deleteFile(basename + ".ttl.settings.json");
+    ad_utility::deleteFile(wordsFileName);
+    ad_utility::deleteFile(docsFileName);
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(TextIndexBuildBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,145 @@
+// Copyright 2025 The QLever Authors
+
+#include <random>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/engine/ValuesForTesting.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "engine/Join.h"
+#include "engine/LeapfrogTriejoin.h"
+#include "engine/MultiColumnJoin.h"
+#include "util/Log.h"
+
+namespace ad_benchmark {
+
+// Compare the `LeapfrogTriejoin` with a cascade of binary joins (a `Join`
+// followed by a `MultiColumnJoin`, which is what the query planner creates
+// otherwise) for the triangle query `?a <e> ?b . ?b <e> ?c . ?a <e> ?c` on
+// synthetic graphs. The edges `(u, v)` always satisfy `u < v`, s.t. each
+// triangle is found exactly once.
+class WorstCaseOptimalJoinBenchmark : public BenchmarkInterface {
+  using Edges = std::vector<std::pair<uint64_t, uint64_t>>;
+
+  std::string name() const final {
+    return "Benchmarks for the worst-case-optimal join of triangles";
+  }
+
+  // Add the edge between `u` and `v` in the direction from the smaller to the
+  // larger node.
+  static void addEdge(Edges& edges, uint64_t u, uint64_t v) {
+    if (u != v) {
+      edges.emplace_back(std::min(u, v), std::max(u, v));
+    }
+  }
+
+  // `numCliques` disjoint cliques with `cliqueSize` nodes each. Almost all the
+  // paths of length two are closed to a triangle.
+  static Edges makeCliques(size_t numCliques, size_t cliqueSize) {
+    Edges edges;
+    for (size_t clique = 0; clique < numCliques; ++clique) {
+      uint64_t first = clique * cliqueSize;
+      for (uint64_t u = first; u < first + cliqueSize; ++u) {
+        for (uint64_t v = u + 1; v < first + cliqueSize; ++v) {
+          addEdge(edges, u, v);
+        }
+      }
+    }
+    return edges;
+  }
+
+  // `numEdges` random edges between `numNodes` nodes.
+  static Edges makeRandomGraph(size_t numNodes, size_t numEdges,
+                               std::mt19937_64& gen) {
+    std::uniform_int_distribution<uint64_t> node{0, numNodes - 1};
+    Edges edges;
+    for (size_t i = 0; i < numEdges; ++i) {
+      addEdge(edges, node(gen), node(gen));
+    }
+    return edges;
+  }
+
+  // `numEdges` random edges between `numNodes` nodes, plus `numHubs` nodes in
+  // the middle of the id range that are connected to all the other nodes. The
+  // paths of length two via the hubs blow up the result of the first binary
+  // join, but only the random edges close them to triangles.
+  static Edges makeGraphWithHubs(size_t numNodes, size_t numEdges,
+                                 size_t numHubs, std::mt19937_64& gen) {
+    Edges edges = makeRandomGraph(numNodes, numEdges, gen);
+    for (uint64_t hub = numNodes / 2; hub < numNodes / 2 + numHubs; ++hub) {
+      for (uint64_t u = 0; u < numNodes; ++u) {
+        addEdge(edges, u, hub);
+      }
+    }
+    return edges;
+  }
+
+  // The `edges` without duplicates as an `IdTable` with two columns.
+  static IdTable makeTable(Edges edges, QueryExecutionContext* qec) {
+    ql::ranges::sort(edges);
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    IdTable table{2, qec->getAllocator()};
+    table.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+      table(i, 0) = Id::makeFromVocabIndex(VocabIndex::make(edges[i].first));
+      table(i, 1) = Id::makeFromVocabIndex(VocabIndex::make(edges[i].second));
+    }
+    return table;
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    auto* qec = ad_utility::testing::getQec();
+    std::mt19937_64 gen{42};
+    std::vector<std::pair<std::string, Edges>> graphs;
+    graphs.emplace_back("20'000 cliques of 20 nodes", makeCliques(20'000, 20));
+    graphs.emplace_back("random, 100'000 nodes, 1'000'000 edges",
+                        makeRandomGraph(100'000, 1'000'000, gen));
+    graphs.emplace_back("random, 2'000 nodes, 20'000 edges, 10 hubs",
+                        makeGraphWithHubs(2'000, 20'000, 10, gen));
+
+    std::vector<std::string> rowNames;
+    for (const auto& graph : graphs | ql::views::keys) {
+      rowNames.push_back(graph);
+    }
+    auto& table = results.addTable(
+        "Triangle query", rowNames,
+        {"Graph", "Number of edges", "Number of triangles",
+         "Leapfrog Triejoin", "Binary joins"});
+
+    for (size_t row = 0; row < graphs.size(); ++row) {
+      IdTable edges = makeTable(std::move(graphs[row].second), qec);
+      table.setEntry(row, 1, edges.numRows());
+      auto scan = [qec, &edges](std::string a, std::string b) {
+        return ad_utility::makeExecutionTree<ValuesForTesting>(
+            qec, edges.clone(),
+            std::vector<std::optional<Variable>>{Variable{std::move(a)},
+                                                 Variable{std::move(b)}});
+      };
+
+      LeapfrogTriejoin triejoin{
+          qec, {scan("?a", "?b"), scan("?b", "?c"), scan("?a", "?c")}};
+      size_t numTriangles = 0;
+      table.addMeasurement(row, 3, [&triejoin, &numTriangles, qec]() {
+        qec->getQueryTreeCache().clearAll();
+        auto result =
+            triejoin.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+        numTriangles = result->idTable().numRows();
+      });
+      table.setEntry(row, 2, numTriangles);
+
+      // `?a ?b` join `?b ?c` on `?b`, then join with `?a ?c` on both columns.
+      auto paths = ad_utility::makeExecutionTree<Join>(
+          qec, scan("?a", "?b"), scan("?b", "?c"), 1, 0);
+      MultiColumnJoin binaryJoins{qec, std::move(paths), scan("?a", "?c")};
+      table.addMeasurement(row, 4, [&binaryJoins, numTriangles, qec]() {
+        qec->getQueryTreeCache().clearAll();
+        auto result =
+            binaryJoins.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+        AD_CORRECTNESS_CHECK(result->idTable().numRows() == numTriangles);
+      });
+    }
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(WorstCaseOptimalJoinBenchmark);
+}  // namespace ad_benchmark
@@ -96,6 +96,16 @@ int main(int argc, char** argv) {
       "least-recently used non-pinned entries from the cache. Note that "
       "this condition and the size limit specified via --cache-max-size "
       "both have to hold (logical AND).");
+  add("disk-cache-directory",
+      optionFactory.getProgramOption<"disk-cache-directory">(),
+      "Directory (ideally on a local SSD) for a second tier of the cache. "
+      "Results that are removed from the cache and pinned results are stored "
+      "there, s.t. the cache is warm after a restart. If empty, results are "
+      "only cached in memory.");
+  add("disk-cache-max-size",
+      optionFactory.getProgramOption<"disk-cache-max-size">(),
+      "Maximum size of all the results in the --disk-cache-directory. If "
+      "exceeded, the least recently used results are deleted.");
   add("no-patterns,P", po::bool_switch(&noPatterns),
       "Disable the use of patterns. If disabled, the special predicate "
       "`ql:has-predicate` is not available.");
@@ -29,6 +29,9 @@ class Bind : public Operation {
   const parsedQuery::Bind& bind() const { return _bind; }
   [[nodiscard]] std::string getDescriptor() const override;
   [[nodiscard]] size_t getResultWidth() const override;
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
   std::vector<QueryExecutionTree*> getChildren() override;
   size_t getCostEstimate() override;
   bool supportsLimitOffset() const override;
@@ -268,6 +268,17 @@ CartesianProductJoin::calculateSubResults(bool requestLaziness) {
   std::shared_ptr<const Result> lazyResult = nullptr;
   auto children = childView();
   AD_CORRECTNESS_CHECK(!ql::ranges::empty(children));
+  // Without a limit, the children are computed in full anyway, so we can
+  // compute them concurrently. The last child is then computed lazily (see
+  // below), if requested.
+  if (!limitIfPresent.has_value()) {
+    auto materializedChildren = children_;
+    if (requestLaziness) {
+      materializedChildren.pop_back();
+    }
+    computeChildrenInParallel(materializedChildren,
+                              ComputationMode::FULLY_MATERIALIZED);
+  }
   // Get all child results (possibly with limit, see above).
   for (std::shared_ptr<QueryExecutionTree>& childTree : children_) {
     if (limitIfPresent.has_value() && childTree->supportsLimit()) {
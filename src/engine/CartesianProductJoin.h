@@ -46,6 +46,10 @@ class CartesianProductJoin : public Operation {
                                 Children children,
                                 size_t chunkSize = 1'000'000);
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   /// get non-owning pointers to all the held subtrees to actually use the
   /// Execution Trees as trees
   std::vector<QueryExecutionTree*> getChildren() override;
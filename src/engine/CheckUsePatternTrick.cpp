@@ -69,7 +69,8 @@ bool isVariableContainedInGraphPatternOperation(
     } else {
       static_assert(
           ad_utility::SameAsAny<T, p::TransPath, p::PathQuery, p::Describe,
-                                p::SpatialQuery, p::TextSearchQuery, p::Load>);
+                                p::SpatialQuery, p::TextSearchQuery,
+                                p::MaterializedViewQuery, p::Load>);
       // The `TransPath` is set up later in the query planning, when this
       // function should not be called anymore.
       AD_FAIL();
@@ -0,0 +1,393 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/DiskResultCache.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <filesystem>
+#include <numeric>
+
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+namespace fs = std::filesystem;
+using ad_utility::MemorySize;
+
+constexpr std::string_view fileExtension = ".result";
+constexpr std::string_view tmpFileExtension = ".tmp";
+
+// The 64-bit FNV-1a hash of the `input`. We don't use `std::hash` or
+// `absl::Hash`, because the filenames have to be stable between different runs
+// (and builds) of the server.
+uint64_t stableHash(std::string_view input) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : input) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// The `Id`s with datatype `LocalVocabIndex` contain a pointer, which is only
+// valid for the lifetime of the `LocalVocab`. In the files, the data bits of
+// these `Id`s are replaced by the position of the word in the list of words
+// that is stored in the same file.
+Id makeLocalVocabPositionId(uint64_t position) {
+  auto datatypeBits = static_cast<Id::T>(Datatype::LocalVocabIndex)
+                      << Id::numDataBits;
+  return Id::fromBits(datatypeBits | position);
+}
+uint64_t getLocalVocabPosition(Id id) {
+  return id.getBits() & ad_utility::bitMaskForLowerBits(Id::numDataBits);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+DiskResultCache::DiskResultCache(std::string directory, MemorySize maxSize,
+                                 std::string buildId,
+                                 size_t locatedTriplesSnapshotIndex,
+                                 ad_utility::AllocatorWithLimit<Id> allocator)
+    : directory_{std::move(directory)},
+      maxSize_{maxSize},
+      buildId_{std::move(buildId)},
+      locatedTriplesSnapshotIndex_{locatedTriplesSnapshotIndex},
+      allocator_{std::move(allocator)} {
+  fs::create_directories(indexDirectory());
+  scanDirectory();
+  writerThread_ = std::thread{[this]() { writerLoop(); }};
+}
+
+// _____________________________________________________________________________
+DiskResultCache::~DiskResultCache() {
+  {
+    std::lock_guard lock{pendingWritesMutex_};
+    shutdown_ = true;
+  }
+  pendingWritesChanged_.notify_all();
+  writerThread_.join();
+}
+
+// _____________________________________________________________________________
+std::string DiskResultCache::filenameForKey(std::string_view key) {
+  return absl::StrCat(absl::StrFormat("%016x", stableHash(key)),
+                      fileExtension);
+}
+
+// _____________________________________________________________________________
+std::string DiskResultCache::indexDirectory() const {
+  return (fs::path{directory_} / absl::StrFormat("%016x", stableHash(buildId_)))
+      .string();
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::scanDirectory() {
+  // Order the existing files by the time of their last modification, which is
+  // also the time of their last use (see `load`).
+  std::vector<std::pair<fs::file_time_type, FileInfo>> existing;
+  std::vector<std::string> names;
+  for (const auto& entry : fs::directory_iterator{indexDirectory()}) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    auto extension = entry.path().extension().string();
+    if (extension == tmpFileExtension) {
+      // A leftover of an incomplete write, e.g. because of a crash.
+      fs::remove(entry.path());
+      continue;
+    }
+    if (extension != fileExtension) {
+      continue;
+    }
+    existing.emplace_back(
+        entry.last_write_time(),
+        FileInfo{MemorySize::bytes(entry.file_size()), existing.size()});
+    names.push_back(entry.path().filename().string());
+  }
+  std::vector<size_t> order(existing.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  ql::ranges::sort(order, {}, [&existing](size_t i) {
+    return existing[i].first;
+  });
+  auto files = files_.wlock();
+  for (size_t i : order) {
+    FileInfo info = existing[i].second;
+    info.lastAccess_ = files->clock_++;
+    files->totalSize_ += info.size_;
+    files->files_.emplace(names[i], info);
+  }
+  deleteFilesIfTooLarge(*files);
+  LOG(INFO) << "The disk cache in \"" << directory_ << "\" contains "
+            << files->files_.size() << " results with a total size of "
+            << files->totalSize_.asString() << std::endl;
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::deleteFilesIfTooLarge(Files& files) {
+  while (files.totalSize_ > maxSize_ && !files.files_.empty()) {
+    auto leastRecentlyUsed =
+        ql::ranges::min_element(files.files_, {}, [](const auto& file) {
+          return file.second.lastAccess_;
+        });
+    std::error_code error;
+    fs::remove(fs::path{indexDirectory()} / leastRecentlyUsed->first, error);
+    files.totalSize_ -= leastRecentlyUsed->second.size_;
+    files.files_.erase(leastRecentlyUsed);
+  }
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::store(const QueryCacheKey& key,
+                            std::shared_ptr<const CacheValue> value) {
+  if (key.locatedTriplesSnapshotIndex_ != locatedTriplesSnapshotIndex_ ||
+      !value->isFullyMaterialized() ||
+      CacheValue::SizeGetter{}(*value) > maxSize_ ||
+      files_.rlock()->files_.contains(filenameForKey(key.key_))) {
+    return;
+  }
+  {
+    std::lock_guard lock{pendingWritesMutex_};
+    if (pendingWrites_.size() >= MAX_NUM_PENDING_WRITES) {
+      return;
+    }
+    pendingWrites_.emplace_back(key.key_, std::move(value));
+  }
+  pendingWritesChanged_.notify_all();
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::writerLoop() {
+  while (true) {
+    std::unique_lock lock{pendingWritesMutex_};
+    pendingWritesChanged_.wait(
+        lock, [this]() { return shutdown_ || !pendingWrites_.empty(); });
+    if (pendingWrites_.empty()) {
+      // `shutdown_` is set and all the writes are done.
+      return;
+    }
+    auto [key, value] = std::move(pendingWrites_.front());
+    pendingWrites_.pop_front();
+    isWriting_ = true;
+    lock.unlock();
+    try {
+      writeToDisk(key, *value);
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not write a result to the disk cache: " << e.what()
+                << std::endl;
+    }
+    lock.lock();
+    isWriting_ = false;
+    lock.unlock();
+    pendingWritesChanged_.notify_all();
+  }
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::waitForPendingWrites() {
+  std::unique_lock lock{pendingWritesMutex_};
+  pendingWritesChanged_.wait(
+      lock, [this]() { return pendingWrites_.empty() && !isWriting_; });
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::writeToDisk(const std::string& key,
+                                  const CacheValue& value) {
+  // Compressed values are decompressed for writing.
+  auto resultPtr = value.resultTablePtr();
+  const Result& result = *resultPtr;
+  const IdTable& idTable = result.idTable();
+  const LocalVocab& localVocab = result.localVocab();
+
+  // Collect the words of the local vocab that are actually used in the result
+  // and replace the `LocalVocabIndex` `Id`s by their positions. Results that
+  // contain local blank nodes can't be stored, because the blank nodes are only
+  // valid for the lifetime of the server.
+  ad_utility::HashMap<LocalVocabIndex, uint64_t> positions;
+  std::vector<std::string> words;
+  auto toDiskId = [&](Id id) -> std::optional<Id> {
+    if (id.getDatatype() == Datatype::BlankNodeIndex &&
+        localVocab.isBlankNodeIndexContained(id.getBlankNodeIndex())) {
+      return std::nullopt;
+    }
+    if (id.getDatatype() != Datatype::LocalVocabIndex) {
+      return id;
+    }
+    auto [it, isNew] =
+        positions.try_emplace(id.getLocalVocabIndex(), words.size());
+    if (isNew) {
+      words.push_back(id.getLocalVocabIndex()->toStringRepresentation());
+    }
+    return makeLocalVocabPositionId(it->second);
+  };
+  // The columns of the file, only the columns that contain `LocalVocabIndex`
+  // `Id`s are copied.
+  std::vector<std::vector<Id>> rewrittenColumns(idTable.numColumns());
+  for (size_t col = 0; col < idTable.numColumns(); ++col) {
+    auto column = idTable.getColumn(col);
+    bool needsRewrite = ql::ranges::any_of(column, [](Id id) {
+      return id.getDatatype() == Datatype::LocalVocabIndex ||
+             id.getDatatype() == Datatype::BlankNodeIndex;
+    });
+    if (!needsRewrite) {
+      continue;
+    }
+    auto& rewritten = rewrittenColumns[col];
+    rewritten.reserve(column.size());
+    for (Id id : column) {
+      auto diskId = toDiskId(id);
+      if (!diskId.has_value()) {
+        return;
+      }
+      rewritten.push_back(diskId.value());
+    }
+  }
+
+  const auto& runtimeInfo = value.runtimeInfo();
+  auto filename = filenameForKey(key);
+  auto path = fs::path{indexDirectory()} / filename;
+  auto tmpPath = fs::path{path}.replace_extension(tmpFileExtension);
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{tmpPath.string()};
+    serializer << FORMAT_VERSION;
+    serializer << buildId_;
+    serializer << key;
+    serializer << result.sortedBy();
+    serializer << words;
+    serializer << static_cast<uint64_t>(runtimeInfo.totalTime_.count());
+    serializer << runtimeInfo.descriptor_;
+    serializer << runtimeInfo.columnNames_;
+    serializer << runtimeInfo.details_.dump();
+    serializer << static_cast<uint64_t>(idTable.numColumns());
+    serializer << static_cast<uint64_t>(idTable.numRows());
+    for (size_t col = 0; col < idTable.numColumns(); ++col) {
+      const Id* data = rewrittenColumns[col].empty()
+                           ? idTable.getColumn(col).data()
+                           : rewrittenColumns[col].data();
+      serializer.serializeBytes(reinterpret_cast<const char*>(data),
+                                idTable.numRows() * sizeof(Id));
+    }
+    serializer.close();
+  }
+  auto size = MemorySize::bytes(fs::file_size(tmpPath));
+  fs::rename(tmpPath, path);
+
+  auto files = files_.wlock();
+  auto [it, isNew] = files->files_.try_emplace(filename, FileInfo{size, 0});
+  if (!isNew) {
+    files->totalSize_ -= it->second.size_;
+    it->second.size_ = size;
+  }
+  it->second.lastAccess_ = files->clock_++;
+  files->totalSize_ += size;
+  deleteFilesIfTooLarge(*files);
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<CacheValue> DiskResultCache::load(const QueryCacheKey& key) {
+  if (key.locatedTriplesSnapshotIndex_ != locatedTriplesSnapshotIndex_) {
+    return nullptr;
+  }
+  auto filename = filenameForKey(key.key_);
+  auto path = fs::path{indexDirectory()} / filename;
+  {
+    auto files = files_.wlock();
+    auto it = files->files_.find(filename);
+    if (it == files->files_.end()) {
+      return nullptr;
+    }
+    it->second.lastAccess_ = files->clock_++;
+  }
+  try {
+    ad_utility::serialization::FileReadSerializer serializer{path.string()};
+    uint64_t version;
+    std::string buildId;
+    std::string storedKey;
+    serializer >> version;
+    if (version != FORMAT_VERSION) {
+      return nullptr;
+    }
+    serializer >> buildId;
+    serializer >> storedKey;
+    // Hash collisions are extremely unlikely, but possible.
+    if (buildId != buildId_ || storedKey != key.key_) {
+      return nullptr;
+    }
+    std::vector<ColumnIndex> sortedBy;
+    std::vector<std::string> words;
+    uint64_t totalTimeInMicroseconds;
+    RuntimeInformation runtimeInfo;
+    std::string details;
+    uint64_t numColumns;
+    uint64_t numRows;
+    serializer >> sortedBy;
+    serializer >> words;
+    serializer >> totalTimeInMicroseconds;
+    serializer >> runtimeInfo.descriptor_;
+    serializer >> runtimeInfo.columnNames_;
+    serializer >> details;
+    serializer >> numColumns;
+    serializer >> numRows;
+
+    // Read the columns directly into the `IdTable`.
+    IdTable idTable{numColumns, allocator_};
+    idTable.resize(numRows);
+    for (size_t col = 0; col < numColumns; ++col) {
+      serializer.serializeBytes(
+          reinterpret_cast<char*>(idTable.getColumn(col).data()),
+          numRows * sizeof(Id));
+    }
+
+    // Restore the local vocab and the `LocalVocabIndex` `Id`s.
+    LocalVocab localVocab;
+    std::vector<Id> localVocabIds;
+    localVocabIds.reserve(words.size());
+    for (auto& word : words) {
+      localVocabIds.push_back(
+          Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+              ad_utility::triple_component::LiteralOrIri::
+                  fromStringRepresentation(std::move(word)))));
+    }
+    if (!localVocabIds.empty()) {
+      for (size_t col = 0; col < numColumns; ++col) {
+        for (Id& id : idTable.getColumn(col)) {
+          if (id.getDatatype() == Datatype::LocalVocabIndex) {
+            id = localVocabIds.at(getLocalVocabPosition(id));
+          }
+        }
+      }
+    }
+
+    runtimeInfo.totalTime_ =
+        RuntimeInformation::Microseconds{totalTimeInMicroseconds};
+    runtimeInfo.details_ = nlohmann::json::parse(details);
+    runtimeInfo.numRows_ = numRows;
+    runtimeInfo.numCols_ = numColumns;
+    runtimeInfo.status_ = RuntimeInformation::Status::fullyMaterialized;
+    // Mark the file as recently used, s.t. the order is preserved across
+    // restarts (see `scanDirectory`).
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    return std::make_shared<CacheValue>(
+        Result{std::move(idTable), std::move(sortedBy), std::move(localVocab)},
+        std::move(runtimeInfo));
+  } catch (const std::exception& e) {
+    LOG(WARN) << "Could not read a result from the disk cache: " << e.what()
+              << std::endl;
+    return nullptr;
+  }
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::clear() {
+  waitForPendingWrites();
+  auto files = files_.wlock();
+  for (const auto& [filename, info] : files->files_) {
+    std::error_code error;
+    fs::remove(fs::path{indexDirectory()} / filename, error);
+  }
+  files->files_.clear();
+  files->totalSize_ = MemorySize::bytes(0);
+}
@@ -0,0 +1,134 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
+#define QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "engine/QueryExecutionContext.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A second tier of the `QueryResultCache` that stores results in a directory
+// on disk (typically on a local SSD), s.t. the cache is warm immediately after
+// a restart of the server. The entries that are removed from the
+// `QueryResultCache` to make room for other entries and the pinned entries are
+// written to the directory by a background thread. On a cache miss, the result
+// is read back from the directory (if it is contained) instead of computing it.
+//
+// Each result is stored in a separate file that contains the columns of the
+// `IdTable` together with the words of the `LocalVocab` and some of the
+// `RuntimeInformation`. The files are stored in a subdirectory that is specific
+// for the build of the index (see `Index::getBuildId`), because the `Id`s of
+// two different indices (or of two builds of the same index) are
+// incompatible. Only the results for a single `LocatedTriplesSnapshot` (the
+// one from the start of the server) are stored, after an UPDATE the results
+// for the new snapshots are simply ignored. The total size of the files is
+// bounded, the least recently used files are deleted first. Results that
+// contain blank nodes that were created during the query processing are not
+// stored, because these are only valid for the lifetime of the server.
+//
+// NOTE: The directory must not be used by several servers at the same time.
+class DiskResultCache
+    : public ad_utility::CacheSecondTier<QueryCacheKey, CacheValue> {
+ public:
+  // Increase this whenever the format of the files changes. Files with a
+  // different version are ignored.
+  static constexpr uint64_t FORMAT_VERSION = 1;
+
+ private:
+  // Information about a single file in the directory.
+  struct FileInfo {
+    ad_utility::MemorySize size_;
+    // Files with a smaller value were used less recently.
+    uint64_t lastAccess_;
+  };
+  struct Files {
+    ad_utility::HashMap<std::string, FileInfo> files_;
+    ad_utility::MemorySize totalSize_ = ad_utility::MemorySize::bytes(0);
+    uint64_t clock_ = 0;
+  };
+
+  std::string directory_;
+  ad_utility::MemorySize maxSize_;
+  std::string buildId_;
+  size_t locatedTriplesSnapshotIndex_;
+  ad_utility::AllocatorWithLimit<Id> allocator_;
+  ad_utility::Synchronized<Files> files_;
+
+  // The results that still have to be written by the background thread. The
+  // number of pending writes is bounded, additional results are dropped.
+  static constexpr size_t MAX_NUM_PENDING_WRITES = 64;
+  std::deque<std::pair<std::string, std::shared_ptr<const CacheValue>>>
+      pendingWrites_;
+  std::mutex pendingWritesMutex_;
+  std::condition_variable pendingWritesChanged_;
+  bool isWriting_ = false;
+  bool shutdown_ = false;
+  std::thread writerThread_;
+
+ public:
+  // Use (and create if necessary) the given `directory`. The results are
+  // identified by the `buildId` of the index and the cache key, only keys with
+  // the given `locatedTriplesSnapshotIndex` are stored. The `IdTable`s of the
+  // loaded results are allocated with the `allocator`.
+  DiskResultCache(std::string directory, ad_utility::MemorySize maxSize,
+                  std::string buildId, size_t locatedTriplesSnapshotIndex,
+                  ad_utility::AllocatorWithLimit<Id> allocator);
+
+  // Finish the pending writes.
+  ~DiskResultCache() override;
+
+  // Disallow copying and moving, the background thread uses `this`.
+  DiskResultCache(const DiskResultCache&) = delete;
+  DiskResultCache& operator=(const DiskResultCache&) = delete;
+
+  // Asynchronously write the `value` to disk, unless it is already contained.
+  void store(const QueryCacheKey& key,
+             std::shared_ptr<const CacheValue> value) override;
+
+  // Read the result for the `key` from disk, return `nullptr` if it is not
+  // contained or can't be read.
+  std::shared_ptr<CacheValue> load(const QueryCacheKey& key) override;
+
+  // Block until all the pending writes have been finished.
+  void waitForPendingWrites();
+
+  // Delete all the files of this cache.
+  void clear();
+
+  size_t numEntries() const { return files_.rlock()->files_.size(); }
+  ad_utility::MemorySize totalSize() const {
+    return files_.rlock()->totalSize_;
+  }
+
+  // The name of the file for the given cache key (without the directory).
+  // Exposed for testing.
+  static std::string filenameForKey(std::string_view key);
+
+ private:
+  // The subdirectory in which the files for the index are stored.
+  std::string indexDirectory() const;
+
+  // Register the files that are already contained in the directory (e.g. from
+  // a previous run of the server).
+  void scanDirectory();
+
+  // Write the `value` to the file with the given name and register it.
+  void writeToDisk(const std::string& key, const CacheValue& value);
+
+  // Delete the least recently used files until the total size is at most the
+  // `maxSize_`. Requires that the lock for the `files` is held.
+  void deleteFilesIfTooLarge(Files& files);
+
+  // The loop of the background thread that writes the `pendingWrites_`.
+  void writerLoop();
+};
+
+#endif  // QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
@@ -8,7 +8,9 @@
 #include <absl/strings/str_join.h>
 
 #include "engine/CallFixedSize.h"
+#include "engine/FactorizedStarJoin.h"
 #include "engine/QueryExecutionTree.h"
+#include "util/Algorithm.h"
 
 using std::endl;
 using std::string;
@@ -22,8 +24,25 @@ Distinct::Distinct(QueryExecutionContext* qec,
                    const std::vector<ColumnIndex>& keepIndices)
     : Operation{qec}, subtree_{std::move(subtree)}, keepIndices_{keepIndices} {
   AD_CORRECTNESS_CHECK(subtree_);
-  subtree_ = QueryExecutionTree::createSortedTreeAnyPermutation(
-      std::move(subtree_), keepIndices_);
+  // A `FactorizedStarJoin` computes the distinct rows directly on its
+  // factorized result (see `computeResult`), which doesn't require sorting,
+  // but only if the join column is one of the `keepIndices_`.
+  if (!getFactorizedStarJoin()) {
+    subtree_ = QueryExecutionTree::createSortedTreeAnyPermutation(
+        std::move(subtree_), keepIndices_);
+  }
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<FactorizedStarJoin> Distinct::getFactorizedStarJoin() const {
+  // Rows from different groups of the factorized result differ in the join
+  // column (which is column 0). If this column is not kept, equal rows can
+  // come from different groups, so the rows have to be sorted.
+  if (!ad_utility::contains(keepIndices_, ColumnIndex{0})) {
+    return nullptr;
+  }
+  return std::dynamic_pointer_cast<FactorizedStarJoin>(
+      subtree_->getRootOperation());
 }
 
 // _____________________________________________________________________________
@@ -67,6 +86,10 @@ Result::Generator Distinct::lazyDistinct(Result::LazyResult input,
 
 // _____________________________________________________________________________
 Result Distinct::computeResult(bool requestLaziness) {
+  if (auto starJoin = getFactorizedStarJoin()) {
+    return starJoin->computeDistinctResult(keepIndices_, requestLaziness);
+  }
+
   LOG(DEBUG) << "Getting sub-result for distinct result computation..." << endl;
   std::shared_ptr<const Result> subRes = subtree_->getResult(true);
 
@@ -10,6 +10,8 @@
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
 
+class FactorizedStarJoin;
+
 class Distinct : public Operation {
  private:
   std::shared_ptr<QueryExecutionTree> subtree_;
@@ -51,6 +53,10 @@ class Distinct : public Operation {
 
   bool knownEmptyResult() override { return subtree_->knownEmptyResult(); }
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   std::vector<QueryExecutionTree*> getChildren() override {
     return {subtree_.get()};
   }
@@ -64,6 +70,10 @@ class Distinct : public Operation {
 
   VariableToColumnMap computeVariableToColumnMap() const override;
 
+  // Return the root operation of the subtree if it is a `FactorizedStarJoin`
+  // and its join column is one of the `keepIndices_`, else `nullptr`.
+  std::shared_ptr<FactorizedStarJoin> getFactorizedStarJoin() const;
+
   // Helper function that only compares rows on the columns in `keepIndices_`.
   template <typename T1, typename T2>
   bool matchesRow(const T1& a, const T2& b) const;
@@ -262,12 +262,75 @@ ExportQueryExecutionTrees::constructQueryResultBindingsToQLeverJSON(
   }
 }
 
+// _____________________________________________________________________________
+// Helper for the export of the rows of an `IdTable` in ascending order: The
+// text excerpts of the `TextRecordIndex` `Id`s in the selected `columns` are
+// retrieved for `BATCH_SIZE` rows at once via `Index::getTextExcerpts`, which
+// reads and decompresses each block of the text records only once. This is
+// much faster than retrieving the excerpts one by one when many rows contain
+// matches of `ql:contains-word`.
+class TextExcerptsForRows {
+  static constexpr uint64_t BATCH_SIZE = 10'000;
+  const Index& index_;
+  const IdTable& idTable_;
+  std::vector<ColumnIndex> columns_;
+  uint64_t endRow_;
+  uint64_t endOfBatch_ = 0;
+  ExportQueryExecutionTrees::TextExcerpts excerpts_;
+
+ public:
+  TextExcerptsForRows(const Index& index, const IdTable& idTable,
+                      const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+                      uint64_t endRow)
+      : index_{index}, idTable_{idTable}, endRow_{endRow} {
+    for (const auto& column : columns) {
+      if (column.has_value()) {
+        columns_.push_back(column->columnIndex_);
+      }
+    }
+  }
+
+  // Return the excerpts for a batch of rows that contains the `row`. Must be
+  // called with ascending `row`s that are smaller than the `endRow`.
+  const ExportQueryExecutionTrees::TextExcerpts* get(uint64_t row) {
+    if (row >= endOfBatch_) {
+      endOfBatch_ = std::min(row + BATCH_SIZE, endRow_);
+      fetch(row);
+    }
+    return &excerpts_;
+  }
+
+ private:
+  void fetch(uint64_t beginOfBatch) {
+    excerpts_.clear();
+    std::vector<TextRecordIndex> cids;
+    for (ColumnIndex column : columns_) {
+      for (Id id : idTable_.getColumn(column).subspan(
+               beginOfBatch, endOfBatch_ - beginOfBatch)) {
+        if (id.getDatatype() == Datatype::TextRecordIndex) {
+          cids.push_back(id.getTextRecordIndex());
+        }
+      }
+    }
+    if (cids.empty()) {
+      return;
+    }
+    ql::ranges::sort(cids);
+    cids.erase(std::unique(cids.begin(), cids.end()), cids.end());
+    auto texts = index_.getTextExcerpts(cids);
+    for (size_t i = 0; i < cids.size(); ++i) {
+      excerpts_.emplace(cids[i].get(), std::move(texts[i]));
+    }
+  }
+};
+
 // _____________________________________________________________________________
 // Create the row indicated by rowIndex from IdTable in QLeverJSON format.
 nlohmann::json idTableToQLeverJSONRow(
     const QueryExecutionTree& qet,
     const QueryExecutionTree::ColumnIndicesAndTypes& columns,
-    const LocalVocab& localVocab, const size_t rowIndex, const IdTable& data) {
+    const LocalVocab& localVocab, const size_t rowIndex, const IdTable& data,
+    const ExportQueryExecutionTrees::TextExcerpts* textExcerpts) {
   // We need the explicit `array` constructor for the special case of zero
   // variables.
   auto row = nlohmann::json::array();
@@ -278,8 +341,9 @@ nlohmann::json idTableToQLeverJSONRow(
     }
     const auto& currentId = data(rowIndex, opt->columnIndex_);
     const auto& optionalStringAndXsdType =
-        ExportQueryExecutionTrees::idToStringAndType(qet.getQec()->getIndex(),
-                                                     currentId, localVocab);
+        ExportQueryExecutionTrees::idToStringAndType(
+            qet.getQec()->getIndex(), currentId, localVocab, std::identity{},
+            textExcerpts);
     if (!optionalStringAndXsdType.has_value()) {
       row.emplace_back(nullptr);
       continue;
@@ -304,9 +368,11 @@ ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
   AD_CORRECTNESS_CHECK(result != nullptr);
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
+    TextExcerptsForRows textExcerpts{qet.getQec()->getIndex(), pair.idTable_,
+                                     columns, *range.end()};
     for (uint64_t rowIndex : range) {
       co_yield idTableToQLeverJSONRow(qet, columns, pair.localVocab_, rowIndex,
-                                      pair.idTable_)
+                                      pair.idTable_, textExcerpts.get(rowIndex))
           .dump();
       cancellationHandle->throwIfCancelled();
     }
@@ -458,7 +524,8 @@ template <bool removeQuotesAndAngleBrackets, bool onlyReturnLiterals,
 std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
                                              const LocalVocab& localVocab,
-                                             EscapeFunction&& escapeFunction) {
+                                             EscapeFunction&& escapeFunction,
+                                             const TextExcerpts* textExcerpts) {
   using enum Datatype;
   auto datatype = id.getDatatype();
   if constexpr (onlyReturnLiterals) {
@@ -496,10 +563,17 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
     case LocalVocabIndex:
       return handleIriOrLiteral(
           getLiteralOrIriFromVocabIndex(index, id, localVocab));
-    case TextRecordIndex:
+    case TextRecordIndex: {
+      if (textExcerpts != nullptr) {
+        auto it = textExcerpts->find(id.getTextRecordIndex().get());
+        if (it != textExcerpts->end()) {
+          return std::pair{escapeFunction(it->second), nullptr};
+        }
+      }
       return std::pair{
           escapeFunction(index.getTextExcerpt(id.getTextRecordIndex())),
           nullptr};
+    }
     default:
       return idToStringAndTypeForEncodedValue(id);
   }
@@ -597,13 +671,13 @@ ExportQueryExecutionTrees::idToLiteralOrIri(const Index& index, Id id,
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType<true, false, std::identity>(
     const Index& index, Id id, const LocalVocab& localVocab,
-    std::identity&& escapeFunction);
+    std::identity&& escapeFunction, const TextExcerpts* textExcerpts);
 
 // ___________________________________________________________________________
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType<true, true, std::identity>(
     const Index& index, Id id, const LocalVocab& localVocab,
-    std::identity&& escapeFunction);
+    std::identity&& escapeFunction, const TextExcerpts* textExcerpts);
 
 // This explicit instantiation is necessary because the `Variable` class
 // currently still uses it.
@@ -612,7 +686,8 @@ ExportQueryExecutionTrees::idToStringAndType<true, true, std::identity>(
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
                                              const LocalVocab& localVocab,
-                                             std::identity&& escapeFunction);
+                                             std::identity&& escapeFunction,
+                                             const TextExcerpts* textExcerpts);
 
 // Convert a stringvalue and optional type to JSON binding.
 static nlohmann::json stringAndTypeToBinding(std::string_view entitystr,
@@ -758,6 +833,8 @@ ExportQueryExecutionTrees::selectQueryResultToStream(
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
+    TextExcerptsForRows textExcerpts{qet.getQec()->getIndex(), pair.idTable_,
+                                     selectedColumnIndices, *range.end()};
     for (uint64_t i : range) {
       for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
         if (selectedColumnIndices[j].has_value()) {
@@ -766,7 +843,7 @@ ExportQueryExecutionTrees::selectQueryResultToStream(
           auto optionalStringAndType =
               idToStringAndType<format == MediaType::csv>(
                   qet.getQec()->getIndex(), id, pair.localVocab_,
-                  escapeFunction);
+                  escapeFunction, textExcerpts.get(i));
           if (optionalStringAndType.has_value()) [[likely]] {
             co_yield optionalStringAndType.value().first;
           }
@@ -784,13 +861,14 @@ ExportQueryExecutionTrees::selectQueryResultToStream(
 
 // Convert a single ID to an XML binding of the given `variable`.
 template <typename IndexType, typename LocalVocabType>
-static std::string idToXMLBinding(std::string_view variable, Id id,
-                                  const IndexType& index,
-                                  const LocalVocabType& localVocab) {
+static std::string idToXMLBinding(
+    std::string_view variable, Id id, const IndexType& index,
+    const LocalVocabType& localVocab,
+    const ExportQueryExecutionTrees::TextExcerpts* textExcerpts) {
   using namespace std::string_view_literals;
   using namespace std::string_literals;
-  const auto& optionalValue =
-      ExportQueryExecutionTrees::idToStringAndType(index, id, localVocab);
+  const auto& optionalValue = ExportQueryExecutionTrees::idToStringAndType(
+      index, id, localVocab, std::identity{}, textExcerpts);
   if (!optionalValue.has_value()) {
     return ""s;
   }
@@ -890,6 +968,8 @@ ad_utility::streams::stream_generator ExportQueryExecutionTrees::
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
+    TextExcerptsForRows textExcerpts{qet.getQec()->getIndex(), pair.idTable_,
+                                     selectedColumnIndices, *range.end()};
     for (uint64_t i : range) {
       co_yield "\n  <result>";
       for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
@@ -897,7 +977,7 @@ ad_utility::streams::stream_generator ExportQueryExecutionTrees::
           const auto& val = selectedColumnIndices[j].value();
           Id id = pair.idTable_(i, val.columnIndex_);
           co_yield idToXMLBinding(val.variable_, id, qet.getQec()->getIndex(),
-                                  pair.localVocab_);
+                                  pair.localVocab_, textExcerpts.get(i));
         }
       }
       co_yield "\n  </result>";
@@ -937,12 +1017,13 @@ ad_utility::streams::stream_generator ExportQueryExecutionTrees::
   std::erase(columns, std::nullopt);
 
   auto getBinding = [&](const IdTable& idTable, const uint64_t& i,
-                        const LocalVocab& localVocab) {
+                        const LocalVocab& localVocab,
+                        const TextExcerpts* textExcerpts) {
     nlohmann::ordered_json binding = {};
     for (const auto& column : columns) {
-      auto optionalStringAndType =
-          idToStringAndType(qet.getQec()->getIndex(),
-                            idTable(i, column->columnIndex_), localVocab);
+      auto optionalStringAndType = idToStringAndType(
+          qet.getQec()->getIndex(), idTable(i, column->columnIndex_),
+          localVocab, std::identity{}, textExcerpts);
       if (optionalStringAndType.has_value()) [[likely]] {
         const auto& [stringValue, xsdType] = optionalStringAndType.value();
         binding[column->variable_] =
@@ -958,6 +1039,8 @@ ad_utility::streams::stream_generator ExportQueryExecutionTrees::
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
+    TextExcerptsForRows textExcerpts{qet.getQec()->getIndex(), pair.idTable_,
+                                     columns, *range.end()};
     for (uint64_t i : range) {
       if (!isFirstRow) [[likely]] {
         co_yield ",";
@@ -965,7 +1048,8 @@ ad_utility::streams::stream_generator ExportQueryExecutionTrees::
       if (columns.empty()) {
         co_yield "{}";
       } else {
-        co_yield getBinding(pair.idTable_, i, pair.localVocab_);
+        co_yield getBinding(pair.idTable_, i, pair.localVocab_,
+                            textExcerpts.get(i));
       }
       cancellationHandle->throwIfCancelled();
       isFirstRow = false;
@@ -10,6 +10,7 @@
 #include "engine/QueryExecutionTree.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "util/CancellationHandle.h"
+#include "util/HashMap.h"
 #include "util/http/MediaTypes.h"
 
 // Class for computing the result of an already parsed and planned query and
@@ -23,6 +24,9 @@ class ExportQueryExecutionTrees {
   using CancellationHandle = ad_utility::SharedCancellationHandle;
   using LiteralOrIri = ad_utility::triple_component::LiteralOrIri;
   using Literal = ad_utility::triple_component::Literal;
+  // The text excerpts of some `TextRecordIndex` `Id`s, which were retrieved
+  // at once via `Index::getTextExcerpts`. The keys are the `TextRecordIndex`es.
+  using TextExcerpts = ad_utility::HashMap<uint64_t, std::string>;
 
   // Compute the result of the given `parsedQuery` (created by the
   // `SparqlParser`) for which the `QueryExecutionTree` has been previously
@@ -58,6 +62,9 @@ class ExportQueryExecutionTrees {
   // element will have the format `"stringContent"^^datatypeUri`. If the `id`
   // holds the `Undefined` value, then `std::nullopt` is returned.
   //
+  // If `textExcerpts` is not null, the excerpts of `TextRecordIndex` `Id`s are
+  // taken from there if they are contained.
+  //
   // Note: This function currently has to be public because the
   // `Variable::evaluate` function calls it for evaluating CONSTRUCT queries.
   //
@@ -68,7 +75,8 @@ class ExportQueryExecutionTrees {
             typename EscapeFunction = std::identity>
   static std::optional<std::pair<std::string, const char*>> idToStringAndType(
       const Index& index, Id id, const LocalVocab& localVocab,
-      EscapeFunction&& escapeFunction = EscapeFunction{});
+      EscapeFunction&& escapeFunction = EscapeFunction{},
+      const TextExcerpts* textExcerpts = nullptr);
 
   // Same as the previous function, but only handles the datatypes for which the
   // value is encoded directly in the ID. For other datatypes an exception is
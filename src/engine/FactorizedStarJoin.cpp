@@ -0,0 +1,439 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/FactorizedStarJoin.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <limits>
+
+#include "util/Algorithm.h"
+#include "util/HashSet.h"
+#include "util/Views.h"
+
+// _____________________________________________________________________________
+LocalVocab FactorizedStarJoin::FactorizedResult::getMergedLocalVocab() const {
+  LocalVocab localVocab;
+  localVocab.mergeWith(
+      childResults_ |
+      ql::views::transform([](const auto& result) -> const LocalVocab& {
+        return result->localVocab();
+      }));
+  return localVocab;
+}
+
+// _____________________________________________________________________________
+size_t FactorizedStarJoin::FactorizedResult::numRows(size_t group) const {
+  size_t numRows = 1;
+  for (size_t child = 0; child < numChildren(); ++child) {
+    auto [begin, end] = range(group, child);
+    numRows *= end - begin;
+  }
+  return numRows;
+}
+
+// _____________________________________________________________________________
+size_t FactorizedStarJoin::FactorizedResult::numRows() const {
+  size_t numRows = 0;
+  for (size_t group = 0; group < numGroups(); ++group) {
+    numRows += this->numRows(group);
+  }
+  return numRows;
+}
+
+// _____________________________________________________________________________
+size_t FactorizedStarJoin::FactorizedResult::numDefinedValues(
+    size_t group, size_t child, ColumnIndex column) const {
+  auto [begin, end] = range(group, child);
+  auto values = childTable(child).getColumn(column).subspan(begin, end - begin);
+  size_t numDefined = ql::ranges::count_if(
+      values, [](Id id) { return !id.isUndefined(); });
+  // Each row of the `child` is combined with all the rows of the other
+  // children.
+  return numDefined * (numRows(group) / (end - begin));
+}
+
+// _____________________________________________________________________________
+std::vector<Id> FactorizedStarJoin::FactorizedResult::distinctValues(
+    size_t group, size_t child, ColumnIndex column) const {
+  auto [begin, end] = range(group, child);
+  std::vector<Id> values;
+  auto ids = childTable(child).getColumn(column).subspan(begin, end - begin);
+  for (Id id : ids) {
+    if (!id.isUndefined()) {
+      values.push_back(id);
+    }
+  }
+  ql::ranges::sort(values);
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+// _____________________________________________________________________________
+FactorizedStarJoin::FactorizedStarJoin(QueryExecutionContext* qec,
+                                       Children children, Variable joinVariable)
+    : Operation{qec},
+      children_{std::move(children)},
+      joinVariable_{std::move(joinVariable)} {
+  AD_CONTRACT_CHECK(children_.size() >= 2);
+  ad_utility::HashSet<Variable> otherVariables;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    AD_CONTRACT_CHECK(child != nullptr);
+    auto joinColumn = child->getVariableColumnOrNullopt(joinVariable_);
+    AD_CONTRACT_CHECK(joinColumn.has_value(),
+                      "Each child of a factorized star join must contain the "
+                      "join variable");
+    AD_CONTRACT_CHECK(
+        child->getVariableColumns().at(joinVariable_).mightContainUndef_ ==
+            ColumnIndexAndTypeInfo::AlwaysDefined,
+        "The join variable of a factorized star join must not contain UNDEF "
+        "values");
+    for (const auto& variable : child->getVariableColumns() | ql::views::keys) {
+      AD_CONTRACT_CHECK(
+          variable == joinVariable_ || otherVariables.insert(variable).second,
+          "The children of a factorized star join must have no common "
+          "variables apart from the join variable");
+    }
+    child = QueryExecutionTree::createSortedTree(std::move(child),
+                                                 {joinColumn.value()});
+    joinColumns_.push_back(joinColumn.value());
+    for (ColumnIndex column = 0; column < child->getResultWidth(); ++column) {
+      if (column != joinColumn.value()) {
+        columnOrigins_.emplace_back(i, column);
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<std::pair<size_t, ColumnIndex>>
+FactorizedStarJoin::getChildAndColumn(const Variable& variable) const {
+  AD_CONTRACT_CHECK(variable != joinVariable_);
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (auto column = children_[i]->getVariableColumnOrNullopt(variable)) {
+      return std::pair{i, column.value()};
+    }
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+std::vector<QueryExecutionTree*> FactorizedStarJoin::getChildren() {
+  std::vector<QueryExecutionTree*> result;
+  ql::ranges::transform(children_, std::back_inserter(result),
+                        [](auto& child) { return child.get(); });
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string FactorizedStarJoin::getDescriptor() const {
+  return absl::StrCat("Factorized star join on ", joinVariable_.name());
+}
+
+// _____________________________________________________________________________
+std::string FactorizedStarJoin::getCacheKeyImpl() const {
+  std::string key = "FACTORIZED STAR JOIN";
+  for (size_t i = 0; i < children_.size(); ++i) {
+    absl::StrAppend(&key, "\nchild (join column ", joinColumns_[i],
+                    "): ", children_[i]->getCacheKey());
+  }
+  return key;
+}
+
+// _____________________________________________________________________________
+uint64_t FactorizedStarJoin::getSizeEstimateBeforeLimit() {
+  // The number of groups is at most the number of distinct join values of
+  // each child, and each group has as many rows as the product of the
+  // multiplicities of the join column in the children.
+  double numGroups = std::numeric_limits<double>::max();
+  double rowsPerGroup = 1.0;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    double multiplicity =
+        std::max(1.0f, children_[i]->getMultiplicity(joinColumns_[i]));
+    numGroups = std::min(
+        numGroups,
+        static_cast<double>(children_[i]->getSizeEstimate()) / multiplicity);
+    rowsPerGroup *= multiplicity;
+  }
+  return static_cast<uint64_t>(numGroups * rowsPerGroup);
+}
+
+// _____________________________________________________________________________
+size_t FactorizedStarJoin::getCostEstimate() {
+  size_t cost = getSizeEstimateBeforeLimit();
+  for (const auto& child : children_) {
+    cost += child->getCostEstimate() + child->getSizeEstimate();
+  }
+  return cost;
+}
+
+// _____________________________________________________________________________
+float FactorizedStarJoin::getMultiplicity(size_t col) {
+  AD_CONTRACT_CHECK(col < getResultWidth());
+  float rowsPerGroup = 1.0f;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    rowsPerGroup *=
+        std::max(1.0f, children_[i]->getMultiplicity(joinColumns_[i]));
+  }
+  if (col == 0) {
+    return rowsPerGroup;
+  }
+  // Each value of a child is repeated for all the rows of the other children
+  // in its group.
+  auto [child, column] = columnOrigins_.at(col - 1);
+  return children_[child]->getMultiplicity(column) * rowsPerGroup /
+         std::max(1.0f,
+                  children_[child]->getMultiplicity(joinColumns_[child]));
+}
+
+// _____________________________________________________________________________
+bool FactorizedStarJoin::knownEmptyResult() {
+  return ql::ranges::any_of(
+      children_, [](const auto& child) { return child->knownEmptyResult(); });
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> FactorizedStarJoin::resultSortedOn() const {
+  // Within a group, the rows of the first child vary the slowest, so the
+  // result is also sorted by the columns by which the first child is sorted.
+  std::vector<ColumnIndex> sortedOn{0};
+  const auto& sortedOnOfFirst = children_.front()->resultSortedOn();
+  for (ColumnIndex column : sortedOnOfFirst | ql::views::drop(1)) {
+    auto it = ql::ranges::find(columnOrigins_,
+                               std::pair{size_t{0}, ColumnIndex{column}});
+    AD_CORRECTNESS_CHECK(it != columnOrigins_.end());
+    sortedOn.push_back(
+        static_cast<ColumnIndex>(it - columnOrigins_.begin() + 1));
+  }
+  return sortedOn;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap FactorizedStarJoin::computeVariableToColumnMap() const {
+  VariableToColumnMap map;
+  map[joinVariable_] = makeAlwaysDefinedColumn(0);
+  for (size_t i = 0; i < children_.size(); ++i) {
+    for (const auto& [variable, info] : children_[i]->getVariableColumns()) {
+      if (variable == joinVariable_) {
+        continue;
+      }
+      auto it =
+          ql::ranges::find(columnOrigins_, std::pair{i, info.columnIndex_});
+      AD_CORRECTNESS_CHECK(it != columnOrigins_.end());
+      map[variable] = ColumnIndexAndTypeInfo{
+          static_cast<size_t>(it - columnOrigins_.begin() + 1),
+          info.mightContainUndef_};
+    }
+  }
+  return map;
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> FactorizedStarJoin::cloneImpl() const {
+  Children copy;
+  for (const auto& child : children_) {
+    copy.push_back(child->clone());
+  }
+  return std::make_unique<FactorizedStarJoin>(_executionContext,
+                                              std::move(copy), joinVariable_);
+}
+
+// _____________________________________________________________________________
+auto FactorizedStarJoin::computeFactorizedResultImpl() -> FactorizedResult {
+  computeChildrenInParallel(children_, ComputationMode::FULLY_MATERIALIZED);
+  FactorizedResult result;
+  for (const auto& child : children_) {
+    result.childResults_.push_back(child->getResult());
+    checkCancellation();
+  }
+
+  std::vector<ql::span<const Id>> columns;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    columns.push_back(result.childTable(i).getColumn(joinColumns_[i]));
+  }
+  std::vector<size_t> cursors(children_.size(), 0);
+  auto isExhausted = [&cursors, &columns](size_t i) {
+    return cursors[i] == columns[i].size();
+  };
+  auto anyExhausted = [&isExhausted, numChildren = children_.size()]() {
+    return ql::ranges::any_of(ad_utility::integerRange(numChildren),
+                              isExhausted);
+  };
+
+  // Seek all the children to the first value `>= key`. If they all find `key`,
+  // then it is a group, else retry with the largest value that was found.
+  while (!anyExhausted()) {
+    Id key = columns[0][cursors[0]];
+    bool allEqual = false;
+    while (!allEqual && !anyExhausted()) {
+      allEqual = true;
+      for (size_t i = 0; i < columns.size() && !isExhausted(i); ++i) {
+        cursors[i] = static_cast<size_t>(
+            std::lower_bound(columns[i].begin() + cursors[i], columns[i].end(),
+                             key) -
+            columns[i].begin());
+        if (!isExhausted(i) && columns[i][cursors[i]] != key) {
+          key = columns[i][cursors[i]];
+          allEqual = false;
+        }
+      }
+    }
+    if (anyExhausted()) {
+      break;
+    }
+    result.keys_.push_back(key);
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto end = static_cast<size_t>(
+          std::upper_bound(columns[i].begin() + cursors[i], columns[i].end(),
+                           key) -
+          columns[i].begin());
+      result.ranges_.emplace_back(cursors[i], end);
+      cursors[i] = end;
+    }
+    checkCancellation();
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+auto FactorizedStarJoin::computeFactorizedResult() -> FactorizedResult {
+  auto result = computeFactorizedResultImpl();
+  std::vector<std::shared_ptr<RuntimeInformation>> childInfos;
+  for (const auto& child : children_) {
+    childInfos.push_back(child->getRootOperation()->getRuntimeInfoPointer());
+  }
+  updateRuntimeInformationWhenOptimizedOut(std::move(childInfos));
+  runtimeInfo().addDetail("num-groups", result.numGroups());
+  return result;
+}
+
+// _____________________________________________________________________________
+Result FactorizedStarJoin::computeDistinctResult(
+    const std::vector<ColumnIndex>& keepIndices, bool requestLaziness) {
+  // Rows from different groups differ in the join column, so if it is kept,
+  // it suffices to remove the duplicates within each group. Within a group the
+  // join column is constant, so only the columns of the children matter.
+  AD_CONTRACT_CHECK(ad_utility::contains(keepIndices, ColumnIndex{0}));
+  auto factorized = computeFactorizedResult();
+  std::vector<std::vector<ColumnIndex>> keepColumnsOfChild(children_.size());
+  for (ColumnIndex column : keepIndices) {
+    AD_CONTRACT_CHECK(column < getResultWidth());
+    if (column > 0) {
+      auto [child, childColumn] = columnOrigins_.at(column - 1);
+      keepColumnsOfChild.at(child).push_back(childColumn);
+    }
+  }
+
+  // For each group and child keep the first of the rows with equal values in
+  // the kept columns.
+  std::vector<std::vector<size_t>> rowsPerGroupAndChild;
+  rowsPerGroupAndChild.reserve(factorized.ranges_.size());
+  ad_utility::HashSet<std::vector<Id>> seen;
+  for (size_t group = 0; group < factorized.numGroups(); ++group) {
+    for (size_t child = 0; child < children_.size(); ++child) {
+      auto& rows = rowsPerGroupAndChild.emplace_back();
+      auto [begin, end] = factorized.range(group, child);
+      const auto& columns = keepColumnsOfChild[child];
+      if (columns.empty()) {
+        rows.push_back(begin);
+        continue;
+      }
+      const auto& table = factorized.childTable(child);
+      seen.clear();
+      for (size_t row = begin; row < end; ++row) {
+        std::vector<Id> values;
+        for (ColumnIndex column : columns) {
+          values.push_back(table(row, column));
+        }
+        if (seen.insert(std::move(values)).second) {
+          rows.push_back(row);
+        }
+      }
+    }
+    checkCancellation();
+  }
+  return expand(std::move(factorized), std::move(rowsPerGroupAndChild),
+                requestLaziness);
+}
+
+// _____________________________________________________________________________
+Result FactorizedStarJoin::computeResult(bool requestLaziness) {
+  return expand(computeFactorizedResultImpl(), std::nullopt, requestLaziness);
+}
+
+// _____________________________________________________________________________
+Result FactorizedStarJoin::expand(
+    FactorizedResult factorized,
+    std::optional<std::vector<std::vector<size_t>>> rowsPerGroupAndChild,
+    bool requestLaziness) const {
+  if (requestLaziness) {
+    return Result{expandLazily(std::move(factorized),
+                               std::move(rowsPerGroupAndChild), CHUNK_SIZE),
+                  resultSortedOn()};
+  }
+  return Result{cppcoro::getSingleElement(expandLazily(
+                    std::move(factorized), std::move(rowsPerGroupAndChild),
+                    std::numeric_limits<size_t>::max())),
+                resultSortedOn()};
+}
+
+// _____________________________________________________________________________
+Result::Generator FactorizedStarJoin::expandLazily(
+    FactorizedResult factorized,
+    std::optional<std::vector<std::vector<size_t>>> rowsPerGroupAndChild,
+    size_t chunkSize) const {
+  bool yieldOnce = chunkSize == std::numeric_limits<size_t>::max();
+  LocalVocab localVocab = factorized.getMergedLocalVocab();
+  IdTable table{getResultWidth(), allocator()};
+  size_t numChildren = children_.size();
+  // The number of rows of each child in the current group and the index of
+  // the current combination of rows (the first child varies the slowest).
+  std::vector<size_t> sizes(numChildren);
+  std::vector<size_t> counters(numChildren);
+  for (size_t group = 0; group < factorized.numGroups(); ++group) {
+    auto getRow = [&](size_t child) {
+      if (rowsPerGroupAndChild.has_value()) {
+        return rowsPerGroupAndChild.value()[group * numChildren + child]
+                                           [counters[child]];
+      }
+      return factorized.range(group, child).first + counters[child];
+    };
+    for (size_t child = 0; child < numChildren; ++child) {
+      auto [begin, end] = factorized.range(group, child);
+      sizes[child] =
+          rowsPerGroupAndChild.has_value()
+              ? rowsPerGroupAndChild.value()[group * numChildren + child].size()
+              : end - begin;
+    }
+    ql::ranges::fill(counters, 0);
+    Id key = factorized.key(group);
+    bool done = false;
+    while (!done) {
+      table.emplace_back();
+      size_t row = table.numRows() - 1;
+      table(row, 0) = key;
+      for (size_t column = 1; column < table.numColumns(); ++column) {
+        auto [child, childColumn] = columnOrigins_[column - 1];
+        table(row, column) =
+            factorized.childTable(child)(getRow(child), childColumn);
+      }
+      // Advance to the next combination.
+      done = true;
+      for (size_t child = numChildren; child-- > 0;) {
+        if (++counters[child] < sizes[child]) {
+          done = false;
+          break;
+        }
+        counters[child] = 0;
+      }
+      if (table.numRows() >= chunkSize) {
+        co_yield {std::move(table), localVocab.clone()};
+        table = IdTable{getResultWidth(), allocator()};
+      }
+    }
+    checkCancellation();
+  }
+  if (yieldOnce || !table.empty()) {
+    co_yield {std::move(table), std::move(localVocab)};
+  }
+}
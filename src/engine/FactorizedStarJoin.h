@@ -0,0 +1,153 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_FACTORIZEDSTARJOIN_H
+#define QLEVER_SRC_ENGINE_FACTORIZEDSTARJOIN_H
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A join of an arbitrary number of children on a single common variable (the
+// center of a star like `?s <p1> ?a . ?s <p2> ?b . ?s <p3> ?c`). The other
+// variables of the children must be disjoint. For each value of the join
+// variable, the result is the cross product of the matching rows of the
+// children, which can be much larger than the children if the properties have
+// multiple values.
+//
+// The join is therefore first computed in a factorized form (see
+// `FactorizedResult`), which only stores for each value of the join variable
+// the range of the matching rows in each child. The parent operations `GroupBy`
+// (for counts grouped by the join variable) and `Distinct` work directly on
+// this form, only all other parents get the expanded rows, which are created
+// lazily if possible.
+//
+// The first column of the result is the join variable, followed by the other
+// columns of the children in the order of the children.
+class FactorizedStarJoin : public Operation {
+ public:
+  using Children = std::vector<std::shared_ptr<QueryExecutionTree>>;
+
+  // The factorized form of the result. For each value of the join variable
+  // that is contained in all the children (a group), this stores one range
+  // of rows per child. The rows of the group are all the combinations of one
+  // row from each of these ranges.
+  class FactorizedResult {
+    friend class FactorizedStarJoin;
+    std::vector<std::shared_ptr<const Result>> childResults_;
+    std::vector<Id> keys_;
+    // The range of group `g` in child `c` is `ranges_[g * numChildren + c]`.
+    std::vector<std::pair<size_t, size_t>> ranges_;
+
+   public:
+    size_t numGroups() const { return keys_.size(); }
+    size_t numChildren() const { return childResults_.size(); }
+    // The value of the join variable for the `group`.
+    Id key(size_t group) const { return keys_.at(group); }
+    // The range of rows of the `child` for the `group`.
+    std::pair<size_t, size_t> range(size_t group, size_t child) const {
+      return ranges_.at(group * numChildren() + child);
+    }
+    const IdTable& childTable(size_t child) const {
+      return childResults_.at(child)->idTable();
+    }
+    // The union of the local vocabs of the children.
+    LocalVocab getMergedLocalVocab() const;
+
+    // The number of expanded rows of the `group` / of all groups.
+    size_t numRows(size_t group) const;
+    size_t numRows() const;
+
+    // The number of expanded rows of the `group` in which the `column` of the
+    // `child` is not UNDEF.
+    size_t numDefinedValues(size_t group, size_t child,
+                            ColumnIndex column) const;
+
+    // The distinct values without UNDEF of the `column` of the `child` in the
+    // `group` (in no particular order).
+    std::vector<Id> distinctValues(size_t group, size_t child,
+                                   ColumnIndex column) const;
+  };
+
+ private:
+  Children children_;
+  Variable joinVariable_;
+  // The column of the join variable in each of the children.
+  std::vector<ColumnIndex> joinColumns_;
+  // For each column of the result except for the first one (the join
+  // variable), the child and the column in the child that it is taken from.
+  std::vector<std::pair<size_t, ColumnIndex>> columnOrigins_;
+
+  static constexpr size_t CHUNK_SIZE = 100'000;
+
+ public:
+  // Constructor. There must be at least two `children`, each of them must
+  // contain the `joinVariable` without UNDEF values, and apart from that their
+  // variables must be disjoint, else an `AD_CONTRACT_CHECK` fails. The
+  // children are sorted by the join variable if necessary.
+  FactorizedStarJoin(QueryExecutionContext* qec, Children children,
+                     Variable joinVariable);
+
+  const Variable& joinVariable() const { return joinVariable_; }
+
+  // Return the child and the column in the child of the `variable`, which
+  // must not be the join variable. Return `std::nullopt` if the `variable` is
+  // not bound by any child.
+  std::optional<std::pair<size_t, ColumnIndex>> getChildAndColumn(
+      const Variable& variable) const;
+
+  // Compute the children and the factorized result. The runtime information
+  // of this operation is updated as if it was optimized out (because the
+  // result is never expanded), this is used by the parent operations that
+  // work on the factorized form.
+  FactorizedResult computeFactorizedResult();
+
+  // Compute the rows that are distinct on the given columns of the result
+  // directly from the factorized result: The cross product of the rows that
+  // are distinct on these columns in each child is distinct on the columns.
+  // The columns must contain the join column (0), otherwise equal rows from
+  // different groups are not detected. The result is a subsequence of the
+  // expanded result, so it is sorted in the same way. Used by `Distinct`.
+  Result computeDistinctResult(const std::vector<ColumnIndex>& keepIndices,
+                               bool requestLaziness);
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override { return columnOrigins_.size() + 1; }
+  size_t getCostEstimate() override;
+  float getMultiplicity(size_t col) override;
+  bool knownEmptyResult() override;
+
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
+ private:
+  std::string getCacheKeyImpl() const override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  std::vector<ColumnIndex> resultSortedOn() const override;
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+  bool isTransparentForRuntimeFilters() const override { return true; }
+
+  // Compute the children and intersect their join columns.
+  FactorizedResult computeFactorizedResultImpl();
+
+  // Expand the groups of the `factorized` result to rows. For each group and
+  // child only the rows in `rowsPerGroupAndChild` (indexed like the ranges of
+  // the `FactorizedResult`) are used, or all the rows of the range if it is
+  // `std::nullopt`. If `requestLaziness` is true, the rows are yielded lazily
+  // in chunks of about `CHUNK_SIZE` rows.
+  Result expand(
+      FactorizedResult factorized,
+      std::optional<std::vector<std::vector<size_t>>> rowsPerGroupAndChild,
+      bool requestLaziness) const;
+
+  // The generator for `expand`, which yields a single table if the
+  // `chunkSize` is the maximal `size_t`.
+  Result::Generator expandLazily(
+      FactorizedResult factorized,
+      std::optional<std::vector<std::vector<size_t>>> rowsPerGroupAndChild,
+      size_t chunkSize) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_FACTORIZEDSTARJOIN_H
@@ -45,6 +45,10 @@ class Filter : public Operation {
   size_t getCostEstimate() override;
 
   std::shared_ptr<QueryExecutionTree> getSubtree() const { return _subtree; };
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+  bool isTransparentForRuntimeFilters() const override { return true; }
   std::vector<QueryExecutionTree*> getChildren() override {
     return {_subtree.get()};
   }
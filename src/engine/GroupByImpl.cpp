@@ -19,6 +19,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
+#include "engine/FactorizedStarJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/LazyGroupBy.h"
@@ -347,6 +348,10 @@ sparqlExpression::EvaluationContext GroupByImpl::createEvaluationContext(
 Result GroupByImpl::computeResult(bool requestLaziness) {
   LOG(DEBUG) << "GroupBy result computation..." << std::endl;
 
+  if (auto result = computeGroupByForFactorizedStarJoin()) {
+    return std::move(result).value();
+  }
+
   // no aliases = no aggregates → skip everything else
   if (_aliases.empty()) {
     // force the child to deliver a full, in‐memory table
@@ -1011,6 +1016,100 @@ std::optional<IdTable> GroupByImpl::computeGroupByForJoinWithFullScan() const {
   return std::move(idTable).toDynamic();
 }
 
+// _____________________________________________________________________________
+std::optional<Result> GroupByImpl::computeGroupByForFactorizedStarJoin()
+    const {
+  auto starJoin = std::dynamic_pointer_cast<FactorizedStarJoin>(
+      _subtree->getRootOperation());
+  if (!starJoin) {
+    return std::nullopt;
+  }
+  bool isImplicitGroupBy = _groupByVariables.empty();
+  if (isImplicitGroupBy ? _aliases.empty()
+                        : _groupByVariables.size() != 1 ||
+                              _groupByVariables.front() !=
+                                  starJoin->joinVariable()) {
+    return std::nullopt;
+  }
+
+  // The counted variable of each alias, `std::nullopt` for `COUNT(*)`.
+  using sparqlExpression::SparqlExpressionPimpl;
+  std::vector<std::optional<SparqlExpressionPimpl::VariableAndDistinctness>>
+      counts;
+  for (const auto& alias : _aliases) {
+    if (auto count = alias._expression.getVariableForCount()) {
+      counts.push_back(std::move(count));
+      continue;
+    }
+    auto countStar =
+        dynamic_cast<const sparqlExpression::CountStarExpression*>(
+            alias._expression.getPimpl());
+    if (!countStar || countStar->isAggregate() !=
+                          sparqlExpression::SparqlExpression::AggregateStatus::
+                              NonDistinctAggregate) {
+      return std::nullopt;
+    }
+    counts.emplace_back(std::nullopt);
+  }
+
+  const auto factorized = starJoin->computeFactorizedResult();
+  IdTable table{getResultWidth(), getExecutionContext()->getAllocator()};
+  table.resize(isImplicitGroupBy ? 1 : factorized.numGroups());
+  if (!isImplicitGroupBy) {
+    for (size_t group = 0; group < factorized.numGroups(); ++group) {
+      table(group, 0) = factorized.key(group);
+    }
+  }
+  size_t column = _groupByVariables.size();
+  for (const auto& count : counts) {
+    bool isDistinct = count.has_value() && count.value().isDistinct_;
+    bool countsAllRows = !count.has_value() ||
+                         count.value().variable_ == starJoin->joinVariable();
+    auto childAndColumn =
+        countsAllRows ? std::nullopt
+                      : starJoin->getChildAndColumn(count.value().variable_);
+    auto countGroup = [&](size_t group) -> size_t {
+      if (countsAllRows) {
+        return isDistinct ? 1 : factorized.numRows(group);
+      }
+      if (!childAndColumn.has_value()) {
+        // The variable is not bound by the subtree.
+        return 0;
+      }
+      auto [child, childColumn] = childAndColumn.value();
+      return isDistinct
+                 ? factorized.distinctValues(group, child, childColumn).size()
+                 : factorized.numDefinedValues(group, child, childColumn);
+    };
+    if (!isImplicitGroupBy) {
+      for (size_t group = 0; group < factorized.numGroups(); ++group) {
+        table(group, column) = Id::makeFromInt(countGroup(group));
+      }
+    } else if (isDistinct && childAndColumn.has_value()) {
+      // The same value can occur in several groups.
+      auto [child, childColumn] = childAndColumn.value();
+      ad_utility::HashSet<Id> values;
+      for (size_t group = 0; group < factorized.numGroups(); ++group) {
+        for (Id id : factorized.distinctValues(group, child, childColumn)) {
+          values.insert(id);
+        }
+      }
+      table(0, column) = Id::makeFromInt(values.size());
+    } else {
+      size_t total = 0;
+      for (size_t group = 0; group < factorized.numGroups(); ++group) {
+        total += countGroup(group);
+      }
+      table(0, column) = Id::makeFromInt(total);
+    }
+    ++column;
+    checkCancellation();
+  }
+  return Result{std::move(table), resultSortedOn(),
+                isImplicitGroupBy ? LocalVocab{}
+                                  : factorized.getMergedLocalVocab()};
+}
+
 // _____________________________________________________________________________
 std::optional<IdTable> GroupByImpl::computeOptimizedGroupByIfPossible() const {
   // TODO<C++23> Use `std::optional::or_else`.
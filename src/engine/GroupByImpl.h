@@ -230,6 +230,18 @@ class GroupByImpl : public Operation {
   // `?z`.
   std::optional<IdTable> computeGroupByForJoinWithFullScan() const;
 
+  // Check if the subtree of this GROUP BY is a `FactorizedStarJoin` that is
+  // grouped by its join variable (or not grouped at all) and if all the
+  // aliases are of the form `COUNT(*)`, `COUNT(?x)`, or `COUNT(DISTINCT ?x)`:
+  //
+  //   SELECT ?s (COUNT(?a) as ?count) WHERE {
+  //     ?s <p1> ?a . ?s <p2> ?b . ?s <p3> ?c
+  //   } GROUP BY ?s
+  //
+  // In this case the counts are computed directly on the factorized result of
+  // the join, without expanding the cross products of the groups.
+  std::optional<Result> computeGroupByForFactorizedStarJoin() const;
+
   // Stores information required for substitution of an expression in an
   // expression tree.
   struct ParentAndChildIndex {
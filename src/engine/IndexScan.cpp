@@ -85,10 +85,16 @@ IndexScan::IndexScan(QueryExecutionContext* qec, Permutation::Enum permutation,
 
 // _____________________________________________________________________________
 string IndexScan::getCacheKeyImpl() const {
+  return getCacheKeyForScan(numVariables_, true);
+}
+
+// _____________________________________________________________________________
+string IndexScan::getCacheKeyForScan(size_t numVariables,
+                                     bool withPrefilter) const {
   std::ostringstream os;
   auto permutationString = Permutation::toString(permutation_);
 
-  if (numVariables_ == 3) {
+  if (numVariables == 3) {
     os << "SCAN FOR FULL INDEX " << permutationString;
 
   } else {
@@ -98,7 +104,7 @@ string IndexScan::getCacheKeyImpl() const {
       const auto& key = getPermutedTriple().at(idx)->toRdfLiteral();
       os << keyString << " = \"" << key << "\"";
     };
-    for (size_t i = 0; i < 3 - numVariables_; ++i) {
+    for (size_t i = 0; i < 3 - numVariables; ++i) {
       addKey(i);
       os << ", ";
     }
@@ -117,7 +123,7 @@ string IndexScan::getCacheKeyImpl() const {
     os << "\nFiltered by Graphs:";
     os << absl::StrJoin(graphIdVec, " ");
   }
-  if (prefilter_.has_value()) {
+  if (withPrefilter && prefilter_.has_value()) {
     auto& [prefilterExpr, columnIdx] = prefilter_.value();
     os << "Added PrefiterExpression: \n";
     os << *prefilterExpr;
@@ -126,6 +132,75 @@ string IndexScan::getCacheKeyImpl() const {
   return std::move(os).str();
 }
 
+// _____________________________________________________________________________
+std::optional<IndexRanges> IndexScan::getIndexRanges() {
+  if (numVariables_ == 3) {
+    return std::nullopt;
+  }
+  auto id = getPermutedTriple().at(0)->toValueId(getIndex().getVocab());
+  if (!id.has_value()) {
+    return std::nullopt;
+  }
+  IndexRanges ranges;
+  ranges.add(permutation_, id.value());
+  return ranges;
+}
+
+// _____________________________________________________________________________
+std::vector<SubsumingSubtree> IndexScan::getSubsumingSubtreesImpl() const {
+  std::vector<SubsumingSubtree> result;
+  // The same scan without the prefilter. Its result contains additional rows,
+  // but those are removed by the `FILTER` from which the prefilter was
+  // derived.
+  if (prefilter_.has_value()) {
+    result.push_back({getCacheKeyForScan(numVariables_, false),
+                      [sortedOn = resultSortedOn()](const Result& r) {
+                        return Result{r.idTable().clone(), sortedOn,
+                                      r.getCopyOfLocalVocab()};
+                      }});
+  }
+  // The scan where the last of the bound constants is a variable, e.g. the
+  // scan for `?s rdf:type ?o` for the scan `?s rdf:type <C>`. Its result is
+  // sorted by the additional first column, so the rows for the constant form
+  // a contiguous range. Note: A constant that is not contained in the
+  // vocabulary is ignored for simplicity.
+  if (numVariables_ == 3) {
+    return result;
+  }
+  std::optional<Id> constant =
+      getPermutedTriple().at(2 - numVariables_)->toValueId(
+          getIndex().getVocab());
+  if (!constant.has_value()) {
+    return result;
+  }
+  // Scans with an internal constant (e.g. the `@en@rdfs:label` of a language
+  // filter) are answered by the internal permutation, which the more general
+  // scan doesn't read, so its result doesn't contain the rows for the
+  // constant.
+  const Permutation& permutation = getScanPermutation();
+  if (&permutation.getActualPermutation(constant.value()) != &permutation) {
+    return result;
+  }
+  result.push_back(
+      {getCacheKeyForScan(numVariables_ + 1, false),
+       [id = constant.value(), sortedOn = resultSortedOn()](const Result& r) {
+         const IdTable& input = r.idTable();
+         auto firstColumn = input.getColumn(0);
+         auto [begin, end] = std::equal_range(firstColumn.begin(),
+                                              firstColumn.end(), id);
+         IdTable table{input.numColumns() - 1, input.getAllocator()};
+         table.resize(end - begin);
+         for (size_t col = 1; col < input.numColumns(); ++col) {
+           ql::ranges::copy(
+               input.getColumn(col).subspan(begin - firstColumn.begin(),
+                                            end - begin),
+               table.getColumn(col - 1).begin());
+         }
+         return Result{std::move(table), sortedOn, r.getCopyOfLocalVocab()};
+       }});
+  return result;
+}
+
 // _____________________________________________________________________________
 string IndexScan::getDescriptor() const {
   return "IndexScan " + subject_.toString() + " " + predicate_.toString() +
@@ -209,17 +284,27 @@ Result::Generator IndexScan::chunkedIndexScan() const {
   // prefiltering will be applied in `getLazyScan`.
   for (IdTable& idTable :
        getLazyScan({blockMetadata.begin(), blockMetadata.end()})) {
+    applyRuntimeFiltersToRows(idTable);
     co_yield {std::move(idTable), LocalVocab{}};
   }
 }
 
 // _____________________________________________________________________________
 IdTable IndexScan::materializedIndexScan() const {
+  auto blocks = getBlockMetadataOptionallyPrefiltered();
+  if (!runtimeFilters_.empty() && !blocks.has_value()) {
+    if (auto allBlocks = getBlockMetadata(); allBlocks.has_value()) {
+      blocks.emplace(allBlocks.value().begin(), allBlocks.value().end());
+    }
+  }
+  if (blocks.has_value()) {
+    blocks = filterBlocksByRuntimeFilter(std::move(blocks.value()));
+  }
   IdTable idTable = getScanPermutation().scan(
       getScanSpecification(), additionalColumns(), cancellationHandle_,
-      locatedTriplesSnapshot(), getLimitOffset(),
-      getBlockMetadataOptionallyPrefiltered());
+      locatedTriplesSnapshot(), getLimitOffset(), std::move(blocks));
   AD_CORRECTNESS_CHECK(idTable.numColumns() == getResultWidth());
+  applyRuntimeFiltersToRows(idTable);
   LOG(DEBUG) << "IndexScan result computation done.\n";
   checkCancellation();
   return idTable;
@@ -228,6 +313,9 @@ IdTable IndexScan::materializedIndexScan() const {
 // _____________________________________________________________________________
 Result IndexScan::computeResult(bool requestLaziness) {
   LOG(DEBUG) << "IndexScan result computation...\n";
+  if (!runtimeFilters_.empty()) {
+    runtimeInfo().addDetail("num-runtime-filters", runtimeFilters_.size());
+  }
   if (requestLaziness) {
     return {chunkedIndexScan(), resultSortedOn()};
   }
@@ -376,11 +464,52 @@ Permutation::IdTableGenerator IndexScan::getLazyScan(
     // be applied.
     filteredBlocks = applyPrefilter(filteredBlocks.value());
   }
+  if (filteredBlocks.has_value()) {
+    filteredBlocks =
+        filterBlocksByRuntimeFilter(std::move(filteredBlocks.value()));
+  }
   return getScanPermutation().lazyScan(
       getScanSpecification(), filteredBlocks, additionalColumns(),
       cancellationHandle_, locatedTriplesSnapshot(), getLimitOffset());
 };
 
+// _____________________________________________________________________________
+bool IndexScan::applyRuntimeFilter(
+    ColumnIndex column, const std::shared_ptr<const RuntimeFilter>& filter) {
+  runtimeFilters_.emplace_back(column, filter);
+  return true;
+}
+
+// _____________________________________________________________________________
+std::vector<CompressedBlockMetadata> IndexScan::filterBlocksByRuntimeFilter(
+    std::vector<CompressedBlockMetadata> blocks) const {
+  auto it = ql::ranges::find(runtimeFilters_, ColumnIndex{0},
+                             [](const auto& pair) { return pair.first; });
+  if (it == runtimeFilters_.end() || numVariables_ == 0) {
+    return blocks;
+  }
+  auto metadata = getMetadataForScan();
+  if (!metadata.has_value()) {
+    return {};
+  }
+  ad_utility::HashSet<size_t> matchingBlocks;
+  for (const auto& block : CompressedRelationReader::getBlocksForJoin(
+           it->second->ids(), metadata.value())) {
+    matchingBlocks.insert(block.blockIndex_);
+  }
+  std::erase_if(blocks, [&matchingBlocks](const auto& block) {
+    return !matchingBlocks.contains(block.blockIndex_);
+  });
+  return blocks;
+}
+
+// _____________________________________________________________________________
+void IndexScan::applyRuntimeFiltersToRows(IdTable& idTable) const {
+  for (const auto& [column, filter] : runtimeFilters_) {
+    filter->filterRows(idTable, column);
+  }
+}
+
 // _____________________________________________________________________________
 std::optional<Permutation::MetadataAndBlocks> IndexScan::getMetadataForScan()
     const {
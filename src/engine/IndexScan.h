@@ -8,6 +8,7 @@
 #include <string>
 
 #include "engine/Operation.h"
+#include "engine/RuntimeFilter.h"
 #include "util/HashMap.h"
 
 class SparqlTriple;
@@ -44,6 +45,12 @@ class IndexScan final : public Operation {
   std::vector<ColumnIndex> additionalColumns_;
   std::vector<Variable> additionalVariables_;
 
+  // The filters that were pushed into this scan by a parent (see
+  // `Operation::pushDownRuntimeFilter`), together with the column of the
+  // result that they apply to.
+  std::vector<std::pair<ColumnIndex, std::shared_ptr<const RuntimeFilter>>>
+      runtimeFilters_;
+
  public:
   IndexScan(QueryExecutionContext* qec, Permutation::Enum permutation,
             const SparqlTripleSimple& triple,
@@ -188,8 +195,22 @@ class IndexScan final : public Operation {
 
   Result computeResult(bool requestLaziness) override;
 
+  // The range of the first bound constant in the permutation. A full scan
+  // (or a scan for a constant that is not in the vocabulary) might depend on
+  // arbitrary parts of the index.
+  std::optional<IndexRanges> getIndexRanges() override;
+
   std::vector<QueryExecutionTree*> getChildren() override { return {}; }
 
+  // A filter for the first column of the result (which is the column by which
+  // the blocks are sorted) is used to skip blocks (see
+  // `filterBlocksByRuntimeFilter`). Filters for all columns are applied to the
+  // rows of the result, except when the scan is lazily consumed by a `Join`
+  // (see `lazyScanForJoinOfTwoScans` etc.), which only uses the blocks.
+  bool applyRuntimeFilter(
+      ColumnIndex column,
+      const std::shared_ptr<const RuntimeFilter>& filter) override;
+
   // Retrieve the `Permutation` entity for the `Permutation::Enum` value of this
   // `IndexScan`.
   const Permutation& getScanPermutation() const;
@@ -202,6 +223,16 @@ class IndexScan final : public Operation {
 
   std::string getCacheKeyImpl() const override;
 
+  // The cache key of the scan with the same permutation and the same first
+  // `3 - numVariables` constants as this scan, with or without the prefilter.
+  std::string getCacheKeyForScan(size_t numVariables,
+                                 bool withPrefilter) const;
+
+  // See `Operation::getSubsumingSubtreesImpl`. The more general subtrees are
+  // this scan without its prefilter, and the scan where the last bound constant
+  // is replaced by a variable.
+  std::vector<SubsumingSubtree> getSubsumingSubtreesImpl() const override;
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 
   // Return an updated QueryExecutionTree containing the new IndexScan which is
@@ -238,6 +269,16 @@ class IndexScan final : public Operation {
   std::vector<CompressedBlockMetadata> applyPrefilter(
       ql::span<const CompressedBlockMetadata> blocks) const;
 
+  // Return only those of the `blocks` that might contain a value of the
+  // runtime filter for the first column, if there is such a filter (see
+  // `CompressedRelationReader::getBlocksForJoin`).
+  std::vector<CompressedBlockMetadata> filterBlocksByRuntimeFilter(
+      std::vector<CompressedBlockMetadata> blocks) const;
+
+  // Remove the rows from the `idTable` that don't match all the runtime
+  // filters.
+  void applyRuntimeFiltersToRows(IdTable& idTable) const;
+
   // Helper functions for the public `getLazyScanFor...` methods and
   // `chunkedIndexScan` (see above).
   Permutation::IdTableGenerator getLazyScan(
@@ -17,6 +17,7 @@
 #include "engine/CallFixedSize.h"
 #include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
+#include "engine/RuntimeFilter.h"
 #include "engine/Service.h"
 #include "global/Constants.h"
 #include "global/Id.h"
@@ -141,18 +142,38 @@ Result Join::computeResult(bool requestLaziness) {
     }
   }
 
+  // Note: If only one of the children is a scan, then we have made sure in the
+  // constructor that it is the right child.
+  auto rightIndexScan =
+      std::dynamic_pointer_cast<IndexScan>(_right->getRootOperation());
+
+  // If the right child is not an index scan (which is already restricted to
+  // the blocks that match the left child, see below), the index scans inside
+  // of it can be restricted by a runtime filter. This requires the left child
+  // to be materialized before the right child is computed.
+  const size_t maxRuntimeFilterSize =
+      RuntimeParameters().get<"runtime-filter-max-size">();
+  bool useRuntimeFilter = maxRuntimeFilterSize > 0 && !rightIndexScan &&
+                          !rightResIfCached &&
+                          _left->getSizeEstimate() <= maxRuntimeFilterSize;
+
+  // If both children have to be computed in full, compute them concurrently.
+  // Note: Index scans are excluded, because they are typically only read
+  // partially, depending on the result of the other child.
+  if (!leftResIfCached && !rightResIfCached && !rightIndexScan &&
+      !useRuntimeFilter) {
+    computeChildrenInParallel({_left, _right},
+                              ComputationMode::LAZY_IF_SUPPORTED);
+  }
+
   std::shared_ptr<const Result> leftRes =
-      leftResIfCached ? leftResIfCached : _left->getResult(true);
+      leftResIfCached ? leftResIfCached : _left->getResult(!useRuntimeFilter);
   checkCancellation();
   if (leftRes->isFullyMaterialized() && leftRes->idTable().empty()) {
     _right->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
     return createEmptyResult();
   }
 
-  // Note: If only one of the children is a scan, then we have made sure in the
-  // constructor that it is the right child.
-  auto rightIndexScan =
-      std::dynamic_pointer_cast<IndexScan>(_right->getRootOperation());
   if (rightIndexScan && !rightResIfCached) {
     if (leftRes->isFullyMaterialized()) {
       return computeResultForIndexScanAndIdTable<false>(
@@ -162,6 +183,11 @@ Result Join::computeResult(bool requestLaziness) {
         requestLaziness, std::move(leftRes), rightIndexScan);
   }
 
+  if (useRuntimeFilter && leftRes->isFullyMaterialized()) {
+    pushDownRuntimeFilterToRight(leftRes->idTable().getColumn(_leftJoinCol),
+                                 maxRuntimeFilterSize);
+  }
+
   std::shared_ptr<const Result> rightRes =
       rightResIfCached ? rightResIfCached : _right->getResult(true);
   checkCancellation();
@@ -557,6 +583,21 @@ void Join::addCombinedRowToIdTable(const ROW_A& rowA, const ROW_B& rowB,
   }
 }
 
+// _____________________________________________________________________________
+void Join::pushDownRuntimeFilterToRight(ql::span<const Id> leftJoinColumn,
+                                        size_t maxSize) {
+  auto filter = RuntimeFilter::fromSortedColumn(leftJoinColumn, maxSize);
+  if (!filter.has_value()) {
+    return;
+  }
+  size_t size = filter->size();
+  if (_right->getRootOperation()->pushDownRuntimeFilter(
+          _joinVar,
+          std::make_shared<const RuntimeFilter>(std::move(filter.value())))) {
+    runtimeInfo().addDetail("runtime-filter-size", size);
+  }
+}
+
 // ______________________________________________________________________________________________________
 Result Join::computeResultForTwoIndexScans(bool requestLaziness) const {
   return createResult(
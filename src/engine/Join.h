@@ -64,6 +64,11 @@ class Join : public Operation {
 
   float getMultiplicity(size_t col) override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+  bool isTransparentForRuntimeFilters() const override { return true; }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {_left.get(), _right.get()};
   }
@@ -139,6 +144,12 @@ class Join : public Operation {
 
   VariableToColumnMap computeVariableToColumnMap() const override;
 
+  // Push the distinct values of the join column of the left child as a
+  // `RuntimeFilter` into the right child, unless there are more than
+  // `maxSize` of them. The `leftJoinColumn` must be sorted.
+  void pushDownRuntimeFilterToRight(ql::span<const Id> leftJoinColumn,
+                                    size_t maxSize);
+
   // A special implementation that is called when both children are
   // `IndexScan`s. Uses the lazy scans to only retrieve the subset of the
   // `IndexScan`s that is actually needed without fully materializing them.
@@ -0,0 +1,349 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/LeapfrogTriejoin.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include <limits>
+#include <numeric>
+
+#include "util/HashMap.h"
+#include "util/Views.h"
+
+namespace {
+// Return the first index in `[begin, end)` of the `column` for which
+// `isBefore` is false. The `column` must be partitioned wrt `isBefore` in
+// this range. The search starts with exponentially growing steps from `begin`
+// (galloping search), s.t. the cost is logarithmic in the distance of the
+// result from `begin` and not in the size of the range. This makes the
+// repeated seeks of the join cheap, which mostly move only a few rows.
+template <typename IsBefore>
+size_t gallop(ql::span<const Id> column, size_t begin, size_t end,
+              const IsBefore& isBefore) {
+  if (begin == end || !isBefore(column[begin])) {
+    return begin;
+  }
+  // Invariant: `isBefore(column[low])`.
+  size_t low = begin;
+  size_t step = 1;
+  while (low + step < end && isBefore(column[low + step])) {
+    low += step;
+    step *= 2;
+  }
+  size_t high = std::min(low + step, end);
+  return static_cast<size_t>(std::partition_point(column.begin() + low + 1,
+                                                  column.begin() + high,
+                                                  isBefore) -
+                             column.begin());
+}
+
+// The number of steps of the join (iterations of the leapfrog loop or result
+// rows) after which the cancellation is checked.
+constexpr size_t CANCELLATION_CHECK_INTERVAL = 10'000;
+}  // namespace
+
+// The state of the recursive join. For each child the range of rows that
+// matches the values of the variables that have already been processed, and
+// for each variable (depth) the buffers of `join` for this depth.
+struct LeapfrogTriejoin::JoinState {
+  std::vector<const IdTable*> tables_;
+  std::vector<std::pair<size_t, size_t>> ranges_;
+  std::vector<std::vector<std::pair<size_t, size_t>>> savedRanges_;
+  std::vector<std::vector<size_t>> cursors_;
+  // The values of the variables that have already been processed.
+  std::vector<Id> row_;
+  IdTable result_;
+  // The number of steps since the last check for cancellation (at any depth).
+  size_t numStepsSinceCancellationCheck_;
+};
+
+// _____________________________________________________________________________
+LeapfrogTriejoin::LeapfrogTriejoin(QueryExecutionContext* qec,
+                                   Children children)
+    : Operation{qec}, children_{std::move(children)} {
+  AD_CONTRACT_CHECK(children_.size() >= 2);
+  AD_CONTRACT_CHECK(ql::ranges::all_of(
+      children_, [](const auto& child) { return child != nullptr; }));
+  variableOrder_ = computeVariableOrder(children_);
+  childrenOfVariable_.resize(variableOrder_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    for (const auto& info : child->getVariableColumns() | ql::views::values) {
+      AD_CONTRACT_CHECK(info.mightContainUndef_ ==
+                            ColumnIndexAndTypeInfo::AlwaysDefined,
+                        "The children of a Leapfrog Triejoin must not contain "
+                        "UNDEF values");
+    }
+    auto sortColumns = computeSortColumns(*child, variableOrder_);
+    child = QueryExecutionTree::createSortedTree(std::move(child), sortColumns);
+    for (size_t var = 0; var < variableOrder_.size(); ++var) {
+      auto column = child->getVariableColumnOrNullopt(variableOrder_[var]);
+      if (column.has_value()) {
+        childrenOfVariable_[var].emplace_back(i, column.value());
+      }
+    }
+    sortColumns_.push_back(std::move(sortColumns));
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<Variable> LeapfrogTriejoin::computeVariableOrder(
+    const Children& children) {
+  ad_utility::HashMap<Variable, size_t> numOccurrences;
+  for (const auto& child : children) {
+    for (const auto& variable : child->getVariableColumns() | ql::views::keys) {
+      ++numOccurrences[variable];
+    }
+  }
+  std::vector<Variable> order;
+  for (const auto& variable : numOccurrences | ql::views::keys) {
+    order.push_back(variable);
+  }
+  ql::ranges::sort(order, [&numOccurrences](const Variable& a,
+                                            const Variable& b) {
+    auto numA = numOccurrences.at(a);
+    auto numB = numOccurrences.at(b);
+    return numA != numB ? numA > numB : a.name() < b.name();
+  });
+  return order;
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> LeapfrogTriejoin::computeSortColumns(
+    const QueryExecutionTree& child,
+    const std::vector<Variable>& variableOrder) {
+  std::vector<ColumnIndex> sortColumns;
+  for (const auto& variable : variableOrder) {
+    auto column = child.getVariableColumnOrNullopt(variable);
+    if (column.has_value()) {
+      sortColumns.push_back(column.value());
+    }
+  }
+  return sortColumns;
+}
+
+// _____________________________________________________________________________
+std::vector<QueryExecutionTree*> LeapfrogTriejoin::getChildren() {
+  std::vector<QueryExecutionTree*> result;
+  ql::ranges::transform(children_, std::back_inserter(result),
+                        [](auto& child) { return child.get(); });
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string LeapfrogTriejoin::getDescriptor() const {
+  std::vector<std::string> names;
+  ql::ranges::transform(variableOrder_, std::back_inserter(names),
+                        &Variable::name);
+  return absl::StrCat("Leapfrog Triejoin on ", absl::StrJoin(names, " "));
+}
+
+// _____________________________________________________________________________
+std::string LeapfrogTriejoin::getCacheKeyImpl() const {
+  // The variables are not part of the key, but the columns of the children in
+  // the order of the variables determine the result.
+  std::string key = "LEAPFROG TRIEJOIN";
+  for (size_t var = 0; var < variableOrder_.size(); ++var) {
+    absl::StrAppend(&key, " var", var, ":");
+    for (const auto& [child, column] : childrenOfVariable_[var]) {
+      absl::StrAppend(&key, " ", child, ".", column);
+    }
+  }
+  for (const auto& child : children_) {
+    absl::StrAppend(&key, "\nchild: ", child->getCacheKey());
+  }
+  return key;
+}
+
+// _____________________________________________________________________________
+uint64_t LeapfrogTriejoin::getSizeEstimateBeforeLimit() {
+  // Like for the other joins this is only a rough heuristic: The result is
+  // assumed to be not larger than the smallest child.
+  auto sizes = children_ | ql::views::transform([](const auto& child) {
+                 return child->getSizeEstimate();
+               });
+  return ql::ranges::min(sizes);
+}
+
+// _____________________________________________________________________________
+size_t LeapfrogTriejoin::getCostEstimate() {
+  // Each child is read once (plus the galloping searches, which are ignored),
+  // and the result is written.
+  size_t cost = getSizeEstimateBeforeLimit();
+  for (const auto& child : children_) {
+    cost += child->getCostEstimate() + child->getSizeEstimate();
+  }
+  return cost;
+}
+
+// _____________________________________________________________________________
+float LeapfrogTriejoin::getMultiplicity(size_t col) {
+  AD_CONTRACT_CHECK(col < childrenOfVariable_.size());
+  float multiplicity = std::numeric_limits<float>::max();
+  for (const auto& [child, column] : childrenOfVariable_[col]) {
+    multiplicity =
+        std::min(multiplicity, children_[child]->getMultiplicity(column));
+  }
+  return multiplicity;
+}
+
+// _____________________________________________________________________________
+bool LeapfrogTriejoin::knownEmptyResult() {
+  return ql::ranges::any_of(
+      children_, [](const auto& child) { return child->knownEmptyResult(); });
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> LeapfrogTriejoin::resultSortedOn() const {
+  std::vector<ColumnIndex> sortedOn(variableOrder_.size());
+  std::iota(sortedOn.begin(), sortedOn.end(), ColumnIndex{0});
+  return sortedOn;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap LeapfrogTriejoin::computeVariableToColumnMap() const {
+  VariableToColumnMap map;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    map[variableOrder_[i]] = makeAlwaysDefinedColumn(i);
+  }
+  return map;
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> LeapfrogTriejoin::cloneImpl() const {
+  Children copy;
+  for (const auto& child : children_) {
+    copy.push_back(child->clone());
+  }
+  return std::make_unique<LeapfrogTriejoin>(_executionContext,
+                                            std::move(copy));
+}
+
+// _____________________________________________________________________________
+void LeapfrogTriejoin::join(JoinState& state, size_t depth) const {
+  // The cancellation is checked at every depth, s.t. a single value with a
+  // huge fan-out at the deeper levels (which is typical for cyclic patterns)
+  // doesn't delay the cancellation.
+  auto countStepAndCheckCancellation = [this, &state]() {
+    if (++state.numStepsSinceCancellationCheck_ >=
+        CANCELLATION_CHECK_INTERVAL) {
+      state.numStepsSinceCancellationCheck_ = 0;
+      checkCancellation();
+    }
+  };
+  if (depth == variableOrder_.size()) {
+    // All the variables are bound, the remaining rows of each child are equal
+    // on all the variables of the child. Each combination of these rows is a
+    // result row.
+    size_t numRows = 1;
+    for (const auto& [begin, end] : state.ranges_) {
+      numRows *= end - begin;
+    }
+    for (size_t i = 0; i < numRows; ++i) {
+      countStepAndCheckCancellation();
+      state.result_.push_back(state.row_);
+    }
+    return;
+  }
+
+  const auto& participants = childrenOfVariable_[depth];
+  auto& saved = state.savedRanges_[depth];
+  auto& cursors = state.cursors_[depth];
+  for (size_t i = 0; i < participants.size(); ++i) {
+    saved[i] = state.ranges_[participants[i].first];
+    cursors[i] = saved[i].first;
+  }
+  auto getColumn = [&state, &participants](size_t i) {
+    const auto& [child, column] = participants[i];
+    return state.tables_[child]->getColumn(column);
+  };
+  auto isExhausted = [&cursors, &saved](size_t i) {
+    return cursors[i] == saved[i].second;
+  };
+
+  if (ql::ranges::none_of(ad_utility::integerRange(participants.size()),
+                          isExhausted)) {
+    Id value = getColumn(0)[cursors[0]];
+    while (true) {
+      countStepAndCheckCancellation();
+      // Seek all the participating children to the first value `>= value`.
+      // If they all find `value`, then it is part of the result, else retry
+      // with the largest value that was found.
+      bool allEqual = true;
+      bool exhausted = false;
+      for (size_t i = 0; i < participants.size(); ++i) {
+        auto column = getColumn(i);
+        cursors[i] = gallop(column, cursors[i], saved[i].second,
+                            [value](Id id) { return id < value; });
+        if (isExhausted(i)) {
+          exhausted = true;
+          break;
+        }
+        if (column[cursors[i]] != value) {
+          value = column[cursors[i]];
+          allEqual = false;
+        }
+      }
+      if (exhausted) {
+        break;
+      }
+      if (!allEqual) {
+        continue;
+      }
+      for (size_t i = 0; i < participants.size(); ++i) {
+        auto end = gallop(getColumn(i), cursors[i], saved[i].second,
+                          [value](Id id) { return !(value < id); });
+        state.ranges_[participants[i].first] = {cursors[i], end};
+        cursors[i] = end;
+      }
+      state.row_[depth] = value;
+      join(state, depth + 1);
+      if (ql::ranges::any_of(ad_utility::integerRange(participants.size()),
+                             isExhausted)) {
+        break;
+      }
+      value = getColumn(0)[cursors[0]];
+    }
+  }
+
+  for (size_t i = 0; i < participants.size(); ++i) {
+    state.ranges_[participants[i].first] = saved[i];
+  }
+}
+
+// _____________________________________________________________________________
+Result LeapfrogTriejoin::computeResult([[maybe_unused]] bool requestLaziness) {
+  computeChildrenInParallel(children_, ComputationMode::FULLY_MATERIALIZED);
+  std::vector<std::shared_ptr<const Result>> subResults;
+  for (const auto& child : children_) {
+    subResults.push_back(child->getResult());
+    checkCancellation();
+  }
+
+  JoinState state{{},
+                  {},
+                  {},
+                  {},
+                  std::vector<Id>(variableOrder_.size()),
+                  IdTable{getResultWidth(),
+                          getExecutionContext()->getAllocator()},
+                  0};
+  for (const auto& subResult : subResults) {
+    state.tables_.push_back(&subResult->idTable());
+    state.ranges_.emplace_back(0, subResult->idTable().numRows());
+  }
+  for (const auto& participants : childrenOfVariable_) {
+    state.savedRanges_.emplace_back(participants.size());
+    state.cursors_.emplace_back(participants.size());
+  }
+  join(state, 0);
+
+  LocalVocab localVocab;
+  localVocab.mergeWith(
+      subResults |
+      ql::views::transform([](const auto& result) -> const LocalVocab& {
+        return result->localVocab();
+      }));
+  return {std::move(state.result_), resultSortedOn(), std::move(localVocab)};
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_LEAPFROGTRIEJOIN_H
+#define QLEVER_SRC_ENGINE_LEAPFROGTRIEJOIN_H
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A worst-case-optimal join of an arbitrary number of children (Leapfrog
+// Triejoin, also known as Generic Join). The variables of all the children
+// are processed one after the other in a global order (see
+// `computeVariableOrder`). Each child is sorted by its variables in this
+// order, so it can be read as a trie. For each variable, the values that are
+// contained in all the children that bind the variable are determined by
+// "leapfrogging" (galloping search) in the children, and only for these values
+// the next variable is processed. In contrast to a cascade of binary joins,
+// this never creates intermediate results that are larger than the final
+// result, which makes a big difference for cyclic patterns like triangles.
+//
+// The result has one column per variable in the global order and is sorted by
+// all its columns. The columns of the children must not contain UNDEF values.
+class LeapfrogTriejoin : public Operation {
+ public:
+  using Children = std::vector<std::shared_ptr<QueryExecutionTree>>;
+
+ private:
+  Children children_;
+  // All the variables of the children in the order in which they are joined.
+  std::vector<Variable> variableOrder_;
+  // For each child the columns of the variables in `variableOrder_` that are
+  // bound by the child, in this order. The child is sorted by these columns.
+  std::vector<std::vector<ColumnIndex>> sortColumns_;
+  // For each variable the indices of the children that bind it, together with
+  // the column of the variable in the child.
+  std::vector<std::vector<std::pair<size_t, ColumnIndex>>> childrenOfVariable_;
+
+ public:
+  // Constructor. `children` must contain at least two children and each of
+  // them must contain only columns without UNDEF values, else an
+  // `AD_CONTRACT_CHECK` fails. The children are sorted as needed.
+  LeapfrogTriejoin(QueryExecutionContext* qec, Children children);
+
+  // Return the order in which the variables of the `children` are joined:
+  // Variables that are bound by more children come first (they restrict the
+  // result the most), ties are broken by the name of the variable, s.t. the
+  // order doesn't depend on the column order of the children.
+  static std::vector<Variable> computeVariableOrder(const Children& children);
+
+  // Return the columns of the `child` by which it has to be sorted when it is
+  // joined using the given `variableOrder`.
+  static std::vector<ColumnIndex> computeSortColumns(
+      const QueryExecutionTree& child,
+      const std::vector<Variable>& variableOrder);
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override { return variableOrder_.size(); }
+  size_t getCostEstimate() override;
+  float getMultiplicity(size_t col) override;
+  bool knownEmptyResult() override;
+
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+  bool isTransparentForRuntimeFilters() const override { return true; }
+
+ private:
+  std::string getCacheKeyImpl() const override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  std::vector<ColumnIndex> resultSortedOn() const override;
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // The state of the recursive join, see `LeapfrogTriejoin.cpp`.
+  struct JoinState;
+  // Process the variable with index `depth` for the current ranges of rows of
+  // the children that are stored in the `state`.
+  void join(JoinState& state, size_t depth) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_LEAPFROGTRIEJOIN_H
@@ -38,11 +38,9 @@ LocalVocabIndex LocalVocab::getIndexAndAddIfNotContainedImpl(WordT&& word) {
   // still might end up with data races but it helps to find wrong
   // implementations.
   AD_CORRECTNESS_CHECK(!copied_->load());
-  auto [wordIterator, isNewWord] = primaryWordSet().insert(AD_FWD(word));
+  auto [wordPointer, isNewWord] = primaryWordSet().insert(AD_FWD(word));
   size_ += static_cast<size_t>(isNewWord);
-  // TODO<Libc++18> Use std::to_address (more idiomatic, but currently breaks
-  // the MacOS build.
-  return &(*wordIterator);
+  return wordPointer;
 }
 
 // _____________________________________________________________________________
@@ -60,11 +58,9 @@ LocalVocabIndex LocalVocab::getIndexAndAddIfNotContained(
 // _____________________________________________________________________________
 std::optional<LocalVocabIndex> LocalVocab::getIndexOrNullopt(
     const LocalVocabEntry& word) const {
-  auto localVocabIndex = primaryWordSet().find(word);
-  if (localVocabIndex != primaryWordSet().end()) {
-    // TODO<Libc++18> Use std::to_address (more idiomatic, but currently breaks
-    // the MacOS build.
-    return &(*localVocabIndex);
+  LocalVocabIndex localVocabIndex = primaryWordSet().find(word);
+  if (localVocabIndex != nullptr) {
+    return localVocabIndex;
   } else {
     return std::nullopt;
   }
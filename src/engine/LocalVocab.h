@@ -7,7 +7,6 @@
 #define QLEVER_SRC_ENGINE_LOCALVOCAB_H
 
 #include <absl/container/flat_hash_set.h>
-#include <absl/container/node_hash_set.h>
 
 #include <cstdlib>
 #include <memory>
@@ -18,6 +17,7 @@
 #include "backports/algorithm.h"
 #include "backports/span.h"
 #include "index/LocalVocabEntry.h"
+#include "util/ArenaBackedHashSet.h"
 #include "util/BlankNodeManager.h"
 #include "util/Exception.h"
 
@@ -38,10 +38,12 @@ class LocalVocab {
  private:
   // The primary set of `LocalVocabEntry`s, which can grow dynamically.
   //
-  // NOTE: This is a `absl::node_hash_set` because we hand out pointers to
-  // the `LocalVocabEntry`s and it is hence essential that their addresses
-  // remain stable over their lifetime in the hash set.
-  using Set = absl::node_hash_set<LocalVocabEntry>;
+  // NOTE: We hand out pointers to the `LocalVocabEntry`s, so it is essential
+  // that their addresses remain stable over their lifetime in the set. The
+  // `ArenaBackedHashSet` guarantees this without a separate heap allocation per
+  // entry, which matters for operations that create millions of new words
+  // (e.g. `BIND` with string functions or `SERVICE`).
+  using Set = ad_utility::ArenaBackedHashSet<LocalVocabEntry>;
   std::shared_ptr<Set> primaryWordSet_ = std::make_shared<Set>();
 
   // The other sets of `LocalVocabEntry`s, which are static.
@@ -0,0 +1,383 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/MaterializedView.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+
+#include "engine/Engine.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+#include "util/BitUtils.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+namespace fs = std::filesystem;
+using ad_utility::triple_component::LiteralOrIri;
+
+constexpr std::string_view viewFileInfix = ".view.";
+
+// The `Id`s with datatype `LocalVocabIndex` contain a pointer, so in the files
+// their data bits are replaced by the position of the word in the list of
+// words that is stored in the same file (like in the `DiskResultCache`).
+Id makeLocalVocabPositionId(uint64_t position) {
+  auto datatypeBits = static_cast<Id::T>(Datatype::LocalVocabIndex)
+                      << Id::numDataBits;
+  return Id::fromBits(datatypeBits | position);
+}
+uint64_t getLocalVocabPosition(Id id) {
+  return id.getBits() & ad_utility::bitMaskForLowerBits(Id::numDataBits);
+}
+
+// A new version for a view that is (re)written now.
+uint64_t makeVersion() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// The metadata of the blocks of the sorted `table` with `blockSize` rows each
+// (except for the last one). The offsets in the file are added when the view
+// is written.
+std::vector<MaterializedView::BlockMetadata> computeBlocks(
+    const IdTable& table, size_t blockSize) {
+  AD_CONTRACT_CHECK(blockSize > 0);
+  std::vector<MaterializedView::BlockMetadata> blocks;
+  for (size_t beginRow = 0; beginRow < table.numRows(); beginRow += blockSize) {
+    auto& block = blocks.emplace_back();
+    block.beginRow_ = beginRow;
+    block.numRows_ = std::min(blockSize, table.numRows() - beginRow);
+    for (size_t col = 0; col < table.numColumns(); ++col) {
+      auto column = table.getColumn(col).subspan(beginRow, block.numRows_);
+      block.firstRow_.push_back(column.front());
+      block.lastRow_.push_back(column.back());
+      block.containsUndef_.push_back(
+          ql::ranges::any_of(column, [](Id id) { return id.isUndefined(); }));
+    }
+  }
+  return blocks;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+MaterializedView::MaterializedView(std::string name, std::string query,
+                                   std::vector<Variable> variables,
+                                   LocalVocab localVocab, uint64_t version)
+    : name_{std::move(name)},
+      query_{std::move(query)},
+      variables_{std::move(variables)},
+      localVocab_{std::move(localVocab)},
+      version_{version} {}
+
+// _____________________________________________________________________________
+MaterializedView MaterializedView::compute(
+    std::string name, std::string query, QueryExecutionContext* qec,
+    ad_utility::SharedCancellationHandle handle, size_t blockSize) {
+  // The name becomes part of a filename.
+  if (name.empty() || !ql::ranges::all_of(name, [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+               c == '-';
+      })) {
+    throw std::runtime_error(absl::StrCat(
+        "The name of a materialized view must be non-empty and consist only "
+        "of letters, digits, `_` and `-`, but was \"",
+        name, "\""));
+  }
+  auto parsedQuery = SparqlParser::parseQuery(query);
+  if (!parsedQuery.hasSelectClause()) {
+    throw std::runtime_error(
+        "The query of a materialized view must be a SELECT query");
+  }
+  QueryPlanner planner{qec, handle};
+  auto qet = planner.createExecutionTree(parsedQuery);
+  qet.getRootOperation()->recursivelySetCancellationHandle(handle);
+  auto result = qet.getResult();
+  const IdTable& idTable = result->idTable();
+
+  // Only keep the selected columns (in the order of the selection), and sort
+  // the rows by all of them.
+  const auto& variables = parsedQuery.selectClause().getSelectedVariables();
+  IdTable table{variables.size(), qec->getAllocator()};
+  table.resize(idTable.numRows());
+  for (size_t i = 0; i < variables.size(); ++i) {
+    auto column = qet.getVariableColumnOrNullopt(variables[i]);
+    if (!column.has_value()) {
+      throw std::runtime_error(
+          absl::StrCat("The selected variable ", variables[i].name(),
+                       " of a materialized view is not bound by the query"));
+    }
+    ql::ranges::copy(idTable.getColumn(column.value()),
+                     table.getColumn(i).begin());
+  }
+  std::vector<ColumnIndex> sortColumns(table.numColumns());
+  std::iota(sortColumns.begin(), sortColumns.end(), ColumnIndex{0});
+  Engine::sort(table, sortColumns);
+  handle->throwIfCancelled();
+  MaterializedView view{std::move(name), std::move(query), variables,
+                        result->localVocab().clone(), makeVersion()};
+  view.blocks_ = computeBlocks(table, blockSize);
+  view.table_ = std::move(table);
+  return view;
+}
+
+// _____________________________________________________________________________
+std::string MaterializedView::getFilename(std::string_view indexBasename,
+                                          std::string_view name) {
+  return absl::StrCat(indexBasename, viewFileInfix, name);
+}
+
+// _____________________________________________________________________________
+size_t MaterializedView::getColumnIndex(std::string_view name) const {
+  auto it = ql::ranges::find(variables_, absl::StrCat("?", name),
+                             &Variable::name);
+  if (it == variables_.end()) {
+    throw std::runtime_error(absl::StrCat("The materialized view \"", name_,
+                                          "\" has no column ?", name));
+  }
+  return static_cast<size_t>(it - variables_.begin());
+}
+
+// _____________________________________________________________________________
+size_t MaterializedView::numRows() const {
+  if (blocks_.empty()) {
+    return 0;
+  }
+  return blocks_.back().beginRow_ + blocks_.back().numRows_;
+}
+
+// _____________________________________________________________________________
+std::string MaterializedView::writeToDisk(std::string_view indexBasename,
+                                          std::string_view buildId) const {
+  if (!table_.has_value()) {
+    throw std::runtime_error(absl::StrCat("The materialized view \"", name_,
+                                          "\" has already been written"));
+  }
+  // Replace the `LocalVocabIndex` `Id`s by their positions in the list of
+  // words. Blank nodes that were created during the computation are only valid
+  // for the lifetime of the server and can't be stored.
+  ad_utility::HashMap<LocalVocabIndex, uint64_t> positions;
+  std::vector<std::string> words;
+  auto toFileId = [this, &positions, &words](Id id) {
+    if (id.getDatatype() == Datatype::BlankNodeIndex &&
+        localVocab_.isBlankNodeIndexContained(id.getBlankNodeIndex())) {
+      throw std::runtime_error(
+          "A materialized view must not contain blank nodes that are "
+          "created by its query");
+    }
+    if (id.getDatatype() != Datatype::LocalVocabIndex) {
+      return id;
+    }
+    auto [it, isNew] =
+        positions.try_emplace(id.getLocalVocabIndex(), words.size());
+    if (isNew) {
+      words.push_back(id.getLocalVocabIndex()->toStringRepresentation());
+    }
+    return makeLocalVocabPositionId(it->second);
+  };
+
+  std::vector<std::string> variableNames;
+  ql::ranges::transform(variables_, std::back_inserter(variableNames),
+                        &Variable::name);
+  // Write to a temporary file first, s.t. an existing view is only replaced
+  // once the new one is complete. The compressed columns of the blocks are
+  // followed by the metadata, the offset of which is stored at the beginning
+  // of the file.
+  auto filename = getFilename(indexBasename, name_);
+  auto tmpFilename = absl::StrCat(filename, ".tmp");
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{tmpFilename};
+    serializer << FORMAT_VERSION;
+    uint64_t metadataOffset = 0;
+    serializer << metadataOffset;
+    auto blocks = blocks_;
+    std::vector<Id> column;
+    for (auto& block : blocks) {
+      for (size_t col = 0; col < numColumns(); ++col) {
+        auto source =
+            table_->getColumn(col).subspan(block.beginRow_, block.numRows_);
+        column.resize(source.size());
+        ql::ranges::transform(source, column.begin(), toFileId);
+        auto compressed =
+            ZstdWrapper::compress(column.data(), column.size() * sizeof(Id));
+        block.offsets_.push_back(serializer.getSerializationPosition());
+        block.compressedSizes_.push_back(compressed.size());
+        serializer.serializeBytes(compressed.data(), compressed.size());
+      }
+      ql::ranges::transform(block.firstRow_, block.firstRow_.begin(),
+                            toFileId);
+      ql::ranges::transform(block.lastRow_, block.lastRow_.begin(), toFileId);
+    }
+    metadataOffset = serializer.getSerializationPosition();
+    serializer << std::string{buildId};
+    serializer << name_;
+    serializer << query_;
+    serializer << version_;
+    serializer << variableNames;
+    serializer << words;
+    serializer << blocks;
+    serializer.setSerializationPosition(sizeof(FORMAT_VERSION));
+    serializer << metadataOffset;
+    serializer.close();
+  }
+  fs::rename(tmpFilename, filename);
+  return filename;
+}
+
+// _____________________________________________________________________________
+MaterializedView MaterializedView::readFromDisk(const std::string& filename,
+                                                std::string_view buildId) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  uint64_t formatVersion;
+  serializer >> formatVersion;
+  if (formatVersion != FORMAT_VERSION) {
+    throw std::runtime_error(absl::StrCat(
+        "The materialized view in \"", filename, "\" has format version ",
+        formatVersion, ", but version ", FORMAT_VERSION, " is required"));
+  }
+  uint64_t metadataOffset;
+  serializer >> metadataOffset;
+  serializer.setSerializationPosition(metadataOffset);
+  std::string storedBuildId;
+  serializer >> storedBuildId;
+  if (storedBuildId != buildId) {
+    throw std::runtime_error(
+        absl::StrCat("The materialized view in \"", filename,
+                     "\" belongs to a different build of the index"));
+  }
+  std::string name;
+  std::string query;
+  uint64_t version;
+  std::vector<std::string> variableNames;
+  std::vector<std::string> words;
+  serializer >> name;
+  serializer >> query;
+  serializer >> version;
+  serializer >> variableNames;
+  serializer >> words;
+
+  std::vector<Variable> variables;
+  for (auto& variableName : variableNames) {
+    variables.emplace_back(std::move(variableName));
+  }
+  MaterializedView view{std::move(name), std::move(query),
+                        std::move(variables), LocalVocab{}, version};
+  view.localVocabIds_.reserve(words.size());
+  for (auto& word : words) {
+    view.localVocabIds_.push_back(Id::makeFromLocalVocabIndex(
+        view.localVocab_.getIndexAndAddIfNotContained(
+            LiteralOrIri::fromStringRepresentation(std::move(word)))));
+  }
+  serializer >> view.blocks_;
+  for (auto& block : view.blocks_) {
+    AD_CORRECTNESS_CHECK(block.offsets_.size() == view.numColumns());
+    view.replaceLocalVocabPositions(block.firstRow_);
+    view.replaceLocalVocabPositions(block.lastRow_);
+  }
+  view.file_ = std::move(serializer).file();
+  return view;
+}
+
+// _____________________________________________________________________________
+void MaterializedView::replaceLocalVocabPositions(ql::span<Id> ids) const {
+  if (localVocabIds_.empty()) {
+    return;
+  }
+  for (Id& id : ids) {
+    if (id.getDatatype() == Datatype::LocalVocabIndex) {
+      id = localVocabIds_.at(getLocalVocabPosition(id));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+IdTable MaterializedView::readBlock(
+    size_t blockIndex,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) const {
+  const auto& block = blocks_.at(blockIndex);
+  IdTable result{numColumns(), allocator};
+  result.resize(block.numRows_);
+  for (size_t col = 0; col < numColumns(); ++col) {
+    auto target = result.getColumn(col);
+    if (table_.has_value()) {
+      ql::ranges::copy(
+          table_->getColumn(col).subspan(block.beginRow_, block.numRows_),
+          target.begin());
+      continue;
+    }
+    std::vector<char> compressed(block.compressedSizes_.at(col));
+    auto numBytesRead = file_.read(compressed.data(), compressed.size(),
+                                   static_cast<off_t>(block.offsets_.at(col)));
+    AD_CORRECTNESS_CHECK(numBytesRead ==
+                         static_cast<ssize_t>(compressed.size()));
+    auto numBytes = ZstdWrapper::decompressToBuffer(
+        compressed.data(), compressed.size(), target.data(),
+        target.size() * sizeof(Id));
+    AD_CORRECTNESS_CHECK(numBytes == target.size() * sizeof(Id));
+    replaceLocalVocabPositions(target);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void MaterializedViews::loadFromDisk(const std::string& indexBasename,
+                                     std::string_view buildId) {
+  fs::path basename{indexBasename};
+  auto directory =
+      basename.has_parent_path() ? basename.parent_path() : fs::path{"."};
+  auto prefix = absl::StrCat(basename.filename().string(), viewFileInfix);
+  for (const auto& entry : fs::directory_iterator{directory}) {
+    auto filename = entry.path().filename().string();
+    if (!entry.is_regular_file() || !filename.starts_with(prefix) ||
+        filename.ends_with(".tmp")) {
+      continue;
+    }
+    try {
+      auto view = std::make_shared<const MaterializedView>(
+          MaterializedView::readFromDisk(entry.path().string(), buildId));
+      LOG(INFO) << "Loaded the materialized view \"" << view->name()
+                << "\" with " << view->numRows() << " rows in "
+                << view->blocks().size() << " blocks" << std::endl;
+      add(std::move(view));
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not load the materialized view from \""
+                << entry.path().string() << "\": " << e.what() << std::endl;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void MaterializedViews::add(std::shared_ptr<const MaterializedView> view) {
+  auto name = view->name();
+  (*views_.wlock())[std::move(name)] = std::move(view);
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const MaterializedView> MaterializedViews::get(
+    const std::string& name) const {
+  auto views = views_.rlock();
+  auto it = views->find(name);
+  if (it == views->end()) {
+    throw std::runtime_error(
+        absl::StrCat("There is no materialized view with the name \"", name,
+                     "\""));
+  }
+  return it->second;
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> MaterializedViews::getNames() const {
+  auto views = views_.rlock();
+  std::vector<std::string> names;
+  for (const auto& [name, view] : *views) {
+    names.push_back(name);
+  }
+  return names;
+}
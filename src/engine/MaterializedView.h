@@ -0,0 +1,167 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_MATERIALIZEDVIEW_H
+#define QLEVER_SRC_ENGINE_MATERIALIZEDVIEW_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "engine/LocalVocab.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/idTable/IdTable.h"
+#include "rdfTypes/Variable.h"
+#include "util/CancellationHandle.h"
+#include "util/File.h"
+#include "util/HashMap.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Synchronized.h"
+
+// A materialized view is the result of a named SPARQL `SELECT` query that is
+// computed once and then stored in a file next to the index, s.t. expensive
+// subqueries that are used over and over again (e.g. labels, type hierarchies,
+// or counts per class) don't have to be recomputed and don't compete for space
+// in the `QueryResultCache`. The views are registered at the start of the
+// server and can be scanned via `SERVICE` (see `MaterializedViewQuery` and
+// `MaterializedViewScan`).
+//
+// The rows of a view are sorted lexicographically by all columns (in the order
+// of the selected variables), s.t. a scan with constants for a prefix of the
+// columns only has to read the blocks that can contain these constants. The
+// rows are stored in blocks of compressed columns. Only the metadata of the
+// blocks (see `BlockMetadata`) is kept in memory, the blocks are read and
+// decompressed by the scans that need them, with the allocator of the query.
+// A view reflects the state of the index at the time at which it was written,
+// it is not changed by SPARQL updates. Writing a view with the same name again
+// replaces it.
+class MaterializedView {
+ public:
+  // Increase this whenever the format of the files changes. Files with a
+  // different version can't be loaded.
+  static constexpr uint64_t FORMAT_VERSION = 2;
+  // The default number of rows per block.
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 100'000;
+
+  // The metadata of a block of rows of a view.
+  struct BlockMetadata {
+    // The index of the first row of the block in the view and the number of
+    // rows of the block.
+    uint64_t beginRow_ = 0;
+    uint64_t numRows_ = 0;
+    // The first and the last row of the block.
+    std::vector<Id> firstRow_;
+    std::vector<Id> lastRow_;
+    // For each column the offset and the size of the compressed column in
+    // the file (empty for a view that is not stored in a file), and whether
+    // the column contains an undefined value.
+    std::vector<uint64_t> offsets_;
+    std::vector<uint64_t> compressedSizes_;
+    std::vector<uint8_t> containsUndef_;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(BlockMetadata) {
+      serializer | arg.beginRow_;
+      serializer | arg.numRows_;
+      serializer | arg.firstRow_;
+      serializer | arg.lastRow_;
+      serializer | arg.offsets_;
+      serializer | arg.compressedSizes_;
+      serializer | arg.containsUndef_;
+    }
+  };
+
+ private:
+  std::string name_;
+  std::string query_;
+  // The selected variables of the query, one for each column.
+  std::vector<Variable> variables_;
+  std::vector<BlockMetadata> blocks_;
+  // The rows of a view that was just computed, or the file from which the
+  // blocks of a view that was read by `readFromDisk` are read.
+  std::optional<IdTable> table_;
+  ad_utility::File file_;
+  // The words of the local vocab, `localVocabIds_[i]` is the `Id` of the
+  // `i`-th word of the file.
+  LocalVocab localVocab_;
+  std::vector<Id> localVocabIds_;
+  // Changes whenever the view is (re)written, part of the cache keys of the
+  // scans.
+  uint64_t version_;
+
+  MaterializedView(std::string name, std::string query,
+                   std::vector<Variable> variables, LocalVocab localVocab,
+                   uint64_t version);
+
+  // Replace the `Id`s that refer to the position of a word in the file by the
+  // `Id`s of the words in the `localVocab_`.
+  void replaceLocalVocabPositions(ql::span<Id> ids) const;
+
+ public:
+  // Compute the view with the given `name` for the SPARQL `query`, which must
+  // be a `SELECT` query. The rows of the result are kept in memory until the
+  // view is written.
+  static MaterializedView compute(std::string name, std::string query,
+                                  QueryExecutionContext* qec,
+                                  ad_utility::SharedCancellationHandle handle,
+                                  size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+  // The name of the file in which the view with the given `name` is stored.
+  static std::string getFilename(std::string_view indexBasename,
+                                 std::string_view name);
+
+  // Write the view to the file for the index with the given basename and
+  // return the name of the file. The `buildId` (see `Index::getBuildId`) is
+  // stored s.t. the view can't be loaded for a different build of the index,
+  // the `Id`s of which are incompatible. Throw if the view was not computed
+  // by `compute`.
+  std::string writeToDisk(std::string_view indexBasename,
+                          std::string_view buildId) const;
+
+  // Read the metadata of a view from the given file, throw if the file is
+  // invalid or belongs to a different build of the index. The blocks are
+  // only read by `readBlock`.
+  static MaterializedView readFromDisk(const std::string& filename,
+                                      std::string_view buildId);
+
+  const std::string& name() const { return name_; }
+  const std::string& query() const { return query_; }
+  const std::vector<Variable>& variables() const { return variables_; }
+  const std::vector<BlockMetadata>& blocks() const { return blocks_; }
+  const LocalVocab& localVocab() const { return localVocab_; }
+  uint64_t version() const { return version_; }
+  size_t numColumns() const { return variables_.size(); }
+  size_t numRows() const;
+
+  // Read the block with the given index, the memory is allocated with the
+  // `allocator`.
+  IdTable readBlock(size_t blockIndex,
+                    const ad_utility::AllocatorWithLimit<Id>& allocator) const;
+
+  // Return the index of the column for the variable with the given `name`
+  // (without the leading `?`), throw if there is no such column.
+  size_t getColumnIndex(std::string_view name) const;
+};
+
+// The materialized views of an index, identified by their names.
+class MaterializedViews {
+  ad_utility::Synchronized<
+      ad_utility::HashMap<std::string, std::shared_ptr<const MaterializedView>>>
+      views_;
+
+ public:
+  // Load (the metadata of) all the views that are stored for the index with
+  // the given basename and `buildId`. Views that can't be loaded are skipped
+  // with a warning.
+  void loadFromDisk(const std::string& indexBasename, std::string_view buildId);
+
+  // Add the `view`, replace the view with the same name if it exists.
+  void add(std::shared_ptr<const MaterializedView> view);
+
+  // Return the view with the given `name`, throw if there is no such view.
+  std::shared_ptr<const MaterializedView> get(const std::string& name) const;
+
+  // The names of all views (in no particular order).
+  std::vector<std::string> getNames() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEW_H
@@ -0,0 +1,222 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/MaterializedViewScan.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+// _____________________________________________________________________________
+MaterializedViewScan::MaterializedViewScan(
+    QueryExecutionContext* qec, std::shared_ptr<const MaterializedView> view,
+    Columns columns)
+    : Operation{qec}, view_{std::move(view)}, columns_{std::move(columns)} {
+  AD_CONTRACT_CHECK(view_ != nullptr);
+  std::vector<std::optional<TripleComponent>> boundTo(view_->numColumns());
+  for (const auto& [name, value] : columns_) {
+    auto& entry = boundTo.at(view_->getColumnIndex(name));
+    AD_CONTRACT_CHECK(!entry.has_value());
+    entry = value;
+  }
+
+  for (size_t col = 0; col < boundTo.size(); ++col) {
+    if (!boundTo[col].has_value()) {
+      continue;
+    }
+    if (boundTo[col]->isVariable()) {
+      const auto& variable = boundTo[col]->getVariable();
+      if (ql::ranges::any_of(resultColumns_, [&variable](const auto& entry) {
+            return entry.second == variable;
+          })) {
+        throw std::runtime_error(absl::StrCat(
+            "The variable ", variable.name(),
+            " must only be bound to one column of a materialized view"));
+      }
+      resultColumns_.emplace_back(col, variable);
+    } else {
+      constants_.emplace_back(
+          col, TripleComponent{boundTo[col].value()}.toValueId(
+                   qec->getIndex().getVocab(), constantsLocalVocab_));
+    }
+  }
+
+  // The constants for the leading columns of the view determine a contiguous
+  // range of rows, and therefore of blocks.
+  std::vector<Id> prefix;
+  while (numPrefixConstants_ < constants_.size() &&
+         constants_[numPrefixConstants_].first == numPrefixConstants_) {
+    prefix.push_back(constants_[numPrefixConstants_].second);
+    ++numPrefixConstants_;
+  }
+  auto prefixOfRowIsLess = [&prefix](const std::vector<Id>& row) {
+    return std::lexicographical_compare(
+        row.begin(), row.begin() + prefix.size(), prefix.begin(), prefix.end());
+  };
+  auto prefixIsLessThanRow = [&prefix](const std::vector<Id>& row) {
+    return std::lexicographical_compare(prefix.begin(), prefix.end(),
+                                        row.begin(),
+                                        row.begin() + prefix.size());
+  };
+  const auto& blocks = view_->blocks();
+  auto begin = std::partition_point(
+      blocks.begin(), blocks.end(),
+      [&](const auto& block) { return prefixOfRowIsLess(block.lastRow_); });
+  auto end = std::partition_point(
+      blocks.begin(), blocks.end(),
+      [&](const auto& block) { return !prefixIsLessThanRow(block.firstRow_); });
+  beginBlock_ = static_cast<size_t>(begin - blocks.begin());
+  endBlock_ = std::max(beginBlock_, static_cast<size_t>(end - blocks.begin()));
+}
+
+// _____________________________________________________________________________
+std::string MaterializedViewScan::getDescriptor() const {
+  return absl::StrCat("Materialized view ", view_->name());
+}
+
+// _____________________________________________________________________________
+std::string MaterializedViewScan::getCacheKeyImpl() const {
+  // The variables are not part of the key, only the positions of the bound
+  // columns.
+  std::vector<std::string> columns(view_->numColumns(), "_");
+  for (size_t i = 0; i < resultColumns_.size(); ++i) {
+    columns.at(resultColumns_[i].first) = absl::StrCat("col", i);
+  }
+  for (const auto& [name, value] : columns_) {
+    if (!value.isVariable()) {
+      columns.at(view_->getColumnIndex(name)) =
+          absl::StrCat("=", value.toString());
+    }
+  }
+  return absl::StrCat("MATERIALIZED VIEW ", view_->name(), " version ",
+                      view_->version(), " (", absl::StrJoin(columns, " "),
+                      ")");
+}
+
+// _____________________________________________________________________________
+uint64_t MaterializedViewScan::getSizeEstimateBeforeLimit() {
+  // All the rows of the blocks that can contain matching rows.
+  const auto& blocks = view_->blocks();
+  uint64_t numRows = 0;
+  for (size_t i = beginBlock_; i < endBlock_; ++i) {
+    numRows += blocks[i].numRows_;
+  }
+  return numRows;
+}
+
+// _____________________________________________________________________________
+size_t MaterializedViewScan::getCostEstimate() {
+  return getSizeEstimateBeforeLimit();
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> MaterializedViewScan::resultSortedOn() const {
+  // The rows of the view are sorted by all columns. Columns that are bound to
+  // a constant don't change this, but the result is only sorted up to the
+  // first column of the view that is dropped.
+  std::vector<ColumnIndex> sortedOn;
+  size_t nextResultColumn = 0;
+  for (size_t col = 0; col < view_->numColumns(); ++col) {
+    if (nextResultColumn < resultColumns_.size() &&
+        resultColumns_[nextResultColumn].first == col) {
+      sortedOn.push_back(nextResultColumn++);
+    } else if (!ql::ranges::any_of(constants_, [col](const auto& constant) {
+                 return constant.first == col;
+               })) {
+      break;
+    }
+  }
+  return sortedOn;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap MaterializedViewScan::computeVariableToColumnMap() const {
+  VariableToColumnMap map;
+  for (size_t i = 0; i < resultColumns_.size(); ++i) {
+    const auto& [col, variable] = resultColumns_[i];
+    const auto& blocks = view_->blocks();
+    bool containsUndef = std::any_of(
+        blocks.begin() + beginBlock_, blocks.begin() + endBlock_,
+        [col](const auto& block) { return block.containsUndef_.at(col) != 0; });
+    map[variable] = containsUndef ? makePossiblyUndefinedColumn(i)
+                                  : makeAlwaysDefinedColumn(i);
+  }
+  return map;
+}
+
+// _____________________________________________________________________________
+bool MaterializedViewScan::rowMatchesConstants(const IdTable& block,
+                                               size_t row) const {
+  return ql::ranges::all_of(
+      constants_ | ql::views::drop(numPrefixConstants_),
+      [&block, row](const auto& constant) {
+        return block(row, constant.first) == constant.second;
+      });
+}
+
+// _____________________________________________________________________________
+IdTable MaterializedViewScan::readAndFilterBlock(size_t blockIndex) const {
+  IdTable block = view_->readBlock(blockIndex, allocator());
+  size_t beginRow = 0;
+  size_t endRow = block.numRows();
+  for (size_t i = 0; i < numPrefixConstants_; ++i) {
+    auto [col, id] = constants_[i];
+    auto column = block.getColumn(col);
+    auto [begin, end] = std::equal_range(column.begin() + beginRow,
+                                         column.begin() + endRow, id);
+    beginRow = static_cast<size_t>(begin - column.begin());
+    endRow = static_cast<size_t>(end - column.begin());
+  }
+
+  IdTable result{getResultWidth(), allocator()};
+  if (numPrefixConstants_ == constants_.size()) {
+    result.resize(endRow - beginRow);
+    for (size_t i = 0; i < resultColumns_.size(); ++i) {
+      auto column = block.getColumn(resultColumns_[i].first)
+                        .subspan(beginRow, endRow - beginRow);
+      ql::ranges::copy(column, result.getColumn(i).begin());
+    }
+    return result;
+  }
+  std::vector<size_t> matchingRows;
+  for (size_t row = beginRow; row < endRow; ++row) {
+    if (rowMatchesConstants(block, row)) {
+      matchingRows.push_back(row);
+    }
+  }
+  result.resize(matchingRows.size());
+  for (size_t i = 0; i < resultColumns_.size(); ++i) {
+    auto column = block.getColumn(resultColumns_[i].first);
+    ql::ranges::transform(matchingRows, result.getColumn(i).begin(),
+                          [&column](size_t row) { return column[row]; });
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+Result::Generator MaterializedViewScan::readBlocksLazily() const {
+  for (size_t i = beginBlock_; i < endBlock_; ++i) {
+    auto result = readAndFilterBlock(i);
+    checkCancellation();
+    if (!result.empty()) {
+      co_yield {std::move(result), view_->localVocab().clone()};
+    }
+  }
+}
+
+// _____________________________________________________________________________
+Result MaterializedViewScan::computeResult(bool requestLaziness) {
+  if (requestLaziness) {
+    return {readBlocksLazily(), resultSortedOn()};
+  }
+  IdTable result{getResultWidth(), allocator()};
+  for (size_t i = beginBlock_; i < endBlock_; ++i) {
+    result.insertAtEnd(readAndFilterBlock(i));
+    checkCancellation();
+  }
+  return {std::move(result), resultSortedOn(), view_->localVocab().clone()};
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> MaterializedViewScan::cloneImpl() const {
+  return std::make_unique<MaterializedViewScan>(_executionContext, view_,
+                                                columns_);
+}
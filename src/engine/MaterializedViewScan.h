@@ -0,0 +1,80 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSCAN_H
+#define QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSCAN_H
+
+#include "engine/MaterializedView.h"
+#include "engine/Operation.h"
+#include "parser/TripleComponent.h"
+
+// Scan of a `MaterializedView`. Each column of the view is either bound to a
+// variable (then it becomes a column of the result), or to a constant (then
+// only the rows with this value are part of the result), or not used at all.
+// Constants for a prefix of the columns of the view restrict the scan to the
+// blocks of the view that can contain them (via the first and last rows of the
+// blocks), and are looked up via binary search in these blocks, because the
+// view is sorted by all its columns. Only these blocks are read.
+class MaterializedViewScan : public Operation {
+ public:
+  // The columns of the view (by the name of the variable in the query of the
+  // view, without the leading `?`) and the variable or constant they are
+  // bound to, see `parsedQuery::MaterializedViewQuery`.
+  using Columns = std::vector<std::pair<std::string, TripleComponent>>;
+
+ private:
+  std::shared_ptr<const MaterializedView> view_;
+  Columns columns_;
+
+  // For each result column the corresponding column of the view and the
+  // variable, in the order of the columns of the view.
+  std::vector<std::pair<ColumnIndex, Variable>> resultColumns_;
+  // The columns of the view that are bound to a constant, together with the
+  // `Id` of the constant.
+  std::vector<std::pair<ColumnIndex, Id>> constants_;
+  // Holds the constants that are not contained in the vocabulary.
+  LocalVocab constantsLocalVocab_;
+  // The number of leading columns of the view that are bound to a constant,
+  // and the range of blocks of the view that can contain rows that match these
+  // constants.
+  size_t numPrefixConstants_ = 0;
+  size_t beginBlock_ = 0;
+  size_t endBlock_ = 0;
+
+ public:
+  MaterializedViewScan(QueryExecutionContext* qec,
+                       std::shared_ptr<const MaterializedView> view,
+                       Columns columns);
+
+  std::vector<QueryExecutionTree*> getChildren() override { return {}; }
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override { return resultColumns_.size(); }
+  size_t getCostEstimate() override;
+  float getMultiplicity(size_t) override { return 1; }
+  bool knownEmptyResult() override { return beginBlock_ == endBlock_; }
+
+  // A view is not changed by updates, see `MaterializedView`.
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
+ private:
+  std::string getCacheKeyImpl() const override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  std::vector<ColumnIndex> resultSortedOn() const override;
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Read the block of the view with the given index and return the result
+  // columns of its rows that match all the constants.
+  IdTable readAndFilterBlock(size_t blockIndex) const;
+
+  // Yield the result of `readAndFilterBlock` for one block after the other.
+  Result::Generator readBlocksLazily() const;
+
+  // Return true iff the given row of the `block` matches all the constants
+  // that are not part of the prefix.
+  bool rowMatchesConstants(const IdTable& block, size_t row) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSCAN_H
@@ -45,6 +45,8 @@ Result Minus::computeResult([[maybe_unused]] bool requestLaziness) {
   IdTable idTable{getExecutionContext()->getAllocator()};
   idTable.setNumColumns(getResultWidth());
 
+  computeChildrenInParallel({_left, _right},
+                            ComputationMode::FULLY_MATERIALIZED);
   const auto leftResult = _left->getResult();
   const auto rightResult = _right->getResult();
 
@@ -49,6 +49,10 @@ class Minus : public Operation {
  public:
   size_t getCostEstimate() override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {_left.get(), _right.get()};
   }
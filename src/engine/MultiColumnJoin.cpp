@@ -72,6 +72,8 @@ Result MultiColumnJoin::computeResult([[maybe_unused]] bool requestLaziness) {
 
   AD_CONTRACT_CHECK(idTable.numColumns() >= _joinColumns.size());
 
+  computeChildrenInParallel({_left, _right},
+                            ComputationMode::FULLY_MATERIALIZED);
   const auto leftResult = _left->getResult();
   const auto rightResult = _right->getResult();
 
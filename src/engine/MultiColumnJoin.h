@@ -51,6 +51,11 @@ class MultiColumnJoin : public Operation {
  public:
   size_t getCostEstimate() override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+  bool isTransparentForRuntimeFilters() const override { return true; }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {_left.get(), _right.get()};
   }
@@ -13,6 +13,9 @@ class NeutralElementOperation : public Operation {
  public:
   explicit NeutralElementOperation(QueryExecutionContext* qec)
       : Operation{qec} {}
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
   std::vector<QueryExecutionTree*> getChildren() override { return {}; }
 
  private:
@@ -7,6 +7,12 @@
 #include <absl/cleanup/cleanup.h>
 #include <absl/container/inlined_vector.h>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/static_thread_pool.hpp>
+#include <future>
+#include <mutex>
+#include <numeric>
+
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
@@ -140,6 +146,25 @@ Result Operation::runComputation(const ad_utility::Timer& timer,
   checkCancellation();
   runtimeInfo().status_ = RuntimeInformation::Status::inProgress;
   signalQueryUpdate();
+  // If the result can be derived from the cached result of a more general
+  // subtree, there is no need to compute it. Note: The derived result already
+  // respects the `LIMIT` and `OFFSET` of this operation. The children of this
+  // operation are not computed in this case, so the children of the runtime
+  // information are those of the cached result.
+  if (canResultBeCached() &&
+      RuntimeParameters().get<"cache-derive-from-general-results">()) {
+    auto derived =
+        _executionContext->deriveResultFromCache(getSubsumingSubtrees());
+    if (derived.has_value()) {
+      const IdTable& idTable = derived->result_.idTable();
+      AD_CORRECTNESS_CHECK(idTable.numColumns() == getResultWidth());
+      runtimeInfo().addDetail("derived-from-cached-result", true);
+      updateRuntimeInformationOnSuccess(
+          idTable.size(), ad_utility::CacheStatus::computed, timer.msecs(),
+          std::move(derived->runtimeInfoOfCachedResult_));
+      return std::move(derived->result_);
+    }
+  }
   Result result =
       computeResult(computationMode == ComputationMode::LAZY_IF_SUPPORTED);
   AD_CONTRACT_CHECK(computationMode == ComputationMode::LAZY_IF_SUPPORTED ||
@@ -246,6 +271,9 @@ CacheValue Operation::runComputationAndPrepareForCache(
     const QueryCacheKey& cacheKey, bool pinned, bool isRoot) {
   auto& cache = _executionContext->getQueryTreeCache();
   auto result = runComputation(timer, computationMode);
+  if (canResultBeCached() && !limitOffset_.isUnconstrained()) {
+    _executionContext->registerCachedLimit(getCacheKeyImpl(), limitOffset_);
+  }
   auto maxSize =
       isRoot ? cache.getMaxSizeSingleEntry()
              : std::min(RuntimeParameters().get<"cache-max-size-lazy-result">(),
@@ -268,10 +296,12 @@ CacheValue Operation::runComputationAndPrepareForCache(
          cacheKey](Result aggregatedResult) {
           auto copy = *runtimeInfo;
           copy.status_ = RuntimeInformation::Status::fullyMaterialized;
-          cache.tryInsertIfNotPresent(
-              false, cacheKey,
-              std::make_shared<CacheValue>(std::move(aggregatedResult),
-                                           std::move(copy)));
+          auto value = std::make_shared<CacheValue>(std::move(aggregatedResult),
+                                                    std::move(copy));
+          if (RuntimeParameters().get<"cache-compress-results">()) {
+            value->compress();
+          }
+          cache.tryInsertIfNotPresent(false, cacheKey, std::move(value));
         });
   }
   if (result.isFullyMaterialized()) {
@@ -288,9 +318,9 @@ CacheValue Operation::runComputationAndPrepareForCache(
 std::shared_ptr<const Result> Operation::getResult(
     bool isRoot, ComputationMode computationMode) {
   // Use the precomputed Result if it exists.
-  if (precomputedResultBecauseSiblingOfService_.has_value()) {
-    auto result = std::move(precomputedResultBecauseSiblingOfService_).value();
-    precomputedResultBecauseSiblingOfService_.reset();
+  if (precomputedResult_.has_value()) {
+    auto result = std::move(precomputedResult_).value();
+    precomputedResult_.reset();
     return result;
   }
 
@@ -329,19 +359,43 @@ std::shared_ptr<const Result> Operation::getResult(
                 updateRuntimeInformationOnFailure(timer.msecs());
               }
             });
+    // If the result is computed by this call and then compressed for the
+    // cache, the uncompressed result is stored here, s.t. it doesn't have to
+    // be decompressed again.
+    std::shared_ptr<const Result> computedResult;
     auto cacheSetup = [this, &timer, computationMode, &cacheKey, pinResult,
-                       isRoot]() {
-      return runComputationAndPrepareForCache(timer, computationMode, cacheKey,
-                                              pinResult, isRoot);
+                       isRoot, &computedResult]() {
+      auto value = runComputationAndPrepareForCache(
+          timer, computationMode, cacheKey, pinResult, isRoot);
+      if (canResultBeCached() &&
+          RuntimeParameters().get<"cache-compress-results">()) {
+        auto uncompressed = value.resultTablePtr();
+        if (value.compress()) {
+          computedResult = std::move(uncompressed);
+        }
+      }
+      return value;
     };
 
     auto suitedForCache = [](const CacheValue& cacheValue) {
-      return cacheValue.resultTable().isFullyMaterialized();
+      return cacheValue.isFullyMaterialized();
     };
 
     bool onlyReadFromCache = computationMode == ComputationMode::ONLY_IF_CACHED;
 
     auto result = [&]() {
+      // After an update, the result might still be contained in the cache
+      // for an earlier snapshot.
+      if (cacheKey.locatedTriplesSnapshotIndex_ > 0 &&
+          !cache.cacheContains(cacheKey)) {
+        if (auto indexRanges = getIndexRanges(); indexRanges.has_value()) {
+          auto earlierResult = _executionContext->getResultFromEarlierSnapshot(
+              cacheKey.key_, indexRanges.value(), pinResult);
+          if (earlierResult.has_value()) {
+            return std::move(earlierResult).value();
+          }
+        }
+      }
       auto compute = [&](auto&&... args) {
         if (!canResultBeCached()) {
           return cache.computeButDontStore(AD_FWD(args)...);
@@ -357,10 +411,9 @@ std::shared_ptr<const Result> Operation::getResult(
       return nullptr;
     }
 
-    if (result._resultPointer->resultTable().isFullyMaterialized()) {
+    if (result._resultPointer->isFullyMaterialized()) {
       AD_CORRECTNESS_CHECK(
-          result._resultPointer->resultTable().idTable().numColumns() ==
-              getResultWidth(),
+          result._resultPointer->numColumns() == getResultWidth(),
           result._cacheStatus == ad_utility::CacheStatus::computed
               ? "This should never happen, non-matching result widths should "
                 "have been caught earlier"
@@ -370,7 +423,12 @@ std::shared_ptr<const Result> Operation::getResult(
       updateRuntimeInformationOnSuccess(result, timer.msecs());
     }
 
-    return result._resultPointer->resultTablePtr();
+    if (computedResult != nullptr) {
+      return computedResult;
+    }
+    // Compressed results are decompressed lazily if the caller supports it.
+    return result._resultPointer->resultTablePtr(
+        computationMode == ComputationMode::LAZY_IF_SUPPORTED);
   } catch (ad_utility::CancellationException& e) {
     e.setOperation(getDescriptor());
     runtimeInfo().status_ = RuntimeInformation::Status::cancelled;
@@ -415,6 +473,170 @@ std::chrono::milliseconds Operation::remainingTime() const {
       0ms, std::chrono::duration_cast<std::chrono::milliseconds>(interval));
 }
 
+namespace {
+// The number of additional threads that are currently used by
+// `computeChildrenInParallel` (for all queries together).
+std::atomic<size_t> numThreadsForParallelSubtrees = 0;
+
+// The thread pool on which `computeChildrenInParallel` runs the additional
+// computations (see also `Operation::runOnSharedThreadPool`). It is shared by
+// all queries and created on first use.
+boost::asio::static_thread_pool& threadPoolForParallelSubtrees() {
+  static boost::asio::static_thread_pool pool{
+      std::max(1u, std::thread::hardware_concurrency())};
+  return pool;
+}
+
+// Try to reserve one of the `parallel-subtrees-max-threads` threads. The
+// number of reserved threads never exceeds the size of the thread pool,
+// otherwise a computation that waits for its (nested) parallel children could
+// wait for a task that never gets a thread.
+bool tryReserveThreadForParallelSubtree() {
+  size_t maxThreads = std::min<size_t>(
+      RuntimeParameters().get<"parallel-subtrees-max-threads">(),
+      std::max(1u, std::thread::hardware_concurrency()));
+  size_t current = numThreadsForParallelSubtrees.load();
+  while (current < maxThreads) {
+    if (numThreadsForParallelSubtrees.compare_exchange_weak(current,
+                                                            current + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// True while the current thread computes a subtree concurrently to other
+// subtrees of the same query. The websocket updates serialize the
+// `RuntimeInformation` of the complete query, which is not safe while other
+// threads modify parts of it, so they are suspended in this case.
+thread_local bool isInsideParallelSubtree = false;
+}  // namespace
+
+// _____________________________________________________________________________
+void Operation::runOnSharedThreadPool(std::function<void()> task) {
+  boost::asio::post(threadPoolForParallelSubtrees(), std::move(task));
+}
+
+// _____________________________________________________________________________
+std::optional<IndexRanges> Operation::getIndexRanges() { return std::nullopt; }
+
+// _____________________________________________________________________________
+std::optional<IndexRanges> Operation::getIndexRangesOfChildren() {
+  IndexRanges result;
+  for (auto* child : getChildren()) {
+    auto childRanges = child->getRootOperation()->getIndexRanges();
+    if (!childRanges.has_value()) {
+      return std::nullopt;
+    }
+    result.add(childRanges.value());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+bool Operation::pushDownRuntimeFilter(
+    const Variable& variable,
+    const std::shared_ptr<const RuntimeFilter>& filter) {
+  const auto& columns = getExternallyVisibleVariableColumns();
+  auto it = columns.find(variable);
+  if (it == columns.end() ||
+      it->second.mightContainUndef_ != ColumnIndexAndTypeInfo::AlwaysDefined ||
+      !limitOffset_.isUnconstrained()) {
+    return false;
+  }
+  bool isApplied = applyRuntimeFilter(it->second.columnIndex_, filter);
+  if (isTransparentForRuntimeFilters()) {
+    for (auto* child : getChildren()) {
+      isApplied |=
+          child->getRootOperation()->pushDownRuntimeFilter(variable, filter);
+    }
+  }
+  if (isApplied) {
+    disableStoringInCache();
+  }
+  return isApplied;
+}
+
+// _____________________________________________________________________________
+void Operation::computeChildrenInParallel(
+    const std::vector<std::shared_ptr<QueryExecutionTree>>& children,
+    ComputationMode computationMode) {
+  AD_CONTRACT_CHECK(computationMode != ComputationMode::ONLY_IF_CACHED);
+  if (children.size() < 2 ||
+      RuntimeParameters().get<"parallel-subtrees-max-threads">() == 0) {
+    return;
+  }
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  // If one of the children fails, the query as a whole fails, so the
+  // computations of the siblings are cancelled via the (shared) cancellation
+  // handle of the query. Only the first exception is rethrown, the siblings
+  // typically fail with a `CancellationException` as a consequence.
+  std::exception_ptr firstException;
+  std::mutex firstExceptionMutex;
+  auto computeChild = [this, computationMode, &firstException,
+                       &firstExceptionMutex](Operation& child) {
+    try {
+      child.precomputedResult() = child.getResult(false, computationMode);
+    } catch (...) {
+      std::lock_guard lock{firstExceptionMutex};
+      if (!firstException) {
+        firstException = std::current_exception();
+        cancellationHandle_->cancel(ad_utility::CancellationState::MANUAL);
+      }
+    }
+  };
+
+  // The computations on the threads of the thread pool. All of them are
+  // waited for before this function returns, also if one of them (or the
+  // computation on this thread) fails.
+  std::vector<std::future<void>> futures;
+  size_t numParallelChildren = 1;
+  for (const auto& child : children | ql::views::drop(1)) {
+    if (!tryReserveThreadForParallelSubtree()) {
+      break;
+    }
+    ++numParallelChildren;
+    std::packaged_task<void()> task{
+        [child = child->getRootOperation(), &computeChild] {
+          absl::Cleanup release{[]() { --numThreadsForParallelSubtrees; }};
+          isInsideParallelSubtree = true;
+          absl::Cleanup reset{[]() { isInsideParallelSubtree = false; }};
+          computeChild(*child);
+        }};
+    futures.push_back(task.get_future());
+    boost::asio::post(threadPoolForParallelSubtrees(), std::move(task));
+  }
+  {
+    bool wasInsideParallelSubtree = std::exchange(
+        isInsideParallelSubtree, isInsideParallelSubtree || !futures.empty());
+    absl::Cleanup restore{[wasInsideParallelSubtree]() {
+      isInsideParallelSubtree = wasInsideParallelSubtree;
+    }};
+    computeChild(*children.front()->getRootOperation());
+    for (auto& future : futures) {
+      future.wait();
+    }
+  }
+  if (firstException) {
+    std::rethrow_exception(firstException);
+  }
+
+  // Show the overlap of the computations.
+  auto sumOfChildTimes = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::transform_reduce(
+          children.begin(), children.begin() + numParallelChildren,
+          std::chrono::microseconds::zero(), std::plus<>{},
+          [](const auto& child) {
+            return child->getRootOperation()->runtimeInfo().totalTime_;
+          }));
+  runtimeInfo().addDetail("num-children-computed-in-parallel",
+                          numParallelChildren);
+  runtimeInfo().addDetail("time-for-parallel-children", timer.msecs());
+  runtimeInfo().addDetail("sum-of-times-of-parallel-children",
+                          sumOfChildTimes);
+  signalQueryUpdate();
+}
+
 // _______________________________________________________________________
 void Operation::updateRuntimeInformationOnSuccess(
     size_t numRows, ad_utility::CacheStatus cacheStatus, Milliseconds duration,
@@ -457,10 +679,10 @@ void Operation::updateRuntimeInformationOnSuccess(
 void Operation::updateRuntimeInformationOnSuccess(
     const QueryResultCache::ResultAndCacheStatus& resultAndCacheStatus,
     Milliseconds duration) {
-  const auto& result = resultAndCacheStatus._resultPointer->resultTable();
-  AD_CONTRACT_CHECK(result.isFullyMaterialized());
+  const auto& cacheValue = *resultAndCacheStatus._resultPointer;
+  AD_CONTRACT_CHECK(cacheValue.isFullyMaterialized());
   updateRuntimeInformationOnSuccess(
-      result.idTable().size(), resultAndCacheStatus._cacheStatus, duration,
+      cacheValue.numRows(), resultAndCacheStatus._cacheStatus, duration,
       resultAndCacheStatus._resultPointer->runtimeInfo());
 }
 
@@ -639,20 +861,78 @@ const vector<ColumnIndex>& Operation::getResultSortedOn() const {
 // _____________________________________________________________________________
 
 void Operation::signalQueryUpdate() const {
-  if (_executionContext && _executionContext->areWebsocketUpdatesEnabled()) {
+  if (_executionContext && _executionContext->areWebsocketUpdatesEnabled() &&
+      !isInsideParallelSubtree) {
     _executionContext->signalQueryUpdate(*_rootRuntimeInfo);
   }
 }
 
+// _____________________________________________________________________________
+namespace {
+// Append the `LIMIT` and `OFFSET` to the `cacheKey` of an operation.
+std::string addLimitOffsetToCacheKey(std::string cacheKey,
+                                     const LimitOffsetClause& limitOffset) {
+  if (limitOffset._limit.has_value()) {
+    absl::StrAppend(&cacheKey, " LIMIT ", limitOffset._limit.value());
+  }
+  if (limitOffset._offset != 0) {
+    absl::StrAppend(&cacheKey, " OFFSET ", limitOffset._offset);
+  }
+  return cacheKey;
+}
+
+// Return the rows of the fully materialized `result` that are selected by the
+// `limitOffset`.
+Result sliceResult(const Result& result, const LimitOffsetClause& limitOffset) {
+  const IdTable& input = result.idTable();
+  IdTable sliced{input.numColumns(), input.getAllocator()};
+  sliced.insertAtEnd(input, limitOffset.actualOffset(input.size()),
+                     limitOffset.upperBound(input.size()));
+  return {std::move(sliced), result.sortedBy(), result.getCopyOfLocalVocab()};
+}
+}  // namespace
+
 // _____________________________________________________________________________
 std::string Operation::getCacheKey() const {
-  auto result = getCacheKeyImpl();
-  if (limitOffset_._limit.has_value()) {
-    absl::StrAppend(&result, " LIMIT ", limitOffset_._limit.value());
+  return addLimitOffsetToCacheKey(getCacheKeyImpl(), limitOffset_);
+}
+
+// _____________________________________________________________________________
+std::vector<SubsumingSubtree> Operation::getSubsumingSubtrees() const {
+  auto candidates = getSubsumingSubtreesImpl();
+  if (limitOffset_.isUnconstrained()) {
+    return candidates;
   }
-  if (limitOffset_._offset != 0) {
-    absl::StrAppend(&result, " OFFSET ", limitOffset_._offset);
+  for (auto& candidate : candidates) {
+    candidate.derive_ = [derive = std::move(candidate.derive_),
+                         limitOffset = limitOffset_](const Result& result) {
+      return sliceResult(derive(result), limitOffset);
+    };
+  }
+
+  // The same operation with a `LIMIT` and `OFFSET` that contains the requested
+  // rows. The result without a `LIMIT` and `OFFSET` is always tried first.
+  auto cacheKeyWithoutLimit = getCacheKeyImpl();
+  auto cachedLimits = _executionContext->getCachedLimits(cacheKeyWithoutLimit);
+  cachedLimits.insert(cachedLimits.begin(), LimitOffsetClause{});
+  std::vector<SubsumingSubtree> result;
+  for (const auto& cached : cachedLimits) {
+    bool containsRequestedRows =
+        cached._offset <= limitOffset_._offset &&
+        (!cached._limit.has_value() ||
+         (limitOffset_._limit.has_value() &&
+          limitOffset_._offset + limitOffset_._limit.value() <=
+              cached._offset + cached._limit.value()));
+    if (!containsRequestedRows || cached == limitOffset_) {
+      continue;
+    }
+    LimitOffsetClause relative{limitOffset_._limit,
+                               limitOffset_._offset - cached._offset};
+    result.push_back(
+        {addLimitOffsetToCacheKey(cacheKeyWithoutLimit, cached),
+         [relative](const Result& r) { return sliceResult(r, relative); }});
   }
+  ql::ranges::move(candidates, std::back_inserter(result));
   return result;
 }
 
@@ -9,6 +9,7 @@
 #include <absl/cleanup/cleanup.h>
 #include <gtest/gtest_prod.h>
 
+#include <functional>
 #include <memory>
 
 #include "engine/QueryExecutionContext.h"
@@ -24,6 +25,7 @@
 
 // forward declaration needed to break dependencies
 class QueryExecutionTree;
+class RuntimeFilter;
 
 enum class ComputationMode {
   FULLY_MATERIALIZED,
@@ -36,10 +38,12 @@ class Operation {
   using SharedCancellationHandle = ad_utility::SharedCancellationHandle;
   using Milliseconds = std::chrono::milliseconds;
 
-  // Holds a precomputed Result of this operation if it is the sibling of a
-  // Service operation.
-  std::optional<std::shared_ptr<const Result>>
-      precomputedResultBecauseSiblingOfService_;
+  // Holds a precomputed Result of this operation, which is returned (once) by
+  // the next call to `getResult`. It is set by the parent operation, e.g. for
+  // the sibling of a Service operation (see `Service::precomputeSiblingResult`)
+  // or if it was computed in parallel to its siblings (see
+  // `computeChildrenInParallel`).
+  std::optional<std::shared_ptr<const Result>> precomputedResult_;
 
   std::shared_ptr<RuntimeInformation> _runtimeInfo =
       std::make_shared<RuntimeInformation>();
@@ -168,6 +172,36 @@ class Operation {
   // Calls  `getCacheKeyImpl` and adds the information about the `LIMIT` clause.
   virtual std::string getCacheKey() const final;
 
+  // Return the ranges of the permutations that the result of this operation
+  // depends on, or `std::nullopt` if it might depend on arbitrary parts of the
+  // index. Cached results remain valid across updates that don't affect these
+  // ranges. The default is `std::nullopt`. Operations, the results of which
+  // only depend on the results of their children, can override this with
+  // `getIndexRangesOfChildren`.
+  virtual std::optional<IndexRanges> getIndexRanges();
+
+  // Restrict the result of this operation to the rows where the `variable` is
+  // bound to one of the values of the `filter`, as far as this is cheaply
+  // possible (see `RuntimeFilter`). This is only used by a parent that drops
+  // the other rows anyway (typically a join), so the restriction is
+  // optional. The filter is passed on to the children of operations for which
+  // `isTransparentForRuntimeFilters()` is true, and applied by the operations
+  // that override `applyRuntimeFilter` (currently only `IndexScan`). Return
+  // true iff the filter was applied somewhere in this subtree. In this case
+  // the results in the subtree are not complete anymore and therefore not
+  // stored in the cache. Nothing happens if the `variable` might be UNDEF or
+  // if there is a LIMIT or OFFSET.
+  bool pushDownRuntimeFilter(
+      const Variable& variable,
+      const std::shared_ptr<const RuntimeFilter>& filter);
+
+  // Return more general subtrees, the cached results of which contain the
+  // result of this operation (see `QueryExecutionContext::
+  // deriveResultFromCache`). These are this operation with a larger (or no)
+  // `LIMIT` and a smaller `OFFSET`, and the subtrees from
+  // `getSubsumingSubtreesImpl` (with the `LIMIT` applied afterwards).
+  std::vector<SubsumingSubtree> getSubsumingSubtrees() const;
+
   // If this function returns `false`, then the result of this `Operation` will
   // never be stored in the cache. It might however be read from the cache.
   // This can be used, if the operation actually only returns a subset of the
@@ -188,10 +222,33 @@ class Operation {
   // `disableStoringInCache()`.
   virtual bool canResultBeCachedImpl() const { return true; }
 
+  // Return true iff the result of this operation only contains the rows with
+  // the values of a `RuntimeFilter` for a variable if the same holds for all
+  // the children that contain the variable (e.g. for joins, filters, and
+  // sorts, but not for an OPTIONAL or a GROUP BY). See
+  // `pushDownRuntimeFilter`.
+  virtual bool isTransparentForRuntimeFilters() const { return false; }
+
+  // Apply the `filter` for the given `column` of the result directly when
+  // computing the result. Return false if this is not supported (the default).
+  // See `pushDownRuntimeFilter`.
+  virtual bool applyRuntimeFilter(
+      [[maybe_unused]] ColumnIndex column,
+      [[maybe_unused]] const std::shared_ptr<const RuntimeFilter>& filter) {
+    return false;
+  }
+
   // The individual implementation of `getCacheKey` (see above) that has to
   // be customized by every child class.
   virtual std::string getCacheKeyImpl() const = 0;
 
+  // Return more general subtrees, the results of which contain the result of
+  // this operation without its `LIMIT` and `OFFSET` (e.g. an index scan with
+  // fewer bound constants). The default is to return no subtrees.
+  virtual std::vector<SubsumingSubtree> getSubsumingSubtreesImpl() const {
+    return {};
+  }
+
  public:
   // Gets a very short (one line without line ending) descriptor string for
   // this Operation.  This string is used in the RuntimeInformation
@@ -227,8 +284,8 @@ class Operation {
 
   // See the member variable with the same name below for documentation.
   std::optional<std::shared_ptr<const Result>>&
-  precomputedResultBecauseSiblingOfService() {
-    return precomputedResultBecauseSiblingOfService_;
+  precomputedResult() {
+    return precomputedResult_;
   }
 
   RuntimeInformation& runtimeInfo() const { return *_runtimeInfo; }
@@ -244,6 +301,13 @@ class Operation {
   /// Notify the `QueryExecutionContext` of the latest `RuntimeInformation`.
   void signalQueryUpdate() const;
 
+  // Run `task` on the thread pool that is shared by all queries for the
+  // concurrent computations inside of a single operation (it is also used by
+  // `computeChildrenInParallel`). The tasks are not guaranteed to start
+  // immediately, so a caller that waits for them must not rely on them
+  // making progress (e.g. by also doing the work on the calling thread).
+  static void runOnSharedThreadPool(std::function<void()> task);
+
   /**
    * @brief Get the result for the subtree rooted at this element. Use existing
    * results if they are already available, otherwise trigger computation.
@@ -384,6 +448,31 @@ class Operation {
 
   std::chrono::milliseconds remainingTime() const;
 
+  // The union of the `getIndexRanges()` of all the children, or `std::nullopt`
+  // if this is unknown for at least one of the children.
+  std::optional<IndexRanges> getIndexRangesOfChildren();
+
+  // Compute the results of the `children` concurrently, the first child on the
+  // calling thread, and each of the others on a shared thread pool as long as
+  // the global limit `parallel-subtrees-max-threads` is not exceeded (the
+  // remaining children are computed later as usual). The results are stored as
+  // precomputed results of the children, s.t. the subsequent calls to
+  // `getResult` for the children (typically in `computeResult`) return them
+  // immediately. If one of the children fails, the other children are
+  // cancelled via the cancellation handle of the query, and the first
+  // exception is rethrown. Has no effect if the runtime parameter is zero or if
+  // there are less than two children. The overlap of the computations is added
+  // to the `RuntimeInformation` of this operation.
+  //
+  // NOTE: With `LAZY_IF_SUPPORTED`, only the children that don't support lazy
+  // evaluation (and thus compute their complete result in `getResult`) profit
+  // from this function. For the other children, only the (cheap) creation of
+  // the lazy result is done concurrently, the actual computation happens when
+  // the result is consumed by this operation.
+  void computeChildrenInParallel(
+      const std::vector<std::shared_ptr<QueryExecutionTree>>& children,
+      ComputationMode computationMode);
+
   /// Pointer to the cancellation handle of this operation.
   SharedCancellationHandle cancellationHandle_ =
       std::make_shared<SharedCancellationHandle::element_type>();
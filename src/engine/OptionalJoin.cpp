@@ -109,6 +109,10 @@ Result OptionalJoin::computeResult(bool requestLaziness) {
   // join column. This might be extended in the future.
   bool lazyJoinIsSupported = _joinColumns.size() == 1;
 
+  computeChildrenInParallel({_left, _right},
+                            lazyJoinIsSupported
+                                ? ComputationMode::LAZY_IF_SUPPORTED
+                                : ComputationMode::FULLY_MATERIALIZED);
   auto leftResult = _left->getResult(lazyJoinIsSupported);
   auto rightResult = _right->getResult(lazyJoinIsSupported);
 
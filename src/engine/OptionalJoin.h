@@ -56,6 +56,10 @@ class OptionalJoin : public Operation {
  public:
   size_t getCostEstimate() override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {_left.get(), _right.get()};
   }
@@ -75,6 +75,10 @@ class OrderBy : public Operation {
 
   size_t getResultWidth() const override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {subtree_.get()};
   }
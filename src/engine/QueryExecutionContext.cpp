@@ -5,7 +5,145 @@
 #include "engine/QueryExecutionContext.h"
 
 #include "global/RuntimeParameters.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
 
 bool QueryExecutionContext::areWebSocketUpdatesEnabled() {
   return RuntimeParameters().get<"websocket-updates-enabled">();
 }
+
+namespace {
+// The registry of the `LIMIT`s and `OFFSET`s for `registerCachedLimit` and
+// `getCachedLimits`. The number of entries is bounded, because the registry is
+// not informed when results are evicted from the cache.
+constexpr size_t maxNumCachedLimitsPerKey = 8;
+constexpr size_t maxNumKeysWithCachedLimits = 100'000;
+using CachedLimits =
+    ad_utility::HashMap<QueryCacheKey, std::vector<LimitOffsetClause>>;
+ad_utility::Synchronized<CachedLimits>& cachedLimits() {
+  static ad_utility::Synchronized<CachedLimits> registry;
+  return registry;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<DerivedResult> QueryExecutionContext::deriveResultFromCache(
+    const std::vector<SubsumingSubtree>& candidates) {
+  for (const auto& [cacheKey, derive] : candidates) {
+    auto cached = getQueryTreeCache().getIfContained(
+        {cacheKey, locatedTriplesSnapshot().index_});
+    if (!cached.has_value() ||
+        !cached.value()._resultPointer->isFullyMaterialized()) {
+      continue;
+    }
+    const auto& cacheValue = *cached.value()._resultPointer;
+    return DerivedResult{derive(*cacheValue.resultTablePtr()),
+                         cacheValue.runtimeInfo()};
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+std::optional<QueryResultCache::ResultAndCacheStatus>
+QueryExecutionContext::getResultFromEarlierSnapshot(
+    const std::string& cacheKey, const IndexRanges& indexRanges, bool pinned) {
+  const auto& snapshot = locatedTriplesSnapshot();
+  // Go back in time one modification after the other as long as the
+  // modifications haven't affected the `indexRanges`.
+  for (const auto& change : snapshot.recentChanges_ | ql::views::reverse) {
+    if (!change->ranges_.has_value() ||
+        change->ranges_->intersects(indexRanges)) {
+      return std::nullopt;
+    }
+    auto cached = getQueryTreeCache().getIfContained(
+        {cacheKey, change->snapshotIndex_ - 1});
+    if (!cached.has_value()) {
+      continue;
+    }
+    getQueryTreeCache().tryInsertIfNotPresent(
+        pinned, QueryCacheKey{cacheKey, snapshot.index_},
+        std::make_shared<CacheValue>(
+            cached.value()._resultPointer->makeShallowCopy()));
+    return cached;
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+void QueryExecutionContext::registerCachedLimit(
+    const std::string& cacheKeyWithoutLimit,
+    const LimitOffsetClause& limitOffset) const {
+  auto lock = cachedLimits().wlock();
+  if (lock->size() >= maxNumKeysWithCachedLimits) {
+    lock->clear();
+  }
+  auto& limits = (*lock)[QueryCacheKey{cacheKeyWithoutLimit,
+                                       locatedTriplesSnapshot().index_}];
+  if (ql::ranges::find(limits, limitOffset) != limits.end()) {
+    return;
+  }
+  if (limits.size() >= maxNumCachedLimitsPerKey) {
+    limits.erase(limits.begin());
+  }
+  limits.push_back(limitOffset);
+}
+
+// _____________________________________________________________________________
+std::vector<LimitOffsetClause> QueryExecutionContext::getCachedLimits(
+    const std::string& cacheKeyWithoutLimit) const {
+  auto lock = cachedLimits().rlock();
+  auto it = lock->find(
+      QueryCacheKey{cacheKeyWithoutLimit, locatedTriplesSnapshot().index_});
+  return it == lock->end() ? std::vector<LimitOffsetClause>{} : it->second;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const Result> CacheValue::resultTablePtr(bool lazy) const {
+  if (!isCompressed()) {
+    return result_;
+  }
+  const auto& compressed = *compressedResult_;
+  if (!lazy) {
+    return std::make_shared<const Result>(compressed.idTable_.decompress(),
+                                          compressed.sortedBy_,
+                                          compressed.localVocab_.clone());
+  }
+  auto decompressBlocks = [](std::shared_ptr<const CompressedResult> compressed)
+      -> Result::Generator {
+    for (size_t i = 0; i < compressed->idTable_.numBlocks(); ++i) {
+      co_yield Result::IdTableVocabPair{compressed->idTable_.decompressBlock(i),
+                                        compressed->localVocab_.clone()};
+    }
+  };
+  return std::make_shared<const Result>(decompressBlocks(compressedResult_),
+                                        compressed.sortedBy_);
+}
+
+// _____________________________________________________________________________
+bool CacheValue::compress() {
+  if (isCompressed() || !result_->isFullyMaterialized()) {
+    return false;
+  }
+  const IdTable& idTable = result_->idTable();
+  ad_utility::LightweightCompressedIdTable compressedTable{idTable};
+  if (compressedTable.size() >= getSize(idTable)) {
+    return false;
+  }
+  compressedResult_ = std::make_shared<const CompressedResult>(
+      CompressedResult{std::move(compressedTable), result_->sortedBy(),
+                       result_->localVocab().clone()});
+  result_.reset();
+  return true;
+}
+
+// _____________________________________________________________________________
+size_t CacheValue::numRows() const {
+  return isCompressed() ? compressedResult_->idTable_.numRows()
+                        : result_->idTable().numRows();
+}
+
+// _____________________________________________________________________________
+size_t CacheValue::numColumns() const {
+  return isCompressed() ? compressedResult_->idTable_.numColumns()
+                        : result_->idTable().numColumns();
+}
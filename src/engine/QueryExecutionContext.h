@@ -6,6 +6,7 @@
 #ifndef QLEVER_SRC_ENGINE_QUERYEXECUTIONCONTEXT_H
 #define QLEVER_SRC_ENGINE_QUERYEXECUTIONCONTEXT_H
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -13,6 +14,7 @@
 #include "engine/Result.h"
 #include "engine/RuntimeInformation.h"
 #include "engine/SortPerformanceEstimator.h"
+#include "engine/idTable/LightweightCompressedIdTable.h"
 #include "global/Id.h"
 #include "index/DeltaTriples.h"
 #include "index/Index.h"
@@ -20,12 +22,29 @@
 #include "util/ConcurrentCache.h"
 
 // The value of the `QueryResultCache` below. It consists of a `Result` together
-// with its `RuntimeInfo`.
+// with its `RuntimeInfo`. A fully materialized result can optionally be stored
+// in a compressed form (see `compress()` below).
 class CacheValue {
  private:
+  // A fully materialized `Result` with a compressed `IdTable`.
+  struct CompressedResult {
+    ad_utility::LightweightCompressedIdTable idTable_;
+    std::vector<ColumnIndex> sortedBy_;
+    LocalVocab localVocab_;
+  };
+
+  // Exactly one of the following is set.
   std::shared_ptr<Result> result_;
+  std::shared_ptr<const CompressedResult> compressedResult_;
   RuntimeInformation runtimeInfo_;
 
+  CacheValue(std::shared_ptr<Result> result,
+             std::shared_ptr<const CompressedResult> compressedResult,
+             RuntimeInformation runtimeInfo)
+      : result_{std::move(result)},
+        compressedResult_{std::move(compressedResult)},
+        runtimeInfo_{std::move(runtimeInfo)} {}
+
  public:
   explicit CacheValue(Result result, RuntimeInformation runtimeInfo)
       : result_{std::make_shared<Result>(std::move(result))},
@@ -36,12 +55,36 @@ class CacheValue {
   CacheValue& operator=(CacheValue&&) = default;
   CacheValue& operator=(const CacheValue&) = delete;
 
-  const Result& resultTable() const noexcept { return *result_; }
+  // Return a new value that shares the (immutable) result with this value.
+  CacheValue makeShallowCopy() const {
+    return CacheValue{result_, compressedResult_, runtimeInfo_};
+  }
+
+  // Access the `Result`. Must not be called for a compressed value, use
+  // `resultTablePtr()` instead.
+  const Result& resultTable() const {
+    AD_CONTRACT_CHECK(!isCompressed());
+    return *result_;
+  }
+
+  // Return the `Result`. If the value is compressed, a new `Result` is created
+  // on each call, which is either fully materialized or, if `lazy` is true,
+  // yields the decompressed blocks one after the other.
+  std::shared_ptr<const Result> resultTablePtr(bool lazy = false) const;
+
+  // Replace a fully materialized `Result` by a compressed representation if
+  // the latter is smaller. Return true iff the value was compressed.
+  bool compress();
 
-  std::shared_ptr<const Result> resultTablePtr() const noexcept {
-    return result_;
+  bool isCompressed() const noexcept { return compressedResult_ != nullptr; }
+  bool isFullyMaterialized() const noexcept {
+    return isCompressed() || result_->isFullyMaterialized();
   }
 
+  // The size of the (fully materialized) result.
+  size_t numRows() const;
+  size_t numColumns() const;
+
   const RuntimeInformation& runtimeInfo() const noexcept {
     return runtimeInfo_;
   }
@@ -54,6 +97,9 @@ class CacheValue {
   // Calculates the `MemorySize` taken up by an instance of `CacheValue`.
   struct SizeGetter {
     ad_utility::MemorySize operator()(const CacheValue& cacheValue) const {
+      if (cacheValue.isCompressed()) {
+        return cacheValue.compressedResult_->idTable_.size();
+      }
       if (const auto& resultPtr = cacheValue.result_; resultPtr) {
         return getSize(resultPtr->idTable());
       } else {
@@ -61,6 +107,18 @@ class CacheValue {
       }
     }
   };
+
+  // The cost of the computation of a `CacheValue` (in milliseconds), which is
+  // used by the `CostAwareCache`. Note that for results that were (partially)
+  // read from the cache when the value was created, this is the time that was
+  // actually spent on the computation.
+  struct CostGetter {
+    double operator()(const CacheValue& cacheValue) const {
+      return std::chrono::duration<double, std::milli>{
+          cacheValue.runtimeInfo_.totalTime_}
+          .count();
+    }
+  };
 };
 
 // The key for the `QueryResultCache` below. It consists of a `string` (the
@@ -81,11 +139,35 @@ struct QueryCacheKey {
   }
 };
 
-// Threadsafe LRU cache for (partial) query results, that
-// checks on insertion, if the result is currently being computed
-// by another query.
-using QueryResultCache = ad_utility::ConcurrentCache<
-    ad_utility::LRUCache<QueryCacheKey, CacheValue, CacheValue::SizeGetter>>;
+// Threadsafe cache for (partial) query results, that checks on insertion, if
+// the result is currently being computed by another query. The eviction policy
+// (LRU or cost-aware) is set via the runtime parameter
+// `cache-eviction-policy`.
+using QueryResultCache =
+    ad_utility::ConcurrentCache<ad_utility::CostAwareCache<
+        QueryCacheKey, CacheValue, CacheValue::SizeGetter,
+        CacheValue::CostGetter>>;
+
+// A more general subtree (e.g. one with fewer bound constants or without a
+// `LIMIT`), the result of which contains the result of a requested subtree.
+// Used for the semantic lookup in the cache (see
+// `QueryExecutionContext::deriveResultFromCache`).
+struct SubsumingSubtree {
+  // The cache key of the more general subtree (without the snapshot index).
+  std::string cacheKey_;
+  // Derive the result of the requested subtree from the (fully materialized)
+  // result of the more general subtree.
+  std::function<Result(const Result&)> derive_;
+};
+
+// The result of `QueryExecutionContext::deriveResultFromCache` together with
+// the `RuntimeInformation` of the cached result from which it was derived.
+struct DerivedResult {
+  Result result_;
+  RuntimeInformation runtimeInfoOfCachedResult_;
+};
+
+class MaterializedViews;
 
 // Execution context for queries.
 // Holds references to index and engine, implements caching.
@@ -133,6 +215,49 @@ class QueryExecutionContext {
 
   void clearCacheUnpinnedOnly() { getQueryTreeCache().clearUnpinnedOnly(); }
 
+  // Semantic cache lookup: If a fully materialized result for one of the
+  // `candidates` is contained in the cache, return the result that is derived
+  // from it (together with the `RuntimeInformation` of the cached result). The
+  // candidates are tried in order. Return `std::nullopt` if none of the
+  // candidates is cached.
+  std::optional<DerivedResult> deriveResultFromCache(
+      const std::vector<SubsumingSubtree>& candidates);
+
+  // Return a result for the `cacheKey` that is contained in the cache for an
+  // earlier snapshot of the delta triples, and is still valid because none of
+  // the updates since then has affected the `indexRanges` that the result
+  // depends on. Such a result is also inserted into the cache for the current
+  // snapshot. Return `std::nullopt` if there is no such result.
+  std::optional<QueryResultCache::ResultAndCacheStatus>
+  getResultFromEarlierSnapshot(const std::string& cacheKey,
+                               const IndexRanges& indexRanges, bool pinned);
+
+  // Remember that a result with the `limitOffset` has been computed for the
+  // subtree with the `cacheKeyWithoutLimit`, s.t. it can later serve requests
+  // for smaller limits (see `getCachedLimits`). This information is shared
+  // between all queries, but it is only a hint, so entries that have been
+  // evicted from the cache in the meantime are harmless.
+  void registerCachedLimit(const std::string& cacheKeyWithoutLimit,
+                           const LimitOffsetClause& limitOffset) const;
+
+  // Return the `LIMIT`s and `OFFSET`s that have been registered for the
+  // subtree with the `cacheKeyWithoutLimit` for the current snapshot.
+  std::vector<LimitOffsetClause> getCachedLimits(
+      const std::string& cacheKeyWithoutLimit) const;
+
+  // The materialized views that can be scanned by the queries (see
+  // `MaterializedView`). The `views` must outlive the context.
+  void setMaterializedViews(const MaterializedViews* views) {
+    materializedViews_ = views;
+  }
+  const MaterializedViews& getMaterializedViews() const {
+    if (materializedViews_ == nullptr) {
+      throw std::runtime_error(
+          "Materialized views are not available for this query");
+    }
+    return *materializedViews_;
+  }
+
   [[nodiscard]] const SortPerformanceEstimator& getSortPerformanceEstimator()
       const {
     return _sortPerformanceEstimator;
@@ -182,6 +307,7 @@ class QueryExecutionContext {
   QueryPlanningCostFactors _costFactors;
   SortPerformanceEstimator _sortPerformanceEstimator;
   std::function<void(std::string)> updateCallback_;
+  const MaterializedViews* materializedViews_ = nullptr;
   // Cache the state of that runtime parameter to reduce the contention of the
   // mutex.
   bool areWebsocketUpdatesEnabled_ = areWebSocketUpdatesEnabled();
@@ -25,12 +25,15 @@
 #include "engine/CountConnectedSubgraphs.h"
 #include "engine/Describe.h"
 #include "engine/Distinct.h"
+#include "engine/FactorizedStarJoin.h"
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
 #include "engine/HasPredicateScan.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "engine/LeapfrogTriejoin.h"
 #include "engine/Load.h"
+#include "engine/MaterializedViewScan.h"
 #include "engine/Minus.h"
 #include "engine/MultiColumnJoin.h"
 #include "engine/NeutralElementOperation.h"
@@ -1734,6 +1737,23 @@ vector<vector<SubtreePlan>> QueryPlanner::fillDpTab(
   vector<vector<SubtreePlan>> lastDpRowFromComponents;
   TextLimitVec textLimitVec(textLimits.begin(), textLimits.end());
   for (auto& component : components | ql::views::values) {
+    // Components with special shapes can be joined by a single operation.
+    std::optional<SubtreePlan> multiwayJoinPlan;
+    if (RuntimeParameters().get<"use-worst-case-optimal-join">()) {
+      multiwayJoinPlan = createWorstCaseOptimalJoinPlan(component);
+    }
+    if (!multiwayJoinPlan.has_value() &&
+        RuntimeParameters().get<"use-factorized-star-join">()) {
+      multiwayJoinPlan = createFactorizedStarJoinPlan(component);
+    }
+    if (multiwayJoinPlan.has_value()) {
+      std::vector<SubtreePlan> row{std::move(multiwayJoinPlan.value())};
+      applyFiltersIfPossible<FilterMode::ReplaceUnfilteredNoSubstitutes>(
+          row, filtersAndOptSubstitutes);
+      applyTextLimitsIfPossible(row, textLimitVec, true);
+      lastDpRowFromComponents.push_back(std::move(row));
+      continue;
+    }
     std::vector<const SubtreePlan*> g;
     for (const auto& plan : component) {
       g.push_back(&plan);
@@ -1804,6 +1824,181 @@ vector<vector<SubtreePlan>> QueryPlanner::fillDpTab(
   return result;
 }
 
+namespace {
+// Return true iff the hypergraph with the given `edges` (each edge is a set of
+// variables) is cyclic. This is checked via the GYO reduction: Repeatedly
+// remove the variables that are contained in only one edge and the edges that
+// are contained in another edge. The hypergraph is acyclic iff at most one
+// edge remains.
+bool isCyclicHypergraph(std::vector<ad_utility::HashSet<Variable>> edges) {
+  bool changed = true;
+  while (changed && edges.size() > 1) {
+    changed = false;
+    ad_utility::HashMap<Variable, size_t> numEdges;
+    for (const auto& edge : edges) {
+      for (const auto& variable : edge) {
+        ++numEdges[variable];
+      }
+    }
+    for (auto& edge : edges) {
+      ad_utility::HashSet<Variable> reduced;
+      for (const auto& variable : edge) {
+        if (numEdges.at(variable) > 1) {
+          reduced.insert(variable);
+        }
+      }
+      changed |= reduced.size() != edge.size();
+      edge = std::move(reduced);
+    }
+    for (size_t i = 0; i < edges.size(); ++i) {
+      bool isContainedInOther = false;
+      for (size_t j = 0; j < edges.size() && !isContainedInOther; ++j) {
+        isContainedInOther =
+            i != j && ql::ranges::all_of(edges[i], [&](const Variable& var) {
+              return edges[j].contains(var);
+            });
+      }
+      if (isContainedInOther) {
+        edges.erase(edges.begin() + i);
+        changed = true;
+        break;
+      }
+    }
+  }
+  return edges.size() > 1;
+}
+
+// If all the plans of the `connectedComponent` are plain index scans, return
+// them grouped by the node of the triple graph (the component contains several
+// candidates with different permutations for each node). Else return
+// `std::nullopt`.
+std::optional<std::vector<std::vector<const SubtreePlan*>>>
+getIndexScanCandidatesPerNode(
+    const std::vector<SubtreePlan>& connectedComponent) {
+  std::vector<std::vector<const SubtreePlan*>> candidatesPerNode;
+  ad_utility::HashMap<uint64_t, size_t> nodeToIndex;
+  for (const auto& plan : connectedComponent) {
+    bool isPlainScan =
+        plan.type == SubtreePlan::BASIC && plan.idsOfIncludedTextLimits_ == 0 &&
+        !plan.containsFilterSubstitute_ &&
+        std::dynamic_pointer_cast<const IndexScan>(
+            plan._qet->getRootOperation()) != nullptr;
+    if (!isPlainScan) {
+      return std::nullopt;
+    }
+    auto [it, isNew] = nodeToIndex.try_emplace(plan._idsOfIncludedNodes,
+                                               candidatesPerNode.size());
+    if (isNew) {
+      candidatesPerNode.emplace_back();
+    }
+    candidatesPerNode.at(it->second).push_back(&plan);
+  }
+  return candidatesPerNode;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<SubtreePlan> QueryPlanner::createWorstCaseOptimalJoinPlan(
+    const std::vector<SubtreePlan>& connectedComponent) const {
+  auto optionalCandidates = getIndexScanCandidatesPerNode(connectedComponent);
+  if (!optionalCandidates.has_value() || optionalCandidates->size() < 3) {
+    return std::nullopt;
+  }
+  const auto& candidatesPerNode = optionalCandidates.value();
+  std::vector<ad_utility::HashSet<Variable>> edges;
+  for (const auto& candidates : candidatesPerNode) {
+    auto& edge = edges.emplace_back();
+    for (const auto& variable :
+         candidates.front()->_qet->getVariableColumns() | ql::views::keys) {
+      edge.insert(variable);
+    }
+  }
+  if (!isCyclicHypergraph(std::move(edges))) {
+    return std::nullopt;
+  }
+
+  // For each node prefer a candidate that is already sorted as required by
+  // the join, s.t. no additional sort is needed.
+  LeapfrogTriejoin::Children children;
+  for (const auto& candidates : candidatesPerNode) {
+    children.push_back(candidates.front()->_qet);
+  }
+  auto variableOrder = LeapfrogTriejoin::computeVariableOrder(children);
+  uint64_t nodes = 0;
+  uint64_t filterIds = 0;
+  for (size_t i = 0; i < candidatesPerNode.size(); ++i) {
+    const auto& candidates = candidatesPerNode[i];
+    auto sortColumns = LeapfrogTriejoin::computeSortColumns(
+        *candidates.front()->_qet, variableOrder);
+    auto it = ql::ranges::find_if(candidates, [&sortColumns](const auto* plan) {
+      const auto& sortedOn = plan->_qet->resultSortedOn();
+      return sortedOn.size() >= sortColumns.size() &&
+             std::equal(sortColumns.begin(), sortColumns.end(),
+                        sortedOn.begin());
+    });
+    const auto* chosen = it != candidates.end() ? *it : candidates.front();
+    children.at(i) = chosen->_qet;
+    nodes |= chosen->_idsOfIncludedNodes;
+    filterIds |= chosen->_idsOfIncludedFilters;
+  }
+  auto plan = makeSubtreePlan<LeapfrogTriejoin>(_qec, std::move(children));
+  plan._idsOfIncludedNodes = nodes;
+  plan._idsOfIncludedFilters = filterIds;
+  return plan;
+}
+
+// _____________________________________________________________________________
+std::optional<SubtreePlan> QueryPlanner::createFactorizedStarJoinPlan(
+    const std::vector<SubtreePlan>& connectedComponent) const {
+  auto optionalCandidates = getIndexScanCandidatesPerNode(connectedComponent);
+  if (!optionalCandidates.has_value() || optionalCandidates->size() < 3) {
+    return std::nullopt;
+  }
+  const auto& candidatesPerNode = optionalCandidates.value();
+
+  // The center of the star is the single variable that is contained in all
+  // the nodes, all the other variables must be contained in only one node.
+  ad_utility::HashMap<Variable, size_t> numNodesOfVariable;
+  for (const auto& candidates : candidatesPerNode) {
+    for (const auto& variable :
+         candidates.front()->_qet->getVariableColumns() | ql::views::keys) {
+      ++numNodesOfVariable[variable];
+    }
+  }
+  std::optional<Variable> center;
+  for (const auto& [variable, numNodes] : numNodesOfVariable) {
+    if (numNodes == candidatesPerNode.size() && !center.has_value()) {
+      center = variable;
+    } else if (numNodes > 1) {
+      return std::nullopt;
+    }
+  }
+  if (!center.has_value()) {
+    return std::nullopt;
+  }
+
+  // For each node prefer a candidate that is already sorted by the center.
+  FactorizedStarJoin::Children children;
+  uint64_t nodes = 0;
+  uint64_t filterIds = 0;
+  for (const auto& candidates : candidatesPerNode) {
+    auto it = ql::ranges::find_if(candidates, [&center](const auto* plan) {
+      const auto& sortedOn = plan->_qet->resultSortedOn();
+      return !sortedOn.empty() &&
+             sortedOn.front() == plan->_qet->getVariableColumn(center.value());
+    });
+    const auto* chosen = it != candidates.end() ? *it : candidates.front();
+    children.push_back(chosen->_qet);
+    nodes |= chosen->_idsOfIncludedNodes;
+    filterIds |= chosen->_idsOfIncludedFilters;
+  }
+  auto plan = makeSubtreePlan<FactorizedStarJoin>(_qec, std::move(children),
+                                                  std::move(center).value());
+  plan._idsOfIncludedNodes = nodes;
+  plan._idsOfIncludedFilters = filterIds;
+  return plan;
+}
+
 // _____________________________________________________________________________
 bool QueryPlanner::TripleGraph::isTextNode(size_t i) const {
   auto it = _nodeMap.find(i);
@@ -2913,6 +3108,8 @@ void QueryPlanner::GraphPatternPlanner::graphPatternOperationVisitor(Arg& arg) {
     visitSpatialSearch(arg);
   } else if constexpr (std::is_same_v<T, p::TextSearchQuery>) {
     visitTextSearch(arg);
+  } else if constexpr (std::is_same_v<T, p::MaterializedViewQuery>) {
+    visitMaterializedView(arg);
   } else {
     static_assert(std::is_same_v<T, p::BasicGraphPattern>);
     visitBasicGraphPattern(arg);
@@ -3102,6 +3299,14 @@ void QueryPlanner::GraphPatternPlanner::visitTextSearch(
   }
 }
 
+// _______________________________________________________________
+void QueryPlanner::GraphPatternPlanner::visitMaterializedView(
+    const parsedQuery::MaterializedViewQuery& viewQuery) {
+  auto view = qec_->getMaterializedViews().get(viewQuery.getName());
+  candidatePlans_.push_back(std::vector{makeSubtreePlan<MaterializedViewScan>(
+      qec_, std::move(view), viewQuery.columns_)});
+}
+
 // _______________________________________________________________
 void QueryPlanner::GraphPatternPlanner::visitUnion(parsedQuery::Union& arg) {
   // TODO<joka921> here we could keep all the candidates, and create a
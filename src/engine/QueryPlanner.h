@@ -578,6 +578,23 @@ class QueryPlanner {
       const FiltersAndOptionalSubstitutes& filters,
       const TextLimitVec& textLimits, const TripleGraph& tg) const;
 
+  // If the `connectedComponent` consists only of index scans and its pattern is
+  // cyclic (e.g. a triangle), return a plan that joins all the scans at once
+  // using a `LeapfrogTriejoin`, which avoids the large intermediate results of
+  // a cascade of binary joins for such patterns. Else return `std::nullopt`.
+  // Used by `fillDpTab` if the runtime parameter
+  // `use-worst-case-optimal-join` is set.
+  std::optional<SubtreePlan> createWorstCaseOptimalJoinPlan(
+      const std::vector<SubtreePlan>& connectedComponent) const;
+
+  // If the `connectedComponent` consists only of index scans that all share a
+  // single variable and have no other variables in common (a star), return a
+  // plan that joins all the scans at once using a `FactorizedStarJoin`. Else
+  // return `std::nullopt`. Used by `fillDpTab` if the runtime parameter
+  // `use-factorized-star-join` is set.
+  std::optional<SubtreePlan> createFactorizedStarJoinPlan(
+      const std::vector<SubtreePlan>& connectedComponent) const;
+
   // Return the number of connected subgraphs is the `graph`, or `budget + 1`,
   // if the number of subgraphs is `> budget`. This is used to analyze the
   // complexity of the query graph and to choose between the DP and the greedy
@@ -649,6 +666,8 @@ class QueryPlanner {
     void visitPathSearch(parsedQuery::PathQuery& config);
     void visitSpatialSearch(parsedQuery::SpatialQuery& config);
     void visitTextSearch(const parsedQuery::TextSearchQuery& config);
+    void visitMaterializedView(
+        const parsedQuery::MaterializedViewQuery& viewQuery);
     void visitUnion(parsedQuery::Union& un);
     void visitSubquery(parsedQuery::Subquery& subquery);
     void visitDescribe(parsedQuery::Describe& describe);
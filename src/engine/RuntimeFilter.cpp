@@ -0,0 +1,49 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/RuntimeFilter.h"
+
+#include <algorithm>
+
+// _____________________________________________________________________________
+std::optional<RuntimeFilter> RuntimeFilter::fromSortedColumn(
+    ql::span<const Id> column, size_t maxSize) {
+  AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(column));
+  // UNDEF is the smallest `Id`, so it can only be at the beginning.
+  if (!column.empty() && column.front().isUndefined()) {
+    return std::nullopt;
+  }
+  std::vector<Id> ids;
+  for (Id id : column) {
+    if (!ids.empty() && ids.back() == id) {
+      continue;
+    }
+    if (ids.size() == maxSize) {
+      return std::nullopt;
+    }
+    ids.push_back(id);
+  }
+  return RuntimeFilter{std::move(ids)};
+}
+
+// _____________________________________________________________________________
+bool RuntimeFilter::contains(Id id) const {
+  return std::binary_search(ids_.begin(), ids_.end(), id);
+}
+
+// _____________________________________________________________________________
+void RuntimeFilter::filterRows(IdTable& table, ColumnIndex column) const {
+  auto values = table.getColumn(column);
+  size_t numKept = 0;
+  for (size_t row = 0; row < table.numRows(); ++row) {
+    if (!contains(values[row])) {
+      continue;
+    }
+    if (numKept != row) {
+      for (size_t col = 0; col < table.numColumns(); ++col) {
+        table(numKept, col) = table(row, col);
+      }
+    }
+    ++numKept;
+  }
+  table.resize(numKept);
+}
@@ -0,0 +1,47 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_RUNTIMEFILTER_H
+#define QLEVER_SRC_ENGINE_RUNTIMEFILTER_H
+
+#include <optional>
+#include <vector>
+
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+
+// A filter on the values of a single variable that is created while a query
+// is computed (sideways information passing): When one side of a join has
+// been materialized, only the values of its join column can contribute to the
+// result, so the operations on the other side may drop all rows with other
+// values (see `Operation::pushDownRuntimeFilter`). The filter is stored as the
+// sorted list of the distinct `Id`s, which can directly be used to select the
+// blocks of an index scan (see `CompressedRelationReader::getBlocksForJoin`).
+class RuntimeFilter {
+ private:
+  // Sorted, without duplicates, and without UNDEF.
+  std::vector<Id> ids_;
+
+  explicit RuntimeFilter(std::vector<Id> ids) : ids_{std::move(ids)} {}
+
+ public:
+  // Create the filter for the values of the sorted `column`. Return
+  // `std::nullopt` if the `column` contains UNDEF (which matches every value)
+  // or more than `maxSize` distinct values.
+  static std::optional<RuntimeFilter> fromSortedColumn(
+      ql::span<const Id> column, size_t maxSize);
+
+  // The number of distinct values.
+  size_t size() const { return ids_.size(); }
+
+  // The sorted distinct values.
+  ql::span<const Id> ids() const { return ids_; }
+
+  // Return true iff the `id` is one of the values.
+  bool contains(Id id) const;
+
+  // Remove all the rows from the `table` whose entry in the `column` is not
+  // one of the values. The order of the remaining rows is kept.
+  void filterRows(IdTable& table, ColumnIndex column) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_RUNTIMEFILTER_H
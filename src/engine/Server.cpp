@@ -18,6 +18,7 @@
 
 #include "CompilationInfo.h"
 #include "GraphStoreProtocol.h"
+#include "engine/DiskResultCache.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/QueryPlanner.h"
@@ -67,6 +68,11 @@ Server::Server(unsigned short port, size_t numThreads,
       [this](ad_utility::MemorySize newValue) {
         cache_.setMaxSizeSingleEntry(newValue);
       });
+  RuntimeParameters().setOnUpdateAction<"cache-eviction-policy">(
+      [this](const std::string& newValue) {
+        cache_.setEvictionPolicy(
+            ad_utility::evictionPolicyFromString(newValue));
+      });
 }
 
 // __________________________________________________________________________
@@ -84,6 +90,28 @@ void Server::initialize(const std::string& indexBaseName, bool useText,
     index_.addTextFromOnDiskIndex();
   }
 
+  materializedViews_.loadFromDisk(indexBaseName, index_.getBuildId());
+
+  // Set up the optional second tier of the cache on disk. The stored results
+  // are only valid for the current state of the index, so it is only used if
+  // there are no (persisted) updates.
+  if (std::string directory = RuntimeParameters().get<"disk-cache-directory">();
+      !directory.empty()) {
+    auto deltaCounts = index_.deltaTriplesManager().modify<DeltaTriplesCount>(
+        [](auto& deltaTriples) { return deltaTriples.getCounts(); }, false);
+    if (deltaCounts.triplesInserted_ == 0 && deltaCounts.triplesDeleted_ == 0) {
+      cache_.setSecondTier(std::make_shared<DiskResultCache>(
+          std::move(directory),
+          RuntimeParameters().get<"disk-cache-max-size">(),
+          index_.getBuildId(),
+          index_.deltaTriplesManager().getCurrentSnapshot()->index_,
+          allocator_));
+    } else {
+      LOG(WARN) << "The index contains updates, the disk cache is disabled"
+                << std::endl;
+    }
+  }
+
   sortPerformanceEstimator_.computeEstimatesExpensively(
       allocator_, index_.numTriples().normalAndInternal_() *
                       PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
@@ -273,6 +301,7 @@ auto Server::prepareOperation(
   QueryExecutionContext qec(index_, &cache_, allocator_,
                             sortPerformanceEstimator_, std::ref(messageSender),
                             pinSubtrees, pinResult);
+  qec.setMaterializedViews(&materializedViews_);
 
   return std::tuple{std::move(qec), std::move(cancellationHandle),
                     std::move(cancelTimeoutOnDestruction)};
@@ -381,6 +410,41 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     logCommand(cmd, "get index ID");
     response =
         createOkResponse(index_.getIndexId(), request, MediaType::textPlain);
+  } else if (auto cmd = checkParameter("cmd", "write-materialized-view")) {
+    requireValidAccessToken("write-materialized-view");
+    auto name = checkParameter("view-name", std::nullopt);
+    auto query = checkParameter("view-query", std::nullopt);
+    if (!name.has_value() || !query.has_value()) {
+      throw std::runtime_error(
+          "The command \"write-materialized-view\" requires the parameters "
+          "\"view-name\" and \"view-query\"");
+    }
+    logCommand(cmd, absl::StrCat("write the materialized view \"",
+                                 name.value(), "\""));
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    // Compute and write the view in a thread of the query thread pool, it is
+    // available for the queries as soon as it has been written.
+    auto coroutine = computeInNewThread(
+        queryThreadPool_,
+        [this, name = name.value(), query = query.value(), handle] {
+          QueryExecutionContext qec{index_, &cache_, allocator_,
+                                    sortPerformanceEstimator_};
+          qec.setMaterializedViews(&materializedViews_);
+          auto filename =
+              MaterializedView::compute(name, query, &qec, handle)
+                  .writeToDisk(index_.getOnDiskBase(), index_.getBuildId());
+          // Only the metadata of the written view is kept in memory, the
+          // blocks are read by the scans.
+          auto view = std::make_shared<const MaterializedView>(
+              MaterializedView::readFromDisk(filename, index_.getBuildId()));
+          materializedViews_.add(view);
+          return view->numRows();
+        },
+        handle);
+    auto numRows = co_await std::move(coroutine);
+    response = createJsonResponse(
+        nlohmann::json{{"view-name", name.value()}, {"num-rows", numRows}},
+        request);
   } else if (auto cmd = checkParameter("cmd", "dump-active-queries")) {
     requireValidAccessToken("dump-active-queries");
     logCommand(cmd, "dump active queries");
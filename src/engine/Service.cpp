@@ -585,8 +585,7 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
           siblingResult, sibling->getExternallyVisibleVariableColumns(),
           sibling->getCacheKey());
     }
-    sibling->precomputedResultBecauseSiblingOfService() =
-        std::move(siblingResult);
+    sibling->precomputedResult() = std::move(siblingResult);
     addRuntimeInfo(resultIsSmall);
     return;
   }
@@ -615,12 +614,11 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
       viewCollection.emplace_back(
           moveToCachingInputRange(std::move(resultPairs)));
       viewCollection.emplace_back(std::move(generator));
-      sibling->precomputedResultBecauseSiblingOfService() =
-          std::make_shared<const Result>(
-              Result::LazyResult{
-                  ad_utility::OwningViewNoConst{std::move(viewCollection)} |
-                  ql::views::join},
-              siblingResult->sortedBy());
+      sibling->precomputedResult() = std::make_shared<const Result>(
+          Result::LazyResult{
+              ad_utility::OwningViewNoConst{std::move(viewCollection)} |
+              ql::views::join},
+          siblingResult->sortedBy());
       addRuntimeInfo(false);
       return;
     }
@@ -644,8 +642,7 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
                                siblingResult->sortedBy()),
       sibling->getExternallyVisibleVariableColumns(), sibling->getCacheKey());
 
-  sibling->precomputedResultBecauseSiblingOfService() =
-      service->siblingInfo_->precomputedResult_;
+  sibling->precomputedResult() = service->siblingInfo_->precomputedResult_;
   addRuntimeInfo(true);
 }
 
@@ -61,6 +61,11 @@ class Sort : public Operation {
 
   [[nodiscard]] size_t getResultWidth() const override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+  bool isTransparentForRuntimeFilters() const override { return true; }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {subtree_.get()};
   }
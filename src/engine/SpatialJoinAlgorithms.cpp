@@ -17,11 +17,18 @@
 #include <util/geo/Geo.h>
 
 #include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <set>
+#include <thread>
 
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/SpatialJoin.h"
+#include "global/RuntimeParameters.h"
+#include "index/SpatialIndex.h"
 #include "util/GeoSparqlHelpers.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
 
 using namespace BoostGeometryNamespace;
 
@@ -94,8 +101,21 @@ std::string_view SpatialJoinAlgorithms::betweenQuotes(
 
 std::optional<size_t> SpatialJoinAlgorithms::getAnyGeometry(
     const IdTable* idtable, size_t row, size_t col) {
+  auto geometry = parseAnyGeometry(idtable, row, col);
+  if (!geometry.has_value()) {
+    return std::nullopt;
+  }
+  geometries_.push_back(std::move(geometry.value()));
+  return geometries_.size() - 1;  // index of the last element
+}
+
+// ____________________________________________________________________________
+std::optional<AnyGeometry> SpatialJoinAlgorithms::parseAnyGeometry(
+    const IdTable* idtable, size_t row, size_t col) const {
   auto printWarning = [this, &spatialJoin = spatialJoin_]() {
-    if (this->numFailedParsedGeometries_ == 0) {
+    // Only the first failure is reported, also if several threads fail at the
+    // same time.
+    if (this->numFailedParsedGeometries_.fetch_add(1) == 0) {
       std::string warning =
           "The input to a spatial join contained at least one element, "
           "that is not a Point, Linestring, Polygon, MultiPoint, "
@@ -103,7 +123,6 @@ std::optional<size_t> SpatialJoinAlgorithms::getAnyGeometry(
           "that QLever currently only accepts those geometries for "
           "the spatial joins";
       AD_LOG_WARN << warning << std::endl;
-      this->numFailedParsedGeometries_ += 1;
       if (spatialJoin.has_value()) {
         AD_CORRECTNESS_CHECK(spatialJoin.value() != nullptr);
         spatialJoin.value()->addWarning(warning);
@@ -123,12 +142,11 @@ std::optional<size_t> SpatialJoinAlgorithms::getAnyGeometry(
   AnyGeometry geometry;
   try {
     bg::read_wkt(str, geometry);
-    geometries_.push_back(std::move(geometry));
   } catch (...) {
     printWarning();
     return std::nullopt;
   }
-  return geometries_.size() - 1;  // index of the last element
+  return geometry;
 }
 
 // ____________________________________________________________________________
@@ -422,7 +440,6 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
   const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
               rightJoinCol, rightSelectedCols, numColumns, maxDist, maxResults,
               joinType] = params_;
-  IdTable result{numColumns, qec_->getAllocator()};
 
   // Helper function to convert `GeoPoint` to `S2Point`
   auto constexpr toS2Point = [](const GeoPoint& p) {
@@ -467,27 +484,34 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
   auto searchTable = indexOfRight ? idTableLeft : idTableRight;
   auto searchJoinCol = indexOfRight ? leftJoinCol : rightJoinCol;
 
-  // Use the index to lookup the points of the other table
-  for (size_t searchRow = 0; searchRow < searchTable->size(); searchRow++) {
-    auto p = getPoint(searchTable, searchRow, searchJoinCol);
-    if (!p.has_value()) {
-      continue;
-    }
-    auto s2target =
-        S2ClosestPointQuery<size_t>::PointTarget{toS2Point(p.value())};
-
-    for (const auto& neighbor : s2query.FindClosestPoints(&s2target)) {
-      // In this loop we only receive points that already satisfy the given
-      // criteria
-      auto indexRow = neighbor.data();
-      auto dist = S2Earth::ToKm(neighbor.distance());
-
-      auto rowLeft = indexOfRight ? searchRow : indexRow;
-      auto rowRight = indexOfRight ? indexRow : searchRow;
-      addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft, rowRight,
-                          Id::makeFromDouble(dist));
+  // Use the index to lookup the points of the other table. The index is only
+  // read, so the rows can be processed concurrently, but each thread needs its
+  // own query object.
+  auto probeRows = [&](size_t beginRow, size_t endRow, IdTable& chunkResult) {
+    S2ClosestPointQuery<size_t> chunkQuery{&s2index, s2query.options()};
+    for (size_t searchRow = beginRow; searchRow < endRow; searchRow++) {
+      throwIfCancelled();
+      auto p = getPoint(searchTable, searchRow, searchJoinCol);
+      if (!p.has_value()) {
+        continue;
+      }
+      auto s2target =
+          S2ClosestPointQuery<size_t>::PointTarget{toS2Point(p.value())};
+
+      for (const auto& neighbor : chunkQuery.FindClosestPoints(&s2target)) {
+        // In this loop we only receive points that already satisfy the given
+        // criteria
+        auto indexRow = neighbor.data();
+        auto dist = S2Earth::ToKm(neighbor.distance());
+
+        auto rowLeft = indexOfRight ? searchRow : indexRow;
+        auto rowRight = indexOfRight ? indexRow : searchRow;
+        addResultTableEntry(&chunkResult, idTableLeft, idTableRight, rowLeft,
+                            rowRight, Id::makeFromDouble(dist));
+      }
     }
-  }
+  };
+  IdTable result = probeInParallel(searchTable->size(), probeRows);
 
   return Result(std::move(result), std::vector<ColumnIndex>{},
                 Result::getMergedLocalVocab(*resultLeft, *resultRight));
@@ -716,26 +740,177 @@ double SpatialJoinAlgorithms::getMaxDistFromMidpointToAnyPointInsideTheBox(
 // ____________________________________________________________________________
 std::optional<RtreeEntry> SpatialJoinAlgorithms::getRtreeEntry(
     const IdTable* idTable, const size_t row, const ColumnIndex col) {
-  RtreeEntry entry{row, std::nullopt, std::nullopt, std::nullopt};
-  entry.geoPoint_ = getPoint(idTable, row, col);
+  auto parsed = parseEntry(idTable, row, col);
+  if (!parsed.has_value()) {
+    return std::nullopt;
+  }
+  return makeRtreeEntry(row, std::move(parsed.value()));
+}
 
-  if (!entry.geoPoint_) {
-    entry.geometryIndex_ = getAnyGeometry(idTable, row, col);
-    if (!entry.geometryIndex_) {
-      return std::nullopt;
-    }
-    entry.boundingBox_ = boost::apply_visitor(
-        BoundingBoxVisitor(), geometries_.at(entry.geometryIndex_.value()));
+// ____________________________________________________________________________
+auto SpatialJoinAlgorithms::parseEntry(const IdTable* idTable, size_t row,
+                                       ColumnIndex col) const
+    -> std::optional<ParsedEntry> {
+  if (auto point = getPoint(idTable, row, col)) {
+    return ParsedEntry{point.value()};
+  }
+  if (auto geometry = parseAnyGeometry(idTable, row, col)) {
+    return ParsedEntry{std::move(geometry.value())};
+  }
+  return std::nullopt;
+}
+
+// ____________________________________________________________________________
+RtreeEntry SpatialJoinAlgorithms::makeRtreeEntry(size_t row,
+                                                 ParsedEntry parsed) {
+  RtreeEntry entry{row, std::nullopt, std::nullopt, std::nullopt};
+  if (auto* geometry = std::get_if<AnyGeometry>(&parsed)) {
+    geometries_.push_back(std::move(*geometry));
+    entry.geometryIndex_ = geometries_.size() - 1;
+    entry.boundingBox_ =
+        boost::apply_visitor(BoundingBoxVisitor(), geometries_.back());
   } else {
+    entry.geoPoint_ = std::get<GeoPoint>(parsed);
     entry.boundingBox_ =
         Box(Point(entry.geoPoint_.value().getLng(),
                   entry.geoPoint_.value().getLat()),
             Point(entry.geoPoint_.value().getLng() + 0.00000001,
                   entry.geoPoint_.value().getLat() + 0.00000001));
+    if (!useMidpointForAreas_) {
+      entry.geometryIndex_ = convertGeoPointToPoint(entry.geoPoint_.value());
+    }
   }
   return entry;
 }
 
+// ____________________________________________________________________________
+std::vector<std::optional<RtreeEntry>> SpatialJoinAlgorithms::getRtreeEntries(
+    const IdTable* idTable, ColumnIndex col) {
+  std::vector<std::optional<ParsedEntry>> parsed(idTable->numRows());
+  forEachChunkInParallel(
+      idTable->numRows(), [&](size_t, size_t beginRow, size_t endRow) {
+        for (size_t row = beginRow; row < endRow; ++row) {
+          throwIfCancelled();
+          parsed[row] = parseEntry(idTable, row, col);
+        }
+      });
+  // Moving the geometries to `geometries_` is cheap and done on a single
+  // thread.
+  std::vector<std::optional<RtreeEntry>> entries(parsed.size());
+  for (size_t row = 0; row < parsed.size(); ++row) {
+    if (parsed[row].has_value()) {
+      entries[row] = makeRtreeEntry(row, std::move(parsed[row].value()));
+    }
+  }
+  return entries;
+}
+
+// ____________________________________________________________________________
+size_t SpatialJoinAlgorithms::forEachChunkInParallel(
+    size_t numRows,
+    const std::function<void(size_t, size_t, size_t)>& processChunk) const {
+  size_t numThreads = std::max(
+      RuntimeParameters().get<"spatial-join-num-threads">(), size_t{1});
+  size_t numChunks = std::clamp(numRows / MIN_ROWS_PER_CHUNK, size_t{1},
+                                numThreads * CHUNKS_PER_THREAD);
+  size_t chunkSize = (numRows + numChunks - 1) / numChunks;
+  numThreads = std::min(numThreads, numChunks);
+
+  std::atomic<size_t> nextChunk = 0;
+  std::atomic<bool> hasFailed = false;
+  std::exception_ptr firstException;
+  std::mutex firstExceptionMutex;
+  auto processChunks = [&]() {
+    try {
+      while (!hasFailed) {
+        size_t chunk = nextChunk++;
+        if (chunk >= numChunks) {
+          return;
+        }
+        size_t beginRow = std::min(chunk * chunkSize, numRows);
+        processChunk(chunk, beginRow, std::min(beginRow + chunkSize, numRows));
+      }
+    } catch (...) {
+      std::lock_guard lock{firstExceptionMutex};
+      if (!hasFailed.exchange(true)) {
+        firstException = std::current_exception();
+      }
+    }
+  };
+
+  // The additional workers run on the shared thread pool of the operations,
+  // where they might only start when all the chunks have already been
+  // processed by the other workers (e.g. if all the threads of the pool are
+  // busy). Such a late worker must not touch the (then possibly destroyed)
+  // local state of this function, so it only proceeds if the computation
+  // hasn't been closed yet, and only the workers that have actually started
+  // are waited for.
+  struct WorkerState {
+    std::mutex mutex_;
+    std::condition_variable workerFinished_;
+    size_t numRunning_ = 0;
+    bool isClosed_ = false;
+  };
+  auto workerState = std::make_shared<WorkerState>();
+  for (size_t i = 1; i < numThreads; ++i) {
+    Operation::runOnSharedThreadPool([workerState, &processChunks]() {
+      {
+        std::lock_guard lock{workerState->mutex_};
+        if (workerState->isClosed_) {
+          return;
+        }
+        ++workerState->numRunning_;
+      }
+      processChunks();
+      std::lock_guard lock{workerState->mutex_};
+      --workerState->numRunning_;
+      workerState->workerFinished_.notify_all();
+    });
+  }
+  // The calling thread also processes chunks, so all the chunks are processed
+  // even if none of the additional workers ever starts.
+  processChunks();
+  {
+    std::unique_lock lock{workerState->mutex_};
+    workerState->isClosed_ = true;
+    workerState->workerFinished_.wait(
+        lock, [&workerState]() { return workerState->numRunning_ == 0; });
+  }
+  if (firstException) {
+    std::rethrow_exception(firstException);
+  }
+  if (spatialJoin_.has_value()) {
+    spatialJoin_.value()->runtimeInfo().addDetail("num-threads", numThreads);
+  }
+  return numChunks;
+}
+
+// ____________________________________________________________________________
+IdTable SpatialJoinAlgorithms::probeInParallel(
+    size_t numRows,
+    const std::function<void(size_t, size_t, IdTable&)>& probeRows) const {
+  size_t numColumns = params_.numColumns_;
+  // The results of the chunks are created on demand, because the number of
+  // chunks is only known inside of `forEachChunkInParallel`.
+  ad_utility::Synchronized<std::vector<std::optional<IdTable>>> chunkResults;
+  forEachChunkInParallel(numRows, [&](size_t chunk, size_t beginRow,
+                                      size_t endRow) {
+    IdTable chunkResult{numColumns, qec_->getAllocator()};
+    probeRows(beginRow, endRow, chunkResult);
+    auto lock = chunkResults.wlock();
+    if (lock->size() <= chunk) {
+      lock->resize(chunk + 1);
+    }
+    (*lock)[chunk] = std::move(chunkResult);
+  });
+  IdTable result{numColumns, qec_->getAllocator()};
+  for (auto& chunkResult : *chunkResults.wlock()) {
+    AD_CORRECTNESS_CHECK(chunkResult.has_value());
+    result.insertAtEnd(chunkResult.value());
+  }
+  return result;
+}
+
 // ____________________________________________________________________________
 std::vector<Box> SpatialJoinAlgorithms::getQueryBox(
     const std::optional<RtreeEntry>& entry) const {
@@ -752,6 +927,10 @@ std::vector<Box> SpatialJoinAlgorithms::getQueryBox(
 
 // ____________________________________________________________________________
 Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
+  if (auto resultFromIndex = boundingBoxAlgorithmWithSpatialIndex()) {
+    return std::move(resultFromIndex.value());
+  }
+
   // helper struct to avoid duplicate entries for areas
   struct AddedPair {
     size_t rowLeft_;
@@ -766,8 +945,6 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
   const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
               rightJoinCol, rightSelectedCols, numColumns, maxDist, maxResults,
               joinType] = params_;
-  IdTable result{numColumns, qec_->getAllocator()};
-
   // create r-tree for smaller result table
   auto smallerResult = idTableLeft;
   auto otherResult = idTableRight;
@@ -785,12 +962,10 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
              bgi::equal_to<Value>, ad_utility::AllocatorWithLimit<Value>>
       rtree(bgi::quadratic<16>{}, bgi::indexable<Value>{},
             bgi::equal_to<Value>{}, qec_->getAllocator());
-  for (size_t i = 0; i < smallerResult->numRows(); i++) {
+  for (auto& entry : getRtreeEntries(smallerResult, smallerResJoinCol)) {
     throwIfCancelled();
 
     // add every box together with the additional information into the rtree
-    std::optional<RtreeEntry> entry =
-        getRtreeEntry(smallerResult, i, smallerResJoinCol);
     if (!entry) {
       // nothing to do. When parsing a point or an area fails, a warning
       // message gets printed at another place and the point/area just gets
@@ -801,55 +976,231 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
                            std::move(entry.value())));
   }
 
-  // query rtree with the other child
-  std::vector<Value, ad_utility::AllocatorWithLimit<Value>> results{
-      qec_->getAllocator()};
-  for (size_t i = 0; i < otherResult->numRows(); i++) {
-    throwIfCancelled();
+  // query rtree with the other child. The rtree and the parsed geometries are
+  // only read from now on, so the rows can be processed concurrently.
+  auto otherEntries = getRtreeEntries(otherResult, otherResJoinCol);
+  auto probeRows = [&](size_t beginRow, size_t endRow, IdTable& chunkResult) {
+    std::vector<Value, ad_utility::AllocatorWithLimit<Value>> results{
+        qec_->getAllocator()};
+    for (size_t i = beginRow; i < endRow; i++) {
+      throwIfCancelled();
 
-    std::optional<RtreeEntry> entry =
-        getRtreeEntry(otherResult, i, otherResJoinCol);
-    if (!entry) {
-      // nothing to do. When parsing a point or an area fails, a warning
-      // message gets printed at another place and the point/area just gets
-      // skipped
-      continue;
+      std::optional<RtreeEntry> entry = otherEntries[i];
+      if (!entry) {
+        // nothing to do. When parsing a point or an area fails, a warning
+        // message gets printed at another place and the point/area just gets
+        // skipped
+        continue;
+      }
+      std::vector<Box> queryBox = getQueryBox(entry);
+
+      results.clear();
+
+      ql::ranges::for_each(queryBox, [&](const Box& bbox) {
+        rtree.query(bgi::intersects(bbox), std::back_inserter(results));
+      });
+
+      std::set<AddedPair> pairs;
+      ql::ranges::for_each(results, [&](Value& res) {
+        size_t rowLeft = res.second.row_;
+        size_t rowRight = i;
+        if (!leftResSmaller) {
+          std::swap(rowLeft, rowRight);
+        }
+        auto distance = computeDist(res.second, entry.value());
+        AD_CORRECTNESS_CHECK(distance.getDatatype() == Datatype::Double);
+        if (distance.getDouble() * 1000 <= maxDist.value()) {
+          // make sure, that no duplicate elements are inserted in the result
+          // table. As duplicates can only occur, when areas are not
+          // approximated as midpoints, the additional runtime can be saved in
+          // that case
+          if (useMidpointForAreas_) {
+            addResultTableEntry(&chunkResult, idTableLeft, idTableRight,
+                                rowLeft, rowRight, distance);
+          } else if (pairs.insert(AddedPair{rowLeft, rowRight}).second) {
+            addResultTableEntry(&chunkResult, idTableLeft, idTableRight,
+                                rowLeft, rowRight, distance);
+          }
+        }
+      });
+    }
+  };
+  IdTable result = probeInParallel(otherResult->numRows(), probeRows);
+  auto resTable =
+      Result(std::move(result), std::vector<ColumnIndex>{},
+             Result::getMergedLocalVocab(*resultLeft, *resultRight));
+  return resTable;
+}
+
+// ____________________________________________________________________________
+std::optional<Result>
+SpatialJoinAlgorithms::boundingBoxAlgorithmWithSpatialIndex() {
+  const SpatialIndex* spatialIndex = qec_->getIndex().getSpatialIndex();
+  if (spatialIndex == nullptr ||
+      !RuntimeParameters().get<"use-spatial-index">()) {
+    return std::nullopt;
+  }
+  const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
+              rightJoinCol, rightSelectedCols, numColumns, maxDist, maxResults,
+              joinType] = params_;
+
+  // Find an input, the join column of which contains only UNDEF values and
+  // literals that are covered by the index. If both inputs are suitable, the
+  // larger one is looked up in the index, because building an R-tree for it
+  // would be more expensive.
+  auto isCoveredByIndex = [spatialIndex](const IdTable* idTable,
+                                         ColumnIndex col) {
+    return ql::ranges::all_of(idTable->getColumn(col), [spatialIndex](Id id) {
+      return id.isUndefined() ||
+             (id.getDatatype() == Datatype::VocabIndex &&
+              spatialIndex->getBox(id.getVocabIndex()).has_value());
+    });
+  };
+  bool leftIsLarger = idTableLeft->numRows() >= idTableRight->numRows();
+  std::optional<bool> indexLeft;
+  for (bool left : {leftIsLarger, !leftIsLarger}) {
+    if (isCoveredByIndex(left ? idTableLeft : idTableRight,
+                         left ? leftJoinCol : rightJoinCol)) {
+      indexLeft = left;
+      break;
     }
-    std::vector<Box> queryBox = getQueryBox(entry);
+  }
+  if (!indexLeft.has_value()) {
+    return std::nullopt;
+  }
+  auto indexedTable = indexLeft.value() ? idTableLeft : idTableRight;
+  auto indexedCol = indexLeft.value() ? leftJoinCol : rightJoinCol;
+  auto otherTable = indexLeft.value() ? idTableRight : idTableLeft;
+  auto otherCol = indexLeft.value() ? rightJoinCol : leftJoinCol;
+  if (spatialJoin_.has_value()) {
+    spatialJoin_.value()->runtimeInfo().addDetail("uses-spatial-index", true);
+  }
 
-    results.clear();
+  // The rows of the indexed input for each of the literals in its join column.
+  ad_utility::HashMap<uint64_t, std::vector<size_t>> rowsOfLiteral;
+  for (size_t row = 0; row < indexedTable->numRows(); ++row) {
+    Id id = indexedTable->at(row, indexedCol);
+    if (!id.isUndefined()) {
+      rowsOfLiteral[id.getVocabIndex().get()].push_back(row);
+    }
+  }
 
-    ql::ranges::for_each(queryBox, [&](const Box& bbox) {
-      rtree.query(bgi::intersects(bbox), std::back_inserter(results));
+  // Append the literals of the indexed input, the bounding box of which
+  // intersects one of the query boxes of the `entry`, to the `candidates`
+  // (sorted and without duplicates).
+  auto getCandidates = [&](const std::optional<RtreeEntry>& entry,
+                           std::vector<VocabIndex>& candidates) {
+    candidates.clear();
+    for (const Box& box : getQueryBox(entry)) {
+      spatialIndex->getIntersecting(
+          SpatialIndex::Box{box.min_corner().get<0>(),
+                            box.min_corner().get<1>(),
+                            box.max_corner().get<0>(),
+                            box.max_corner().get<1>()},
+          candidates);
+    }
+    // The query boxes are disjoint, but a literal can intersect several of
+    // them.
+    ql::ranges::sort(candidates);
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+    std::erase_if(candidates, [&rowsOfLiteral](VocabIndex candidate) {
+      return !rowsOfLiteral.contains(candidate.get());
     });
+  };
+  auto otherEntries = getRtreeEntries(otherTable, otherCol);
+
+  // The `RtreeEntry` for each literal of the indexed input that is a candidate
+  // for at least one row of the other input. If areas are approximated by the
+  // midpoints of their bounding boxes, the bounding box from the index is
+  // sufficient and the entries are created on the fly. Otherwise, the
+  // geometries of the candidates have to be parsed, which is done before the
+  // probing, s.t. the `geometries_` are only read by the concurrent probes.
+  ad_utility::HashMap<uint64_t, std::optional<RtreeEntry>> entryOfLiteral;
+  if (!useMidpointForAreas_) {
+    ad_utility::Synchronized<std::vector<VocabIndex>> neededLiterals;
+    forEachChunkInParallel(
+        otherTable->numRows(), [&](size_t, size_t beginRow, size_t endRow) {
+          std::vector<VocabIndex> candidates;
+          std::vector<VocabIndex> chunkLiterals;
+          for (size_t i = beginRow; i < endRow; i++) {
+            throwIfCancelled();
+            if (otherEntries[i].has_value()) {
+              getCandidates(otherEntries[i], candidates);
+              chunkLiterals.insert(chunkLiterals.end(), candidates.begin(),
+                                   candidates.end());
+            }
+          }
+          auto lock = neededLiterals.wlock();
+          lock->insert(lock->end(), chunkLiterals.begin(),
+                       chunkLiterals.end());
+        });
+    auto literals = std::move(*neededLiterals.wlock());
+    ql::ranges::sort(literals);
+    literals.erase(std::unique(literals.begin(), literals.end()),
+                   literals.end());
+    std::vector<std::optional<ParsedEntry>> parsed(literals.size());
+    forEachChunkInParallel(
+        literals.size(), [&](size_t, size_t beginIdx, size_t endIdx) {
+          for (size_t j = beginIdx; j < endIdx; j++) {
+            throwIfCancelled();
+            parsed[j] = parseEntry(
+                indexedTable, rowsOfLiteral.at(literals[j].get()).front(),
+                indexedCol);
+          }
+        });
+    for (size_t j = 0; j < literals.size(); j++) {
+      auto& entry = entryOfLiteral[literals[j].get()];
+      if (parsed[j].has_value()) {
+        entry = makeRtreeEntry(rowsOfLiteral.at(literals[j].get()).front(),
+                               std::move(parsed[j].value()));
+      }
+    }
+  }
+  auto getIndexedEntry = [&](VocabIndex literal) -> std::optional<RtreeEntry> {
+    if (!useMidpointForAreas_) {
+      return entryOfLiteral.at(literal.get());
+    }
+    auto box = spatialIndex->getBox(literal).value();
+    return RtreeEntry{rowsOfLiteral.at(literal.get()).front(), std::nullopt,
+                      std::nullopt,
+                      Box{Point{box.minLng_, box.minLat_},
+                          Point{box.maxLng_, box.maxLat_}}};
+  };
 
-    std::set<AddedPair> pairs;
-    ql::ranges::for_each(results, [&](Value& res) {
-      size_t rowLeft = res.second.row_;
-      size_t rowRight = i;
-      if (!leftResSmaller) {
-        std::swap(rowLeft, rowRight);
+  auto probeRows = [&](size_t beginRow, size_t endRow, IdTable& chunkResult) {
+    std::vector<VocabIndex> candidates;
+    for (size_t i = beginRow; i < endRow; i++) {
+      throwIfCancelled();
+      std::optional<RtreeEntry> entry = otherEntries[i];
+      if (!entry) {
+        // When parsing a point or an area fails, a warning message gets
+        // printed at another place and the point/area just gets skipped.
+        continue;
       }
-      auto distance = computeDist(res.second, entry.value());
-      AD_CORRECTNESS_CHECK(distance.getDatatype() == Datatype::Double);
-      if (distance.getDouble() * 1000 <= maxDist.value()) {
-        // make sure, that no duplicate elements are inserted in the result
-        // table. As duplicates can only occur, when areas are not approximated
-        // as midpoints, the additional runtime can be saved in that case
-        if (useMidpointForAreas_) {
-          addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft,
-                              rowRight, distance);
-        } else if (pairs.insert(AddedPair{rowLeft, rowRight}).second) {
-          addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft,
+      getCandidates(entry, candidates);
+      for (VocabIndex candidate : candidates) {
+        auto indexedEntry = getIndexedEntry(candidate);
+        if (!indexedEntry.has_value()) {
+          continue;
+        }
+        auto distance = computeDist(indexedEntry.value(), entry.value());
+        AD_CORRECTNESS_CHECK(distance.getDatatype() == Datatype::Double);
+        if (distance.getDouble() * 1000 > maxDist.value()) {
+          continue;
+        }
+        for (size_t row : rowsOfLiteral.at(candidate.get())) {
+          size_t rowLeft = indexLeft.value() ? row : i;
+          size_t rowRight = indexLeft.value() ? i : row;
+          addResultTableEntry(&chunkResult, idTableLeft, idTableRight, rowLeft,
                               rowRight, distance);
         }
       }
-    });
-  }
-  auto resTable =
-      Result(std::move(result), std::vector<ColumnIndex>{},
-             Result::getMergedLocalVocab(*resultLeft, *resultRight));
-  return resTable;
+    }
+  };
+  IdTable result = probeInParallel(otherTable->numRows(), probeRows);
+  return Result(std::move(result), std::vector<ColumnIndex>{},
+                Result::getMergedLocalVocab(*resultLeft, *resultRight));
 }
 
 // ____________________________________________________________________________
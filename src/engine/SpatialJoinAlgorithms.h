@@ -14,6 +14,8 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/point.hpp>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <variant>
 
@@ -146,6 +148,15 @@ class SpatialJoinAlgorithms {
   }
 
  private:
+  // A point or a parsed geometry from a cell of an input.
+  using ParsedEntry = std::variant<GeoPoint, AnyGeometry>;
+
+  // The inputs are processed in chunks of consecutive rows, which are
+  // distributed among the threads. Each thread processes several chunks to
+  // balance the load if the work per row differs.
+  static constexpr size_t MIN_ROWS_PER_CHUNK = 1'000;
+  static constexpr size_t CHUNKS_PER_THREAD = 4;
+
   // Helper function which returns a GeoPoint if the element of the given table
   // represents a GeoPoint
   std::optional<GeoPoint> getPoint(const IdTable* restable, size_t row,
@@ -191,6 +202,47 @@ class SpatialJoinAlgorithms {
                                           const size_t row,
                                           const ColumnIndex col);
 
+  // The part of `getRtreeEntry` that doesn't modify `geometries_` and can
+  // therefore be called concurrently: Return the point or the parsed geometry
+  // of the given cell, or `std::nullopt` if the cell contains neither.
+  std::optional<ParsedEntry> parseEntry(const IdTable* idTable, size_t row,
+                                        ColumnIndex col) const;
+  std::optional<AnyGeometry> parseAnyGeometry(const IdTable* idTable,
+                                              size_t row, size_t col) const;
+
+  // The other part of `getRtreeEntry`: Create the entry for the `parsed`
+  // point or geometry, a geometry is moved to `geometries_`. If areas are not
+  // approximated by their midpoints, a point is also added to `geometries_`
+  // right away, s.t. `computeDist` doesn't have to modify `geometries_`,
+  // which makes it safe to call concurrently.
+  RtreeEntry makeRtreeEntry(size_t row, ParsedEntry parsed);
+
+  // Return the `RtreeEntry` for each row of the given column. The parsing is
+  // done concurrently (see `forEachChunkInParallel`).
+  std::vector<std::optional<RtreeEntry>> getRtreeEntries(const IdTable* idTable,
+                                                         ColumnIndex col);
+
+  // Split the rows `[0, numRows)` into chunks of consecutive rows and call
+  // `processChunk(chunkIndex, beginRow, endRow)` for each of them. The chunks
+  // are processed concurrently by up to `spatial-join-num-threads` workers,
+  // the calling thread and additional workers on the shared thread pool of
+  // the operations (see `Operation::runOnSharedThreadPool`). Return the number
+  // of chunks. If one of the calls throws (e.g. because the query was
+  // cancelled), then no further chunks are started and the first exception is
+  // rethrown after all running calls have finished.
+  size_t forEachChunkInParallel(
+      size_t numRows,
+      const std::function<void(size_t, size_t, size_t)>& processChunk) const;
+
+  // Call `probeRows(beginRow, endRow, result)` for chunks of the rows
+  // `[0, numRows)` of the probe side of a join concurrently (see
+  // `forEachChunkInParallel`). Return the concatenation of the `result`s in
+  // the order of the chunks, which is the same as for a single call with all
+  // the rows.
+  IdTable probeInParallel(
+      size_t numRows,
+      const std::function<void(size_t, size_t, IdTable&)>& probeRows) const;
+
   // this helper function converts a GeoPoint into a boost geometry Point
   size_t convertGeoPointToPoint(GeoPoint point);
 
@@ -201,6 +253,14 @@ class SpatialJoinAlgorithms {
   // If there is more than one box, the boxes are disjoint.
   std::vector<Box> getQueryBox(const std::optional<RtreeEntry>& entry) const;
 
+  // The variant of the `BoundingBoxAlgorithm` that uses the `SpatialIndex` of
+  // the vocabulary instead of building an R-tree. One of the inputs must
+  // contain only WKT literals that are covered by the index in its join
+  // column, the geometries of this input are only parsed if they are
+  // candidates for the result. Return `std::nullopt` if there is no spatial
+  // index or none of the inputs is suitable.
+  std::optional<Result> boundingBoxAlgorithmWithSpatialIndex();
+
   // This helper functions parses WKT geometries from the given `column` in
   // `idTable` and adds them to `sweeper` (which will be used to perform the
   // spatial join). The Boolean `leftOrRightSide` specifies whether these
@@ -244,8 +304,9 @@ class SpatialJoinAlgorithms {
   // number of times the parsing of a geometry failed. For now this is only used
   // to print the warning once, but it could also be used to print how many
   // geometries failed. It is mutable to let parsing function which are const
-  // still modify the the nr of failed parsings.
-  size_t numFailedParsedGeometries_ = 0;
+  // still modify the the nr of failed parsings. It is atomic, because the
+  // geometries are parsed concurrently.
+  mutable std::atomic<size_t> numFailedParsedGeometries_ = 0;
 
   // this vector stores the geometries, which have already been parsed
   std::vector<AnyGeometry, ad_utility::AllocatorWithLimit<AnyGeometry>>
@@ -211,6 +211,10 @@ size_t Union::getCostEstimate() {
 
 Result Union::computeResult(bool requestLaziness) {
   LOG(DEBUG) << "Union result computation..." << std::endl;
+  computeChildrenInParallel({_subtrees[0], _subtrees[1]},
+                            requestLaziness
+                                ? ComputationMode::LAZY_IF_SUPPORTED
+                                : ComputationMode::FULLY_MATERIALIZED);
   std::shared_ptr<const Result> subRes1 =
       _subtrees[0]->getResult(requestLaziness);
   std::shared_ptr<const Result> subRes2 =
@@ -64,6 +64,10 @@ class Union : public Operation {
       const IdTable& left, const IdTable& right,
       const std::vector<std::array<size_t, 2>>& columnOrigins) const;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   vector<QueryExecutionTree*> getChildren() override {
     return {_subtrees[0].get(), _subtrees[1].get()};
   }
@@ -45,6 +45,10 @@ class Values : public Operation {
  public:
   virtual size_t getCostEstimate() override;
 
+  std::optional<IndexRanges> getIndexRanges() override {
+    return getIndexRangesOfChildren();
+  }
+
   vector<QueryExecutionTree*> getChildren() override { return {}; }
 
  public:
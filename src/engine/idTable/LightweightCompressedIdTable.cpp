@@ -0,0 +1,222 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/idTable/LightweightCompressedIdTable.h"
+
+#include <bit>
+
+#include "util/BitUtils.h"
+#include "util/HashMap.h"
+
+namespace ad_utility {
+
+namespace {
+// The number of 64-bit words that are required to store `numValues` values with
+// `bitWidth` bits each.
+size_t numPackedWords(size_t numValues, uint8_t bitWidth) {
+  return (numValues * bitWidth + 63) / 64;
+}
+
+// Store the lower `bitWidth` bits of `value` as the `i`-th value in `packed`.
+// The values are stored consecutively and may cross word boundaries.
+void pack(ql::span<uint64_t> packed, size_t i, uint8_t bitWidth,
+          uint64_t value) {
+  size_t bit = i * bitWidth;
+  size_t word = bit / 64;
+  size_t offset = bit % 64;
+  packed[word] |= value << offset;
+  if (offset + bitWidth > 64) {
+    packed[word + 1] |= value >> (64 - offset);
+  }
+}
+
+// Retrieve the `i`-th value that was stored via `pack`.
+uint64_t unpack(ql::span<const uint64_t> packed, size_t i, uint8_t bitWidth) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  size_t bit = i * bitWidth;
+  size_t word = bit / 64;
+  size_t offset = bit % 64;
+  uint64_t value = packed[word] >> offset;
+  if (offset + bitWidth > 64) {
+    value |= packed[word + 1] << (64 - offset);
+  }
+  return value & bitMaskForLowerBits(bitWidth);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+MemorySize LightweightCompressedIdTable::Column::size() const {
+  return MemorySize::bytes(sizeof(Column) + ids_.size() * sizeof(Id) +
+                           runEnds_.size() * sizeof(uint32_t) +
+                           packed_.size() * sizeof(uint64_t));
+}
+
+// _____________________________________________________________________________
+LightweightCompressedIdTable::LightweightCompressedIdTable(const IdTable& table)
+    : numColumns_{table.numColumns()},
+      numRows_{table.numRows()},
+      allocator_{table.getAllocator()} {
+  for (size_t begin = 0; begin < numRows_; begin += BLOCK_SIZE) {
+    size_t end = std::min(begin + BLOCK_SIZE, numRows_);
+    Block& block = blocks_.emplace_back(Block{end - begin, {}});
+    block.columns_.reserve(numColumns_);
+    for (size_t col = 0; col < numColumns_; ++col) {
+      block.columns_.push_back(
+          encodeColumn(table.getColumn(col).subspan(begin, end - begin)));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+auto LightweightCompressedIdTable::encodeColumn(ql::span<const Id> ids) const
+    -> Column {
+  const size_t numRows = ids.size();
+  AD_CORRECTNESS_CHECK(numRows > 0);
+
+  // Gather the statistics that determine the size of each of the encodings.
+  size_t numRuns = 1;
+  Id::T minBits = ids[0].getBits();
+  Id::T maxBits = minBits;
+  ad_utility::HashMap<Id::T, uint32_t> dictionary;
+  bool dictionaryIsTooLarge = false;
+  for (size_t i = 0; i < numRows; ++i) {
+    Id::T bits = ids[i].getBits();
+    numRuns += i > 0 && bits != ids[i - 1].getBits();
+    minBits = std::min(minBits, bits);
+    maxBits = std::max(maxBits, bits);
+    if (!dictionaryIsTooLarge) {
+      dictionary.try_emplace(bits, static_cast<uint32_t>(dictionary.size()));
+      dictionaryIsTooLarge = dictionary.size() > MAX_DICTIONARY_SIZE;
+    }
+  }
+  auto referenceWidth = static_cast<uint8_t>(std::bit_width(maxBits - minBits));
+  auto dictionaryWidth =
+      static_cast<uint8_t>(std::bit_width(dictionary.size() - 1));
+
+  size_t rawSize = numRows * sizeof(Id);
+  size_t runLengthSize = numRuns * (sizeof(Id) + sizeof(uint32_t));
+  size_t referenceSize = numPackedWords(numRows, referenceWidth) * 8;
+  size_t dictionarySize =
+      dictionaryIsTooLarge
+          ? std::numeric_limits<size_t>::max()
+          : dictionary.size() * sizeof(Id) +
+                numPackedWords(numRows, dictionaryWidth) * 8;
+  size_t minSize =
+      std::min({rawSize, runLengthSize, referenceSize, dictionarySize});
+
+  Column column{allocator_};
+  auto packAll = [&column, numRows](uint8_t bitWidth, auto getValue) {
+    column.bitWidth_ = bitWidth;
+    // One additional word, s.t. `pack` and `unpack` never read or write out
+    // of bounds.
+    column.packed_.resize(numPackedWords(numRows, bitWidth) + 1, 0);
+    for (size_t i = 0; i < numRows; ++i) {
+      pack(column.packed_, i, bitWidth, getValue(i));
+    }
+  };
+  if (minSize == rawSize) {
+    column.encoding_ = Encoding::Raw;
+    column.ids_.assign(ids.begin(), ids.end());
+  } else if (minSize == runLengthSize) {
+    column.encoding_ = Encoding::RunLength;
+    column.ids_.reserve(numRuns);
+    column.runEnds_.reserve(numRuns);
+    // Note: We deliberately compare the bits, because `operator==` considers
+    // different `LocalVocabIndex`es with the same word to be equal.
+    for (size_t i = 0; i < numRows; ++i) {
+      if (i == 0 || ids[i].getBits() != ids[i - 1].getBits()) {
+        if (i > 0) {
+          column.runEnds_.push_back(static_cast<uint32_t>(i));
+        }
+        column.ids_.push_back(ids[i]);
+      }
+    }
+    column.runEnds_.push_back(static_cast<uint32_t>(numRows));
+  } else if (minSize == referenceSize) {
+    column.encoding_ = Encoding::FrameOfReference;
+    column.reference_ = minBits;
+    packAll(referenceWidth,
+            [&](size_t i) { return ids[i].getBits() - minBits; });
+  } else {
+    column.encoding_ = Encoding::Dictionary;
+    column.ids_.resize(dictionary.size());
+    for (const auto& [bits, index] : dictionary) {
+      column.ids_[index] = Id::fromBits(bits);
+    }
+    packAll(dictionaryWidth,
+            [&](size_t i) { return dictionary.at(ids[i].getBits()); });
+  }
+  return column;
+}
+
+// _____________________________________________________________________________
+void LightweightCompressedIdTable::decodeColumn(const Column& column,
+                                                ql::span<Id> target) {
+  switch (column.encoding_) {
+    case Encoding::Raw:
+      ql::ranges::copy(column.ids_, target.begin());
+      return;
+    case Encoding::RunLength: {
+      size_t begin = 0;
+      for (size_t run = 0; run < column.ids_.size(); ++run) {
+        size_t end = column.runEnds_[run];
+        std::fill(target.begin() + begin, target.begin() + end,
+                  column.ids_[run]);
+        begin = end;
+      }
+      return;
+    }
+    case Encoding::Dictionary:
+      for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = column.ids_[unpack(column.packed_, i, column.bitWidth_)];
+      }
+      return;
+    case Encoding::FrameOfReference:
+      for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = Id::fromBits(column.reference_ +
+                                 unpack(column.packed_, i, column.bitWidth_));
+      }
+      return;
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+MemorySize LightweightCompressedIdTable::size() const {
+  MemorySize result = MemorySize::bytes(sizeof(*this));
+  for (const auto& block : blocks_) {
+    for (const auto& column : block.columns_) {
+      result += column.size();
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+IdTable LightweightCompressedIdTable::decompressBlock(size_t blockIndex) const {
+  const Block& block = blocks_.at(blockIndex);
+  IdTable result{numColumns_, allocator_};
+  result.resize(block.numRows_);
+  for (size_t col = 0; col < numColumns_; ++col) {
+    decodeColumn(block.columns_[col], result.getColumn(col));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+IdTable LightweightCompressedIdTable::decompress() const {
+  IdTable result{numColumns_, allocator_};
+  result.resize(numRows_);
+  size_t offset = 0;
+  for (const auto& block : blocks_) {
+    for (size_t col = 0; col < numColumns_; ++col) {
+      decodeColumn(block.columns_[col],
+                   result.getColumn(col).subspan(offset, block.numRows_));
+    }
+    offset += block.numRows_;
+  }
+  return result;
+}
+
+}  // namespace ad_utility
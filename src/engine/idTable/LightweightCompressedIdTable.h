@@ -0,0 +1,114 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_IDTABLE_LIGHTWEIGHTCOMPRESSEDIDTABLE_H
+#define QLEVER_SRC_ENGINE_IDTABLE_LIGHTWEIGHTCOMPRESSEDIDTABLE_H
+
+#include <vector>
+
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/MemorySize/MemorySize.h"
+
+namespace ad_utility {
+
+// An immutable in-memory representation of an `IdTable` that is compressed
+// with lightweight encodings that are very cheap to decompress (in contrast to
+// the general-purpose compression of the `CompressedExternalIdTable`). The
+// table is split into blocks of `BLOCK_SIZE` rows, and each column of each
+// block is encoded separately with the encoding that leads to the smallest
+// size (see `Encoding` below). This works well for columns that are sorted
+// (e.g. the first column of most results), have few distinct values (e.g.
+// types or booleans), or contain small integers or `Id`s that are close to
+// each other. The blocks can be decompressed independently, which allows the
+// table to be read back lazily.
+class LightweightCompressedIdTable {
+ public:
+  static constexpr size_t BLOCK_SIZE = 1ul << 16;
+
+  enum class Encoding : uint8_t {
+    // The `Id`s are stored as is.
+    Raw,
+    // Each run of equal `Id`s is stored as the `Id` and the end of the run.
+    RunLength,
+    // The distinct `Id`s are stored once, each row stores the index of its
+    // `Id` in this dictionary with the minimal number of bits.
+    Dictionary,
+    // Each row stores the difference of the bits of its `Id` to the smallest
+    // bits in the column with the minimal number of bits.
+    FrameOfReference
+  };
+
+  // Dictionaries with more entries are not considered.
+  static constexpr size_t MAX_DICTIONARY_SIZE = 1ul << 16;
+
+ private:
+  template <typename T>
+  using Vector = std::vector<T, AllocatorWithLimit<T>>;
+
+  // A single column of a single block.
+  struct Column {
+    Encoding encoding_ = Encoding::Raw;
+    // `Raw`: The `Id`s of all rows, `RunLength`: The `Id` of each run,
+    // `Dictionary`: The distinct `Id`s.
+    Vector<Id> ids_;
+    // `RunLength`: The (exclusive) end of each run.
+    Vector<uint32_t> runEnds_;
+    // `Dictionary`, `FrameOfReference`: The bit-packed values of all rows with
+    // `bitWidth_` bits per row.
+    Vector<uint64_t> packed_;
+    uint8_t bitWidth_ = 0;
+    // `FrameOfReference`: The bits that are added to each of the packed values.
+    Id::T reference_ = 0;
+
+    explicit Column(const AllocatorWithLimit<Id>& allocator)
+        : ids_{allocator}, runEnds_{allocator}, packed_{allocator} {}
+    MemorySize size() const;
+  };
+  struct Block {
+    size_t numRows_;
+    std::vector<Column> columns_;
+  };
+
+  size_t numColumns_;
+  size_t numRows_ = 0;
+  std::vector<Block> blocks_;
+  AllocatorWithLimit<Id> allocator_;
+
+ public:
+  // Compress the `table`. The memory for the compressed table as well as for
+  // the decompressed `IdTable`s is allocated with the allocator of the `table`.
+  explicit LightweightCompressedIdTable(const IdTable& table);
+
+  size_t numRows() const { return numRows_; }
+  size_t numColumns() const { return numColumns_; }
+  size_t numBlocks() const { return blocks_.size(); }
+
+  // The total size of the compressed representation.
+  MemorySize size() const;
+
+  // Decompress the block with the given index. The blocks contain the rows of
+  // the table in order.
+  IdTable decompressBlock(size_t blockIndex) const;
+
+  // Decompress the complete table.
+  IdTable decompress() const;
+
+  // The encoding of the given column in the given block. Only used for
+  // testing.
+  Encoding getEncoding(size_t blockIndex, size_t columnIndex) const {
+    return blocks_.at(blockIndex).columns_.at(columnIndex).encoding_;
+  }
+
+ private:
+  // Encode the `Id`s of a single column of a single block.
+  Column encodeColumn(ql::span<const Id> ids) const;
+
+  // Write the decompressed `Id`s of the `column` to `target`, which must have
+  // the number of rows of the block.
+  static void decodeColumn(const Column& column, ql::span<Id> target);
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_ENGINE_IDTABLE_LIGHTWEIGHTCOMPRESSEDIDTABLE_H
@@ -30,7 +30,7 @@ struct EvaluateOnChildOperand {
     if (isAnySpecializedFunctionPossible(
             aggregateOperation._specializedFunctions, operand)) {
       auto optionalResult = evaluateOnSpecializedFunctionsIfPossible(
-          aggregateOperation._specializedFunctions, AD_FWD(operand));
+          aggregateOperation._specializedFunctions, context, AD_FWD(operand));
       AD_CONTRACT_CHECK(optionalResult);
       return std::move(optionalResult.value());
     }
@@ -0,0 +1,233 @@
+// Copyright 2025 The QLever Authors
+
+#include "engine/sparqlExpressions/DistinctIdFilterExpression.h"
+
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "global/RuntimeParameters.h"
+#include "index/TrigramIndex.h"
+#include "util/ChunkedForLoop.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
+
+namespace sparqlExpression {
+
+// _____________________________________________________________________________
+DistinctIdFilterExpression::DistinctIdFilterExpression(
+    Ptr child, std::vector<std::string> requiredSubstrings)
+    : child_{std::move(child)},
+      requiredSubstrings_{std::move(requiredSubstrings)} {
+  AD_CONTRACT_CHECK(child_ != nullptr);
+}
+
+// _____________________________________________________________________________
+std::optional<Variable> DistinctIdFilterExpression::getSingleVariable() const {
+  if (child_->containsAggregate()) {
+    return std::nullopt;
+  }
+  auto variables = child_->containedVariables();
+  if (variables.empty()) {
+    return std::nullopt;
+  }
+  const Variable& first = *variables.front();
+  if (!ql::ranges::all_of(variables, [&first](const Variable* var) {
+        return *var == first;
+      })) {
+    return std::nullopt;
+  }
+  return first;
+}
+
+// _____________________________________________________________________________
+ExpressionResult DistinctIdFilterExpression::evaluate(
+    EvaluationContext* context) const {
+  // If the variable is not a column of the input (e.g. because it is bound to
+  // the result of a previous aggregate), or if it is a grouped variable, which
+  // is constant for each group, then there is nothing to gain.
+  auto optVariable = getSingleVariable();
+  if (!optVariable.has_value() ||
+      !RuntimeParameters().get<"evaluate-filters-per-distinct-id">() ||
+      !context->getColumnIndexForVariable(optVariable.value()).has_value() ||
+      context->_groupedVariables.contains(optVariable.value())) {
+    return child_->evaluate(context);
+  }
+  const Variable& variable = optVariable.value();
+
+  // If possible, determine the candidates among the literals from the
+  // vocabulary via the trigram index.
+  const TrigramIndex* trigramIndex = context->_qec.getIndex().getTrigramIndex();
+  std::optional<std::vector<VocabIndex>> candidates;
+  if (trigramIndex != nullptr && !requiredSubstrings_.empty() &&
+      RuntimeParameters().get<"use-trigram-index">()) {
+    candidates = trigramIndex->getCandidates(requiredSubstrings_);
+  }
+  auto isRuledOut = [&candidates, trigramIndex](Id id) {
+    return candidates.has_value() && id.getDatatype() == Datatype::VocabIndex &&
+           trigramIndex->isIndexedLiteral(id.getVocabIndex()) &&
+           !ql::ranges::binary_search(candidates.value(), id.getVocabIndex());
+  };
+
+  // Without candidates from the trigram index, the evaluation per distinct
+  // `Id` only pays off if the column contains many duplicates, so check this
+  // on a sample first.
+  auto column = detail::getIdsFromVariable(variable, context);
+  if (!candidates.has_value() &&
+      !detail::hasFewDistinctIds(
+          column, context->isResultSortedBy(variable),
+          RuntimeParameters().get<"distinct-id-filter-max-distinct-ratio">(),
+          context->cancellationHandle_)) {
+    return child_->evaluate(context);
+  }
+
+  // Collect the distinct `Id`s of the column in the order of their first
+  // occurrence. We deliberately hash and compare the bits of the `Id`s, because
+  // this is much cheaper than the comparison of `LocalVocabIndex`es by their
+  // string value. The (rare) duplicates are harmless. The `Id`s that are ruled
+  // out by the trigram index are directly assigned the result `false`.
+  ad_utility::HashMapWithMemoryLimit<Id::T, size_t> distinctIndex{
+      context->_allocator};
+  VectorWithMemoryLimit<Id> resultPerDistinctId{context->_allocator};
+  IdTable idsToEvaluate{1, context->_allocator};
+  VectorWithMemoryLimit<size_t> positionsToEvaluate{context->_allocator};
+  ad_utility::chunkedForLoop<100'000>(
+      0, column.size(),
+      [&](size_t i) {
+        bool isNew = distinctIndex
+                         .try_emplace(column[i].getBits(), distinctIndex.size())
+                         .second;
+        if (!isNew) {
+          return;
+        }
+        if (isRuledOut(column[i])) {
+          resultPerDistinctId.push_back(Id::makeFromBool(false));
+        } else {
+          positionsToEvaluate.push_back(resultPerDistinctId.size());
+          idsToEvaluate.push_back({column[i]});
+          resultPerDistinctId.push_back(Id::makeUndefined());
+        }
+      },
+      [context]() { context->cancellationHandle_->throwIfCancelled(); });
+
+  // Evaluate the wrapped expression once per remaining distinct `Id`.
+  auto columnInfo = context->_variableToColumnMap.at(variable);
+  columnInfo.columnIndex_ = 0;
+  VariableToColumnMap distinctVarColMap{{variable, columnInfo}};
+  EvaluationContext distinctContext{context->_qec,
+                                    distinctVarColMap,
+                                    idsToEvaluate,
+                                    context->_allocator,
+                                    context->_localVocab,
+                                    context->cancellationHandle_,
+                                    context->deadline_};
+  distinctContext._isPartOfGroupBy = context->_isPartOfGroupBy;
+  if (!idsToEvaluate.empty()) {
+    size_t numEvaluated = 0;
+    std::visit(
+        [&](auto&& distinctResult) {
+          for (auto&& value : detail::makeGenerator(AD_FWD(distinctResult),
+                                                    idsToEvaluate.size(),
+                                                    &distinctContext)) {
+            auto copy = value;
+            resultPerDistinctId[positionsToEvaluate.at(numEvaluated)] =
+                detail::constantExpressionResultToId(std::move(copy),
+                                                     context->_localVocab);
+            ++numEvaluated;
+          }
+        },
+        child_->evaluate(&distinctContext));
+    AD_CORRECTNESS_CHECK(numEvaluated == idsToEvaluate.size());
+  }
+
+  auto resultForRow = [&](size_t i) {
+    return resultPerDistinctId[distinctIndex.at(column[i].getBits())];
+  };
+
+  // If the input is sorted by the variable, then all the rows with the same
+  // `Id` are adjacent, and a boolean result can be expressed as a (typically
+  // small) `SetOfIntervals`.
+  bool allResultsAreBool = ql::ranges::all_of(resultPerDistinctId, [](Id id) {
+    return id.getDatatype() == Datatype::Bool;
+  });
+  if (allResultsAreBool && context->isResultSortedBy(variable)) {
+    ad_utility::SetOfIntervals result;
+    size_t i = 0;
+    while (i < column.size()) {
+      size_t end = i + 1;
+      while (end < column.size() &&
+             column[end].getBits() == column[i].getBits()) {
+        ++end;
+      }
+      if (resultForRow(i).getBool()) {
+        if (!result._intervals.empty() &&
+            result._intervals.back().second == i) {
+          result._intervals.back().second = end;
+        } else {
+          result._intervals.emplace_back(i, end);
+        }
+      }
+      i = end;
+    }
+    context->cancellationHandle_->throwIfCancelled();
+    return result;
+  }
+
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(column.size());
+  ad_utility::chunkedForLoop<100'000>(
+      0, column.size(), [&](size_t i) { result.push_back(resultForRow(i)); },
+      [context]() { context->cancellationHandle_->throwIfCancelled(); });
+  return result;
+}
+
+// _____________________________________________________________________________
+bool detail::hasFewDistinctIds(
+    ql::span<const ValueId> column, bool isSorted, double maxDistinctRatio,
+    const ad_utility::SharedCancellationHandle& handle) {
+  static constexpr size_t maxSampleSize = 10'000;
+  if (column.empty()) {
+    return true;
+  }
+  // For a sorted column, the number of distinct `Id`s is the number of runs,
+  // which can be counted exactly. Otherwise, count the distinct `Id`s of an
+  // evenly spaced sample.
+  if (isSorted) {
+    size_t numDistinct = 1;
+    ad_utility::chunkedForLoop<100'000>(
+        1, column.size(),
+        [&](size_t i) {
+          numDistinct += column[i].getBits() != column[i - 1].getBits();
+        },
+        [&handle]() { handle->throwIfCancelled(); });
+    return static_cast<double>(numDistinct) <=
+           maxDistinctRatio * static_cast<double>(column.size());
+  }
+  size_t sampleSize = std::min(column.size(), maxSampleSize);
+  ad_utility::HashSet<Id::T> distinct;
+  for (size_t i = 0; i < sampleSize; ++i) {
+    distinct.insert(column[i * column.size() / sampleSize].getBits());
+  }
+  return static_cast<double>(distinct.size()) <=
+         maxDistinctRatio * static_cast<double>(sampleSize);
+}
+
+// _____________________________________________________________________________
+std::optional<std::string> detail::getConstantPatternForVariable(
+    const SparqlExpression& string, const SparqlExpression& pattern) {
+  const SparqlExpression* variable =
+      string.isStrExpression() ? string.children()[0].get() : &string;
+  if (dynamic_cast<const VariableExpression*>(variable) == nullptr) {
+    return std::nullopt;
+  }
+  const auto* literalExpression =
+      dynamic_cast<const StringLiteralExpression*>(&pattern);
+  if (literalExpression == nullptr) {
+    return std::nullopt;
+  }
+  const auto& literal = literalExpression->value();
+  if (literal.hasLanguageTag() || literal.hasDatatype()) {
+    return std::nullopt;
+  }
+  return std::string{asStringViewUnsafe(literal.getContent())};
+}
+
+}  // namespace sparqlExpression
@@ -0,0 +1,132 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_DISTINCTIDFILTEREXPRESSION_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_DISTINCTIDFILTEREXPRESSION_H
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+
+namespace sparqlExpression {
+
+// A wrapper around an expression, the value of which only depends on a single
+// variable, e.g. `REGEX(?label, "ba.*r")`, `CONTAINS(STR(?x), "foo")`, or
+// `STRSTARTS(?x, "bar")`. For such expressions, the wrapped expression is
+// evaluated only once per distinct `Id` in the column of the variable, and the
+// result is then mapped back to the rows of the input. This is much cheaper
+// than evaluating the (expensive) string functions once per row when the
+// column contains the same `Id`s many times (which e.g. is typically the case
+// for the labels after a join). If the input is sorted by the variable, then
+// the result is returned as a `SetOfIntervals`. If the wrapped expression
+// depends on more than one variable (e.g. `CONTAINS(?x, ?y)`), or contains an
+// aggregate, then it is evaluated as usual.
+//
+// The optional `requiredSubstrings` are strings that the value of the variable
+// must contain for the wrapped expression to be true (e.g. `foo` for
+// `CONTAINS(?x, "foo")`). If the index has a `TrigramIndex`, then it is used to
+// rule out the literals from the vocabulary that don't contain all of these
+// substrings. The wrapped expression is then only evaluated for the remaining
+// candidates, the result for all the other literals is `false`.
+class DistinctIdFilterExpression : public SparqlExpression {
+ private:
+  Ptr child_;
+  std::vector<std::string> requiredSubstrings_;
+
+ public:
+  explicit DistinctIdFilterExpression(
+      Ptr child, std::vector<std::string> requiredSubstrings = {});
+
+  // ___________________________________________________________________________
+  ExpressionResult evaluate(EvaluationContext* context) const override;
+
+  // The result is the same as the result of the wrapped expression, so we can
+  // also use the same cache key.
+  std::string getCacheKey(const VariableToColumnMap& varColMap) const override {
+    return child_->getCacheKey(varColMap);
+  }
+
+  // The wrapper is transparent, so all the functions that describe the
+  // expression are forwarded to the wrapped expression.
+  AggregateStatus isAggregate() const override {
+    return child_->isAggregate();
+  }
+
+  // ___________________________________________________________________________
+  std::optional<SparqlExpressionPimpl::VariableAndDistinctness>
+  getVariableForCount() const override {
+    return child_->getVariableForCount();
+  }
+
+  // ___________________________________________________________________________
+  std::optional<::Variable> getVariableOrNullopt() const override {
+    return child_->getVariableOrNullopt();
+  }
+
+  // ___________________________________________________________________________
+  bool containsLangExpression() const override {
+    return child_->containsLangExpression();
+  }
+
+  // ___________________________________________________________________________
+  bool isYearExpression() const override { return child_->isYearExpression(); }
+
+  // ___________________________________________________________________________
+  std::optional<LangFilterData> getLanguageFilterExpression() const override {
+    return child_->getLanguageFilterExpression();
+  }
+
+  // ___________________________________________________________________________
+  bool isConstantExpression() const override {
+    return child_->isConstantExpression();
+  }
+
+  // ___________________________________________________________________________
+  bool isStrExpression() const override { return child_->isStrExpression(); }
+
+  // ___________________________________________________________________________
+  bool isExistsExpression() const override {
+    return child_->isExistsExpression();
+  }
+
+  // ___________________________________________________________________________
+  std::vector<PrefilterExprVariablePair> getPrefilterExpressionForMetadata(
+      bool isNegated) const override {
+    return child_->getPrefilterExpressionForMetadata(isNegated);
+  }
+
+  // ___________________________________________________________________________
+  Estimates getEstimatesForFilterExpression(
+      uint64_t inputSize,
+      const std::optional<Variable>& firstSortedVariable) const override {
+    return child_->getEstimatesForFilterExpression(inputSize,
+                                                   firstSortedVariable);
+  }
+
+ private:
+  // The wrapped expression is the only child.
+  ql::span<Ptr> childrenImpl() override { return {&child_, 1}; }
+
+  // Return the variable if the wrapped expression contains no aggregate and
+  // all the variables it contains are the same. Else return `std::nullopt`.
+  std::optional<Variable> getSingleVariable() const;
+};
+
+namespace detail {
+// If `string` is a variable `?x` or `STR(?x)`, and `pattern` is a literal
+// without a language tag or datatype, then return the content of the `pattern`,
+// else return `std::nullopt`. This is used to determine the
+// `requiredSubstrings` of a `DistinctIdFilterExpression` for expressions like
+// `CONTAINS(?x, "foo")`.
+std::optional<std::string> getConstantPatternForVariable(
+    const SparqlExpression& string, const SparqlExpression& pattern);
+
+// Return true if the fraction of distinct `Id`s in the `column` is at most
+// `maxDistinctRatio`. For a sorted `column` the fraction is exact, otherwise it
+// is estimated from an evenly spaced sample of the `column`. The `handle` is
+// checked regularly while the exact fraction is computed.
+bool hasFewDistinctIds(ql::span<const ValueId> column, bool isSorted,
+                       double maxDistinctRatio,
+                       const ad_utility::SharedCancellationHandle& handle);
+}  // namespace detail
+
+}  // namespace sparqlExpression
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_DISTINCTIDFILTEREXPRESSION_H
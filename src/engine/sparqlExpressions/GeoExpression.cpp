@@ -174,11 +174,16 @@ std::optional<GeoFunctionCall> getGeoFunctionExpressionParameters(
   return std::nullopt;
 }
 
-// _____________________________________________________________________________
-std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
-    const SparqlExpression& expr) {
+namespace {
+
+// The two geometries and the unit of measurement of a distance function call.
+using DistArgs = std::tuple<const SparqlExpression*, const SparqlExpression*,
+                            UnitOfMeasurement>;
+
+// Helper to check if `expr` is a call to `geof:distance` or
+// `geof:metricDistance` and to extract its arguments.
+std::optional<DistArgs> getDistanceArguments(const SparqlExpression& expr) {
   using namespace ad_utility::use_type_identity;
-  using DistArgs = std::tuple<Variable, Variable, UnitOfMeasurement>;
 
   // Helper lambda to extract a unit of measurement from a SparqlExpression (IRI
   // or literal with xsd:anyURI datatype)
@@ -201,7 +206,7 @@ std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
     return std::nullopt;
   };
 
-  // Helper lambda to extract the variables and the distance unit from a
+  // Helper lambda to extract the geometries and the distance unit from a
   // distance function call
   auto extractArguments = [&](auto ti) -> std::optional<DistArgs> {
     // Check if the argument is a distance function expression
@@ -211,16 +216,6 @@ std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
       return std::nullopt;
     }
 
-    // Extract variables
-    auto p1 = distExpr->children()[0]->getVariableOrNullopt();
-    if (!p1.has_value()) {
-      return std::nullopt;
-    }
-    auto p2 = distExpr->children()[1]->getVariableOrNullopt();
-    if (!p2.has_value()) {
-      return std::nullopt;
-    }
-
     // Extract unit
     auto unit = UnitOfMeasurement::KILOMETERS;
     if constexpr (std::is_same_v<T, MetricDistExpression>) {
@@ -234,23 +229,73 @@ std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
       unit = unitOrNullopt.value();
     }
 
-    return DistArgs{p1.value(), p2.value(), unit};
+    return DistArgs{distExpr->children()[0].get(),
+                    distExpr->children()[1].get(), unit};
   };
 
   // Try all possible distance expression types
-  auto distVars = extractArguments(ti<DistExpression>);
-  if (!distVars.has_value()) {
-    distVars = extractArguments(ti<MetricDistExpression>);
+  auto distArgs = extractArguments(ti<DistExpression>);
+  if (!distArgs.has_value()) {
+    distArgs = extractArguments(ti<MetricDistExpression>);
+  }
+  if (!distArgs.has_value()) {
+    distArgs = extractArguments(ti<DistWithUnitExpression>);
+  }
+  return distArgs;
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
+    const SparqlExpression& expr) {
+  auto distArgs = getDistanceArguments(expr);
+  if (!distArgs.has_value()) {
+    return std::nullopt;
   }
-  if (!distVars.has_value()) {
-    distVars = extractArguments(ti<DistWithUnitExpression>);
+  const auto& [child1, child2, unit] = distArgs.value();
+
+  // Extract variables
+  auto p1 = child1->getVariableOrNullopt();
+  if (!p1.has_value()) {
+    return std::nullopt;
   }
-  if (!distVars.has_value()) {
+  auto p2 = child2->getVariableOrNullopt();
+  if (!p2.has_value()) {
     return std::nullopt;
   }
 
-  const auto& [v1, v2, unit] = distVars.value();
-  return GeoDistanceCall{{SpatialJoinType::WITHIN_DIST, v1, v2}, unit};
+  return GeoDistanceCall{{SpatialJoinType::WITHIN_DIST, p1.value(), p2.value()},
+                         unit};
+}
+
+// _____________________________________________________________________________
+std::optional<GeoDistanceToPointCall> getGeoDistanceToPointParameters(
+    const SparqlExpression& expr) {
+  auto distArgs = getDistanceArguments(expr);
+  if (!distArgs.has_value()) {
+    return std::nullopt;
+  }
+  const auto& [child1, child2, unit] = distArgs.value();
+
+  // The distance is symmetric, so the constant point may be either argument.
+  auto extract = [&unit](const SparqlExpression* variableChild,
+                         const SparqlExpression* pointChild)
+      -> std::optional<GeoDistanceToPointCall> {
+    auto variable = variableChild->getVariableOrNullopt();
+    auto pointExpr = dynamic_cast<const IdExpression*>(pointChild);
+    if (!variable.has_value() || pointExpr == nullptr ||
+        pointExpr->value().getDatatype() != Datatype::GeoPoint) {
+      return std::nullopt;
+    }
+    return GeoDistanceToPointCall{variable.value(),
+                                  pointExpr->value().getGeoPoint(), unit};
+  };
+  auto result = extract(child1, child2);
+  if (!result.has_value()) {
+    result = extract(child2, child1);
+  }
+  return result;
 }
 
 }  // namespace sparqlExpression
@@ -60,7 +60,7 @@ class NaryExpression : public SparqlExpression {
     if (isAnySpecializedFunctionPossible(naryOperation._specializedFunctions,
                                          operands...)) {
       auto optionalResult = evaluateOnSpecializedFunctionsIfPossible(
-          naryOperation._specializedFunctions,
+          naryOperation._specializedFunctions, context,
           std::forward<Operands>(operands)...);
       AD_CORRECTNESS_CHECK(optionalResult);
       return std::move(optionalResult.value());
@@ -3,14 +3,23 @@
 //  Author: Johannes Kalmbach <kalmbacj@cs.uni-freiburg.de>
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "engine/sparqlExpressions/VectorizedNumericKernels.h"
 #include "global/RuntimeParameters.h"
 
 namespace sparqlExpression {
 namespace detail {
+// The arithmetic expressions below use the vectorized kernels if all the
+// operands are columns of `Id`s or constant `Id`s.
+template <typename Function, bool NanOrInfToUndef = false>
+using VEC = SpecializedFunction<
+    vectorized::NumericBinaryKernel<Function, NanOrInfToUndef>,
+    decltype(vectorized::areIdColumnsOrConstants)>;
+
 // Multiplication.
 inline auto multiply = makeNumericExpression<std::multiplies<>>();
 NARY_EXPRESSION(MultiplyExpression, 2,
-                FV<decltype(multiply), NumericValueGetter>);
+                FV<decltype(multiply), NumericValueGetter>,
+                VEC<std::multiplies<>>);
 
 // Division.
 //
@@ -28,19 +37,23 @@ NARY_EXPRESSION(MultiplyExpression, 2,
 
 inline auto divide1 = makeNumericExpression<decltype(divideImpl), true>();
 NARY_EXPRESSION(DivideExpressionByZeroIsUndef, 2,
-                FV<decltype(divide1), NumericValueGetter>);
+                FV<decltype(divide1), NumericValueGetter>,
+                VEC<decltype(divideImpl), true>);
 
 inline auto divide2 = makeNumericExpression<decltype(divideImpl), false>();
 NARY_EXPRESSION(DivideExpressionByZeroIsNan, 2,
-                FV<decltype(divide2), NumericValueGetter>);
+                FV<decltype(divide2), NumericValueGetter>,
+                VEC<decltype(divideImpl), false>);
 
 // Addition and subtraction, currently all results are converted to double.
 inline auto add = makeNumericExpression<std::plus<>>();
-NARY_EXPRESSION(AddExpression, 2, FV<decltype(add), NumericValueGetter>);
+NARY_EXPRESSION(AddExpression, 2, FV<decltype(add), NumericValueGetter>,
+                VEC<std::plus<>>);
 
 inline auto subtract = makeNumericExpression<std::minus<>>();
 NARY_EXPRESSION(SubtractExpression, 2,
-                FV<decltype(subtract), NumericValueGetter>);
+                FV<decltype(subtract), NumericValueGetter>,
+                VEC<std::minus<>>);
 
 // _____________________________________________________________________________
 // Power.
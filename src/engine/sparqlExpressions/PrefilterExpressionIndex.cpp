@@ -8,6 +8,8 @@
 
 #include <absl/functional/bind_front.h>
 
+#include <numbers>
+
 #include "global/ValueIdComparators.h"
 #include "util/ConstexprMap.h"
 #include "util/OverloadCallOperator.h"
@@ -961,6 +963,26 @@ std::unique_ptr<PrefilterExpression> makePrefilterExpressionYearImpl(
   }
 };
 
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression> makePrefilterExpressionGeoDistanceImpl(
+    const GeoPoint& point, double maxDistInKilometers) {
+  AD_CONTRACT_CHECK(maxDistInKilometers >= 0);
+  // The latitude is stored in the higher bits of a `GeoPoint` `Id`, so the
+  // `GeoPoint`s are sorted by their latitude first, and all the points within
+  // the distance lie between the following two `Id`s. The band of latitudes
+  // is slightly enlarged to be robust against the reduced precision of the
+  // encoded coordinates and rounding errors.
+  constexpr double kilometersPerDegree = 6371.01 * std::numbers::pi / 180;
+  double maxDistInDegrees =
+      maxDistInKilometers / kilometersPerDegree * 1.001 + 1e-6;
+  double minLat = std::max(point.getLat() - maxDistInDegrees, -90.0);
+  double maxLat = std::min(point.getLat() + maxDistInDegrees, 90.0);
+  auto lowerBound = Id::makeFromGeoPoint(GeoPoint{minLat, -180});
+  auto upperBound = Id::makeFromGeoPoint(GeoPoint{maxLat, 180});
+  return make<AndExpression>(make<GreaterEqualExpression>(lowerBound),
+                             make<LessEqualExpression>(upperBound));
+}
+
 //______________________________________________________________________________
 template <CompOp comparison>
 static std::unique_ptr<PrefilterExpression> makePrefilterExpressionVecImpl(
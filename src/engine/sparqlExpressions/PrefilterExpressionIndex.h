@@ -22,7 +22,9 @@
 // (declared in this file) for the respective SparqlExpression is available and
 // compatible with the IndexScan. The following SparqlExpressions construct a
 // PrefilterExpression if possible: logical-or, logical-and, logical-negate
-// (unary), relational-ops and strstarts.
+// (unary), relational-ops and strstarts. Relational-ops also cover upper bounds
+// for the distance between a variable and a constant point, e.g.
+// `geof:distance(?x, "POINT(7.8 48.0)"^^geo:wktLiteral) < 5`.
 
 namespace prefilterExpressions {
 
@@ -441,6 +443,15 @@ void checkPropertiesForPrefilterConstruction(
 std::unique_ptr<PrefilterExpression> makePrefilterExpressionYearImpl(
     CompOp comparison, const int year);
 
+//______________________________________________________________________________
+// Create the `PrefilterExpression` for `geof:distance(?x, point) <
+// maxDistInKilometers`. It selects all the blocks that might contain
+// `GeoPoint`s with a latitude that is close enough to the latitude of the
+// `point`. The actual distance has to be checked by the evaluation of the
+// expression, so this prefilter must not be negated.
+std::unique_ptr<PrefilterExpression> makePrefilterExpressionGeoDistanceImpl(
+    const GeoPoint& point, double maxDistInKilometers);
+
 //______________________________________________________________________________
 // Creates a `RelationalExpression<comparison>` prefilter expression based on
 // the specified `CompOp` comparison operation and the reference
@@ -8,6 +8,7 @@
 #include "engine/SpatialJoinConfig.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "global/Constants.h"
+#include "rdfTypes/GeoPoint.h"
 #include "rdfTypes/Variable.h"
 
 // This header declares utilities required during query planning for rewriting
@@ -48,6 +49,22 @@ struct GeoDistanceCall : public GeoFunctionCall {
 std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
     const SparqlExpression& expr);
 
+// Helper struct for `getGeoDistanceToPointParameters`
+struct GeoDistanceToPointCall {
+  Variable variable_;
+  GeoPoint point_;
+  UnitOfMeasurement unit_;
+};
+
+// Check if the given `SparqlExpression` is a `geof:distance` or
+// `geof:metricDistance` call between a variable and a constant point (in any
+// order), as in `geof:distance(?x, "POINT(7.8 48.0)"^^geo:wktLiteral)`. This is
+// used for the prefiltering of the blocks of an index scan (see
+// `makePrefilterExpressionForGeoDistance`). Also implemented in
+// `GeoExpression.cpp`.
+std::optional<GeoDistanceToPointCall> getGeoDistanceToPointParameters(
+    const SparqlExpression& expr);
+
 }  // namespace sparqlExpression
 
 #endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_QUERYREWRITEEXPRESSIONHELPERS_H
@@ -9,11 +9,13 @@
 #include <re2/re2.h>
 
 #include "NaryExpressionImpl.h"
+#include "engine/sparqlExpressions/DistinctIdFilterExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
+#include "index/TrigramIndex.h"
 #include "global/ValueIdComparators.h"
 
 using namespace std::literals;
@@ -328,6 +330,15 @@ PrefixRegexExpression::makePrefixRegexExpressionIfPossible(
 SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
                                           SparqlExpression::Ptr regex,
                                           SparqlExpression::Ptr flags) {
+  // The substrings that every match of the regex contains. Flags like `i`
+  // change the meaning of the literal characters, so we only use them for
+  // regexes without flags.
+  std::vector<std::string> requiredSubstrings;
+  if (auto pattern = detail::getConstantPatternForVariable(*string, *regex);
+      pattern.has_value() && !flags) {
+    requiredSubstrings =
+        TrigramIndex::getRequiredSubstringsOfRegex(pattern.value());
+  }
   if (flags) {
     if (auto* stringLiteralExpression =
             dynamic_cast<const StringLiteralExpression*>(flags.get())) {
@@ -345,8 +356,10 @@ SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
   } else {
     detail::ensureIsValidRegexIfConstant(*regex);
   }
-  return std::make_unique<detail::RegexExpression>(std::move(string),
-                                                   std::move(regex));
+  return std::make_unique<DistinctIdFilterExpression>(
+      std::make_unique<detail::RegexExpression>(std::move(string),
+                                                std::move(regex)),
+      std::move(requiredSubstrings));
 }
 
 }  // namespace sparqlExpression
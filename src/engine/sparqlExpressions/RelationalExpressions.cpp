@@ -10,6 +10,7 @@
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/VectorizedNumericKernels.h"
 #include "util/GeoSparqlHelpers.h"
 #include "util/LambdaHelpers.h"
 #include "util/TypeTraits.h"
@@ -154,8 +155,6 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
       sparqlExpression::detail::getResultSize(*context, value1, value2);
   constexpr static bool resultIsConstant =
       (isConstantResult<S1> && isConstantResult<S2>);
-  VectorWithMemoryLimit<Id> result{context->_allocator};
-  result.reserve(resultSize);
 
   // TODO<joka921> Make this simpler by factoring out the whole binary search
   // stuff.
@@ -191,6 +190,16 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
     }
   }
 
+  // Columns of `Id`s (and constant `Id`s) can be compared by a vectorized
+  // kernel.
+  namespace vectorized = sparqlExpression::detail::vectorized;
+  if constexpr (vectorized::IdColumnOrConstant<S1> &&
+                vectorized::IdColumnOrConstant<S2> && !resultIsConstant) {
+    return vectorized::compare<Comp>(value1, value2, context);
+  }
+
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(resultSize);
   auto [generatorA, generatorB] =
       getGenerators(AD_FWD(value1), AD_FWD(value2), resultSize, context);
   auto itA = generatorA.begin();
@@ -459,15 +468,67 @@ static std::optional<std::pair<Variable, bool>> getOptVariableAndIsYear(
   return std::nullopt;
 }
 
+// _____________________________________________________________________________
+// If the relational expression with the given children has the form
+// `geof:distance(?x, point) < constant` (or `<=`, or is mirrored as in
+// `constant > geof:distance(?x, point)`), return the `PrefilterExpression` for
+// `?x` that selects the blocks that might contain points within the distance
+// (see `makePrefilterExpressionGeoDistanceImpl`). Otherwise, return an empty
+// vector.
+template <Comparison comp>
+static std::vector<PrefilterExprVariablePair> getPrefilterForGeoDistance(
+    const SparqlExpression* child0, const SparqlExpression* child1) {
+  using enum Comparison;
+  if constexpr (comp == GT || comp == GE) {
+    std::swap(child0, child1);
+  } else if constexpr (comp != LT && comp != LE) {
+    return {};
+  }
+  auto distanceCall = getGeoDistanceToPointParameters(*child0);
+  auto constantExpr = dynamic_cast<const IdExpression*>(child1);
+  if (!distanceCall.has_value() || constantExpr == nullptr ||
+      distanceCall.value().unit_ == UnitOfMeasurement::UNKNOWN) {
+    return {};
+  }
+  Id constant = constantExpr->value();
+  double maxDist = 0;
+  if (constant.getDatatype() == Datatype::Double) {
+    maxDist = constant.getDouble();
+  } else if (constant.getDatatype() == Datatype::Int) {
+    maxDist = static_cast<double>(constant.getInt());
+  } else {
+    return {};
+  }
+  if (!(maxDist >= 0)) {
+    return {};
+  }
+  const auto& [variable, point, unit] = distanceCall.value();
+  std::vector<PrefilterExprVariablePair> result;
+  result.emplace_back(
+      prefilterExpressions::detail::makePrefilterExpressionGeoDistanceImpl(
+          point, ad_utility::detail::valueInUnitToKilometer(maxDist, unit)),
+      variable);
+  return result;
+}
+
 // _____________________________________________________________________________
 template <Comparison comp>
 std::vector<PrefilterExprVariablePair>
 RelationalExpression<comp>::getPrefilterExpressionForMetadata(
-    [[maybe_unused]] bool isNegated) const {
+    bool isNegated) const {
   AD_CORRECTNESS_CHECK(children_.size() == 2);
   const SparqlExpression* child0 = children_.at(0).get();
   const SparqlExpression* child1 = children_.at(1).get();
 
+  // The prefilter for a distance only selects a superset of the relevant
+  // blocks, so its complement can't be used for the negated expression.
+  if (!isNegated) {
+    auto geoPrefilter = getPrefilterForGeoDistance<comp>(child0, child1);
+    if (!geoPrefilter.empty()) {
+      return geoPrefilter;
+    }
+  }
+
   const auto tryGetPrefilterExprVariablePairVec =
       [](const SparqlExpression* child0, const SparqlExpression* child1,
          bool reversed) -> std::vector<PrefilterExprVariablePair> {
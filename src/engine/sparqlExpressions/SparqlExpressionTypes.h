@@ -276,15 +276,20 @@ struct SpecializedFunction {
   }
 
   // Evaluate the function on the `operands`. Return std::nullopt if the
-  // function cannot be evaluated on the `operands`
+  // function cannot be evaluated on the `operands`. Functions that need access
+  // to the `context` (e.g. to read the columns of variables) take it as their
+  // first argument.
   template <typename... Operands>
   std::optional<ExpressionResult> evaluateIfOperandsAreValid(
-      Operands&&... operands) {
+      const EvaluationContext* context, Operands&&... operands) {
     if (!areAllOperandsValid<Operands...>(operands...)) {
       return std::nullopt;
     } else {
       if constexpr (ranges::invocable<Function, Operands&&...>) {
         return Function{}(std::forward<Operands>(operands)...);
+      } else if constexpr (ranges::invocable<Function, const EvaluationContext*,
+                                             Operands&&...>) {
+        return Function{}(context, std::forward<Operands>(operands)...);
       } else {
         AD_FAIL();
       }
@@ -308,13 +313,14 @@ constexpr bool isAnySpecializedFunctionPossible(SpecializedFunctionsTuple&& tup,
 /// function exists, return `std::nullopt`.
 template <typename SpecializedFunctionsTuple, typename... Operands>
 std::optional<ExpressionResult> evaluateOnSpecializedFunctionsIfPossible(
-    SpecializedFunctionsTuple&& tup, Operands&&... operands) {
+    SpecializedFunctionsTuple&& tup, const EvaluationContext* context,
+    Operands&&... operands) {
   std::optional<ExpressionResult> result = std::nullopt;
 
   auto writeToResult = [&](auto f) {
     if (!result) {
-      result =
-          f.evaluateIfOperandsAreValid(std::forward<Operands>(operands)...);
+      result = f.evaluateIfOperandsAreValid(
+          context, std::forward<Operands>(operands)...);
     }
   };
 
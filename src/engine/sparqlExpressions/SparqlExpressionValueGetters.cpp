@@ -9,6 +9,7 @@
 #include "engine/ExportQueryExecutionTrees.h"
 #include "global/Constants.h"
 #include "global/ValueId.h"
+#include "index/SpatialIndex.h"
 #include "parser/NormalizedString.h"
 #include "rdfTypes/GeometryInfo.h"
 #include "rdfTypes/Literal.h"
@@ -479,6 +480,17 @@ std::optional<RequestedInfo> GeometryInfoValueGetter<RequestedInfo>::operator()(
   switch (id.getDatatype()) {
     case LocalVocabIndex:
     case VocabIndex: {
+      // Bounding boxes of WKT literals in the vocabulary are also stored in
+      // the optional spatial index.
+      if constexpr (std::is_same_v<RequestedInfo, ad_utility::BoundingBox>) {
+        const auto* spatialIndex = context->_qec.getIndex().getSpatialIndex();
+        if (spatialIndex != nullptr && id.getDatatype() == VocabIndex) {
+          auto box = spatialIndex->getBox(id.getVocabIndex());
+          if (box.has_value()) {
+            return box.value().toBoundingBox();
+          }
+        }
+      }
       auto precomputed = getPrecomputedGeometryInfo(id, context);
       if (precomputed.has_value()) {
         return precomputed.value().getRequestedInfo<RequestedInfo>();
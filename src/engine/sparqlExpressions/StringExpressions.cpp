@@ -6,6 +6,7 @@
 
 #include <boost/url.hpp>
 
+#include "engine/sparqlExpressions/DistinctIdFilterExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
@@ -653,7 +654,11 @@ Expr makeSubstrExpression(Expr string, Expr start, Expr length) {
 }
 
 Expr makeStrStartsExpression(Expr child1, Expr child2) {
-  return make<StrStartsExpression>(child1, child2);
+  auto prefix = detail::getConstantPatternForVariable(*child1, *child2);
+  return std::make_unique<DistinctIdFilterExpression>(
+      make<StrStartsExpression>(child1, child2),
+      prefix.has_value() ? std::vector{std::move(prefix.value())}
+                         : std::vector<std::string>{});
 }
 
 Expr makeLowercaseExpression(Expr child) {
@@ -684,7 +689,11 @@ Expr makeReplaceExpression(Expr input, Expr pattern, Expr repl, Expr flags) {
   return make<ReplaceExpression>(input, pattern, repl);
 }
 Expr makeContainsExpression(Expr child1, Expr child2) {
-  return make<ContainsExpression>(child1, child2);
+  auto substring = detail::getConstantPatternForVariable(*child1, *child2);
+  return std::make_unique<DistinctIdFilterExpression>(
+      make<ContainsExpression>(child1, child2),
+      substring.has_value() ? std::vector{std::move(substring.value())}
+                            : std::vector<std::string>{});
 }
 Expr makeConcatExpression(std::vector<Expr> children) {
   return std::make_unique<ConcatExpression>(std::move(children));
@@ -0,0 +1,182 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDNUMERICKERNELS_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDNUMERICKERNELS_H
+
+#include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "util/ChunkedForLoop.h"
+
+// Kernels that evaluate relational and arithmetic expressions on whole columns
+// of `ValueId`s. The generic evaluation of these expressions goes through
+// generators and value getters and thus costs several (indirect) function calls
+// and unpredictable branches per row. The kernels instead work directly on the
+// bits of the `Id`s: For each row, the values for all the possible numeric
+// datatypes are decoded and combined without branches, and the correct one is
+// then selected via the datatype bits. This allows the compiler to vectorize
+// the inner loops. The results are exactly the same as those of the generic
+// evaluation.
+namespace sparqlExpression::detail::vectorized {
+
+using valueIdComparators::Comparison;
+
+// The operands that the kernels work on: columns of `Id`s and constant `Id`s.
+template <typename T>
+CPP_concept IdColumn =
+    ad_utility::SimilarToAny<T, ::Variable, VectorWithMemoryLimit<ValueId>>;
+template <typename T>
+CPP_concept IdColumnOrConstant =
+    IdColumn<T> || ad_utility::SimilarTo<T, ValueId>;
+
+// True iff all the `operands` are `IdColumnOrConstant` and at least one of
+// them is a column (if all of them are constants, then the generic evaluation
+// is just as cheap).
+inline auto areIdColumnsOrConstants = [](const auto&... operands) constexpr {
+  return (... && IdColumnOrConstant<std::decay_t<decltype(operands)>>) &&
+         (... || IdColumn<std::decay_t<decltype(operands)>>);
+};
+
+// Return a function that maps `i` to the `i`-th `Id` of the `operand`.
+inline auto makeAccessor(const ::Variable& variable,
+                         const EvaluationContext* context) {
+  return [ids = getIdsFromVariable(variable, context)](size_t i) {
+    return ids[i];
+  };
+}
+inline auto makeAccessor(const VectorWithMemoryLimit<ValueId>& vector,
+                         const EvaluationContext*) {
+  return [ids = ql::span<const ValueId>{vector}](size_t i) { return ids[i]; };
+}
+inline auto makeAccessor(ValueId constant, const EvaluationContext*) {
+  return [constant](size_t) { return constant; };
+}
+
+// The numeric value of an `Id`, decoded without branches. Only `Int` and
+// `Double` (and `Bool` if `BoolIsNumeric` is true) are numeric. For all other
+// datatypes the values are unspecified.
+struct DecodedNumber {
+  bool isNumeric_;
+  // True for `Int` (and `Bool`), false for `Double`.
+  bool isInt_;
+  int64_t intValue_;
+  double doubleValue_;
+};
+
+// The arithmetic expressions treat `Bool`s as the integers 0 and 1 (see
+// `NumericValueGetter`), the comparisons treat them as a separate datatype
+// (see `compareIds`).
+template <bool BoolIsNumeric>
+inline DecodedNumber decode(ValueId id) {
+  auto datatypeBits = id.getBits() >> ValueId::numDataBits;
+  auto is = [datatypeBits](Datatype type) {
+    return datatypeBits == static_cast<ValueId::T>(type);
+  };
+  bool isBool = BoolIsNumeric && is(Datatype::Bool);
+  bool isInt = is(Datatype::Int) || isBool;
+  int64_t intValue = isBool ? static_cast<int64_t>(id.getBool()) : id.getInt();
+  double doubleValue = isInt ? static_cast<double>(intValue) : id.getDouble();
+  return {isInt || is(Datatype::Double), isInt, intValue, doubleValue};
+}
+
+// Compute `a Comp b` for all rows of the operands `a` and `b`. The result is
+// the same as that of `compareIds<AlwaysUndef>`.
+CPP_template(Comparison Comp, typename A, typename B)(
+    requires IdColumnOrConstant<A> CPP_and IdColumnOrConstant<B>)
+    VectorWithMemoryLimit<ValueId> compare(const A& a, const B& b,
+                                           const EvaluationContext* context) {
+  auto getA = makeAccessor(a, context);
+  auto getB = makeAccessor(b, context);
+  size_t size = getResultSize(*context, a, b);
+  VectorWithMemoryLimit<ValueId> result{context->_allocator};
+  result.resize(size);
+  auto checkCancellation = [context]() {
+    context->cancellationHandle_->throwIfCancelled();
+  };
+
+  // First handle the rows where both values are numeric. Two integers are
+  // compared exactly, all other pairs of numeric values are compared as
+  // `double`s (just like in `compareIds`).
+  size_t numNonNumeric = 0;
+  ad_utility::chunkedForLoop<100'000>(
+      0, size,
+      [&](size_t i) {
+        auto x = decode<false>(getA(i));
+        auto y = decode<false>(getB(i));
+        bool intResult = applyComparison<Comp>(x.intValue_, y.intValue_);
+        bool doubleResult =
+            applyComparison<Comp>(x.doubleValue_, y.doubleValue_);
+        bool isNumeric = x.isNumeric_ && y.isNumeric_;
+        bool comparison = x.isInt_ && y.isInt_ ? intResult : doubleResult;
+        result[i] = isNumeric ? ValueId::makeFromBool(comparison)
+                              : ValueId::makeUndefined();
+        numNonNumeric += !isNumeric;
+      },
+      checkCancellation);
+
+  // The remaining rows (e.g. two strings) are handled by the generic
+  // comparison.
+  if (numNonNumeric > 0) {
+    ad_utility::chunkedForLoop<100'000>(
+        0, size,
+        [&](size_t i) {
+          ValueId x = getA(i);
+          ValueId y = getB(i);
+          if (!(decode<false>(x).isNumeric_ && decode<false>(y).isNumeric_)) {
+            result[i] = valueIdComparators::toValueId(
+                valueIdComparators::compareIds(x, y, Comp));
+          }
+        },
+        checkCancellation);
+  }
+  return result;
+}
+
+// Apply the binary numeric `Function` (e.g. `std::plus<>`) to all rows of the
+// operands `a` and `b`. The result is the same as that of the generic
+// evaluation via `makeNumericExpression<Function, NanOrInfToUndef>` and the
+// `NumericValueGetter`.
+template <typename Function, bool NanOrInfToUndef = false>
+struct NumericBinaryKernel {
+  CPP_template(typename A, typename B)(
+      requires IdColumnOrConstant<A> CPP_and IdColumnOrConstant<B>)
+      ExpressionResult
+      operator()(const EvaluationContext* context, const A& a,
+                 const B& b) const {
+    // If the `Function` maps two integers to an integer (e.g. for `+`, but not
+    // for `/`), then integer inputs yield an integer result.
+    constexpr bool intResultForInts =
+        std::is_integral_v<std::invoke_result_t<Function, int64_t, int64_t>>;
+    auto getA = makeAccessor(a, context);
+    auto getB = makeAccessor(b, context);
+    size_t size = getResultSize(*context, a, b);
+    VectorWithMemoryLimit<ValueId> result{context->_allocator};
+    result.resize(size);
+    ad_utility::chunkedForLoop<100'000>(
+        0, size,
+        [&](size_t i) {
+          auto x = decode<true>(getA(i));
+          auto y = decode<true>(getB(i));
+          ValueId value = makeNumericId<NanOrInfToUndef>(
+              Function{}(x.doubleValue_, y.doubleValue_));
+          if constexpr (intResultForInts) {
+            // The integer operation is performed on unsigned integers to
+            // avoid undefined behavior on overflow, the lower 60 bits (which
+            // are stored in the `Id`) are the same.
+            auto intValue = static_cast<int64_t>(
+                Function{}(static_cast<uint64_t>(x.intValue_),
+                           static_cast<uint64_t>(y.intValue_)));
+            value = x.isInt_ && y.isInt_ ? ValueId::makeFromInt(intValue)
+                                         : value;
+          }
+          result[i] = x.isNumeric_ && y.isNumeric_ ? value
+                                                   : ValueId::makeUndefined();
+        },
+        [context]() { context->cancellationHandle_->throwIfCancelled(); });
+    return result;
+  }
+};
+
+}  // namespace sparqlExpression::detail::vectorized
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDNUMERICKERNELS_H
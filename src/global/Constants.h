@@ -170,6 +170,11 @@ constexpr inline std::string_view UNIT_MILE_IRI =
 constexpr std::string_view SF_PREFIX = "http://www.opengis.net/ont/sf#";
 
 constexpr inline std::string_view VOCAB_SUFFIX = ".vocabulary";
+constexpr inline std::string_view TRIGRAM_INDEX_SUFFIX =
+    ".vocabulary.trigrams";
+constexpr inline std::string_view SPATIAL_INDEX_SUFFIX = ".vocabulary.spatial";
+constexpr inline std::string_view SORT_KEY_PREFIXES_SUFFIX =
+    ".vocabulary.sort-key-prefixes";
 constexpr inline std::string_view MMAP_FILE_SUFFIX = ".meta";
 constexpr inline std::string_view CONFIGURATION_FILE = ".meta-data.json";
 
@@ -14,6 +14,7 @@ inline auto& RuntimeParameters() {
   using ad_utility::detail::parameterShortNames::Int;
   using ad_utility::detail::parameterShortNames::MemorySizeParameter;
   using ad_utility::detail::parameterShortNames::SizeT;
+  using ad_utility::detail::parameterShortNames::String;
   // NOTE: It is important that the value of the static variable is created by
   // an immediately invoked lambda, otherwise we get really strange segfaults on
   // Clang 16 and 17.
@@ -41,6 +42,38 @@ inline auto& RuntimeParameters() {
         SizeT<"cache-max-num-entries">{1000},
         MemorySizeParameter<"cache-max-size">{30_GB},
         MemorySizeParameter<"cache-max-size-single-entry">{5_GB},
+        // The strategy that determines which entries are removed from the
+        // query result cache when it is full, either `lru` (least recently
+        // used) or `gdsf` (cost-aware, see `ad_utility::EvictionPolicy`).
+        [] {
+          String<"cache-eviction-policy"> parameter{"lru"};
+          parameter.setParameterConstraint(
+              [](const std::string& value, std::string_view parameterName) {
+                if (value != "lru" && value != "gdsf") {
+                  throw std::runtime_error{absl::StrCat(
+                      "Parameter ", parameterName,
+                      " must be \"lru\" or \"gdsf\", was \"", value, "\"")};
+                }
+              });
+          return parameter;
+        }(),
+        // If true, fully materialized results are stored in the query result
+        // cache with a lightweight compression of their columns (see
+        // `CacheValue::compress`), s.t. more results fit into the cache.
+        Bool<"cache-compress-results">{false},
+        // If true, a result that is not contained in the cache is derived from
+        // the cached result of a more general subtree (e.g. with a larger
+        // LIMIT or fewer bound constants) if possible.
+        Bool<"cache-derive-from-general-results">{false},
+        // The directory of the optional second tier of the query result cache
+        // on disk (see `DiskResultCache`). If empty, there is no second tier.
+        // Both parameters are only read when the server is started.
+        String<"disk-cache-directory">{""},
+        MemorySizeParameter<"disk-cache-max-size">{100_GB},
+        // The maximal number of additional threads (for all queries together)
+        // that are used to compute independent subtrees of a query (e.g. the
+        // children of a UNION) concurrently. Zero disables this.
+        SizeT<"parallel-subtrees-max-threads">{0},
         SizeT<"lazy-index-scan-queue-size">{20},
         SizeT<"lazy-index-scan-num-threads">{10},
         ensureStrictPositivity(
@@ -65,6 +98,21 @@ inline auto& RuntimeParameters() {
         SizeT<"group-by-hash-map-group-threshold">{1'000'000},
         SizeT<"service-max-value-rows">{10'000},
         SizeT<"query-planning-budget">{1500},
+        // If true, connected components of a basic graph pattern that consist
+        // only of index scans and are cyclic (e.g. triangles) are computed by a
+        // single worst-case-optimal `LeapfrogTriejoin` instead of a cascade of
+        // binary joins.
+        Bool<"use-worst-case-optimal-join">{false},
+        // If the left child of a join is estimated to have at most this many
+        // rows, it is fully materialized first and the distinct values of its
+        // join column are pushed as a filter into the index scans of the right
+        // child (see `RuntimeFilter`). Zero disables this.
+        SizeT<"runtime-filter-max-size">{0},
+        // If set, connected components of the query that consist only of index
+        // scans which share a single variable (stars like `?s <p1> ?a . ?s <p2>
+        // ?b . ?s <p3> ?c`) are computed by a `FactorizedStarJoin`, which does
+        // not expand the cross products for a following GROUP BY or DISTINCT.
+        Bool<"use-factorized-star-join">{false},
         Bool<"throw-on-unbound-variables">{false},
         // Control up until which size lazy results should be cached. Caching
         // does cause significant overhead for this case.
@@ -107,6 +155,29 @@ inline auto& RuntimeParameters() {
         // prefilter-free baseline, or for debugging, as wrong results may be
         // related to the `PrefilterExpression`s.
         Bool<"enable-prefilter-on-index-scans">{true},
+        // If set to `true`, expensive string filters that only depend on a
+        // single variable (e.g. `REGEX(?x, "a.*b")`, `CONTAINS(?x, "ab")`) are
+        // evaluated only once per distinct `Id` in the column of the variable
+        // (see `DistinctIdFilterExpression.h`).
+        Bool<"evaluate-filters-per-distinct-id">{false},
+        // The per-distinct-`Id` evaluation from above is skipped if the
+        // fraction (distinct `Id`s / rows) in a sample of the column exceeds
+        // this ratio, because then it only adds the overhead of the hash map.
+        Double<"distinct-id-filter-max-distinct-ratio">{0.5},
+        // If set to `true` and the index has a trigram index for its literals,
+        // then the literals that can't match a filter like `CONTAINS(?x,
+        // "foo")` are ruled out via the trigram index instead of evaluating the
+        // filter for them (see `TrigramIndex.h`).
+        Bool<"use-trigram-index">{true},
+        // If set to `true` and the index has a spatial index for its WKT
+        // literals, then spatial joins with the bounding box algorithm query
+        // this index instead of building an R-tree for one of their inputs
+        // (see `SpatialIndex.h`).
+        Bool<"use-spatial-index">{true},
+        // The number of threads that are used by the bounding box and the S2
+        // algorithm of the spatial join to parse their inputs and to probe the
+        // rows of one input against the index of the other one.
+        SizeT<"spatial-join-num-threads">{1},
     };
   }();
   return params;
@@ -56,6 +56,19 @@ constexpr inline std::string_view PARTIAL_VOCAB_FILE_NAME =
     ".tmp.partial-vocabulary.";
 constexpr inline std::string_view PARTIAL_MMAP_IDS = ".tmp.partial-ids-mmap.";
 
+// Every `PARTIAL_VOCAB_SAMPLE_DISTANCE`-th word of a partial vocabulary is
+// also written to a file with the suffix `PARTIAL_VOCAB_SAMPLES_SUFFIX`,
+// together with its position in the partial vocabulary. From these samples,
+// the merging of the partial vocabularies is split into (at most)
+// `NUM_PARALLEL_VOCABULARY_MERGE_RANGES` ranges of words that are merged in
+// parallel. All ranges but the first are written to temporary files with the
+// prefix `MERGED_VOCAB_RANGE_FILE_NAME`.
+constexpr inline std::string_view PARTIAL_VOCAB_SAMPLES_SUFFIX = ".samples";
+constexpr inline size_t PARTIAL_VOCAB_SAMPLE_DISTANCE = 10'000;
+constexpr inline size_t NUM_PARALLEL_VOCABULARY_MERGE_RANGES = 4;
+constexpr inline std::string_view MERGED_VOCAB_RANGE_FILE_NAME =
+    ".tmp.merged-vocabulary-range.";
+
 // ________________________________________________________________
 constexpr inline std::string_view TMP_BASENAME_COMPRESSION =
     ".tmp.for-prefix-compression";
@@ -74,6 +87,12 @@ constexpr inline size_t NUM_PARALLEL_ITEM_MAPS = 10;
 // parser is used.
 constexpr inline size_t NUM_PARALLEL_PARSER_THREADS = 8;
 
+// The default number of threads that build the postings of the text index in
+// parallel, and the minimal number of lines of the words file per shard that
+// is processed by one of these threads (see `TextIndexBuilder`).
+constexpr inline size_t NUM_THREADS_TEXT_INDEX_BUILDING = 8;
+constexpr inline size_t NUM_LINES_PER_TEXT_INDEX_SHARD = 100'000;
+
 // Increasing the following two constants increases the RAM usage without much
 // benefit to the performance.
 
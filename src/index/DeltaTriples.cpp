@@ -29,6 +29,7 @@ void DeltaTriples::clear() {
   triplesInserted_.clear();
   triplesDeleted_.clear();
   ql::ranges::for_each(locatedTriples(), &LocatedTriplesPerBlock::clear);
+  pendingChanges_.reset();
 }
 
 // ____________________________________________________________________________
@@ -163,6 +164,15 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
   std::erase_if(triples, [&targetMap](const IdTriple<0>& triple) {
     return targetMap.contains(triple);
   });
+  // Remember the ranges that are affected by the remaining triples.
+  if (pendingChanges_.has_value()) {
+    ql::ranges::for_each(triples, [this](const IdTriple<0>& triple) {
+      pendingChanges_->add(triple);
+    });
+    if (pendingChanges_->size() > MAX_NUM_RANGES_PER_CHANGE) {
+      pendingChanges_.reset();
+    }
+  }
   ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
     auto handle = inverseMap.find(triple);
     if (handle != inverseMap.end()) {
@@ -199,8 +209,61 @@ SharedLocatedTriplesSnapshot DeltaTriples::getSnapshot() {
   // copies), hence the explicit `clone`.
   auto snapshotIndex = nextSnapshotIndex_;
   ++nextSnapshotIndex_;
+  // The first snapshot is not created by a modification.
+  if (snapshotIndex > 0) {
+    recentChanges_.push_back(std::make_shared<const DeltaTriplesChange>(
+        DeltaTriplesChange{snapshotIndex, std::move(pendingChanges_)}));
+    if (recentChanges_.size() > MAX_NUM_RECENT_CHANGES) {
+      recentChanges_.erase(recentChanges_.begin());
+    }
+  }
+  pendingChanges_.emplace();
   return SharedLocatedTriplesSnapshot{std::make_shared<LocatedTriplesSnapshot>(
-      locatedTriples(), localVocab_.getLifetimeExtender(), snapshotIndex)};
+      locatedTriples(), localVocab_.getLifetimeExtender(), snapshotIndex,
+      recentChanges_)};
+}
+
+// ____________________________________________________________________________
+void IndexRanges::add(Permutation::Enum permutation, Id id) {
+  auto position = Permutation::toKeyOrder(permutation).keys().at(0);
+  idsPerPosition_.at(position).insert(id);
+}
+
+// ____________________________________________________________________________
+void IndexRanges::add(const IdTriple<0>& triple) {
+  for (size_t i = 0; i < idsPerPosition_.size(); ++i) {
+    idsPerPosition_[i].insert(triple.ids()[i]);
+  }
+}
+
+// ____________________________________________________________________________
+void IndexRanges::add(const IndexRanges& other) {
+  for (size_t i = 0; i < idsPerPosition_.size(); ++i) {
+    idsPerPosition_[i].insert(other.idsPerPosition_[i].begin(),
+                              other.idsPerPosition_[i].end());
+  }
+}
+
+// ____________________________________________________________________________
+size_t IndexRanges::size() const {
+  return idsPerPosition_[0].size() + idsPerPosition_[1].size() +
+         idsPerPosition_[2].size();
+}
+
+// ____________________________________________________________________________
+bool IndexRanges::intersects(const IndexRanges& other) const {
+  for (size_t i = 0; i < idsPerPosition_.size(); ++i) {
+    const auto& [smaller, larger] =
+        std::minmax(idsPerPosition_[i], other.idsPerPosition_[i],
+                    [](const auto& a, const auto& b) {
+                      return a.size() < b.size();
+                    });
+    if (ql::ranges::any_of(smaller,
+                           [&larger](Id id) { return larger.contains(id); })) {
+      return true;
+    }
+  }
+  return false;
 }
 
 // ____________________________________________________________________________
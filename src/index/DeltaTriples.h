@@ -18,6 +18,7 @@
 #include "index/IndexBuilderTypes.h"
 #include "index/LocatedTriples.h"
 #include "index/Permutation.h"
+#include "util/HashSet.h"
 #include "util/Synchronized.h"
 
 // Typedef for one `LocatedTriplesPerBlock` object for each of the six
@@ -25,6 +26,38 @@
 using LocatedTriplesPerBlockAllPermutations =
     std::array<LocatedTriplesPerBlock, Permutation::ALL.size()>;
 
+// A set of ranges of the permutations. Each range consists of all the triples
+// with a given `Id` at a given position (subject, predicate, or object), which
+// is a contiguous range in the two permutations that are sorted by this
+// position first (e.g. PSO and POS for the predicate). This is used to find
+// out which cached query results are not affected by an update.
+struct IndexRanges {
+  // The `Id`s for the subject, predicate, and object position.
+  std::array<ad_utility::HashSet<Id>, 3> idsPerPosition_;
+
+  // Add the range of the `id` in the first column of the `permutation`.
+  void add(Permutation::Enum permutation, Id id);
+  // Add the ranges that contain the `triple`.
+  void add(const IdTriple<0>& triple);
+  // Add all the ranges of `other`.
+  void add(const IndexRanges& other);
+
+  // The total number of ranges.
+  size_t size() const;
+
+  // Return true iff this and `other` have at least one range in common.
+  bool intersects(const IndexRanges& other) const;
+};
+
+// The ranges of the permutations that were affected by a single modification
+// of the `DeltaTriples`, see `LocatedTriplesSnapshot::recentChanges_` below.
+struct DeltaTriplesChange {
+  // The index of the snapshot that was created by the modification.
+  size_t snapshotIndex_;
+  // `std::nullopt` means that any part of the index might have been affected.
+  std::optional<IndexRanges> ranges_;
+};
+
 // The locations of a set of delta triples (triples that were inserted or
 // deleted since the index was built) in each of the six permutations, and a
 // local vocab. This is all the information that is required to perform a query
@@ -37,6 +70,11 @@ struct LocatedTriplesSnapshot {
   LocalVocab::LifetimeExtender localVocabLifetimeExtender_;
   // A unique index for this snapshot that is used in the query cache.
   size_t index_;
+  // The most recent modifications of the `DeltaTriples`, oldest first. The
+  // last one has created this snapshot, the first ones might be missing (the
+  // number is bounded). This can be used to reuse cached results from earlier
+  // snapshots for which the relevant parts of the index have not changed.
+  std::vector<std::shared_ptr<const DeltaTriplesChange>> recentChanges_;
   // Get `TripleWithPosition` objects for given permutation.
   const LocatedTriplesPerBlock& getLocatedTriplesForPermutation(
       Permutation::Enum permutation) const;
@@ -87,6 +125,10 @@ class DeltaTriples {
   using Triples = std::vector<IdTriple<0>>;
   using CancellationHandle = ad_utility::SharedCancellationHandle;
 
+  // The bounds for `LocatedTriplesSnapshot::recentChanges_`.
+  static constexpr size_t MAX_NUM_RECENT_CHANGES = 32;
+  static constexpr size_t MAX_NUM_RANGES_PER_CHANGE = 100'000;
+
  private:
   // The index to which these triples are added.
   const IndexImpl& index_;
@@ -102,6 +144,13 @@ class DeltaTriples {
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
+  // The ranges that were affected by the modifications since the last
+  // snapshot, and the most recent changes for `LocatedTriplesSnapshot::
+  // recentChanges_`. If too many ranges were affected, `pendingChanges_` is
+  // `std::nullopt`, which means that any part of the index might have changed.
+  std::optional<IndexRanges> pendingChanges_{std::in_place};
+  std::vector<std::shared_ptr<const DeltaTriplesChange>> recentChanges_;
+
   // Assert that the Permutation Enum values have the expected int values.
   // This is used to store and lookup items that exist for permutation in an
   // array.
@@ -4,22 +4,214 @@
 
 #include "DocsDB.h"
 
+#include <absl/strings/str_cat.h>
+#include <zdict.h>
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <optional>
+
 #include "../global/Constants.h"
 #include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+
+namespace {
+// Call `callback(text)` for each record from the `docsFileName` (see
+// `DocsDB::writeFromDocsFile`) in the order of the record indices, including
+// the empty records for the missing indices. Stop when the `callback` returns
+// false.
+template <typename Callback>
+void forEachRecord(const std::string& docsFileName, Callback callback) {
+  std::ifstream docsFile{docsFileName};
+  uint64_t nextRecord = 0;
+  std::string line;
+  line.reserve(BUFFER_SIZE_DOCSFILE_LINE);
+  while (std::getline(docsFile, line)) {
+    std::string_view lineView = line;
+    size_t tab = lineView.find('\t');
+    uint64_t contextId = 0;
+    std::from_chars(lineView.data(), lineView.data() + tab, contextId);
+    for (; nextRecord < contextId; ++nextRecord) {
+      if (!callback(std::string_view{})) {
+        return;
+      }
+    }
+    ++nextRecord;
+    if (!callback(lineView.substr(tab + 1))) {
+      return;
+    }
+  }
+}
+
+// Train a zstd dictionary on the first records of the `docsFileName`. Return
+// an empty dictionary if the training fails (e.g. because there are too few
+// records), the blocks are then compressed without a dictionary.
+std::string trainDictionary(const std::string& docsFileName) {
+  std::string samples;
+  std::vector<size_t> sampleSizes;
+  forEachRecord(docsFileName, [&](std::string_view text) {
+    if (!text.empty()) {
+      samples.append(text);
+      sampleSizes.push_back(text.size());
+    }
+    return samples.size() < DocsDB::MAX_DICTIONARY_SAMPLE_SIZE;
+  });
+  std::string dictionary(DocsDB::MAX_DICTIONARY_SIZE, '\0');
+  size_t dictionarySize = ZDICT_trainFromBuffer(
+      dictionary.data(), dictionary.size(), samples.data(), sampleSizes.data(),
+      static_cast<unsigned>(sampleSizes.size()));
+  if (ZDICT_isError(dictionarySize)) {
+    LOG(INFO) << "Compressing the text records without a dictionary ("
+              << ZDICT_getErrorName(dictionarySize) << ")" << std::endl;
+    return {};
+  }
+  dictionary.resize(dictionarySize);
+  return dictionary;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void DocsDB::writeFromDocsFile(const std::string& docsFileName,
+                               const std::string& fileName) {
+  std::string dictionary = trainDictionary(docsFileName);
+  ad_utility::File file{fileName, "w"};
+  file.write(MAGIC_BYTES.data(), MAGIC_BYTES.size());
+  file.write(dictionary.data(), dictionary.size());
+  uint64_t offsetInFile = MAGIC_BYTES.size() + dictionary.size();
+
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> compressionDictionary{
+      dictionary.empty() ? nullptr
+                         : ZSTD_createCDict(dictionary.data(),
+                                            dictionary.size(),
+                                            COMPRESSION_LEVEL),
+      &ZSTD_freeCDict};
+  AD_CORRECTNESS_CHECK(context != nullptr);
+  AD_CORRECTNESS_CHECK(dictionary.empty() || compressionDictionary != nullptr);
+
+  std::vector<BlockMetadata> blocks;
+  uint64_t numRecords = 0;
+  // The offsets and the text of the current block.
+  std::vector<uint64_t> offsets{0};
+  std::string text;
+  std::string block;
+  std::string compressed;
+  auto writeBlock = [&]() {
+    size_t numRecordsInBlock = offsets.size() - 1;
+    if (numRecordsInBlock == 0) {
+      return;
+    }
+    block.resize(offsets.size() * sizeof(uint64_t));
+    std::memcpy(block.data(), offsets.data(), block.size());
+    block.append(text);
+    compressed.resize(ZSTD_compressBound(block.size()));
+    size_t compressedSize =
+        compressionDictionary != nullptr
+            ? ZSTD_compress_usingCDict(context.get(), compressed.data(),
+                                       compressed.size(), block.data(),
+                                       block.size(),
+                                       compressionDictionary.get())
+            : ZSTD_compressCCtx(context.get(), compressed.data(),
+                                compressed.size(), block.data(), block.size(),
+                                COMPRESSION_LEVEL);
+    AD_CORRECTNESS_CHECK(!ZSTD_isError(compressedSize));
+    file.write(compressed.data(), compressedSize);
+    blocks.push_back(BlockMetadata{numRecords - numRecordsInBlock,
+                                   offsetInFile, compressedSize, block.size()});
+    offsetInFile += compressedSize;
+    offsets.resize(1);
+    text.clear();
+  };
+  forEachRecord(docsFileName, [&](std::string_view record) {
+    text.append(record);
+    offsets.push_back(text.size());
+    ++numRecords;
+    if (text.size() >= BLOCK_SIZE) {
+      writeBlock();
+    }
+    return true;
+  });
+  writeBlock();
+
+  uint64_t dictionarySize = dictionary.size();
+  uint64_t numBlocks = blocks.size();
+  file.write(&numRecords, sizeof(numRecords));
+  file.write(&dictionarySize, sizeof(dictionarySize));
+  file.write(&numBlocks, sizeof(numBlocks));
+  file.write(blocks.data(), blocks.size() * sizeof(BlockMetadata));
+  auto startOfMetadata = static_cast<off_t>(offsetInFile);
+  file.write(&startOfMetadata, sizeof(startOfMetadata));
+  LOG(INFO) << "Text records: " << numRecords << " records in "
+            << blocks.size() << " blocks, dictionary of " << dictionary.size()
+            << " bytes" << std::endl;
+}
 
 // _____________________________________________________________________________
 void DocsDB::init(const std::string& fileName) {
   _dbFile.open(fileName.c_str(), "r");
+  _isCompressed = false;
+  _blocks.clear();
+  _dictionary.reset();
   if (_dbFile.empty()) {
     _size = 0;
-  } else {
+  } else if (!readCompressedMetadata()) {
     off_t posLastOfft = _dbFile.getLastOffset(&_startOfOffsets);
     _size = (posLastOfft - _startOfOffsets) / sizeof(off_t);
   }
 }
 
 // _____________________________________________________________________________
-std::string DocsDB::getTextExcerpt(TextRecordIndex cid) const {
+bool DocsDB::readCompressedMetadata() {
+  // The file starts with the `MAGIC_BYTES` and the offset at the end points
+  // to metadata that exactly fills the rest of the file. A file in the old
+  // format could only accidentally fulfill both conditions.
+  auto fileSize = static_cast<uint64_t>(_dbFile.sizeOfFile());
+  constexpr size_t headerSize = 3 * sizeof(uint64_t);
+  if (fileSize < MAGIC_BYTES.size() + headerSize + sizeof(off_t)) {
+    return false;
+  }
+  std::string magicBytes(MAGIC_BYTES.size(), '\0');
+  _dbFile.read(magicBytes.data(), magicBytes.size(), 0);
+  if (magicBytes != MAGIC_BYTES) {
+    return false;
+  }
+  off_t startOfMetadata;
+  _dbFile.getLastOffset(&startOfMetadata);
+  if (startOfMetadata < 0 ||
+      static_cast<uint64_t>(startOfMetadata) + headerSize + sizeof(off_t) >
+          fileSize) {
+    return false;
+  }
+  uint64_t header[3];
+  _dbFile.read(header, headerSize, startOfMetadata);
+  auto [numRecords, dictionarySize, numBlocks] = header;
+  if (static_cast<uint64_t>(startOfMetadata) + headerSize +
+          numBlocks * sizeof(BlockMetadata) + sizeof(off_t) !=
+      fileSize) {
+    return false;
+  }
+
+  _blocks.resize(numBlocks);
+  _dbFile.read(_blocks.data(), numBlocks * sizeof(BlockMetadata),
+               startOfMetadata + headerSize);
+  if (dictionarySize > 0) {
+    std::string dictionary(dictionarySize, '\0');
+    _dbFile.read(dictionary.data(), dictionary.size(), MAGIC_BYTES.size());
+    _dictionary.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    AD_CORRECTNESS_CHECK(_dictionary != nullptr);
+  }
+  _size = numRecords;
+  _startOfOffsets = startOfMetadata;
+  _isCompressed = true;
+  return true;
+}
+
+// _____________________________________________________________________________
+void DocsDB::throwIfEmpty() const {
   // If no DocsDB available, we cannot return a text excerpt for the given ID.
   if (_size == 0) {
     AD_THROW(
@@ -27,7 +219,109 @@ std::string DocsDB::getTextExcerpt(TextRecordIndex cid) const {
         "sure that"
         " a file .text.docsDB exists");
   }
+}
+
+// _____________________________________________________________________________
+std::string DocsDB::getTextExcerpt(TextRecordIndex cid) const {
+  throwIfEmpty();
+  if (!_isCompressed) {
+    return getUncompressedTextExcerpt(cid);
+  }
+  Context context{ZSTD_createDCtx()};
+  size_t blockIndex = getBlockIndex(cid);
+  return getRecordFromBlock(readBlock(blockIndex, context.get()), blockIndex,
+                            cid);
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> DocsDB::getTextExcerpts(
+    const std::vector<TextRecordIndex>& cids) const {
+  std::vector<std::string> result(cids.size());
+  if (cids.empty()) {
+    return result;
+  }
+  throwIfEmpty();
+  if (!_isCompressed) {
+    for (size_t i = 0; i < cids.size(); ++i) {
+      result[i] = getUncompressedTextExcerpt(cids[i]);
+    }
+    return result;
+  }
+  // Visit the records in ascending order, s.t. the records from the same block
+  // are adjacent.
+  std::vector<size_t> order(cids.size());
+  std::iota(order.begin(), order.end(), 0);
+  ql::ranges::sort(order, {}, [&cids](size_t i) { return cids[i]; });
+  Context context{ZSTD_createDCtx()};
+  std::optional<size_t> currentBlockIndex;
+  std::string block;
+  for (size_t i : order) {
+    size_t blockIndex = getBlockIndex(cids[i]);
+    if (blockIndex != currentBlockIndex) {
+      block = readBlock(blockIndex, context.get());
+      currentBlockIndex = blockIndex;
+    }
+    result[i] = getRecordFromBlock(block, blockIndex, cids[i]);
+  }
+  return result;
+}
 
+// _____________________________________________________________________________
+size_t DocsDB::getBlockIndex(TextRecordIndex cid) const {
+  AD_CONTRACT_CHECK(cid.get() < _size);
+  auto it = ql::ranges::upper_bound(_blocks, cid.get(), {},
+                                    &BlockMetadata::firstRecord_);
+  AD_CORRECTNESS_CHECK(it != _blocks.begin());
+  return static_cast<size_t>(it - _blocks.begin()) - 1;
+}
+
+// _____________________________________________________________________________
+std::string DocsDB::readBlock(size_t blockIndex, ZSTD_DCtx* context) const {
+  AD_CORRECTNESS_CHECK(context != nullptr);
+  const BlockMetadata& metadata = _blocks.at(blockIndex);
+  std::string compressed(metadata.compressedSize_, '\0');
+  _dbFile.read(compressed.data(), compressed.size(),
+               static_cast<off_t>(metadata.offsetInFile_));
+  std::string block(metadata.uncompressedSize_, '\0');
+  size_t decompressedSize =
+      _dictionary != nullptr
+          ? ZSTD_decompress_usingDDict(context, block.data(), block.size(),
+                                       compressed.data(), compressed.size(),
+                                       _dictionary.get())
+          : ZSTD_decompressDCtx(context, block.data(), block.size(),
+                                compressed.data(), compressed.size());
+  if (ZSTD_isError(decompressedSize)) {
+    AD_THROW(absl::StrCat("Error while decompressing a block of the text "
+                          "records: ",
+                          ZSTD_getErrorName(decompressedSize)));
+  }
+  AD_CORRECTNESS_CHECK(decompressedSize == block.size());
+  return block;
+}
+
+// _____________________________________________________________________________
+std::string DocsDB::getRecordFromBlock(std::string_view block,
+                                       size_t blockIndex,
+                                       TextRecordIndex cid) const {
+  uint64_t firstRecord = _blocks[blockIndex].firstRecord_;
+  uint64_t endRecord = blockIndex + 1 < _blocks.size()
+                           ? _blocks[blockIndex + 1].firstRecord_
+                           : _size;
+  AD_CORRECTNESS_CHECK(firstRecord <= cid.get() && cid.get() < endRecord);
+  size_t startOfText = (endRecord - firstRecord + 1) * sizeof(uint64_t);
+  AD_CORRECTNESS_CHECK(startOfText <= block.size());
+  uint64_t offsets[2];
+  std::memcpy(offsets,
+              block.data() + (cid.get() - firstRecord) * sizeof(uint64_t),
+              sizeof(offsets));
+  AD_CORRECTNESS_CHECK(offsets[0] <= offsets[1] &&
+                       startOfText + offsets[1] <= block.size());
+  return std::string{block.substr(startOfText + offsets[0],
+                                  offsets[1] - offsets[0])};
+}
+
+// _____________________________________________________________________________
+std::string DocsDB::getUncompressedTextExcerpt(TextRecordIndex cid) const {
   off_t ft[2];
   off_t& from = ft[0];
   off_t& to = ft[1];
@@ -5,19 +5,107 @@
 #ifndef QLEVER_SRC_INDEX_DOCSDB_H
 #define QLEVER_SRC_INDEX_DOCSDB_H
 
+#include <zstd.h>
+
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "global/IndexTypes.h"
 #include "util/File.h"
 
+// The text records (aka docs) of the text index, which are returned as the
+// text excerpts for the matches of `ql:contains-word`.
+//
+// The records are stored in blocks of consecutive records with about
+// `BLOCK_SIZE` bytes of text each. Each block is compressed with zstd, using a
+// dictionary that was trained on a sample of the records (this works much
+// better for many small blocks of similar text than compressing each block on
+// its own). The file has the following layout:
+//
+//   `MAGIC_BYTES` | dictionary | compressed blocks | metadata | offset of the
+//   metadata (`off_t`)
+//
+// The metadata consists of the number of records, the size of the dictionary,
+// the number of blocks, and a `BlockMetadata` for each block, which is a
+// sparse index for finding the block of a record. A decompressed block
+// consists of the `numRecordsInBlock + 1` offsets (`uint64_t`) of its records
+// relative to the beginning of the text, followed by the text of the records.
+//
+// Files in the previous uncompressed format (the text of all the records,
+// followed by the `off_t` offsets of all the records) can still be read.
 class DocsDB {
  public:
+  static constexpr std::string_view MAGIC_BYTES = "QLDOCSZ1";
+  static constexpr size_t BLOCK_SIZE = 32 * 1024;
+  static constexpr size_t MAX_DICTIONARY_SIZE = 112 * 1024;
+  static constexpr size_t MAX_DICTIONARY_SAMPLE_SIZE = 16 * 1024 * 1024;
+  static constexpr int COMPRESSION_LEVEL = 3;
+
+  struct BlockMetadata {
+    uint64_t firstRecord_;
+    uint64_t offsetInFile_;
+    uint64_t compressedSize_;
+    uint64_t uncompressedSize_;
+  };
+
+  // Write the records from the `docsFileName` (one record per line in the
+  // format `recordIndex<TAB>text`, sorted by the `recordIndex`) to the file
+  // `fileName`. Missing record indices get an empty record.
+  static void writeFromDocsFile(const std::string& docsFileName,
+                                const std::string& fileName);
+
   void init(const std::string& fileName);
   std::string getTextExcerpt(TextRecordIndex cid) const;
 
+  // Return the text excerpts of all the `cids` (in the same order). Each block
+  // is read and decompressed only once, no matter how many of its records are
+  // requested, which is much faster than repeated calls to `getTextExcerpt`.
+  std::vector<std::string> getTextExcerpts(
+      const std::vector<TextRecordIndex>& cids) const;
+
   mutable ad_utility::File _dbFile;
   off_t _startOfOffsets;
   size_t _size = 0;
+
+ private:
+  struct FreeDictionary {
+    void operator()(ZSTD_DDict* dictionary) const {
+      ZSTD_freeDDict(dictionary);
+    }
+  };
+  struct FreeContext {
+    void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+  };
+  using Context = std::unique_ptr<ZSTD_DCtx, FreeContext>;
+
+  // False iff the file has the old uncompressed format.
+  bool _isCompressed = false;
+  std::vector<BlockMetadata> _blocks;
+  // Null if the blocks were compressed without a dictionary.
+  std::unique_ptr<ZSTD_DDict, FreeDictionary> _dictionary;
+
+  // Read the metadata of a file in the compressed format. Return false if the
+  // file has the old uncompressed format.
+  bool readCompressedMetadata();
+
+  // Throw if there are no text records.
+  void throwIfEmpty() const;
+
+  // Return the index of the block that contains the record `cid`.
+  size_t getBlockIndex(TextRecordIndex cid) const;
+
+  // Read the block with the given index from disk and decompress it.
+  std::string readBlock(size_t blockIndex, ZSTD_DCtx* context) const;
+
+  // Return the record `cid` from the decompressed `block` with the given
+  // `blockIndex`.
+  std::string getRecordFromBlock(std::string_view block, size_t blockIndex,
+                                 TextRecordIndex cid) const;
+
+  // Implementation of `getTextExcerpt` for the old uncompressed format.
+  std::string getUncompressedTextExcerpt(TextRecordIndex cid) const;
 };
 
 #endif  // QLEVER_SRC_INDEX_DOCSDB_H
@@ -140,6 +140,12 @@ std::string Index::getTextExcerpt(TextRecordIndex cid) const {
   return pimpl_->getTextExcerpt(cid);
 }
 
+// ____________________________________________________________________________
+std::vector<std::string> Index::getTextExcerpts(
+    const std::vector<TextRecordIndex>& cids) const {
+  return pimpl_->getTextExcerpts(cids);
+}
+
 // ____________________________________________________________________________
 float Index::getAverageNofEntityContexts() const {
   return pimpl_->getAverageNofEntityContexts();
@@ -161,6 +167,25 @@ bool& Index::usePatterns() { return pimpl_->usePatterns(); }
 // ____________________________________________________________________________
 bool& Index::loadAllPermutations() { return pimpl_->loadAllPermutations(); }
 
+// ____________________________________________________________________________
+bool& Index::buildTrigramIndex() { return pimpl_->buildTrigramIndex(); }
+
+// ____________________________________________________________________________
+const TrigramIndex* Index::getTrigramIndex() const {
+  return pimpl_->getTrigramIndex();
+}
+
+// ____________________________________________________________________________
+bool& Index::buildSpatialIndex() { return pimpl_->buildSpatialIndex(); }
+
+// ____________________________________________________________________________
+bool& Index::buildSortKeyPrefixes() { return pimpl_->buildSortKeyPrefixes(); }
+
+// ____________________________________________________________________________
+const SpatialIndex* Index::getSpatialIndex() const {
+  return pimpl_->getSpatialIndex();
+}
+
 // ____________________________________________________________________________
 void Index::setKeepTempFiles(bool keepTempFiles) {
   return pimpl_->setKeepTempFiles(keepTempFiles);
@@ -220,6 +245,9 @@ const std::string& Index::getOnDiskBase() const {
 // ____________________________________________________________________________
 const std::string& Index::getIndexId() const { return pimpl_->getIndexId(); }
 
+// ____________________________________________________________________________
+const std::string& Index::getBuildId() const { return pimpl_->getBuildId(); }
+
 // ____________________________________________________________________________
 const std::string& Index::getGitShortHash() const {
   return pimpl_->getGitShortHash();
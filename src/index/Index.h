@@ -24,6 +24,8 @@
 class IdTable;
 class TextBlockMetaData;
 class IndexImpl;
+class TrigramIndex;
+class SpatialIndex;
 struct LocatedTriplesSnapshot;
 class DeltaTriplesManager;
 
@@ -175,6 +177,12 @@ class Index {
 
   [[nodiscard]] std::string getTextExcerpt(TextRecordIndex cid) const;
 
+  // Return the text excerpts of all the `cids` (in the same order). This is
+  // much faster than calling `getTextExcerpt` for each of them, because each
+  // compressed block of the text records is only read once.
+  [[nodiscard]] std::vector<std::string> getTextExcerpts(
+      const std::vector<TextRecordIndex>& cids) const;
+
   [[nodiscard]] float getAverageNofEntityContexts() const;
 
   void setKbName(const std::string& name);
@@ -185,6 +193,27 @@ class Index {
 
   bool& loadAllPermutations();
 
+  // If set to true before the index is built, then a `TrigramIndex` is built
+  // for the literals in the vocabulary.
+  bool& buildTrigramIndex();
+
+  // Return the `TrigramIndex` for the vocabulary, or `nullptr` if the index
+  // was built without one.
+  const TrigramIndex* getTrigramIndex() const;
+
+  // If set to true before the index is built, then a `SpatialIndex` is built
+  // for the WKT literals in the vocabulary.
+  bool& buildSpatialIndex();
+
+  // Return the `SpatialIndex` for the vocabulary, or `nullptr` if the index
+  // was built without one.
+  const SpatialIndex* getSpatialIndex() const;
+
+  // If set to true before the index is built, then the prefixes of the sort
+  // keys of the words are stored next to the vocabulary (see
+  // `SortKeyPrefixes`).
+  bool& buildSortKeyPrefixes();
+
   void setKeepTempFiles(bool keepTempFiles);
 
   ad_utility::MemorySize& memoryLimitIndexBuilding();
@@ -205,6 +234,13 @@ class Index {
   const std::string& getKbName() const;
   const std::string& getOnDiskBase() const;
   const std::string& getIndexId() const;
+
+  // Return an identifier that is unique for each build of the index and of its
+  // text index. In contrast to the `getIndexId()`, which only consists of the
+  // name and the statistics of the index, it changes whenever the index is
+  // rebuilt, so it can be used to identify data that is only valid for a
+  // single build (e.g. the results in the `DiskResultCache`).
+  const std::string& getBuildId() const;
   const std::string& getGitShortHash() const;
 
   NumNormalAndInternal numTriples() const;
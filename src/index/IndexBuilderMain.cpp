@@ -141,9 +141,13 @@ int main(int argc, char** argv) {
   bool onlyAddTextIndex = false;
   bool keepTemporaryFiles = false;
   bool onlyPsoAndPos = false;
+  bool buildTrigramIndex = false;
+  bool buildSpatialIndex = false;
+  bool buildSortKeyPrefixes = false;
   bool addWordsFromLiterals = false;
   float bScoringParam = 0.75;
   float kScoringParam = 1.75;
+  size_t numThreadsTextIndex = NUM_THREADS_TEXT_INDEX_BUILDING;
   std::optional<ad_utility::MemorySize> indexMemoryLimit;
   std::optional<ad_utility::MemorySize> parserBufferSize;
   std::optional<ad_utility::VocabularyType> vocabType;
@@ -206,6 +210,9 @@ int main(int argc, char** argv) {
       "scores that are read from the wordsfile, "
       R"("tf-idf" for tf idf )"
       R"(and "bm25" for bm25. The default is "explicit".)");
+  add("text-index-num-threads", po::value(&numThreadsTextIndex),
+      "The number of threads that build the postings of the text index in "
+      "parallel.");
 
   // Options for the knowledge graph index.
   add("settings-file,s", po::value(&settingsFile),
@@ -220,6 +227,18 @@ int main(int argc, char** argv) {
       "The vocabulary implementation for strings in qlever, can be any of ",
       ad_utility::VocabularyType::getListOfSupportedValues());
   add("vocabulary-type", po::value(&vocabType), msg.c_str());
+  add("build-trigram-index", po::bool_switch(&buildTrigramIndex),
+      "Build an index of the trigrams in the literals, which speeds up "
+      "filters like `CONTAINS(?x, \"foo\")` or `REGEX(?x, \"ba.*r\")` "
+      "on large vocabularies, but requires additional space on disk.");
+  add("build-spatial-index", po::bool_switch(&buildSpatialIndex),
+      "Build an R-tree over the bounding boxes of the WKT literals, which is "
+      "used by spatial joins instead of building one for each query.");
+  add("build-sort-key-prefixes", po::bool_switch(&buildSortKeyPrefixes),
+      "Store a prefix of the sort key of each word next to the vocabulary, "
+      "which makes the lookups of strings in the vocabulary (e.g. for "
+      "filters with string comparisons) cheaper, but requires 8 bytes per "
+      "word on disk and some additional time for the index build.");
 
   // Options for the index building process.
   add("stxxl-memory,m", po::value(&indexMemoryLimit),
@@ -294,6 +313,9 @@ int main(int argc, char** argv) {
     index.setKeepTempFiles(keepTemporaryFiles);
     index.setSettingsFile(settingsFile);
     index.loadAllPermutations() = !onlyPsoAndPos;
+    index.buildTrigramIndex() = buildTrigramIndex;
+    index.buildSpatialIndex() = buildSpatialIndex;
+    index.buildSortKeyPrefixes() = buildSortKeyPrefixes;
 
     // Convert the parameters for the filenames, file types, and default graphs
     // into a `vector<InputFileSpecification>`.
@@ -345,6 +367,7 @@ int main(int argc, char** argv) {
     }
     auto textIndexBuilder = TextIndexBuilder(
         ad_utility::makeUnlimitedAllocator<Id>(), index.getOnDiskBase());
+    textIndexBuilder.setNumThreads(numThreadsTextIndex);
 
     if (wordsAndDocsFileSpecified || addWordsFromLiterals) {
       textIndexBuilder.buildTextIndexFile(
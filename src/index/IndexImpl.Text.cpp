@@ -56,6 +56,27 @@ void IndexImpl::addTextFromOnDiskIndex() {
   }
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> IndexImpl::getTextExcerpts(
+    const std::vector<TextRecordIndex>& cids) const {
+  // Like in `getTextExcerpt`, the excerpt of a record that is not contained in
+  // the docsDB is empty.
+  std::vector<std::string> result(cids.size());
+  std::vector<TextRecordIndex> containedCids;
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < cids.size(); ++i) {
+    if (cids[i].get() < docsDB_._size) {
+      containedCids.push_back(cids[i]);
+      positions.push_back(i);
+    }
+  }
+  auto excerpts = docsDB_.getTextExcerpts(containedCids);
+  for (size_t i = 0; i < positions.size(); ++i) {
+    result[positions[i]] = std::move(excerpts[i]);
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 TextBlockIndex IndexImpl::getWordBlockId(WordIndex wordIndex) const {
   return std::lower_bound(blockBoundaries_.begin(), blockBoundaries_.end(),
@@ -87,7 +108,8 @@ IdTable IndexImpl::getWordPostingsForTerm(
   }
   const auto& tbmd = optionalTbmd.value().tbmd_;
   idTable = textIndexReadWrite::readWordCl(tbmd, allocator, textIndexFile_,
-                                           textScoringMetric_);
+                                           textScoringMetric_,
+                                           textPostingCodec_);
   if (optionalTbmd.value().hasToBeFiltered_) {
     idTable =
         FTSAlgorithms::filterByRange(optionalTbmd.value().idRange_, idTable);
@@ -107,7 +129,8 @@ IdTable IndexImpl::getEntityMentionsForWord(
   }
   const auto& tbmd = optTbmd.value().tbmd_;
   return textIndexReadWrite::readWordEntityCl(tbmd, allocator, textIndexFile_,
-                                              textScoringMetric_);
+                                              textScoringMetric_,
+                                              textPostingCodec_);
 }
 
 // _____________________________________________________________________________
@@ -24,6 +24,7 @@
 #include "util/HashMap.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
 #include "util/ProgressBar.h"
+#include "util/Random.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -288,20 +289,18 @@ void IndexImpl::updateInputFileSpecificationsAndLog(
     std::optional<bool> parallelParsingSpecifiedViaJson) {
   std::string pleaseUseParallelParsingOption =
       "please use the command-line option --parse-parallel or -p";
-  // Parallel parsing specified in the `settings.json` file. This is deprecated
-  // for a single input stream and forbidden for multiple input streams.
+  // Parallel parsing specified in the `settings.json` file. This is
+  // deprecated. It applies to all the input streams, for which parallel
+  // parsing was not specified explicitly on the command line. Each of these
+  // streams then gets its own parser threads (see `RdfMultifileParser`).
   if (parallelParsingSpecifiedViaJson.has_value()) {
-    if (spec.size() == 1) {
-      AD_LOG_WARN
-          << "Parallel parsing set in the `.settings.json` file; this is "
-             "deprecated, "
-          << pleaseUseParallelParsingOption << std::endl;
-      spec.at(0).parseInParallel_ = parallelParsingSpecifiedViaJson.value();
-    } else {
-      throw std::runtime_error{absl::StrCat(
-          "Parallel parsing set in the `.settings.json` file; this is "
-          "forbidden for multiple input streams, ",
-          pleaseUseParallelParsingOption)};
+    AD_LOG_WARN << "Parallel parsing set in the `.settings.json` file; this is "
+                   "deprecated, "
+                << pleaseUseParallelParsingOption << std::endl;
+    for (auto& file : spec) {
+      if (!file.parseInParallelSetExplicitly_) {
+        file.parseInParallel_ = parallelParsingSpecifiedViaJson.value();
+      }
     }
   }
   // For a single input stream, if parallel parsing is not specified explicitly
@@ -322,8 +321,18 @@ void IndexImpl::updateInputFileSpecificationsAndLog(
                 << (spec.at(0).parseInParallel_ ? "true" : "false") << ") ..."
                 << std::endl;
   } else {
+    auto numParallel = static_cast<size_t>(ql::ranges::count_if(
+        spec, [](const auto& file) { return file.parseInParallel_; }));
+    size_t threadBudget = RdfMultifileParser::getThreadBudget();
     AD_LOG_INFO << "Processing triples from " << spec.size()
-                << " input streams ..." << std::endl;
+                << " input streams ("
+                << RdfMultifileParser::getNumConcurrentFiles(spec.size(),
+                                                             threadBudget)
+                << " at the same time, " << numParallel
+                << " of them in parallel with "
+                << RdfMultifileParser::getNumThreadsPerParser(
+                       spec.size(), numParallel, threadBudget)
+                << " threads each) ..." << std::endl;
   }
 }
 
@@ -343,6 +352,11 @@ void IndexImpl::createFromFiles(
   IndexBuilderDataAsFirstPermutationSorter indexBuilderData =
       createIdTriplesAndVocab(makeRdfParser(files));
 
+  // Every build gets a new random identity, which e.g. the `DiskResultCache`
+  // uses to detect results that were computed for a previous build of an index
+  // with the same name and statistics.
+  configurationJson_["build-id"] = ad_utility::UuidGenerator{}();
+
   // Write the configuration already at this point, so we have it available in
   // case any of the permutations fail.
   writeConfiguration();
@@ -572,12 +586,65 @@ IndexBuilderDataAsExternalVector IndexImpl::passFileForVocabulary(
       return (*cmp)(a, b, decltype(vocab_)::SortLevel::TOTAL);
     };
     auto wordCallbackPtr = vocab_.makeWordWriterPtr(onDiskBase_ + VOCAB_SUFFIX);
-    auto& wordCallback = *wordCallbackPtr;
-    wordCallback.readableName() = "internal vocabulary";
+    auto& wordWriter = *wordCallbackPtr;
+    wordWriter.readableName() = "internal vocabulary";
+    // If requested, also build the trigram index and the spatial index from
+    // the words in the order in which they are written to the vocabulary.
+    std::optional<TrigramIndex::Builder> trigramIndexBuilder;
+    if (buildTrigramIndex_) {
+      trigramIndexBuilder.emplace(
+          absl::StrCat(onDiskBase_, TRIGRAM_INDEX_SUFFIX, ".sorter.dat"),
+          memoryLimitIndexBuilding() / NUM_EXTERNAL_SORTERS_AT_SAME_TIME,
+          allocator_);
+    }
+    std::optional<SpatialIndex::Builder> spatialIndexBuilder;
+    if (buildSpatialIndex_) {
+      spatialIndexBuilder.emplace();
+    }
+    // If requested, the prefixes of the sort keys are stored next to the
+    // vocabulary to make the binary searches on the vocabulary cheaper.
+    std::optional<SortKeyPrefixes::Builder> sortKeyPrefixesBuilder;
+    if (buildSortKeyPrefixes_) {
+      sortKeyPrefixesBuilder.emplace(
+          absl::StrCat(onDiskBase_, SORT_KEY_PREFIXES_SUFFIX));
+    }
+    auto wordCallback = [&wordWriter, &trigramIndexBuilder,
+                         &spatialIndexBuilder, &sortKeyPrefixesBuilder](
+                            std::string_view word, bool isExternal,
+                            uint64_t sortKeyPrefix) {
+      auto index = wordWriter(word, isExternal);
+      if (sortKeyPrefixesBuilder.has_value()) {
+        sortKeyPrefixesBuilder->addWord(index, sortKeyPrefix);
+      }
+      if (trigramIndexBuilder.has_value()) {
+        trigramIndexBuilder->addWord(word, index);
+      }
+      if (spatialIndexBuilder.has_value()) {
+        spatialIndexBuilder->addWord(word, index);
+      }
+      return index;
+    };
     auto mergedVocabMeta = ad_utility::vocabulary_merger::mergeVocabulary(
         onDiskBase_, numFiles, sortPred, wordCallback,
         memoryLimitIndexBuilding());
-    wordCallback.finish();
+    wordWriter.finish();
+    configurationJson_["has-sort-key-prefixes"] =
+        sortKeyPrefixesBuilder.has_value() &&
+        std::move(sortKeyPrefixesBuilder.value()).finish();
+    if (trigramIndexBuilder.has_value()) {
+      AD_LOG_INFO << "Writing the trigram index for the literals ..."
+                  << std::endl;
+      std::move(trigramIndexBuilder.value())
+          .writeToFile(onDiskBase_ + TRIGRAM_INDEX_SUFFIX);
+    }
+    configurationJson_["has-trigram-index"] = buildTrigramIndex_;
+    if (spatialIndexBuilder.has_value()) {
+      AD_LOG_INFO << "Writing the spatial index for the WKT literals ..."
+                  << std::endl;
+      std::move(spatialIndexBuilder.value())
+          .writeToFile(onDiskBase_ + SPATIAL_INDEX_SUFFIX);
+    }
+    configurationJson_["has-spatial-index"] = buildSpatialIndex_;
     return mergedVocabMeta;
   }();
   AD_LOG_DEBUG << "Finished merging partial vocabularies" << std::endl;
@@ -598,6 +665,8 @@ IndexBuilderDataAsExternalVector IndexImpl::passFileForVocabulary(
   AD_LOG_DEBUG << "Removing temporary files ..." << std::endl;
   for (size_t n = 0; n < numFiles; ++n) {
     deleteTemporaryFile(absl::StrCat(onDiskBase_, PARTIAL_VOCAB_FILE_NAME, n));
+    deleteTemporaryFile(absl::StrCat(onDiskBase_, PARTIAL_VOCAB_FILE_NAME, n,
+                                     PARTIAL_VOCAB_SAMPLES_SUFFIX));
   }
 
   return res;
@@ -888,6 +957,9 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
   setOnDiskBase(onDiskBase);
   readConfiguration();
   vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
+  if (configurationJson_.value("has-sort-key-prefixes", false)) {
+    vocab_.readSortKeyPrefixes(onDiskBase_ + SORT_KEY_PREFIXES_SUFFIX);
+  }
   globalSingletonComparator_ = &vocab_.getCaseComparator();
 
   AD_LOG_DEBUG << "Number of words in internal and external vocabulary: "
@@ -964,6 +1036,18 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
       usePatterns_ = false;
     }
   }
+  if (configurationJson_.value("has-trigram-index", false)) {
+    trigramIndex_.emplace();
+    trigramIndex_->readFromFile(onDiskBase_ + TRIGRAM_INDEX_SUFFIX);
+    AD_LOG_INFO << "The trigram index for the literals was loaded"
+                << std::endl;
+  }
+  if (configurationJson_.value("has-spatial-index", false)) {
+    spatialIndex_.emplace();
+    spatialIndex_->readFromFile(onDiskBase_ + SPATIAL_INDEX_SUFFIX);
+    AD_LOG_INFO << "The spatial index for the WKT literals was loaded"
+                << std::endl;
+  }
   if (persistUpdatesOnDisk) {
     deltaTriples_.value().setFilenameForPersistentUpdatesAndReadFromDisk(
         onDiskBase + ".update-triples");
@@ -1166,6 +1250,9 @@ void IndexImpl::readConfiguration() {
                  TextScoringMetric::EXPLICIT);
   loadDataMember("b-and-k-parameter-for-text-scoring",
                  bAndKParamForTextScoring_, std::make_pair(0.75, 1.75));
+  // Text indices that were built before this key existed use Simple8b.
+  loadDataMember("text-posting-codec", textPostingCodec_,
+                 TextPostingCodec::SIMPLE8B);
 
   ad_utility::VocabularyType vocabType(
       ad_utility::VocabularyType::Enum::OnDiskCompressed);
@@ -1185,6 +1272,16 @@ void IndexImpl::readConfiguration() {
   indexId_ = absl::StrCat("#", getKbName(), ".", numTriples_.normal, ".",
                           numSubjects_.normal, ".", numPredicates_.normal, ".",
                           numObjects_.normal);
+
+  // The identity of the build of the index and of the text index. Indices that
+  // were built before the `build-id` was stored fall back to the `indexId_`.
+  std::string buildId;
+  loadDataMember("build-id", buildId, indexId_);
+  std::string textIndexBuildId;
+  loadDataMember("text-index-build-id", textIndexBuildId, std::string{});
+  buildId_ = textIndexBuildId.empty()
+                 ? std::move(buildId)
+                 : absl::StrCat(buildId, ".text.", textIndexBuildId);
 }
 
 // ___________________________________________________________________________
@@ -29,8 +29,10 @@
 #include "index/PatternCreator.h"
 #include "index/Permutation.h"
 #include "index/Postings.h"
+#include "index/SpatialIndex.h"
 #include "index/TextMetaData.h"
 #include "index/TextScoring.h"
+#include "index/TrigramIndex.h"
 #include "index/Vocabulary.h"
 #include "index/VocabularyMerger.h"
 #include "parser/RdfParser.h"
@@ -147,6 +149,17 @@ class IndexImpl {
 
   // Pattern trick data
   bool usePatterns_ = false;
+
+  // The optional trigram index for the literals in the vocabulary.
+  bool buildTrigramIndex_ = false;
+  std::optional<TrigramIndex> trigramIndex_;
+
+  // The optional spatial index for the WKT literals in the vocabulary.
+  bool buildSpatialIndex_ = false;
+  std::optional<SpatialIndex> spatialIndex_;
+
+  // Store the prefixes of the sort keys next to the vocabulary.
+  bool buildSortKeyPrefixes_ = false;
   double avgNumDistinctPredicatesPerSubject_;
   double avgNumDistinctSubjectsPerPredicate_;
   uint64_t numDistinctSubjectPredicatePairs_;
@@ -159,6 +172,9 @@ class IndexImpl {
   NumNormalAndInternal numObjects_;
   NumNormalAndInternal numTriples_;
   std::string indexId_;
+  // Identifies the build of the index (and of the text index, if one was
+  // added), see `getBuildId()`.
+  std::string buildId_;
   std::string gitShortHash_ = "git short hash not set";
 
   // Keeps track of the number of nonLiteral contexts in the index this is used
@@ -168,6 +184,7 @@ class IndexImpl {
 
   TextScoringMetric textScoringMetric_;
   std::pair<float, float> bAndKParamForTextScoring_;
+  TextPostingCodec textPostingCodec_ = TextPostingCodec::SIMPLE8B;
 
   // Global static pointers to the currently active index and comparator.
   // Those are used to compare LocalVocab entries with each other as well as
@@ -390,6 +407,11 @@ class IndexImpl {
     return docsDB_.getTextExcerpt(cid);
   }
 
+  // Return the text excerpts of all the `cids` (in the same order), see
+  // `DocsDB::getTextExcerpts`.
+  std::vector<std::string> getTextExcerpts(
+      const std::vector<TextRecordIndex>& cids) const;
+
   float getAverageNofEntityContexts() const {
     return textMeta_.getAverageNofEntityContexts();
   };
@@ -402,6 +424,20 @@ class IndexImpl {
 
   bool& loadAllPermutations();
 
+  bool& buildTrigramIndex() { return buildTrigramIndex_; }
+
+  const TrigramIndex* getTrigramIndex() const {
+    return trigramIndex_.has_value() ? &trigramIndex_.value() : nullptr;
+  }
+
+  bool& buildSpatialIndex() { return buildSpatialIndex_; }
+
+  bool& buildSortKeyPrefixes() { return buildSortKeyPrefixes_; }
+
+  const SpatialIndex* getSpatialIndex() const {
+    return spatialIndex_.has_value() ? &spatialIndex_.value() : nullptr;
+  }
+
   void setKeepTempFiles(bool keepTempFiles);
 
   ad_utility::MemorySize& memoryLimitIndexBuilding() {
@@ -432,6 +468,7 @@ class IndexImpl {
   const std::string& getKbName() const { return pso_.getKbName(); }
   const std::string& getOnDiskBase() const { return onDiskBase_; }
   const std::string& getIndexId() const { return indexId_; }
+  const std::string& getBuildId() const { return buildId_; }
   const std::string& getGitShortHash() const { return gitShortHash_; }
 
   size_t getNofTextRecords() const { return textMeta_.getNofTextRecords(); }
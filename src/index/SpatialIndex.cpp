@@ -0,0 +1,193 @@
+// Copyright 2025 The QLever Authors
+
+#include "index/SpatialIndex.h"
+
+#include <cmath>
+
+#include "backports/algorithm.h"
+#include "global/Constants.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+SpatialIndex::Box SpatialIndex::Box::fromBoundingBox(
+    const ad_utility::BoundingBox& boundingBox) {
+  return {boundingBox.lowerLeft_.getLng(), boundingBox.lowerLeft_.getLat(),
+          boundingBox.upperRight_.getLng(), boundingBox.upperRight_.getLat()};
+}
+
+// _____________________________________________________________________________
+ad_utility::BoundingBox SpatialIndex::Box::toBoundingBox() const {
+  return {GeoPoint{minLat_, minLng_}, GeoPoint{maxLat_, maxLng_}};
+}
+
+// _____________________________________________________________________________
+SpatialIndex::Box SpatialIndex::Box::extend(const Box& other) const {
+  return {std::min(minLng_, other.minLng_), std::min(minLat_, other.minLat_),
+          std::max(maxLng_, other.maxLng_), std::max(maxLat_, other.maxLat_)};
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::Builder::addWord(std::string_view word, uint64_t index) {
+  if (!word.starts_with('"') || !word.ends_with(GEO_LITERAL_SUFFIX)) {
+    return;
+  }
+  AD_CONTRACT_CHECK(entries_.empty() || entries_.back().vocabIndex_ < index);
+  Box box;
+  try {
+    box = Box::fromBoundingBox(ad_utility::GeometryInfo::getBoundingBox(word));
+  } catch (const std::exception&) {
+    ++numInvalidLiterals_;
+    return;
+  }
+  if (std::isnan(box.minLng_) || std::isnan(box.minLat_) ||
+      std::isnan(box.maxLng_) || std::isnan(box.maxLat_)) {
+    ++numInvalidLiterals_;
+    return;
+  }
+  entries_.push_back(Entry{box, index});
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::Builder::writeToFile(const std::string& basename) && {
+  // The entries are added in ascending order of their `VocabIndex`.
+  {
+    ad_utility::MmapVector<Entry> byVocabIndex{entries_.begin(),
+                                               entries_.end(), basename};
+  }  // The destructor of the `MmapVector` writes the file.
+
+  // Sort the leaves by the Hilbert index of the center of their box, which
+  // keeps boxes that are close to each other in the same nodes.
+  auto gridCoordinate = [](double value, double min, double max) {
+    double relative = std::clamp((value - min) / (max - min), 0.0, 1.0);
+    return static_cast<uint32_t>(relative * 65535);
+  };
+  auto hilbertKey = [&gridCoordinate](const Entry& entry) {
+    const auto& box = entry.box_;
+    return hilbertIndex(
+        gridCoordinate((box.minLng_ + box.maxLng_) / 2, -180, 180),
+        gridCoordinate((box.minLat_ + box.maxLat_) / 2, -90, 90));
+  };
+  std::vector<std::pair<uint32_t, size_t>> keys;
+  keys.reserve(entries_.size());
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    keys.emplace_back(hilbertKey(entries_[i]), i);
+  }
+  ql::ranges::sort(keys);
+
+  auto levelOffsets = computeLevelOffsets(entries_.size());
+  std::vector<Entry> tree;
+  tree.reserve(levelOffsets.back());
+  for (const auto& [key, i] : keys) {
+    tree.push_back(entries_[i]);
+  }
+  entries_ = std::vector<Entry>{};
+  for (size_t level = 1; level + 1 < levelOffsets.size(); ++level) {
+    size_t childBegin = levelOffsets[level - 1];
+    size_t childEnd = levelOffsets[level];
+    for (size_t first = childBegin; first < childEnd; first += NODE_SIZE) {
+      size_t last = std::min(first + NODE_SIZE, childEnd);
+      Box box = tree[first].box_;
+      for (size_t i = first + 1; i < last; ++i) {
+        box = box.extend(tree[i].box_);
+      }
+      tree.push_back(Entry{box, 0});
+    }
+    AD_CORRECTNESS_CHECK(tree.size() == levelOffsets[level + 1]);
+  }
+  {
+    ad_utility::MmapVector<Entry> treeOnDisk{tree.begin(), tree.end(),
+                                             basename + ".tree"};
+  }
+  AD_LOG_INFO << "Spatial index: " << keys.size() << " WKT literals, "
+              << numInvalidLiterals_ << " literals could not be parsed"
+              << std::endl;
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::readFromFile(const std::string& basename) {
+  entriesByVocabIndex_.open(basename);
+  tree_.open(basename + ".tree");
+  levelOffsets_ = computeLevelOffsets(entriesByVocabIndex_.size());
+  AD_CORRECTNESS_CHECK(tree_.size() == levelOffsets_.back());
+}
+
+// _____________________________________________________________________________
+std::optional<SpatialIndex::Box> SpatialIndex::getBox(VocabIndex index) const {
+  const Entry* begin = entriesByVocabIndex_.data();
+  const Entry* end = begin + entriesByVocabIndex_.size();
+  auto it = std::lower_bound(begin, end, index.get(),
+                             [](const Entry& entry, uint64_t vocabIndex) {
+                               return entry.vocabIndex_ < vocabIndex;
+                             });
+  if (it == end || it->vocabIndex_ != index.get()) {
+    return std::nullopt;
+  }
+  return it->box_;
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::getIntersecting(const Box& queryBox,
+                                   std::vector<VocabIndex>& result) const {
+  if (tree_.size() == 0) {
+    return;
+  }
+  auto levelSize = [this](size_t level) {
+    return levelOffsets_[level + 1] - levelOffsets_[level];
+  };
+  // Depth-first search, starting from the nodes of the topmost level (which
+  // is only the root, unless there is only a single leaf).
+  std::vector<std::pair<size_t, size_t>> stack;
+  size_t topLevel = levelOffsets_.size() - 2;
+  for (size_t i = 0; i < levelSize(topLevel); ++i) {
+    stack.emplace_back(topLevel, i);
+  }
+  while (!stack.empty()) {
+    auto [level, i] = stack.back();
+    stack.pop_back();
+    const Entry& entry = tree_[levelOffsets_[level] + i];
+    if (!entry.box_.intersects(queryBox)) {
+      continue;
+    }
+    if (level == 0) {
+      result.push_back(VocabIndex::make(entry.vocabIndex_));
+      continue;
+    }
+    size_t childEnd = std::min((i + 1) * NODE_SIZE, levelSize(level - 1));
+    for (size_t child = i * NODE_SIZE; child < childEnd; ++child) {
+      stack.emplace_back(level - 1, child);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+uint32_t SpatialIndex::hilbertIndex(uint32_t x, uint32_t y) {
+  constexpr uint32_t n = 1u << 16;
+  AD_CONTRACT_CHECK(x < n && y < n);
+  uint32_t d = 0;
+  for (uint32_t s = n / 2; s > 0; s /= 2) {
+    uint32_t rx = (x & s) > 0;
+    uint32_t ry = (y & s) > 0;
+    d += s * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant s.t. the curve in it has the standard orientation.
+    if (ry == 0) {
+      if (rx == 1) {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+// _____________________________________________________________________________
+std::vector<size_t> SpatialIndex::computeLevelOffsets(size_t numLeaves) {
+  std::vector<size_t> offsets{0, numLeaves};
+  size_t levelSize = numLeaves;
+  while (levelSize > 1) {
+    levelSize = (levelSize + NODE_SIZE - 1) / NODE_SIZE;
+    offsets.push_back(offsets.back() + levelSize);
+  }
+  return offsets;
+}
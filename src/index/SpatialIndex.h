@@ -0,0 +1,108 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_INDEX_SPATIALINDEX_H
+#define QLEVER_SRC_INDEX_SPATIALINDEX_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "global/VocabIndex.h"
+#include "rdfTypes/GeometryInfo.h"
+#include "util/MmapVector.h"
+
+// A static R-tree over the bounding boxes of all the WKT literals in the
+// vocabulary, which allows to find the literals that might lie in a given
+// area without parsing them. It is used by the spatial joins instead of
+// building an R-tree from the geometries of one of the inputs for each query.
+// The index is optional and built during the merging of the vocabulary if the
+// `--build-spatial-index` option of the `IndexBuilderMain` is set.
+//
+// The tree is a packed Hilbert R-tree: The leaves are sorted by the position
+// of the center of their bounding box on a Hilbert curve and then grouped into
+// nodes of `NODE_SIZE` consecutive entries, level by level, until a single
+// root remains. Both the tree and the bounding boxes sorted by `VocabIndex`
+// are stored in files that are memory-mapped when the index is loaded.
+class SpatialIndex {
+ public:
+  // A bounding box in degrees, longitude is the x-axis.
+  struct Box {
+    double minLng_;
+    double minLat_;
+    double maxLng_;
+    double maxLat_;
+
+    static Box fromBoundingBox(const ad_utility::BoundingBox& boundingBox);
+    ad_utility::BoundingBox toBoundingBox() const;
+    // Return the smallest box that contains this box and the `other` box.
+    Box extend(const Box& other) const;
+    bool intersects(const Box& other) const {
+      return minLng_ <= other.maxLng_ && other.minLng_ <= maxLng_ &&
+             minLat_ <= other.maxLat_ && other.minLat_ <= maxLat_;
+    }
+    bool operator==(const Box&) const = default;
+  };
+
+  // The bounding box of a WKT literal (for leaves) or of all the entries in a
+  // subtree (for inner nodes, where `vocabIndex_` is unused).
+  struct Entry {
+    Box box_;
+    uint64_t vocabIndex_;
+  };
+
+  static constexpr size_t NODE_SIZE = 16;
+
+  // Incrementally build a `SpatialIndex` from the words of a vocabulary and
+  // write it to disk.
+  class Builder {
+    std::vector<Entry> entries_;
+    size_t numInvalidLiterals_ = 0;
+
+   public:
+    // Add the next `word` of the vocabulary, which has the given `index`. Must
+    // be called in ascending order of the `index`. Words that are not WKT
+    // literals or that can't be parsed are ignored.
+    void addWord(std::string_view word, uint64_t index);
+
+    // Write the index to the files with the given `basename`.
+    void writeToFile(const std::string& basename) &&;
+  };
+
+ private:
+  // The entries for all the indexed literals, sorted by their `VocabIndex`.
+  ad_utility::MmapVectorView<Entry> entriesByVocabIndex_;
+  // The leaves in Hilbert order, followed by the inner nodes level by level,
+  // the last entry is the root.
+  ad_utility::MmapVectorView<Entry> tree_;
+  // The index of the first entry of each level in `tree_`, the leaves are level
+  // 0. Contains an additional last element, which is the size of `tree_`.
+  std::vector<size_t> levelOffsets_;
+
+ public:
+  // Read an index that was previously written by a `Builder`.
+  void readFromFile(const std::string& basename);
+
+  // The number of indexed literals.
+  size_t size() const { return entriesByVocabIndex_.size(); }
+
+  // Return the bounding box of the literal with the given `index`, or
+  // `std::nullopt` if the literal is not covered by this index.
+  std::optional<Box> getBox(VocabIndex index) const;
+
+  // Append the `VocabIndex`es of all indexed literals, the bounding box of
+  // which intersects the `queryBox`, to the `result` (in no particular order).
+  void getIntersecting(const Box& queryBox,
+                       std::vector<VocabIndex>& result) const;
+
+  // Return the position of the point `(x, y)` in a grid of `2^16 x 2^16`
+  // cells on the Hilbert curve that fills this grid.
+  static uint32_t hilbertIndex(uint32_t x, uint32_t y);
+
+  // Return the offsets of the levels for a tree with `numLeaves` leaves (see
+  // `levelOffsets_`).
+  static std::vector<size_t> computeLevelOffsets(size_t numLeaves);
+};
+
+#endif  // QLEVER_SRC_INDEX_SPATIALINDEX_H
@@ -707,6 +707,40 @@ class TripleComponentComparator {
     return a.langtag_.compare(b.langtag_);
   }
 
+  /**
+   * A cheap approximation of the position of a word in the order of this
+   * comparator. The highest byte is the `firstOriginalChar_` of the word, the
+   * remaining seven bytes are the first bytes of the primary weights of its
+   * `SortKey` (padded with zeros). If the prefixes of two words differ, then
+   * the words compare like their prefixes on every `Level`. Only for equal
+   * prefixes the (much more expensive) comparison via ICU is required.
+   */
+  using SortKeyPrefix = uint64_t;
+  static constexpr size_t SORT_KEY_PREFIX_NUM_BYTES = sizeof(SortKeyPrefix) - 1;
+
+  // Get the `SortKeyPrefix` from a `SplitVal` that contains a `SortKey` (for
+  // example from `extractAndTransformComparable`).
+  template <class A, class B, typename C>
+  static SortKeyPrefix getSortKeyPrefix(const SplitValBase<A, B, C>& split) {
+    LocaleManager::U8StringView sortKey{split.transformedVal_.get()};
+    SortKeyPrefix result =
+        static_cast<unsigned char>(split.firstOriginalChar_);
+    // The primary weights of a `SortKey` end at the first level separator
+    // (byte 1). All the weights are at least 2.
+    bool isPrimaryWeight = true;
+    for (size_t i = 0; i < SORT_KEY_PREFIX_NUM_BYTES; ++i) {
+      isPrimaryWeight = isPrimaryWeight && i < sortKey.size() && sortKey[i] > 1;
+      result = (result << 8) | (isPrimaryWeight ? sortKey[i] : 0);
+    }
+    return result;
+  }
+
+  // Get the `SortKeyPrefix` of a word from the vocabulary.
+  [[nodiscard]] SortKeyPrefix getSortKeyPrefix(std::string_view word) const {
+    return getSortKeyPrefix(
+        extractAndTransformComparable(word, Level::TOTAL, false));
+  }
+
   /**
    *
    * @brief Transform a string s from the vocabulary to the SplitVal of the
@@ -4,7 +4,11 @@
 
 #include "index/TextIndexBuilder.h"
 
+#include <deque>
+#include <future>
+
 #include "index/TextIndexReadWrite.h"
+#include "util/Random.h"
 
 // _____________________________________________________________________________
 void TextIndexBuilder::buildTextIndexFile(
@@ -44,6 +48,8 @@ void TextIndexBuilder::buildTextIndexFile(
     auto [b, k] = bAndKForBM25;
     storeTextScoringParamsInConfiguration(textScoringMetric, b, k);
   }
+  textPostingCodec_ = postingCodec_;
+  configurationJson_["text-posting-codec"] = postingCodec_;
   vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
 
   scoreData_ = {vocab_.getLocaleManager(), textScoringMetric_,
@@ -84,35 +90,59 @@ size_t TextIndexBuilder::processWordsForVocabulary(
 void TextIndexBuilder::processWordsForInvertedLists(
     const std::string& contextFile, bool addWordsFromLiterals, TextVec& vec) {
   LOG(TRACE) << "BEGIN IndexImpl::passContextFileIntoVector" << std::endl;
-  ad_utility::HashMap<WordIndex, Score> wordsInContext;
-  ad_utility::HashMap<Id, Score> entitiesInContext;
   auto currentContext = TextRecordIndex::make(0);
   // The nofContexts can be misleading since it also counts empty contexts
   size_t nofContexts = 0;
   size_t nofWordPostings = 0;
   size_t nofEntityPostings = 0;
-  size_t entityNotFoundErrorMsgCount = 0;
+  std::atomic<size_t> entityNotFoundErrorMsgCount = 0;
   size_t nofLiterals = 0;
 
-  for (const auto& line :
-       wordsInTextRecords(contextFile, addWordsFromLiterals)) {
+  // The lines are read on this thread and split into shards. The postings of
+  // at most `numThreads_` shards are built at the same time, the order in
+  // which they are added to the `vec` doesn't matter because it is sorted.
+  std::mutex vecMutex;
+  std::deque<std::future<size_t>> shardsInProgress;
+  auto finishOldestShard = [&shardsInProgress, &nofLiterals]() {
+    nofLiterals += shardsInProgress.front().get();
+    shardsInProgress.pop_front();
+  };
+  auto startShard = [&](std::vector<WordsFileLine> lines) {
+    if (shardsInProgress.size() >= numThreads_) {
+      finishOldestShard();
+    }
+    shardsInProgress.push_back(std::async(
+        std::launch::async,
+        [this, &vec, &vecMutex, &entityNotFoundErrorMsgCount,
+         lines = std::move(lines)]() {
+          return processShard(lines, vec, vecMutex,
+                              entityNotFoundErrorMsgCount);
+        }));
+  };
+
+  std::vector<WordsFileLine> shard;
+  for (auto& line : wordsInTextRecords(contextFile, addWordsFromLiterals)) {
     if (line.contextId_ != currentContext) {
       ++nofContexts;
-      addContextToVector(vec, currentContext, wordsInContext,
-                         entitiesInContext);
       currentContext = line.contextId_;
-      wordsInContext.clear();
-      entitiesInContext.clear();
+      // Only start a new shard at the beginning of a text record.
+      if (shard.size() >= numLinesPerShard_) {
+        startShard(std::move(shard));
+        shard.clear();
+      }
     }
     if (line.isEntity_) {
       ++nofEntityPostings;
-      processEntityCaseDuringInvertedListProcessing(
-          line, entitiesInContext, nofLiterals, entityNotFoundErrorMsgCount);
     } else {
       ++nofWordPostings;
-      processWordCaseDuringInvertedListProcessing(line, wordsInContext,
-                                                  scoreData_);
     }
+    shard.push_back(std::move(line));
+  }
+  if (!shard.empty()) {
+    startShard(std::move(shard));
+  }
+  while (!shardsInProgress.empty()) {
+    finishOldestShard();
   }
   if (entityNotFoundErrorMsgCount > 0) {
     LOG(WARN) << "Number of mentions of entities not found in the vocabulary: "
@@ -121,18 +151,56 @@ void TextIndexBuilder::processWordsForInvertedLists(
   LOG(DEBUG) << "Number of total entity mentions: " << nofEntityPostings
              << std::endl;
   ++nofContexts;
-  addContextToVector(vec, currentContext, wordsInContext, entitiesInContext);
   textMeta_.setNofTextRecords(nofContexts);
   textMeta_.setNofWordPostings(nofWordPostings);
   textMeta_.setNofEntityPostings(nofEntityPostings);
   nofNonLiteralsInTextIndex_ = nofContexts - nofLiterals;
   configurationJson_["num-non-literals-text-index"] =
       nofNonLiteralsInTextIndex_;
+  // See the `build-id` in `IndexImpl::createFromFiles`.
+  configurationJson_["text-index-build-id"] = ad_utility::UuidGenerator{}();
   writeConfiguration();
 
   LOG(TRACE) << "END IndexImpl::passContextFileIntoVector" << std::endl;
 }
 
+// _____________________________________________________________________________
+size_t TextIndexBuilder::processShard(
+    const std::vector<WordsFileLine>& lines, TextVec& vec,
+    std::mutex& vecMutex,
+    std::atomic<size_t>& entityNotFoundErrorMsgCount) const {
+  ad_utility::HashMap<WordIndex, Score> wordsInContext;
+  ad_utility::HashMap<Id, Score> entitiesInContext;
+  std::vector<std::array<Id, 5>> postings;
+  size_t nofLiterals = 0;
+  auto addContext = [&](TextRecordIndex context) {
+    addContextToVector(postings, context, wordsInContext, entitiesInContext);
+    wordsInContext.clear();
+    entitiesInContext.clear();
+  };
+  for (size_t i = 0; i < lines.size(); ++i) {
+    const auto& line = lines[i];
+    if (i > 0 && line.contextId_ != lines[i - 1].contextId_) {
+      addContext(lines[i - 1].contextId_);
+    }
+    if (line.isEntity_) {
+      processEntityCaseDuringInvertedListProcessing(
+          line, entitiesInContext, nofLiterals, entityNotFoundErrorMsgCount);
+    } else {
+      processWordCaseDuringInvertedListProcessing(line, wordsInContext,
+                                                  scoreData_);
+    }
+  }
+  if (!lines.empty()) {
+    addContext(lines.back().contextId_);
+  }
+  std::lock_guard lock{vecMutex};
+  for (const auto& posting : postings) {
+    vec.push(posting);
+  }
+  return nofLiterals;
+}
+
 // _____________________________________________________________________________
 cppcoro::generator<WordsFileLine> TextIndexBuilder::wordsInTextRecords(
     std::string contextFile, bool addWordsFromLiterals) const {
@@ -182,7 +250,7 @@ cppcoro::generator<WordsFileLine> TextIndexBuilder::wordsInTextRecords(
 void TextIndexBuilder::processEntityCaseDuringInvertedListProcessing(
     const WordsFileLine& line,
     ad_utility::HashMap<Id, Score>& entitiesInContext, size_t& nofLiterals,
-    size_t& entityNotFoundErrorMsgCount) const {
+    std::atomic<size_t>& entityNotFoundErrorMsgCount) const {
   VocabIndex eid;
   // TODO<joka921> Currently only IRIs and strings from the vocabulary can
   // be tagged entities in the text index (no doubles, ints, etc).
@@ -202,7 +270,7 @@ void TextIndexBuilder::processEntityCaseDuringInvertedListProcessing(
 void TextIndexBuilder::processWordCaseDuringInvertedListProcessing(
     const WordsFileLine& line,
     ad_utility::HashMap<WordIndex, Score>& wordsInContext,
-    ScoreData& scoreData) const {
+    const ScoreData& scoreData) const {
   // TODO<joka921> Let the `textVocab_` return a `WordIndex` directly.
   WordVocabIndex vid;
   bool ret = textVocab_.getId(line.word_, &vid);
@@ -220,22 +288,21 @@ void TextIndexBuilder::processWordCaseDuringInvertedListProcessing(
 }
 
 // _____________________________________________________________________________
-void TextIndexBuilder::logEntityNotFound(const std::string& word,
-                                         size_t& entityNotFoundErrorMsgCount) {
-  if (entityNotFoundErrorMsgCount < 20) {
+void TextIndexBuilder::logEntityNotFound(
+    const std::string& word, std::atomic<size_t>& entityNotFoundErrorMsgCount) {
+  size_t numPreviousErrors = entityNotFoundErrorMsgCount++;
+  if (numPreviousErrors < 20) {
     LOG(WARN) << "Entity from text not in KB: " << word << '\n';
-    if (++entityNotFoundErrorMsgCount == 20) {
+    if (numPreviousErrors + 1 == 20) {
       LOG(WARN) << "There are more entities not in the KB..."
                 << " suppressing further warnings...\n";
     }
-  } else {
-    entityNotFoundErrorMsgCount++;
   }
 }
 
 // _____________________________________________________________________________
 void TextIndexBuilder::addContextToVector(
-    TextVec& vec, TextRecordIndex context,
+    std::vector<std::array<Id, 5>>& postings, TextRecordIndex context,
     const ad_utility::HashMap<WordIndex, Score>& words,
     const ad_utility::HashMap<Id, Score>& entities) const {
   // Determine blocks for each word and each entity.
@@ -244,10 +311,10 @@ void TextIndexBuilder::addContextToVector(
   ql::ranges::for_each(words, [&](const auto& word) {
     TextBlockIndex blockId = getWordBlockId(word.first);
     touchedBlocks.insert(blockId);
-    vec.push(std::array{Id::makeFromInt(blockId), Id::makeFromBool(false),
-                        Id::makeFromInt(context.get()),
-                        Id::makeFromInt(word.first),
-                        Id::makeFromDouble(word.second)});
+    postings.push_back(std::array{
+        Id::makeFromInt(blockId), Id::makeFromBool(false),
+        Id::makeFromInt(context.get()), Id::makeFromInt(word.first),
+        Id::makeFromDouble(word.second)});
   });
 
   // All entities have to be written in the entity list part for each block.
@@ -258,10 +325,11 @@ void TextIndexBuilder::addContextToVector(
   for (TextBlockIndex blockId : touchedBlocks) {
     for (auto it = entities.begin(); it != entities.end(); ++it) {
       AD_CONTRACT_CHECK(it->first.getDatatype() == Datatype::VocabIndex);
-      vec.push(std::array{Id::makeFromInt(blockId), Id::makeFromBool(true),
-                          Id::makeFromInt(context.get()),
-                          Id::makeFromInt(it->first.getVocabIndex().get()),
-                          Id::makeFromDouble(it->second)});
+      postings.push_back(std::array{
+          Id::makeFromInt(blockId), Id::makeFromBool(true),
+          Id::makeFromInt(context.get()),
+          Id::makeFromInt(it->first.getVocabIndex().get()),
+          Id::makeFromDouble(it->second)});
     }
   }
 }
@@ -289,9 +357,11 @@ void TextIndexBuilder::createTextIndex(const std::string& filename,
       AD_CONTRACT_CHECK(!classicPostings.empty());
       bool scoreIsInt = textScoringMetric_ == TextScoringMetric::EXPLICIT;
       ContextListMetaData classic = textIndexReadWrite::writePostings(
-          out, classicPostings, true, currenttOffset_, scoreIsInt);
+          out, classicPostings, true, currenttOffset_, scoreIsInt,
+          textPostingCodec_);
       ContextListMetaData entity = textIndexReadWrite::writePostings(
-          out, entityPostings, false, currenttOffset_, scoreIsInt);
+          out, entityPostings, false, currenttOffset_, scoreIsInt,
+          textPostingCodec_);
       textMeta_.addBlock(TextBlockMetaData(
           currentMinWordIndex, currentMaxWordIndex, classic, entity));
       classicPostings.clear();
@@ -317,9 +387,11 @@ void TextIndexBuilder::createTextIndex(const std::string& filename,
   AD_CONTRACT_CHECK(!classicPostings.empty());
   bool scoreIsInt = textScoringMetric_ == TextScoringMetric::EXPLICIT;
   ContextListMetaData classic = textIndexReadWrite::writePostings(
-      out, classicPostings, true, currenttOffset_, scoreIsInt);
+      out, classicPostings, true, currenttOffset_, scoreIsInt,
+      textPostingCodec_);
   ContextListMetaData entity = textIndexReadWrite::writePostings(
-      out, entityPostings, false, currenttOffset_, scoreIsInt);
+      out, entityPostings, false, currenttOffset_, scoreIsInt,
+      textPostingCodec_);
   textMeta_.addBlock(TextBlockMetaData(currentMinWordIndex, currentMaxWordIndex,
                                        classic, entity));
   classicPostings.clear();
@@ -480,34 +552,6 @@ void TextIndexBuilder::calculateBlockBoundaries() {
 // _____________________________________________________________________________
 void TextIndexBuilder::buildDocsDB(const std::string& docsFileName) const {
   LOG(INFO) << "Building DocsDB...\n";
-  std::ifstream docsFile{docsFileName};
-  std::ofstream ofs{onDiskBase_ + ".text.docsDB"};
-  // To avoid excessive use of RAM,
-  // we write the offsets to and `ad_utility::MmapVector` first;
-  ad_utility::MmapVectorTmp<off_t> offsets{onDiskBase_ + ".text.docsDB.tmp"};
-  off_t currentOffset = 0;
-  uint64_t currentContextId = 0;
-  std::string line;
-  line.reserve(BUFFER_SIZE_DOCSFILE_LINE);
-  while (std::getline(docsFile, line)) {
-    std::string_view lineView = line;
-    size_t tab = lineView.find('\t');
-    uint64_t contextId = 0;
-    // Get contextId from line
-    std::from_chars(lineView.data(), lineView.data() + tab, contextId);
-    // Set lineView to the docText
-    lineView = lineView.substr(tab + 1);
-    ofs << lineView;
-    while (currentContextId < contextId) {
-      offsets.push_back(currentOffset);
-      currentContextId++;
-    }
-    offsets.push_back(currentOffset);
-    currentContextId++;
-    currentOffset += static_cast<off_t>(lineView.size());
-  }
-  offsets.push_back(currentOffset);
-  ofs.write(reinterpret_cast<const char*>(offsets.data()),
-            sizeof(off_t) * offsets.size());
+  DocsDB::writeFromDocsFile(docsFileName, onDiskBase_ + ".text.docsDB");
   LOG(INFO) << "DocsDB done.\n";
 }
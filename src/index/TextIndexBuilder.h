@@ -5,11 +5,24 @@
 #ifndef QLEVER_SRC_INDEX_TEXTINDEXBUILDER_H
 #define QLEVER_SRC_INDEX_TEXTINDEXBUILDER_H
 
+#include <atomic>
+#include <mutex>
+
+#include "index/ConstantsIndexBuilding.h"
 #include "index/IndexImpl.h"
 
 // This class contains all the code that is only required when building the
 // fulltext index
+//
+// The postings are built in parallel: The lines of the text records are split
+// into shards of consecutive text records, the postings of each shard are
+// built by one of `numThreads_` threads, and all postings are then sorted and
+// written to the blocks of the text index.
 class TextIndexBuilder : public IndexImpl {
+  size_t numThreads_ = NUM_THREADS_TEXT_INDEX_BUILDING;
+  size_t numLinesPerShard_ = NUM_LINES_PER_TEXT_INDEX_SHARD;
+  TextPostingCodec postingCodec_ = TextPostingCodec::BIT_PACKING;
+
  public:
   explicit TextIndexBuilder(ad_utility::AllocatorWithLimit<Id> allocator,
                             const std::string& onDiskBase)
@@ -32,6 +45,23 @@ class TextIndexBuilder : public IndexImpl {
   // Build docsDB file from given file (one text record per line).
   void buildDocsDB(const std::string& docsFile) const;
 
+  // Set the number of threads that build the postings in parallel.
+  void setNumThreads(size_t numThreads) {
+    AD_CONTRACT_CHECK(numThreads > 0);
+    numThreads_ = numThreads;
+  }
+
+  // Set the minimal number of lines per shard. A text record is never split
+  // between two shards.
+  void setNumLinesPerShard(size_t numLinesPerShard) {
+    AD_CONTRACT_CHECK(numLinesPerShard > 0);
+    numLinesPerShard_ = numLinesPerShard;
+  }
+
+  // Set the codec of the posting lists. The default `BIT_PACKING` is much
+  // faster to decode, `SIMPLE8B` is the codec of older text indices.
+  void setPostingCodec(TextPostingCodec codec) { postingCodec_ = codec; }
+
  private:
   size_t processWordsForVocabulary(const std::string& contextFile,
                                    bool addWordsFromLiterals);
@@ -39,6 +69,13 @@ class TextIndexBuilder : public IndexImpl {
   void processWordsForInvertedLists(const std::string& contextFile,
                                     bool addWordsFromLiterals, TextVec& vec);
 
+  // Build the postings for the `lines` of a shard of complete text records and
+  // add them to the `vec` (which is protected by the `vecMutex`). Return the
+  // number of literals among the text records.
+  size_t processShard(const std::vector<WordsFileLine>& lines, TextVec& vec,
+                      std::mutex& vecMutex,
+                      std::atomic<size_t>& entityNotFoundErrorMsgCount) const;
+
   // Generator that returns all words in the given context file (if not empty)
   // and then all words in all literals (if second argument is true).
   //
@@ -51,17 +88,19 @@ class TextIndexBuilder : public IndexImpl {
   void processEntityCaseDuringInvertedListProcessing(
       const WordsFileLine& line,
       ad_utility::HashMap<Id, Score>& entitiesInContxt, size_t& nofLiterals,
-      size_t& entityNotFoundErrorMsgCount) const;
+      std::atomic<size_t>& entityNotFoundErrorMsgCount) const;
 
   void processWordCaseDuringInvertedListProcessing(
       const WordsFileLine& line,
       ad_utility::HashMap<WordIndex, Score>& wordsInContext,
-      ScoreData& scoreData) const;
+      const ScoreData& scoreData) const;
 
-  static void logEntityNotFound(const std::string& word,
-                                size_t& entityNotFoundErrorMsgCount);
+  static void logEntityNotFound(
+      const std::string& word,
+      std::atomic<size_t>& entityNotFoundErrorMsgCount);
 
-  void addContextToVector(TextVec& vec, TextRecordIndex context,
+  void addContextToVector(std::vector<std::array<Id, 5>>& postings,
+                          TextRecordIndex context,
                           const ad_utility::HashMap<WordIndex, Score>& words,
                           const ad_utility::HashMap<Id, Score>& entities) const;
 
@@ -12,17 +12,25 @@ namespace textIndexReadWrite::detail {
 IdTable readContextListHelper(
     const ad_utility::AllocatorWithLimit<Id>& allocator,
     const ContextListMetaData& contextList, bool isWordCl,
-    const ad_utility::File& textIndexFile,
-    TextScoringMetric textScoringMetric) {
+    const ad_utility::File& textIndexFile, TextScoringMetric textScoringMetric,
+    TextPostingCodec codec) {
   IdTable idTable{3, allocator};
   idTable.resize(contextList._nofElements);
   // Read ContextList
-  readGapComprList<Id, uint64_t>(
-      idTable.getColumn(0).begin(), contextList._nofElements,
-      contextList._startContextlist, contextList.getByteLengthContextList(),
-      textIndexFile, [](uint64_t id) {
-        return Id::makeFromTextRecordIndex(TextRecordIndex::make(id));
-      });
+  auto textRecordToId = [](uint64_t id) {
+    return Id::makeFromTextRecordIndex(TextRecordIndex::make(id));
+  };
+  if (codec == TextPostingCodec::SIMPLE8B) {
+    readGapComprList<Id, uint64_t>(
+        idTable.getColumn(0).begin(), contextList._nofElements,
+        contextList._startContextlist, contextList.getByteLengthContextList(),
+        textIndexFile, textRecordToId);
+  } else {
+    readBitPackedList<true, Id>(
+        idTable.getColumn(0).begin(), contextList._nofElements,
+        contextList._startContextlist, contextList.getByteLengthContextList(),
+        textIndexFile, textRecordToId);
+  }
 
   // Helper lambda to read wordIndexList
   auto wordIndexToId = [isWordCl](auto wordIndex) {
@@ -36,7 +44,7 @@ IdTable readContextListHelper(
   readFreqComprList<Id, WordIndex>(
       idTable.getColumn(1).begin(), contextList._nofElements,
       contextList._startWordlist, contextList.getByteLengthWordlist(),
-      textIndexFile, wordIndexToId);
+      textIndexFile, codec, wordIndexToId);
 
   // Helper lambdas to read scoreList
   auto scoreToId = [](auto score) {
@@ -53,7 +61,7 @@ IdTable readContextListHelper(
     readFreqComprList<Id, uint16_t>(
         idTable.getColumn(2).begin(), contextList._nofElements,
         contextList._startScorelist, contextList.getByteLengthScorelist(),
-        textIndexFile, scoreToId);
+        textIndexFile, codec, scoreToId);
   } else {
     auto scores = readZstdComprList<Score>(
         contextList._nofElements, contextList._startScorelist,
@@ -80,7 +88,8 @@ void compressAndWrite(ql::span<const T> src, ad_utility::File& out,
 ContextListMetaData writePostings(ad_utility::File& out,
                                   const vector<Posting>& postings,
                                   bool skipWordlistIfAllTheSame,
-                                  off_t& currentOffset, bool scoreIsInt) {
+                                  off_t& currentOffset, bool scoreIsInt,
+                                  TextPostingCodec codec) {
   ContextListMetaData meta;
   meta._nofElements = postings.size();
   if (meta._nofElements == 0) {
@@ -91,21 +100,30 @@ ContextListMetaData writePostings(ad_utility::File& out,
     return meta;
   }
 
-  GapEncode textRecordEncoder(postings |
-                              ql::views::transform([](const Posting& posting) {
-                                return std::get<0>(posting).get();
-                              }));
+  auto textRecords =
+      postings | ql::views::transform([](const Posting& posting) {
+        return std::get<0>(posting).get();
+      });
   FrequencyEncode wordIndexEncoder(
       postings | ql::views::transform([](const Posting& posting) {
         return std::get<1>(posting);
       }));
 
   meta._startContextlist = currentOffset;
-  textRecordEncoder.writeToFile(out, currentOffset);
+  if (codec == TextPostingCodec::SIMPLE8B) {
+    GapEncode textRecordEncoder(textRecords);
+    textRecordEncoder.writeToFile(out, currentOffset);
+  } else {
+    std::vector<uint64_t> textRecordVector;
+    textRecordVector.reserve(postings.size());
+    ql::ranges::copy(textRecords, std::back_inserter(textRecordVector));
+    bitPackAndWriteSpanAndMoveOffset<true, uint64_t>(textRecordVector, out,
+                                                     currentOffset);
+  }
 
   meta._startWordlist = currentOffset;
   if (!skipWordlistIfAllTheSame || wordIndexEncoder.getCodeBook().size() > 1) {
-    wordIndexEncoder.writeToFile(out, currentOffset);
+    wordIndexEncoder.writeToFile(out, currentOffset, codec);
   }
 
   meta._startScorelist = currentOffset;
@@ -114,7 +132,7 @@ ContextListMetaData writePostings(ad_utility::File& out,
         postings | ql::views::transform([](const Posting& posting) {
           return static_cast<uint16_t>(std::get<2>(posting));
         }));
-    scoreEncoder.writeToFile(out, currentOffset);
+    scoreEncoder.writeToFile(out, currentOffset, codec);
   } else {
     std::vector<float> scores;
     scores.reserve(postings.size());
@@ -155,22 +173,37 @@ void encodeAndWriteSpanAndMoveOffset(ql::span<const T> spanToWrite,
   currentOffset += bytes;
 }
 
+// ____________________________________________________________________________
+template <bool isDeltaEncoded, typename T>
+void bitPackAndWriteSpanAndMoveOffset(ql::span<const T> spanToWrite,
+                                      ad_utility::File& file,
+                                      off_t& currentOffset) {
+  auto encoded = ad_utility::BitPackingCode::encode<isDeltaEncoded>(
+      spanToWrite.data(), spanToWrite.size());
+  size_t bytes = encoded.size() * sizeof(uint64_t);
+  size_t ret = file.write(encoded.data(), bytes);
+  AD_CONTRACT_CHECK(bytes == ret);
+  currentOffset += bytes;
+}
+
 // ____________________________________________________________________________
 IdTable readWordCl(const TextBlockMetaData& tbmd,
                    const ad_utility::AllocatorWithLimit<Id>& allocator,
                    const ad_utility::File& textIndexFile,
-                   TextScoringMetric textScoringMetric) {
+                   TextScoringMetric textScoringMetric,
+                   TextPostingCodec codec) {
   return detail::readContextListHelper(allocator, tbmd._cl, true, textIndexFile,
-                                       textScoringMetric);
+                                       textScoringMetric, codec);
 }
 
 // ____________________________________________________________________________
 IdTable readWordEntityCl(const TextBlockMetaData& tbmd,
                          const ad_utility::AllocatorWithLimit<Id>& allocator,
                          const ad_utility::File& textIndexFile,
-                         TextScoringMetric textScoringMetric) {
+                         TextScoringMetric textScoringMetric,
+                         TextPostingCodec codec) {
   return detail::readContextListHelper(allocator, tbmd._entityCl, false,
-                                       textIndexFile, textScoringMetric);
+                                       textIndexFile, textScoringMetric, codec);
 }
 
 }  // namespace textIndexReadWrite
@@ -221,10 +254,16 @@ void FrequencyEncode<T>::initialize(View&& view) {
 // ____________________________________________________________________________
 template <typename T>
 void FrequencyEncode<T>::writeToFile(ad_utility::File& out,
-                                     off_t& currentOffset) {
+                                     off_t& currentOffset,
+                                     TextPostingCodec codec) {
   currentOffset += textIndexReadWrite::writeCodebook(codeBook_, out);
-  textIndexReadWrite::encodeAndWriteSpanAndMoveOffset<size_t>(
-      encodedVector_, out, currentOffset);
+  if (codec == TextPostingCodec::SIMPLE8B) {
+    textIndexReadWrite::encodeAndWriteSpanAndMoveOffset<size_t>(
+        encodedVector_, out, currentOffset);
+  } else {
+    textIndexReadWrite::bitPackAndWriteSpanAndMoveOffset<false, size_t>(
+        encodedVector_, out, currentOffset);
+  }
 }
 
 // ____________________________________________________________________________
@@ -12,6 +12,7 @@
 #include "index/Postings.h"
 #include "index/TextMetaData.h"
 #include "index/TextScoringEnum.h"
+#include "util/BitPackingCode.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/HashMap.h"
 #include "util/Simple8bCode.h"
@@ -24,12 +25,14 @@ namespace textIndexReadWrite::detail {
 // - Read codebook size
 // - Read codebook
 // - return the read codebook through reference
-// - Read list from disk which is simple8b and frequency encoded
-// - simple8b decode the list
+// - Read list from disk which is encoded with the `codec` and frequency
+//   encoded
+// - decode the list
 // - return the still frequency encoded vector through reference
 template <typename From>
 void readFreqComprListHelper(size_t nofElements, off_t from, size_t nofBytes,
                              const ad_utility::File& textIndexFile,
+                             TextPostingCodec codec,
                              vector<uint64_t>& frequencyEncodedVector,
                              std::vector<From>& codebook) {
   AD_CONTRACT_CHECK(nofBytes > 0);
@@ -51,23 +54,30 @@ void readFreqComprListHelper(size_t nofElements, off_t from, size_t nofBytes,
   AD_CONTRACT_CHECK(ret == size_t(nofCodebookBytes));
   current += ret;
 
-  // Create vector that is simple8b and frequency encoded, read encoded vector
+  // Create vector that is encoded and frequency encoded, read encoded vector
   // from file, advance pointer (current)
-  std::vector<uint64_t> simple8bEncoded;
-  simple8bEncoded.resize(nofElements);
-  ret = textIndexFile.read(simple8bEncoded.data(), nofBytes - (current - from),
+  std::vector<uint64_t> encoded;
+  encoded.resize((nofBytes - (current - from)) / sizeof(uint64_t));
+  ret = textIndexFile.read(encoded.data(), nofBytes - (current - from),
                            current);
   current += ret;
 
   AD_CONTRACT_CHECK(size_t(current - from) == nofBytes);
 
-  // simple8b decode the list which is then directly passed to
-  // frequencyEncodedVector. The resizing with overhead is necessary for
-  // simple8b
-  LOG(DEBUG) << "Decoding Simple8b code...\n";
-  frequencyEncodedVector.resize(nofElements + 250);
-  ad_utility::Simple8bCode::decode(simple8bEncoded.data(), nofElements,
-                                   frequencyEncodedVector.data());
+  // Decode the list which is then directly passed to frequencyEncodedVector.
+  // The resizing with overhead is necessary for both codecs.
+  if (codec == TextPostingCodec::SIMPLE8B) {
+    LOG(DEBUG) << "Decoding Simple8b code...\n";
+    frequencyEncodedVector.resize(nofElements + 250);
+    ad_utility::Simple8bCode::decode(encoded.data(), nofElements,
+                                     frequencyEncodedVector.data());
+  } else {
+    LOG(DEBUG) << "Decoding bit-packed code...\n";
+    using ad_utility::BitPackingCode;
+    frequencyEncodedVector.resize(BitPackingCode::decodedSize(nofElements));
+    BitPackingCode::decode<false>(encoded.data(), nofElements,
+                                  frequencyEncodedVector.data());
+  }
   LOG(DEBUG) << "Reverting frequency encoded items to actual IDs...\n";
   frequencyEncodedVector.resize(nofElements);
 }
@@ -113,12 +123,14 @@ void readGapComprListHelper(size_t nofElements, off_t from, size_t nofBytes,
  * @param textScoringMetric The textScoringMetric used to save the contextList
  *                          during index building. This is necessary to cast the
  *                          scores to the right type.
+ * @param codec The codec that was used to write the contextList.
  *
  */
 IdTable readContextListHelper(
     const ad_utility::AllocatorWithLimit<Id>& allocator,
     const ContextListMetaData& contextList, bool isWordCl,
-    const ad_utility::File& textIndexFile, TextScoringMetric textScoringMetric);
+    const ad_utility::File& textIndexFile, TextScoringMetric textScoringMetric,
+    TextPostingCodec codec);
 
 }  // namespace textIndexReadWrite::detail
 namespace textIndexReadWrite {
@@ -134,10 +146,12 @@ void compressAndWrite(ql::span<const T> src, ad_utility::File& out,
 /**
  * @brief Writes posting to given file. It splits the vector of postings into
  *        the lists for each respective tuple element of postings.
- *        The TextRecordIndex list gets gap encoded and then simple8b encoded
- *        before being written to file. The WordIndex and Score lists get
- *        frequency encoded and then simple8b encoded before being written to
- *        file.
+ *        With the `SIMPLE8B` codec, the TextRecordIndex list gets gap encoded
+ *        and then simple8b encoded before being written to file. With the
+ *        `BIT_PACKING` codec, it is encoded with the delta encoding of the
+ *        `BitPackingCode`. The WordIndex and integer Score lists get
+ *        frequency encoded and then encoded with the codec before being
+ *        written to file.
  * @param out The file to write to.
  * @param postings The vector of postings to write.
  * @param skipWordlistIfAllTheSame If true, the wordlist is not written to file.
@@ -147,12 +161,14 @@ void compressAndWrite(ql::span<const T> src, ad_utility::File& out,
  *                                 false for the entity postings.
  * @param currentOffset The current offset in the file which gets passed by
  *                      reference because it gets updated.
+ * @param codec The codec for the lists, see `TextPostingCodec`.
  *
  */
 ContextListMetaData writePostings(ad_utility::File& out,
                                   const vector<Posting>& postings,
                                   bool skipWordlistIfAllTheSame,
-                                  off_t& currentOffset, bool scoreIsInt);
+                                  off_t& currentOffset, bool scoreIsInt,
+                                  TextPostingCodec codec);
 
 template <typename T>
 size_t writeCodebook(const vector<T>& codebook, ad_utility::File& file);
@@ -170,6 +186,16 @@ void encodeAndWriteSpanAndMoveOffset(ql::span<const T> spanToWrite,
                                      ad_utility::File& file,
                                      off_t& currentOffset);
 
+/**
+ * @brief Same as `encodeAndWriteSpanAndMoveOffset`, but uses the
+ *        `BitPackingCode` (with delta encoding iff `isDeltaEncoded`, which
+ *        requires the elements to be sorted).
+ */
+template <bool isDeltaEncoded, typename T>
+void bitPackAndWriteSpanAndMoveOffset(ql::span<const T> spanToWrite,
+                                      ad_utility::File& file,
+                                      off_t& currentOffset);
+
 /// READING PART
 
 template <typename T>
@@ -188,14 +214,16 @@ vector<T> readZstdComprList(size_t nofElements, off_t from,
 IdTable readWordCl(const TextBlockMetaData& tbmd,
                    const ad_utility::AllocatorWithLimit<Id>& allocator,
                    const ad_utility::File& textIndexFile,
-                   TextScoringMetric textScoringMetric);
+                   TextScoringMetric textScoringMetric,
+                   TextPostingCodec codec);
 
 // Reads the given textblock and returns all entities with their contextId,
 // entityId and score. Internally uses readContextListHelper.
 IdTable readWordEntityCl(const TextBlockMetaData& tbmd,
                          const ad_utility::AllocatorWithLimit<Id>& allocator,
                          const ad_utility::File& textIndexFile,
-                         TextScoringMetric textScoringMetric);
+                         TextScoringMetric textScoringMetric,
+                         TextPostingCodec codec);
 
 /**
  * @brief Reads a frequency encoded list from the given file and casts its
@@ -206,8 +234,9 @@ IdTable readWordEntityCl(const TextBlockMetaData& tbmd,
  * @param nofElements The number of elements in the list.
  * @param from The offset in the file to start reading from.
  * @param nofBytes The number of bytes to read which can't be deduced from the
- *                 number of elements since the list is simple8b compressed.
+ *                 number of elements since the list is compressed.
  * @param textIndexFile The file to read from.
+ * @param codec The codec that was used to write the list.
  * @param transformer The transformer to cast the decoded values to the To type.
  *                    If no transformer is given, a static cast is used.
  */
@@ -215,11 +244,12 @@ template <typename To, typename From,
           typename Transformer = decltype(ad_utility::staticCast<To>)>
 vector<To> readFreqComprList(size_t nofElements, off_t from, size_t nofBytes,
                              const ad_utility::File& textIndexFile,
+                             TextPostingCodec codec,
                              Transformer transformer = {}) {
   vector<uint64_t> frequencyEncodedVector;
   vector<From> codebook;
   detail::readFreqComprListHelper(nofElements, from, nofBytes, textIndexFile,
-                                  frequencyEncodedVector, codebook);
+                                  codec, frequencyEncodedVector, codebook);
   vector<To> result;
   result.reserve(frequencyEncodedVector.size());
   ql::ranges::for_each(frequencyEncodedVector, [&](const auto& encoded) {
@@ -240,11 +270,11 @@ template <typename To, typename From, typename OutputIterator,
           typename Transformer = decltype(ad_utility::staticCast<To>)>
 void readFreqComprList(OutputIterator iterator, size_t nofElements, off_t from,
                        size_t nofBytes, const ad_utility::File& textIndexFile,
-                       Transformer transformer = {}) {
+                       TextPostingCodec codec, Transformer transformer = {}) {
   vector<uint64_t> frequencyEncodedVector;
   vector<From> codebook;
   detail::readFreqComprListHelper(nofElements, from, nofBytes, textIndexFile,
-                                  frequencyEncodedVector, codebook);
+                                  codec, frequencyEncodedVector, codebook);
   ql::ranges::for_each(frequencyEncodedVector, [&](const auto& encoded) {
     *iterator = transformer(codebook.at(encoded));
     ++iterator;
@@ -312,6 +342,30 @@ void readGapComprList(OutputIterator iterator, size_t nofElements, off_t from,
   LOG(DEBUG) << "Done reading gap-encoded list.";
 }
 
+/**
+ * @brief Reads a list that was written with the `BitPackingCode` (with delta
+ *        encoding iff `isDeltaEncoded`) from the given file, and writes its
+ *        elements, cast to the To type using the given transformer, to the
+ *        given iterator.
+ * @warning The iterator has to be big enough to be increased nofElements times.
+ */
+template <bool isDeltaEncoded, typename To, typename OutputIterator,
+          typename Transformer = decltype(ad_utility::staticCast<To>)>
+void readBitPackedList(OutputIterator iterator, size_t nofElements, off_t from,
+                       size_t nofBytes, const ad_utility::File& textIndexFile,
+                       Transformer transformer = {}) {
+  using ad_utility::BitPackingCode;
+  std::vector<uint64_t> encoded(nofBytes / sizeof(uint64_t));
+  size_t ret = textIndexFile.read(encoded.data(), nofBytes, from);
+  AD_CONTRACT_CHECK(ret == nofBytes);
+  std::vector<uint64_t> decoded(BitPackingCode::decodedSize(nofElements));
+  BitPackingCode::decode<isDeltaEncoded>(encoded.data(), nofElements,
+                                         decoded.data());
+  ql::ranges::transform(decoded.begin(), decoded.begin() + nofElements,
+                        iterator, transformer);
+  LOG(DEBUG) << "Done reading bit-packed list.";
+}
+
 }  // namespace textIndexReadWrite
 
 /**
@@ -348,7 +402,10 @@ class FrequencyEncode {
   FrequencyEncode(FrequencyEncode&&) = delete;
   FrequencyEncode& operator=(FrequencyEncode&&) = delete;
 
-  void writeToFile(ad_utility::File& out, off_t& currentOffset);
+  // Write the codebook and the encoded vector, which is encoded with the
+  // `codec`.
+  void writeToFile(ad_utility::File& out, off_t& currentOffset,
+                   TextPostingCodec codec);
 
   const std::vector<size_t>& getEncodedVector() const { return encodedVector_; }
   const CodeMap& getCodeMap() const { return codeMap_; }
@@ -373,7 +430,8 @@ FrequencyEncode(View&& view)
  * @brief A class used to encode a view of elements by gap encoding them.
  *        It does this during the construction of the object and stores the
  *        encoded vector. It also has a method to write the encoded vector to
- *        a file.
+ *        a file. This is only used for the `SIMPLE8B` codec, the
+ *        `BitPackingCode` does its own delta encoding.
  */
 template <typename T>
 class GapEncode {
@@ -16,6 +16,11 @@
 
 using std::vector;
 
+// The codec of the lists of a `ContextListMetaData` in the text index file.
+// Text indices that were built before the `BIT_PACKING` codec was introduced
+// use `SIMPLE8B`, see `textIndexReadWrite` for the details.
+enum struct TextPostingCodec { SIMPLE8B, BIT_PACKING };
+
 class ContextListMetaData {
  public:
   ContextListMetaData()
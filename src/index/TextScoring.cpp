@@ -55,6 +55,7 @@ void ScoreData::calculateScoreData(const std::string& docsFileName,
 
   // Parse literals if added
   if (!addWordsFromLiterals) {
+    calculateAVDL();
     return;
   }
   if (wordsNotFoundFromDocuments > 0) {
@@ -83,6 +84,7 @@ void ScoreData::calculateScoreData(const std::string& docsFileName,
                        "index. One reason may be the tokenizer for creating "
                        "the text vocab from literals and the one used during "
                        "score calculation being different which shouldn't be.");
+  calculateAVDL();
 }
 
 // ____________________________________________________________________________
@@ -108,7 +110,8 @@ void ScoreData::addDocumentOrLiteralToScoreDataInvertedIndex(
 }
 
 // ____________________________________________________________________________
-float ScoreData::getScore(WordIndex wordIndex, TextRecordIndex contextId) {
+float ScoreData::getScore(WordIndex wordIndex,
+                          TextRecordIndex contextId) const {
   AD_CORRECTNESS_CHECK(!(scoringMetric_ == TextScoringMetric::EXPLICIT),
                        "This method shouldn't be called for explicit scores.");
   // Retrieve inner map
@@ -118,8 +121,7 @@ float ScoreData::getScore(WordIndex wordIndex, TextRecordIndex contextId) {
                << wordIndex << std::endl;
     return 0;
   }
-  calculateAVDL();
-  InnerMap& innerMap = it->second;
+  const InnerMap& innerMap = it->second;
   size_t df = innerMap.size();
   float idf = std::log2f(static_cast<float>(nofDocuments_) / df);
 
@@ -31,7 +31,7 @@ class ScoreData {
   TextScoringMetric getScoringMetric() const { return scoringMetric_; }
 
   // Retrieves score from filled InvertedIndex
-  float getScore(WordIndex wordIndex, TextRecordIndex contextId);
+  float getScore(WordIndex wordIndex, TextRecordIndex contextId) const;
 
   // Parses docsFile and if true literals to fill the InvertedIndex and the
   // extra values needed to calculate scores
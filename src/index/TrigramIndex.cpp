@@ -0,0 +1,375 @@
+// Copyright 2025 The QLever Authors
+
+#include "index/TrigramIndex.h"
+
+#include <absl/strings/ascii.h>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+// Return the content of a literal from the vocabulary (without the quotes and
+// without a language tag or datatype), or `std::nullopt` if the `word` is not a
+// literal.
+std::optional<std::string_view> getLiteralContent(std::string_view word) {
+  if (!word.starts_with('"')) {
+    return std::nullopt;
+  }
+  auto closingQuote = word.rfind('"');
+  AD_CORRECTNESS_CHECK(closingQuote > 0);
+  return word.substr(1, closingQuote - 1);
+}
+
+// Return the position of the `]` that closes the character class that is
+// opened by the `[` at `regex[openPos]`, or `std::nullopt` if there is none.
+// The `]` of nested POSIX classes like `[:alpha:]`, collating elements like
+// `[.a.]`, and equivalence classes like `[=a=]` don't close the class.
+std::optional<size_t> findClosingBracket(std::string_view regex,
+                                         size_t openPos) {
+  size_t i = openPos + 1;
+  if (i < regex.size() && regex[i] == '^') {
+    ++i;
+  }
+  // A `]` directly at the beginning of the class is a literal.
+  if (i < regex.size() && regex[i] == ']') {
+    ++i;
+  }
+  for (; i < regex.size(); ++i) {
+    if (regex[i] == '\\') {
+      ++i;
+    } else if (regex[i] == '[' && i + 1 < regex.size() &&
+               std::string_view{":.="}.find(regex[i + 1]) !=
+                   std::string_view::npos) {
+      const char terminator[] = {regex[i + 1], ']'};
+      auto end = regex.find(std::string_view{terminator, 2}, i + 2);
+      if (end == std::string_view::npos) {
+        return std::nullopt;
+      }
+      i = end + 1;
+    } else if (regex[i] == ']') {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+// Return the position of the `)` that closes the group that is opened by the
+// `(` at `regex[openPos]`, or `std::nullopt` if there is none.
+std::optional<size_t> findClosingParenthesis(std::string_view regex,
+                                             size_t openPos) {
+  size_t depth = 0;
+  for (size_t i = openPos; i < regex.size(); ++i) {
+    char c = regex[i];
+    if (c == '\\') {
+      ++i;
+    } else if (c == '[') {
+      auto end = findClosingBracket(regex, i);
+      if (!end.has_value()) {
+        return std::nullopt;
+      }
+      i = end.value();
+    } else if (c == '(') {
+      ++depth;
+    } else if (c == ')') {
+      --depth;
+      if (depth == 0) {
+        return i;
+      }
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TrigramIndex::Builder::Builder(std::string sorterFilename,
+                               ad_utility::MemorySize memoryLimit,
+                               ad_utility::AllocatorWithLimit<Id> allocator)
+    : sorter_{std::move(sorterFilename), memoryLimit, std::move(allocator)} {}
+
+// _____________________________________________________________________________
+void TrigramIndex::Builder::addWord(std::string_view word, uint64_t index) {
+  auto content = getLiteralContent(word);
+  if (!content.has_value()) {
+    return;
+  }
+  if (!literalRanges_.empty() && literalRanges_.back().second == index) {
+    ++literalRanges_.back().second;
+  } else {
+    AD_CONTRACT_CHECK(literalRanges_.empty() ||
+                      literalRanges_.back().second < index);
+    literalRanges_.emplace_back(index, index + 1);
+  }
+  for (Trigram trigram : getTrigrams(content.value())) {
+    sorter_.push(std::array{Id::fromBits(trigram), Id::fromBits(index)});
+  }
+}
+
+// _____________________________________________________________________________
+void TrigramIndex::Builder::writeToFile(const std::string& filename) && {
+  // File format: the offset of the metadata, followed by the lists of
+  // `VocabIndex`es (one per trigram), followed by the metadata.
+  ad_utility::serialization::FileWriteSerializer serializer{filename};
+  uint64_t metadataOffset = 0;
+  serializer << metadataOffset;
+  std::vector<Trigram> trigrams;
+  std::vector<uint64_t> offsets;
+  uint64_t numEntries = 0;
+  // The sorted pairs are grouped by the trigram, and the indices of each
+  // trigram are sorted, so the lists can be written block by block.
+  std::vector<uint64_t> buffer;
+  for (const auto& block : sorter_.getSortedBlocks()) {
+    buffer.clear();
+    buffer.reserve(block.numRows());
+    for (const auto& row : block) {
+      auto trigram = static_cast<Trigram>(row[0].getBits());
+      if (trigrams.empty() || trigrams.back() != trigram) {
+        trigrams.push_back(trigram);
+        offsets.push_back(numEntries);
+      }
+      buffer.push_back(row[1].getBits());
+      ++numEntries;
+    }
+    serializer.serializeBytes(reinterpret_cast<const char*>(buffer.data()),
+                              buffer.size() * sizeof(uint64_t));
+  }
+  offsets.push_back(numEntries);
+  metadataOffset = serializer.getSerializationPosition();
+  serializer << trigrams;
+  serializer << offsets;
+  serializer << literalRanges_;
+  serializer.setSerializationPosition(0);
+  serializer << metadataOffset;
+  AD_LOG_INFO << "Trigram index: " << trigrams.size()
+              << " distinct trigrams with " << numEntries << " occurrences in "
+              << "literals" << std::endl;
+}
+
+// _____________________________________________________________________________
+void TrigramIndex::readFromFile(const std::string& filename) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  uint64_t metadataOffset;
+  serializer >> metadataOffset;
+  serializer.setSerializationPosition(metadataOffset);
+  serializer >> trigrams_;
+  serializer >> offsets_;
+  serializer >> literalRanges_;
+  AD_CORRECTNESS_CHECK(offsets_.size() == trigrams_.size() + 1);
+  postingsFile_ = std::move(serializer).file();
+}
+
+// _____________________________________________________________________________
+bool TrigramIndex::isIndexedLiteral(VocabIndex index) const {
+  auto it = ql::ranges::upper_bound(literalRanges_, index.get(), {},
+                                    &IndexRange::first);
+  return it != literalRanges_.begin() && index.get() < std::prev(it)->second;
+}
+
+// _____________________________________________________________________________
+std::vector<uint64_t> TrigramIndex::readPostings(size_t i) const {
+  std::vector<uint64_t> result(offsets_.at(i + 1) - offsets_.at(i));
+  // The lists start after the offset of the metadata.
+  off_t offsetInFile = (1 + offsets_[i]) * sizeof(uint64_t);
+  size_t numBytes = result.size() * sizeof(uint64_t);
+  auto numBytesRead = postingsFile_.read(result.data(), numBytes, offsetInFile);
+  AD_CORRECTNESS_CHECK(numBytesRead >= 0 &&
+                       static_cast<size_t>(numBytesRead) == numBytes);
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<VocabIndex>> TrigramIndex::getCandidates(
+    const std::vector<std::string>& requiredSubstrings) const {
+  std::vector<Trigram> trigrams;
+  for (const auto& substring : requiredSubstrings) {
+    ql::ranges::copy(getTrigrams(substring), std::back_inserter(trigrams));
+  }
+  ql::ranges::sort(trigrams);
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+
+  // Find the lists for all the trigrams, if one of them doesn't occur in any
+  // literal, then there are no candidates.
+  std::vector<size_t> listIndices;
+  for (Trigram trigram : trigrams) {
+    auto it = ql::ranges::lower_bound(trigrams_, trigram);
+    if (it == trigrams_.end() || *it != trigram) {
+      return std::vector<VocabIndex>{};
+    }
+    listIndices.push_back(it - trigrams_.begin());
+  }
+
+  // Intersect the lists, starting with the shortest ones, s.t. the
+  // intermediate results are as small as possible.
+  auto listSize = [this](size_t i) { return offsets_[i + 1] - offsets_[i]; };
+  ql::ranges::sort(listIndices, std::less{}, listSize);
+  std::vector<uint64_t> intersection = readPostings(listIndices.front());
+  std::vector<uint64_t> nextIntersection;
+  for (size_t i : listIndices | ql::views::drop(1)) {
+    if (intersection.empty()) {
+      break;
+    }
+    auto list = readPostings(i);
+    nextIntersection.clear();
+    ql::ranges::set_intersection(intersection, list,
+                                 std::back_inserter(nextIntersection));
+    std::swap(intersection, nextIntersection);
+  }
+
+  std::vector<VocabIndex> result;
+  result.reserve(intersection.size());
+  ql::ranges::transform(intersection, std::back_inserter(result),
+                        &VocabIndex::make);
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<TrigramIndex::Trigram> TrigramIndex::getTrigrams(
+    std::string_view s) {
+  std::vector<Trigram> result;
+  if (s.size() < 3) {
+    return result;
+  }
+  result.reserve(s.size() - 2);
+  for (size_t i = 0; i + 3 <= s.size(); ++i) {
+    auto byte = [&s, i](size_t j) {
+      return static_cast<Trigram>(static_cast<unsigned char>(s[i + j]));
+    };
+    result.push_back((byte(0) << 16) | (byte(1) << 8) | byte(2));
+  }
+  ql::ranges::sort(result);
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> TrigramIndex::getRequiredSubstringsOfRegex(
+    std::string_view regex) {
+  std::vector<std::string> result;
+  std::string current;
+  auto finishCurrent = [&result, &current]() {
+    if (!current.empty()) {
+      result.push_back(std::move(current));
+      current.clear();
+    }
+  };
+  // Remove the last character from `current`, because it is made optional by
+  // a quantifier. Note that this character might consist of several bytes in
+  // UTF-8.
+  auto removeLastCharacter = [&current]() {
+    while (!current.empty() &&
+           (static_cast<unsigned char>(current.back()) & 0xC0) == 0x80) {
+      current.pop_back();
+    }
+    if (!current.empty()) {
+      current.pop_back();
+    }
+  };
+  auto isQuantifier = [](char c) { return c == '*' || c == '?' || c == '{'; };
+
+  for (size_t i = 0; i < regex.size(); ++i) {
+    char c = regex[i];
+    switch (c) {
+      case '|':
+        // With alternatives, no single substring is required.
+        return {};
+      case '*':
+      case '?':
+        removeLastCharacter();
+        finishCurrent();
+        break;
+      case '{': {
+        // A repetition like `{0,3}` might make the previous character
+        // optional, we conservatively treat all repetitions like this.
+        removeLastCharacter();
+        finishCurrent();
+        auto end = regex.find('}', i);
+        if (end == std::string_view::npos) {
+          return {};
+        }
+        i = end;
+        break;
+      }
+      case '+':
+        // The previous character is required at least once.
+        finishCurrent();
+        break;
+      case '.':
+      case '^':
+      case '$':
+      case ')':
+        finishCurrent();
+        break;
+      case '[': {
+        finishCurrent();
+        auto end = findClosingBracket(regex, i);
+        if (!end.has_value()) {
+          return {};
+        }
+        i = end.value();
+        break;
+      }
+      case '(': {
+        finishCurrent();
+        auto end = findClosingParenthesis(regex, i);
+        if (!end.has_value()) {
+          return {};
+        }
+        if (end.value() + 1 < regex.size() &&
+            isQuantifier(regex[end.value() + 1])) {
+          // The group is optional, skip it entirely (the quantifier is then
+          // handled by the next iteration and removes nothing).
+          i = end.value();
+          break;
+        }
+        if (i + 1 < regex.size() && regex[i + 1] == '?') {
+          // Only non-capturing `(?:...)` and named `(?P<name>...)` groups are
+          // supported, flags like `(?i)` change the semantics of the literal
+          // characters.
+          if (regex.substr(i + 1).starts_with("?:")) {
+            i += 2;
+          } else if (regex.substr(i + 1).starts_with("?P<")) {
+            auto nameEnd = regex.find('>', i);
+            if (nameEnd == std::string_view::npos) {
+              return {};
+            }
+            i = nameEnd;
+          } else {
+            return {};
+          }
+        }
+        break;
+      }
+      case '\\': {
+        if (i + 1 == regex.size()) {
+          return {};
+        }
+        char escaped = regex[++i];
+        if (!absl::ascii_isalnum(static_cast<unsigned char>(escaped))) {
+          // An escaped special character like `\.` or `\\`.
+          current.push_back(escaped);
+        } else if (std::string_view{"dDwWsSbBAznrtfva"}.find(escaped) !=
+                   std::string_view::npos) {
+          // Character classes, anchors, and control characters.
+          finishCurrent();
+        } else {
+          // Escape sequences with arguments like `\x{41}`, `\pL`, or `\Q...\E`
+          // are not supported.
+          return {};
+        }
+        break;
+      }
+      default:
+        current.push_back(c);
+    }
+  }
+  finishCurrent();
+  return result;
+}
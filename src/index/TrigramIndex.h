@@ -0,0 +1,116 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_INDEX_TRIGRAMINDEX_H
+#define QLEVER_SRC_INDEX_TRIGRAMINDEX_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/Id.h"
+#include "global/VocabIndex.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+
+// An index that maps each trigram (three consecutive bytes) to the sorted list
+// of the `VocabIndex`es of all the literals in the vocabulary, the content of
+// which contains this trigram. A literal can only contain a string `s` if it
+// contains all the trigrams of `s`. The index can thus be used to quickly
+// compute a (typically small) set of candidates for filters like
+// `CONTAINS(?x, "foo")` or `REGEX(?x, "ba.*r")`. The candidates still have to
+// be verified by evaluating the actual filter. The index is optional and built
+// during the merging of the vocabulary if the `--build-trigram-index` option of
+// the `IndexBuilderMain` is set.
+//
+// The postings lists are stored on disk and are read on demand, only the
+// (small) mapping from the trigrams to the offsets of their lists is kept in
+// memory.
+class TrigramIndex {
+ public:
+  // A trigram, the three bytes of which are stored in the lower 24 bits.
+  using Trigram = uint32_t;
+  // A half-open range `[first, second)` of `VocabIndex`es that are literals.
+  using IndexRange = std::pair<uint64_t, uint64_t>;
+
+  // Incrementally build a `TrigramIndex` from the words of a vocabulary and
+  // write it to disk. The pairs of (trigram, `VocabIndex`) are collected in an
+  // external sorter, s.t. the memory usage is bounded by the given limit also
+  // for very large vocabularies.
+  class Builder {
+    // Sort the pairs of (trigram, `VocabIndex`), which are stored as the bits
+    // of the `Id`s, first by the trigram and then by the index.
+    struct SortByTrigramAndIndex {
+      bool operator()(const auto& a, const auto& b) const {
+        return std::pair{a[0].getBits(), a[1].getBits()} <
+               std::pair{b[0].getBits(), b[1].getBits()};
+      }
+    };
+    ad_utility::CompressedExternalIdTableSorter<SortByTrigramAndIndex, 2>
+        sorter_;
+    std::vector<IndexRange> literalRanges_;
+
+   public:
+    // The `sorterFilename` is used for the temporary file of the external
+    // sorter, which may use at most `memoryLimit` of RAM.
+    Builder(std::string sorterFilename, ad_utility::MemorySize memoryLimit,
+            ad_utility::AllocatorWithLimit<Id> allocator);
+
+    // Add the next `word` of the vocabulary, which has the given `index`. Must
+    // be called in ascending order of the `index`. Words that are not literals
+    // are ignored.
+    void addWord(std::string_view word, uint64_t index);
+
+    // Write the index to the given `filename`.
+    void writeToFile(const std::string& filename) &&;
+  };
+
+ private:
+  // The trigrams that occur in at least one literal in ascending order, and
+  // for each of them the offset of its list of `VocabIndex`es (in number of
+  // elements) in the `postingsFile_`. `offsets_` contains an additional last
+  // element, which is the total number of `VocabIndex`es in the file.
+  std::vector<Trigram> trigrams_;
+  std::vector<uint64_t> offsets_;
+  // The ranges of the vocabulary that consist of literals. These are exactly
+  // the vocabulary entries that were considered when building the index.
+  std::vector<IndexRange> literalRanges_;
+  ad_utility::File postingsFile_;
+
+ public:
+  // Read an index that was previously written by a `Builder`.
+  void readFromFile(const std::string& filename);
+
+  // Return true iff the word with the given `index` is a literal that is
+  // covered by this index.
+  bool isIndexedLiteral(VocabIndex index) const;
+
+  // Return the sorted list of the indexed literals that might contain all of
+  // the `requiredSubstrings`. All indexed literals that are not part of the
+  // result are guaranteed to not contain at least one of the substrings.
+  // Return `std::nullopt` if the substrings don't contain any trigram (e.g.
+  // because all of them are shorter than three bytes), so the index can't be
+  // used to restrict the candidates.
+  std::optional<std::vector<VocabIndex>> getCandidates(
+      const std::vector<std::string>& requiredSubstrings) const;
+
+  // Return all the distinct trigrams of `s` in ascending order.
+  static std::vector<Trigram> getTrigrams(std::string_view s);
+
+  // Return strings that every string matched by the (RE2) `regex` must
+  // contain. For example, for `ab.*cd?e` return `{"ab", "c", "e"}`. The
+  // analysis is conservative: for regexes that contain alternatives, inline
+  // flags, or unsupported escape sequences the result is empty.
+  static std::vector<std::string> getRequiredSubstringsOfRegex(
+      std::string_view regex);
+
+ private:
+  // Read the list of `VocabIndex`es for the `i`-th trigram from disk.
+  std::vector<uint64_t> readPostings(size_t i) const;
+};
+
+#endif  // QLEVER_SRC_INDEX_TRIGRAMINDEX_H
@@ -40,6 +40,7 @@ bool Vocabulary<StringType, ComparatorType, IndexT>::PrefixRanges::contain(
 template <class S, class C, typename I>
 void Vocabulary<S, C, I>::readFromFile(const string& fileName) {
   vocabulary_.close();
+  sortKeyPrefixes_.reset();
   vocabulary_.open(fileName);
 
   // Precomputing ranges for IRIs, blank nodes, and literals, for faster
@@ -52,6 +53,15 @@ void Vocabulary<S, C, I>::readFromFile(const string& fileName) {
   prefixRangesLiterals_ = prefixRanges("\"");
 }
 
+// _____________________________________________________________________________
+template <class S, class C, class I>
+void Vocabulary<S, C, I>::readSortKeyPrefixes(const string& fileName) {
+  AD_CONTRACT_CHECK(supportsSortKeyPrefixes);
+  sortKeyPrefixes_.emplace();
+  sortKeyPrefixes_->readFromFile(fileName);
+  AD_CORRECTNESS_CHECK(sortKeyPrefixes_->size() <= size());
+}
+
 // _____________________________________________________________________________
 template <class S, class C, class I>
 void Vocabulary<S, C, I>::createFromSet(
@@ -207,6 +217,9 @@ template <typename S, typename C, typename I>
 auto Vocabulary<S, C, I>::upper_bound(const string& word,
                                       const SortLevel level) const
     -> IndexType {
+  if (auto result = boundFromSortKeyPrefixes<true>(word, level)) {
+    return result.value();
+  }
   auto wordAndIndex = vocabulary_.upper_bound(word, level);
   return IndexType::make(wordAndIndex.indexOrDefault(size()));
 }
@@ -216,10 +229,48 @@ template <typename S, typename C, typename I>
 auto Vocabulary<S, C, I>::lower_bound(std::string_view word,
                                       const SortLevel level) const
     -> IndexType {
+  if (auto result = boundFromSortKeyPrefixes<false>(word, level)) {
+    return result.value();
+  }
   auto wordAndIndex = vocabulary_.lower_bound(word, level);
   return IndexType::make(wordAndIndex.indexOrDefault(size()));
 }
 
+// _____________________________________________________________________________
+template <typename S, typename C, typename I>
+template <bool isUpperBound>
+auto Vocabulary<S, C, I>::boundFromSortKeyPrefixes(std::string_view word,
+                                                   SortLevel level) const
+    -> std::optional<IndexType> {
+  if constexpr (!supportsSortKeyPrefixes) {
+    return std::nullopt;
+  } else {
+    if (!sortKeyPrefixes_.has_value()) {
+      return std::nullopt;
+    }
+    const auto& comparator = getCaseComparator();
+    // The bound lies within the range of the words with the same prefix (or
+    // at its end), so only this range has to be searched.
+    auto [lower, upper] =
+        sortKeyPrefixes_->getRange(comparator.getSortKeyPrefix(word));
+    while (lower < upper) {
+      uint64_t middle = lower + (upper - lower) / 2;
+      auto middleWord = vocabulary_[middle];
+      bool isBeforeBound = isUpperBound
+                               ? !comparator(word, middleWord, level)
+                               : comparator(middleWord, word, level);
+      if (isBeforeBound) {
+        lower = middle + 1;
+      } else {
+        upper = middle;
+      }
+    }
+    // The prefixes only cover the main vocabulary (see
+    // `SortKeyPrefixes::Builder`), which is searched by `vocabulary_` as well.
+    return IndexType::make(lower == sortKeyPrefixes_->size() ? size() : lower);
+  }
+}
+
 // _____________________________________________________________________________
 template <typename S, typename ComparatorType, typename I>
 void Vocabulary<S, ComparatorType, I>::setLocale(const std::string& language,
@@ -24,6 +24,7 @@
 #include "index/StringSortComparator.h"
 #include "index/vocabulary/CompressedVocabulary.h"
 #include "index/vocabulary/PolymorphicVocabulary.h"
+#include "index/vocabulary/SortKeyPrefixes.h"
 #include "index/vocabulary/UnicodeVocabulary.h"
 #include "index/vocabulary/VocabularyInMemory.h"
 #include "util/Exception.h"
@@ -104,6 +105,10 @@ class Vocabulary {
   PrefixRanges prefixRangesIris_;
   PrefixRanges prefixRangesLiterals_;
 
+  // The optional prefixes of the sort keys of the words, see
+  // `readSortKeyPrefixes`.
+  std::optional<SortKeyPrefixes> sortKeyPrefixes_;
+
  public:
   using SortLevel = typename ComparatorType::Level;
   using IndexType = IndexT;
@@ -121,6 +126,19 @@ class Vocabulary {
   //! Read the vocabulary from file.
   void readFromFile(const std::string& filename);
 
+  // The `SortKeyPrefixes` can only be used with the
+  // `TripleComponentComparator`.
+  static constexpr bool supportsSortKeyPrefixes =
+      std::is_same_v<ComparatorType, TripleComponentComparator>;
+
+  // Read the prefixes of the sort keys of the words (see `SortKeyPrefixes`),
+  // which make `lower_bound` and `upper_bound` much cheaper. Must be called
+  // after `readFromFile`.
+  void readSortKeyPrefixes(const std::string& filename);
+
+  // Return true iff the prefixes of the sort keys were read.
+  bool hasSortKeyPrefixes() const { return sortKeyPrefixes_.has_value(); }
+
   // Get the word with the given `idx`. Throw if the `idx` is not contained
   // in the vocabulary.
   AccessReturnType operator[](IndexType idx) const;
@@ -230,6 +248,14 @@ class Vocabulary {
       vocabulary_.getUnderlyingVocabulary().resetToType(type);
     }
   }
+
+ private:
+  // Compute the `lower_bound` (or the `upper_bound` if `isUpperBound` is true)
+  // of the `word` using the `sortKeyPrefixes_`. Return `std::nullopt` if there
+  // are no `sortKeyPrefixes_`.
+  template <bool isUpperBound>
+  std::optional<IndexType> boundFromSortKeyPrefixes(std::string_view word,
+                                                    SortLevel level) const;
 };
 
 namespace detail {
@@ -15,9 +15,12 @@
 #include "index/ConstantsIndexBuilding.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/Vocabulary.h"
+#include "util/Generator.h"
 #include "util/HashMap.h"
 #include "util/MmapVector.h"
 #include "util/ProgressBar.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
 #include "util/TypeTraits.h"
 
 using IdPairMMapVec = ad_utility::MmapVector<std::pair<Id, Id>>;
@@ -29,11 +32,18 @@ using TripleVec =
 namespace ad_utility::vocabulary_merger {
 // Concept for a callback that can be called with a `string_view` and a `bool`.
 // If the `bool` is true, then the word is to be stored in the external
-// vocabulary else in the internal vocabulary.
+// vocabulary else in the internal vocabulary. The callback can optionally take
+// the `SortKeyPrefix` of the word (see
+// `TripleComponentComparator::getSortKeyPrefix`) as a third argument.
+template <typename T>
+CPP_concept WordCallbackWithSortKeyPrefix =
+    ad_utility::InvocableWithExactReturnType<T, uint64_t, std::string_view,
+                                             bool, uint64_t>;
 template <typename T>
 CPP_concept WordCallback =
     ad_utility::InvocableWithExactReturnType<T, uint64_t, std::string_view,
-                                             bool>;
+                                             bool> ||
+    WordCallbackWithSortKeyPrefix<T>;
 // Concept for a callable that compares two `string_view`s.
 template <typename T>
 CPP_concept WordComparator =
@@ -139,6 +149,22 @@ struct VocabularyMetaData {
   const ad_utility::HashMap<std::string, Id>* globalSpecialIds_ =
       &qlever::specialIds();
 };
+// A word from a partial vocabulary, together with its position in the file of
+// the partial vocabulary. See `PARTIAL_VOCAB_SAMPLE_DISTANCE`.
+struct PartialVocabularySample {
+  std::string word_;
+  // The offset of the word in the file (in bytes).
+  uint64_t offset_;
+  // The number of words before this word in the partial vocabulary.
+  uint64_t index_;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(PartialVocabularySample) {
+    serializer | arg.word_;
+    serializer | arg.offset_;
+    serializer | arg.index_;
+  }
+};
+
 // _______________________________________________________________
 // Merge the partial vocabularies in the  binary files
 // `basename + PARTIAL_VOCAB_FILE_NAME + to_string(i)`
@@ -148,9 +174,16 @@ struct VocabularyMetaData {
 // strings (case-sensitive or not). Argument `wordCallback`
 // is called for each merged word in the vocabulary in the order of their
 // appearance.
+// If the samples of all the partial vocabularies exist (see
+// `writePartialVocabularyToFile`), then the words are split into (at most)
+// `numRanges` ranges, which are merged in parallel.
+// The words are first ordered by the `SortKeyPrefix` that is stored with them
+// in the partial vocabularies, and only words with equal prefixes are compared
+// using the `comparator`, so the two have to be consistent.
 template <typename W, typename C>
 auto mergeVocabulary(const std::string& basename, size_t numFiles, W comparator,
-                     C& wordCallback, ad_utility::MemorySize memoryToUse)
+                     C& wordCallback, ad_utility::MemorySize memoryToUse,
+                     size_t numRanges = NUM_PARALLEL_VOCABULARY_MERGE_RANGES)
     -> CPP_ret(VocabularyMetaData)(
         requires WordComparator<W>&& WordCallback<C>);
 
@@ -164,6 +197,7 @@ class VocabularyMerger {
   // The result (mostly metadata) which we'll return.
   VocabularyMetaData metaData_;
   std::optional<TripleComponentWithIndex> lastTripleComponent_ = std::nullopt;
+  uint64_t lastSortKeyPrefix_ = 0;
   // we will store pairs of <partialId, globalId>
   std::vector<IdPairMMapVec> idVecs_;
 
@@ -173,7 +207,8 @@ class VocabularyMerger {
   template <typename W, typename C>
   friend auto mergeVocabulary(const std::string& basename, size_t numFiles,
                               W comparator, C& wordCallback,
-                              ad_utility::MemorySize memoryToUse)
+                              ad_utility::MemorySize memoryToUse,
+                              size_t numRanges)
       -> CPP_ret(VocabularyMetaData)(
           requires WordComparator<W>&& WordCallback<C>);
   VocabularyMerger() = default;
@@ -184,18 +219,23 @@ class VocabularyMerger {
   template <typename W, typename C>
   auto mergeVocabulary(const std::string& basename, size_t numFiles,
                        W comparator, C& wordCallback,
-                       ad_utility::MemorySize memoryToUse)
+                       ad_utility::MemorySize memoryToUse, size_t numRanges)
       -> CPP_ret(VocabularyMetaData)(
           requires WordComparator<W>&& WordCallback<C>);
 
   // Helper `struct` for a word from a partial vocabulary.
   struct QueueWord {
     QueueWord() = default;
-    QueueWord(TripleComponentWithIndex&& v, size_t file)
-        : entry_(std::move(v)), partialFileId_(file) {}
+    QueueWord(TripleComponentWithIndex&& v, size_t file,
+              uint64_t sortKeyPrefix)
+        : entry_(std::move(v)),
+          partialFileId_(file),
+          sortKeyPrefix_(sortKeyPrefix) {}
     TripleComponentWithIndex entry_;  // the word, its local ID and the
                                       // information if it will be externalized
     size_t partialFileId_;  // from which partial vocabulary did this word come
+    // The `SortKeyPrefix` of the word, which decides most of the comparisons.
+    uint64_t sortKeyPrefix_ = 0;
 
     [[nodiscard]] const bool& isExternal() const { return entry_.isExternal(); }
     [[nodiscard]] bool& isExternal() { return entry_.isExternal(); }
@@ -212,6 +252,37 @@ class VocabularyMerger {
                                          q.entry_.iriOrLiteral().size());
   };
 
+  // Read the samples of all the partial vocabularies. Return `nullopt` if the
+  // samples of one of the partial vocabularies don't exist.
+  static std::optional<std::vector<std::vector<PartialVocabularySample>>>
+  readSamples(const std::string& basename, size_t numFiles);
+
+  // Choose (at most) `numRanges - 1` distinct splitters from the `samples`,
+  // s.t. the ranges between the splitters contain about the same number of
+  // words. The splitters are sorted wrt the `comparator`.
+  template <typename W>
+  static std::vector<std::string> computeSplitters(
+      const std::vector<std::vector<PartialVocabularySample>>& samples,
+      const W& comparator, size_t numRanges);
+
+  // Yield the words `w` with `*lower <= w < *upper` from the partial
+  // vocabulary in the file `filename` with the given `fileIndex`. A `nullptr`
+  // means that there is no lower (upper) bound. The words before the last
+  // sample from `samples` that is less than the lower bound are skipped
+  // without being read.
+  template <typename W>
+  static cppcoro::generator<QueueWord> readPartialVocabulary(
+      std::string filename, size_t fileIndex,
+      const std::vector<PartialVocabularySample>* samples,
+      const std::string* lower, const std::string* upper, W comparator);
+
+  // Pass the sorted `words` (a range of `QueueWord`s) in batches to
+  // `writeQueueWordsToIdVec`. The writing of a batch is done asynchronously
+  // while the next batch is collected.
+  template <typename R, typename C, typename L>
+  void writeMergedWords(R&& words, C& wordCallback, const L& lessThan,
+                        ad_utility::ProgressBar& progressBar);
+
   // Write the queue words in the buffer to their corresponding `idPairVecs`.
   // The `QueueWord`s must be passed in alphabetical order wrt `lessThan` (also
   // across multiple calls).
@@ -229,6 +300,7 @@ class VocabularyMerger {
   void clear() {
     metaData_ = VocabularyMetaData{};
     lastTripleComponent_ = std::nullopt;
+    lastSortKeyPrefix_ = 0;
     idVecs_.clear();
   }
 
@@ -271,11 +343,18 @@ void writeMappedIdsToExtVec(const T& input,
  * For each string first writes the size of the string (64 bits). Then the
  * actual string content (no trailing zero) and then the Id (sizeof(Id)
  *
+ * Each word is followed by its `SortKeyPrefix`, which is used to speed up the
+ * merging of the partial vocabularies.
+ *
+ * Every `sampleDistance`-th word is also written to the file
+ * `fileName + PARTIAL_VOCAB_SAMPLES_SUFFIX` as a `PartialVocabularySample`.
+ *
  * @param els The input
  * @param fileName will write to this file. If it exists it will be overwritten
  */
-void writePartialVocabularyToFile(const ItemVec& els,
-                                  const std::string& fileName);
+void writePartialVocabularyToFile(
+    const ItemVec& els, const std::string& fileName,
+    size_t sampleDistance = PARTIAL_VOCAB_SAMPLE_DISTANCE);
 
 /**
  * @brief Take an Array of HashMaps of strings to Ids and insert all the
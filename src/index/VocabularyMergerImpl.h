@@ -5,6 +5,7 @@
 #ifndef QLEVER_SRC_INDEX_VOCABULARYMERGERIMPL_H
 #define QLEVER_SRC_INDEX_VOCABULARYMERGERIMPL_H
 
+#include <filesystem>
 #include <fstream>
 #include <future>
 #include <iostream>
@@ -22,6 +23,7 @@
 #include "rdfTypes/RdfEscaping.h"
 #include "util/Conversions.h"
 #include "util/Exception.h"
+#include "util/File.h"
 #include "util/HashMap.h"
 #include "util/InputRangeUtils.h"
 #include "util/Iterators.h"
@@ -38,12 +40,12 @@ namespace ad_utility::vocabulary_merger {
 template <typename W, typename C>
 auto mergeVocabulary(const std::string& basename, size_t numFiles, W comparator,
                      C& internalWordCallback,
-                     ad_utility::MemorySize memoryToUse)
+                     ad_utility::MemorySize memoryToUse, size_t numRanges)
     -> CPP_ret(VocabularyMetaData)(
         requires WordComparator<W>&& WordCallback<C>) {
   VocabularyMerger merger;
   return merger.mergeVocabulary(basename, numFiles, std::move(comparator),
-                                internalWordCallback, memoryToUse);
+                                internalWordCallback, memoryToUse, numRanges);
 }
 
 // _________________________________________________________________
@@ -51,7 +53,8 @@ template <typename W, typename C>
 auto VocabularyMerger::mergeVocabulary(const std::string& basename,
                                        size_t numFiles, W comparator,
                                        C& wordCallback,
-                                       ad_utility::MemorySize memoryToUse)
+                                       ad_utility::MemorySize memoryToUse,
+                                       size_t numRanges)
     -> CPP_ret(VocabularyMetaData)(
         requires WordComparator<W>&& WordCallback<C>) {
   // Return true iff p1 >= p2 according to the lexicographic order of the IRI
@@ -60,51 +63,209 @@ auto VocabularyMerger::mergeVocabulary(const std::string& basename,
                                 const TripleComponentWithIndex& t2) {
     return comparator(t1.iriOrLiteral_, t2.iriOrLiteral_);
   };
+  // Most of the words can already be ordered by their `SortKeyPrefix`, which
+  // is much cheaper than the `comparator`.
   auto lessThanForQueue = [&lessThan](const QueueWord& p1,
                                       const QueueWord& p2) {
+    if (p1.sortKeyPrefix_ != p2.sortKeyPrefix_) {
+      return p1.sortKeyPrefix_ < p2.sortKeyPrefix_;
+    }
     return lessThan(p1.entry_, p2.entry_);
   };
 
-  // Open and prepare all infiles and mmap output vectors.
-  auto makeWordRangeFromFile = [&basename](size_t fileIndex) {
-    ad_utility::serialization::FileReadSerializer infile{
-        absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, fileIndex)};
-    uint64_t numWords;
-    infile >> numWords;
-
-    return ad_utility::CachingTransformInputRange{
-        ad_utility::integerRange(numWords),
-        [fileIndex, infile{std::move(infile)}](
-            [[maybe_unused]] const std::size_t i) mutable {
-          TripleComponentWithIndex val;
-          infile >> val;
-          return QueueWord{std::move(val), fileIndex};
-        }};
-  };
-  std::vector<decltype(makeWordRangeFromFile(0))> generators;
-  generators.reserve(numFiles);
-
   for (std::size_t i : ad_utility::integerRange(numFiles)) {
-    generators.push_back(makeWordRangeFromFile(i));
     idVecs_.emplace_back(0, absl::StrCat(basename, PARTIAL_MMAP_IDS, i));
   }
 
-  std::vector<QueueWord> sortedBuffer;
-  sortedBuffer.reserve(bufferSize_);
-
-  std::future<void> writeFuture;
+  // Split the words into ranges that can be merged independently. The
+  // splitters are chosen from the samples of the partial vocabularies, s.t.
+  // all the ranges have about the same size. Without samples (e.g. for
+  // partial vocabularies that were written by an older version), there is
+  // only a single range.
+  auto samples = readSamples(basename, numFiles);
+  std::vector<std::string> splitters;
+  if (samples.has_value()) {
+    splitters = computeSplitters(samples.value(), comparator, numRanges);
+  }
+  size_t numActualRanges = splitters.size() + 1;
 
   // Some memory (that is hard to measure exactly) is used for the writing of
   // a batch of merged words, so we only give 80% of the total memory to the
   // merging. This is very approximate and should be investigated in more
   // detail.
-  auto mergedWords =
-      ad_utility::parallelMultiwayMerge<QueueWord, true,
-                                        decltype(sizeOfQueueWord)>(
-          0.8 * memoryToUse, std::move(generators), lessThanForQueue);
+  auto memoryPerRange = 0.8 * memoryToUse / numActualRanges;
+
+  // Merge the words `w` with `*lower <= w < *upper` from all the partial
+  // vocabularies.
+  auto mergeRange = [&](size_t rangeIndex) {
+    const std::string* lower =
+        rangeIndex == 0 ? nullptr : &splitters.at(rangeIndex - 1);
+    const std::string* upper =
+        rangeIndex == splitters.size() ? nullptr : &splitters.at(rangeIndex);
+    std::vector<cppcoro::generator<QueueWord>> generators;
+    generators.reserve(numFiles);
+    for (std::size_t i : ad_utility::integerRange(numFiles)) {
+      generators.push_back(readPartialVocabulary(
+          absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, i), i,
+          samples.has_value() ? &samples.value().at(i) : nullptr, lower, upper,
+          comparator));
+    }
+    return ad_utility::parallelMultiwayMerge<QueueWord, true,
+                                             decltype(sizeOfQueueWord)>(
+        memoryPerRange, std::move(generators), lessThanForQueue);
+  };
+
+  // All ranges but the first are merged concurrently into temporary files,
+  // while the first range is directly passed to the `wordCallback`. The
+  // assignment of the IDs (and therefore the calls to the `wordCallback`)
+  // has to happen in order.
+  auto rangeFilename = [&basename](size_t rangeIndex) {
+    return absl::StrCat(basename, MERGED_VOCAB_RANGE_FILE_NAME, rangeIndex);
+  };
+  std::vector<std::future<uint64_t>> rangeFutures;
+  for (size_t rangeIndex = 1; rangeIndex < numActualRanges; ++rangeIndex) {
+    rangeFutures.push_back(std::async(
+        std::launch::async, [&mergeRange, &rangeFilename, rangeIndex]() {
+          ad_utility::serialization::FileWriteSerializer outfile{
+              rangeFilename(rangeIndex)};
+          uint64_t numWords = 0;
+          auto mergedWords = mergeRange(rangeIndex);
+          for (const QueueWord& word : ql::views::join(mergedWords)) {
+            outfile << word.entry_;
+            outfile << static_cast<uint64_t>(word.partialFileId_);
+            outfile << word.sortKeyPrefix_;
+            ++numWords;
+          }
+          outfile.close();
+          return numWords;
+        }));
+  }
+
   ad_utility::ProgressBar progressBar{metaData_.numWordsTotal(),
                                       "Words merged: "};
-  for (QueueWord& currentWord : ql::views::join(mergedWords)) {
+  {
+    auto mergedWords = mergeRange(0);
+    writeMergedWords(ql::views::join(mergedWords), wordCallback, lessThan,
+                     progressBar);
+  }
+  for (size_t rangeIndex = 1; rangeIndex < numActualRanges; ++rangeIndex) {
+    uint64_t numWords = rangeFutures.at(rangeIndex - 1).get();
+    ad_utility::serialization::FileReadSerializer infile{
+        rangeFilename(rangeIndex)};
+    writeMergedWords(
+        ad_utility::CachingTransformInputRange{
+            ad_utility::integerRange(numWords),
+            [infile{std::move(infile)}](
+                [[maybe_unused]] const std::size_t i) mutable {
+              TripleComponentWithIndex val;
+              uint64_t fileIndex;
+              uint64_t sortKeyPrefix;
+              infile >> val;
+              infile >> fileIndex;
+              infile >> sortKeyPrefix;
+              return QueueWord{std::move(val), fileIndex, sortKeyPrefix};
+            }},
+        wordCallback, lessThan, progressBar);
+    ad_utility::deleteFile(rangeFilename(rangeIndex));
+  }
+  LOG(INFO) << progressBar.getFinalProgressString() << std::flush;
+
+  auto metaData = std::move(metaData_);
+  // completely reset all the inner state
+  clear();
+  return metaData;
+}
+
+// _________________________________________________________________
+inline std::optional<std::vector<std::vector<PartialVocabularySample>>>
+VocabularyMerger::readSamples(const std::string& basename, size_t numFiles) {
+  std::vector<std::vector<PartialVocabularySample>> samples(numFiles);
+  for (std::size_t i : ad_utility::integerRange(numFiles)) {
+    auto filename = absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, i,
+                                 PARTIAL_VOCAB_SAMPLES_SUFFIX);
+    if (!std::filesystem::exists(filename)) {
+      return std::nullopt;
+    }
+    ad_utility::serialization::FileReadSerializer infile{filename};
+    infile >> samples.at(i);
+  }
+  return samples;
+}
+
+// _________________________________________________________________
+template <typename W>
+std::vector<std::string> VocabularyMerger::computeSplitters(
+    const std::vector<std::vector<PartialVocabularySample>>& samples,
+    const W& comparator, size_t numRanges) {
+  std::vector<std::string_view> words;
+  for (const auto& samplesOfFile : samples) {
+    for (const auto& sample : samplesOfFile) {
+      words.push_back(sample.word_);
+    }
+  }
+  ql::ranges::sort(words, comparator);
+  std::vector<std::string> splitters;
+  for (size_t i = 1; i < numRanges; ++i) {
+    size_t index = i * words.size() / numRanges;
+    // The first sample is (about) the smallest word, so it would lead to an
+    // empty first range.
+    if (index == 0 ||
+        (!splitters.empty() && splitters.back() == words.at(index))) {
+      continue;
+    }
+    splitters.emplace_back(words.at(index));
+  }
+  return splitters;
+}
+
+// _________________________________________________________________
+template <typename W>
+cppcoro::generator<VocabularyMerger::QueueWord>
+VocabularyMerger::readPartialVocabulary(
+    std::string filename, size_t fileIndex,
+    const std::vector<PartialVocabularySample>* samples,
+    const std::string* lower, const std::string* upper, W comparator) {
+  ad_utility::serialization::FileReadSerializer infile{std::move(filename)};
+  uint64_t numWords;
+  infile >> numWords;
+  if (lower != nullptr && samples != nullptr) {
+    // All the words before the last sample that is less than `lower` can be
+    // skipped.
+    auto it = ql::ranges::partition_point(
+        *samples, [&comparator, lower](const PartialVocabularySample& s) {
+          return comparator(s.word_, *lower);
+        });
+    if (it != samples->begin()) {
+      --it;
+      infile.setSerializationPosition(it->offset_);
+      numWords -= it->index_;
+    }
+  }
+  for ([[maybe_unused]] auto i : ad_utility::integerRange(numWords)) {
+    TripleComponentWithIndex val;
+    uint64_t sortKeyPrefix;
+    infile >> val;
+    infile >> sortKeyPrefix;
+    if (lower != nullptr && comparator(val.iriOrLiteral_, *lower)) {
+      continue;
+    }
+    if (upper != nullptr && !comparator(val.iriOrLiteral_, *upper)) {
+      co_return;
+    }
+    co_yield QueueWord{std::move(val), fileIndex, sortKeyPrefix};
+  }
+}
+
+// _________________________________________________________________
+template <typename R, typename C, typename L>
+void VocabularyMerger::writeMergedWords(R&& words, C& wordCallback,
+                                        const L& lessThan,
+                                        ad_utility::ProgressBar& progressBar) {
+  std::vector<QueueWord> sortedBuffer;
+  sortedBuffer.reserve(bufferSize_);
+
+  std::future<void> writeFuture;
+  for (QueueWord& currentWord : words) {
     // Accumulate the globally ordered queue words in a buffer.
     sortedBuffer.push_back(std::move(currentWord));
 
@@ -140,12 +301,6 @@ auto VocabularyMerger::mergeVocabulary(const std::string& basename,
   if (!sortedBuffer.empty()) {
     writeQueueWordsToIdVec(sortedBuffer, wordCallback, lessThan, progressBar);
   }
-  LOG(INFO) << progressBar.getFinalProgressString() << std::flush;
-
-  auto metaData = std::move(metaData_);
-  // completely reset all the inner state
-  clear();
-  return metaData;
 }
 
 // ________________________________________________________________________________
@@ -168,14 +323,18 @@ CPP_template_def(typename C, typename L)(
   for (auto& top : buffer) {
     if (!lastTripleComponent_.has_value() ||
         top.iriOrLiteral() != lastTripleComponent_.value().iriOrLiteral()) {
+      // The (expensive) `lessThan` is only needed for equal prefixes.
       if (lastTripleComponent_.has_value() &&
-          !lessThan(lastTripleComponent_.value(), top.entry_)) {
+          (top.sortKeyPrefix_ < lastSortKeyPrefix_ ||
+           (top.sortKeyPrefix_ == lastSortKeyPrefix_ &&
+            !lessThan(lastTripleComponent_.value(), top.entry_)))) {
         LOG(WARN) << "Total vocabulary order violated for "
                   << lastTripleComponent_->iriOrLiteral() << " and "
                   << top.iriOrLiteral() << std::endl;
       }
       lastTripleComponent_ = TripleComponentWithIndex{
           top.iriOrLiteral(), top.isExternal(), metaData_.numWordsTotal()};
+      lastSortKeyPrefix_ = top.sortKeyPrefix_;
 
       // TODO<optimization> If we aim to further speed this up, we could
       // order all the write requests to _outfile _externalOutfile and all the
@@ -186,8 +345,14 @@ CPP_template_def(typename C, typename L)(
       if (nextWord.isBlankNode()) {
         nextWord.index_ = metaData_.getNextBlankNodeIndex();
       } else {
-        nextWord.index_ =
-            wordCallback(nextWord.iriOrLiteral(), nextWord.isExternal());
+        if constexpr (WordCallbackWithSortKeyPrefix<C>) {
+          nextWord.index_ =
+              wordCallback(nextWord.iriOrLiteral(), nextWord.isExternal(),
+                           top.sortKeyPrefix_);
+        } else {
+          nextWord.index_ =
+              wordCallback(nextWord.iriOrLiteral(), nextWord.isExternal());
+        }
         metaData_.addWord(top.iriOrLiteral(), nextWord.index_);
       }
       if (progressBar.update()) {
@@ -290,21 +455,30 @@ inline void writeMappedIdsToExtVec(
 
 // _________________________________________________________________________________________________________
 inline void writePartialVocabularyToFile(const ItemVec& els,
-                                         const std::string& fileName) {
+                                         const std::string& fileName,
+                                         size_t sampleDistance) {
   LOG(DEBUG) << "Writing partial vocabulary to: " << fileName << "\n";
+  AD_CONTRACT_CHECK(sampleDistance > 0);
   ad_utility::serialization::ByteBufferWriteSerializer byteBuffer;
   byteBuffer.reserve(1'000'000'000);
   ad_utility::serialization::FileWriteSerializer serializer{fileName};
   uint64_t size = els.size();  // really make sure that this has 64bits;
   serializer << size;
-  for (const auto& [word, idAndSplitVal] : els) {
+  std::vector<PartialVocabularySample> samples;
+  for (size_t i = 0; i < els.size(); ++i) {
     // When merging the vocabulary, we need the actual word, the (internal) id
     // we have assigned to this word, and the information, whether this word
     // belongs to the internal or external vocabulary.
+    const auto& [word, idAndSplitVal] = els[i];
     const auto& [id, splitVal] = idAndSplitVal;
+    if (i % sampleDistance == 0) {
+      samples.push_back(PartialVocabularySample{
+          std::string{word}, sizeof(size) + byteBuffer.data().size(), i});
+    }
     byteBuffer << word;
     byteBuffer << splitVal.isExternalized_;
     byteBuffer << id;
+    byteBuffer << TripleComponentComparator::getSortKeyPrefix(splitVal);
   }
   {
     ad_utility::TimeBlockAndLog t{"performing the actual write"};
@@ -312,6 +486,10 @@ inline void writePartialVocabularyToFile(const ItemVec& els,
                               byteBuffer.data().size());
     serializer.close();
   }
+  ad_utility::serialization::FileWriteSerializer sampleSerializer{
+      absl::StrCat(fileName, PARTIAL_VOCAB_SAMPLES_SUFFIX)};
+  sampleSerializer << samples;
+  sampleSerializer.close();
   LOG(DEBUG) << "Done writing partial vocabulary\n";
 }
 
@@ -0,0 +1,53 @@
+// Copyright 2025 The QLever Authors
+
+#include "index/vocabulary/SortKeyPrefixes.h"
+
+#include <algorithm>
+
+#include "util/Exception.h"
+#include "util/File.h"
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+SortKeyPrefixes::Builder::Builder(const std::string& filename)
+    : prefixes_{0, filename} {}
+
+// _____________________________________________________________________________
+void SortKeyPrefixes::Builder::addWord(uint64_t index, SortKeyPrefix prefix) {
+  if (index != prefixes_.size()) {
+    AD_CORRECTNESS_CHECK(index > prefixes_.size());
+    return;
+  }
+  if (prefixes_.size() > 0 && prefix < prefixes_.back()) {
+    isSorted_ = false;
+  }
+  prefixes_.push_back(prefix);
+}
+
+// _____________________________________________________________________________
+bool SortKeyPrefixes::Builder::finish() && {
+  auto filename = prefixes_.getFilename();
+  prefixes_.close();
+  if (!isSorted_) {
+    AD_LOG_WARN << "The prefixes of the sort keys are not consistent with the "
+                   "order of the vocabulary and are therefore not used"
+                << std::endl;
+    ad_utility::deleteFile(filename);
+  }
+  return isSorted_;
+}
+
+// _____________________________________________________________________________
+void SortKeyPrefixes::readFromFile(const std::string& filename) {
+  prefixes_.open(filename);
+}
+
+// _____________________________________________________________________________
+std::pair<uint64_t, uint64_t> SortKeyPrefixes::getRange(
+    SortKeyPrefix prefix) const {
+  const SortKeyPrefix* begin = prefixes_.data();
+  const SortKeyPrefix* end = begin + prefixes_.size();
+  auto [first, last] = std::equal_range(begin, end, prefix);
+  return {static_cast<uint64_t>(first - begin),
+          static_cast<uint64_t>(last - begin)};
+}
@@ -0,0 +1,61 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARY_SORTKEYPREFIXES_H
+#define QLEVER_SRC_INDEX_VOCABULARY_SORTKEYPREFIXES_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "util/MmapVector.h"
+
+// The `SortKeyPrefix` (see `TripleComponentComparator::getSortKeyPrefix`) of
+// each word in a vocabulary, stored in a separate file next to the vocabulary.
+// As the prefixes are sorted, a binary search on them restricts the range of
+// the vocabulary that contains the lower or upper bound of a word to the words
+// with the same prefix. Only within this (typically very small) range, the
+// words have to be decompressed and compared via ICU.
+//
+// The prefixes are built during the merging of the vocabulary, where they are
+// already known from the partial vocabularies.
+class SortKeyPrefixes {
+ public:
+  using SortKeyPrefix = uint64_t;
+
+  // Write the prefixes of the words of a vocabulary to a file.
+  class Builder {
+    ad_utility::MmapVector<SortKeyPrefix> prefixes_;
+    bool isSorted_ = true;
+
+   public:
+    explicit Builder(const std::string& filename);
+
+    // Add the `prefix` of the next word of the vocabulary, which has the given
+    // `index`. Words with a larger `index` belong to one of the other
+    // vocabularies of a `SplitVocabulary` (the `index` contains a marker),
+    // and are ignored.
+    void addWord(uint64_t index, SortKeyPrefix prefix);
+
+    // Finish writing the prefixes. Return false (and delete the file) if the
+    // prefixes were not sorted, which means that they are not consistent with
+    // the order of the vocabulary and can't be used.
+    bool finish() &&;
+  };
+
+ private:
+  ad_utility::MmapVectorView<SortKeyPrefix> prefixes_;
+
+ public:
+  // Read the prefixes that were previously written by a `Builder`.
+  void readFromFile(const std::string& filename);
+
+  // The number of words.
+  size_t size() const { return prefixes_.size(); }
+
+  // Return the half-open range `[first, second)` of the words that have the
+  // given `prefix`. All the words before this range are smaller and all the
+  // words after it are larger than every word with this `prefix`.
+  std::pair<uint64_t, uint64_t> getRange(SortKeyPrefix prefix) const;
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARY_SORTKEYPREFIXES_H
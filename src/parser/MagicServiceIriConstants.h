@@ -18,6 +18,9 @@ constexpr inline std::string_view SPATIAL_SEARCH_IRI =
 constexpr inline std::string_view TEXT_SEARCH_IRI =
     "<https://qlever.cs.uni-freiburg.de/textSearch/>";
 
+constexpr inline std::string_view MATERIALIZED_VIEW_IRI =
+    "<https://qlever.cs.uni-freiburg.de/materializedView/>";
+
 // For backward compatibility: invocation of SpatialJoin via special predicates.
 static const std::string MAX_DIST_IN_METERS = "<max-distance-in-meters:";
 static const std::string NEAREST_NEIGHBORS = "<nearest-neighbors:";
@@ -0,0 +1,58 @@
+// Copyright 2025 The QLever Authors
+
+#include "parser/MaterializedViewQuery.h"
+
+#include <absl/strings/str_cat.h>
+
+#include "parser/MagicServiceIriConstants.h"
+#include "parser/NormalizedString.h"
+#include "parser/SparqlTriple.h"
+
+namespace parsedQuery {
+
+// ____________________________________________________________________________
+void MaterializedViewQuery::addParameter(const SparqlTriple& triple) {
+  auto simpleTriple = triple.getSimple();
+  const TripleComponent& object = simpleTriple.o_;
+  auto predString =
+      extractParameterName(simpleTriple.p_, MATERIALIZED_VIEW_IRI);
+  constexpr std::string_view columnPrefix = "column-";
+
+  if (predString == "name") {
+    if (!object.isLiteral()) {
+      throw MaterializedViewException(
+          "The parameter <name> expects a literal");
+    }
+    if (name_.has_value()) {
+      throw MaterializedViewException(
+          "The parameter <name> must only be specified once");
+    }
+    name_ = std::string{asStringViewUnsafe(object.getLiteral().getContent())};
+  } else if (predString.starts_with(columnPrefix) &&
+             predString.size() > columnPrefix.size()) {
+    std::string column{predString.substr(columnPrefix.size())};
+    if (ql::ranges::any_of(columns_, [&column](const auto& entry) {
+          return entry.first == column;
+        })) {
+      throw MaterializedViewException(absl::StrCat(
+          "The column `?", column, "` of the view must only be bound once"));
+    }
+    columns_.emplace_back(std::move(column), object);
+  } else {
+    throw MaterializedViewException(
+        absl::StrCat("Unsupported argument <", predString,
+                     "> in materialized view. Supported arguments: <name>, "
+                     "<column-NAME> for each column `?NAME` of the view."));
+  }
+}
+
+// ____________________________________________________________________________
+const std::string& MaterializedViewQuery::getName() const {
+  if (!name_.has_value()) {
+    throw MaterializedViewException(
+        "A scan of a materialized view requires the parameter <name>");
+  }
+  return name_.value();
+}
+
+}  // namespace parsedQuery
@@ -0,0 +1,44 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_PARSER_MATERIALIZEDVIEWQUERY_H
+#define QLEVER_SRC_PARSER_MATERIALIZEDVIEWQUERY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/MagicServiceQuery.h"
+
+namespace parsedQuery {
+
+class MaterializedViewException : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+// Scan of a materialized view (see `MaterializedView`) via SERVICE, for
+// example
+//
+//   SERVICE view: {
+//     [] view:name "labels" ; view:column-entity ?x ; view:column-label ?l
+//   }
+//
+// The object of `view:column-<name>` is bound to the column of the view that
+// is named `?<name>` in the query of the view. It is either a variable or a
+// constant, which restricts the view to the rows with this value. The columns
+// of the view that are not mentioned are not part of the result.
+struct MaterializedViewQuery : MagicServiceQuery {
+  std::optional<std::string> name_;
+  // The names of the columns (without the leading `?`) together with the
+  // variable or constant they are bound to, in the order of the triples.
+  std::vector<std::pair<std::string, TripleComponent>> columns_;
+
+  // See `MagicServiceQuery` for details.
+  void addParameter(const SparqlTriple& triple) override;
+
+  // Return the name of the view, throw if it was not specified.
+  const std::string& getName() const;
+};
+
+}  // namespace parsedQuery
+
+#endif  // QLEVER_SRC_PARSER_MATERIALIZEDVIEWQUERY_H
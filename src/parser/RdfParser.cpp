@@ -11,6 +11,7 @@
 #include <cstring>
 #include <exception>
 #include <optional>
+#include <thread>
 
 #include "engine/CallFixedSize.h"
 #include "global/Constants.h"
@@ -1262,7 +1263,7 @@ RdfParallelParser<T>::~RdfParallelParser() {
 template <typename TokenizerT>
 static std::unique_ptr<RdfParserBase> makeSingleRdfParser(
     const Index::InputFileSpecification& file,
-    ad_utility::MemorySize bufferSize) {
+    ad_utility::MemorySize bufferSize, size_t numParserThreads) {
   auto graph = [file]() -> TripleComponent {
     if (file.defaultGraph_.has_value()) {
       return TripleComponent::Iri::fromIrirefWithoutBrackets(
@@ -1272,16 +1273,19 @@ static std::unique_ptr<RdfParserBase> makeSingleRdfParser(
     }
   };
   auto makeRdfParserImpl = ad_utility::ApplyAsValueIdentity{
-      [&filename = file.filename_, &bufferSize, &graph](
+      [&filename = file.filename_, &bufferSize, &graph, numParserThreads](
           auto useParallel,
           auto isTurtleInput) -> std::unique_ptr<RdfParserBase> {
         using InnerParser =
             std::conditional_t<isTurtleInput == 1, TurtleParser<TokenizerT>,
                                NQuadParser<TokenizerT>>;
-        using Parser =
-            std::conditional_t<useParallel == 1, RdfParallelParser<InnerParser>,
-                               RdfStreamParser<InnerParser>>;
-        return std::make_unique<Parser>(filename, bufferSize, graph());
+        if constexpr (useParallel == 1) {
+          return std::make_unique<RdfParallelParser<InnerParser>>(
+              filename, bufferSize, graph(), numParserThreads);
+        } else {
+          return std::make_unique<RdfStreamParser<InnerParser>>(
+              filename, bufferSize, graph());
+        }
       }};
 
   // The call to `callFixedSize` lifts runtime integers to compile time
@@ -1314,14 +1318,23 @@ std::optional<std::vector<TurtleTriple>> RdfParserBase::getBatch() {
 // ______________________________________________________________
 RdfMultifileParser::RdfMultifileParser(
     const std::vector<qlever::InputFileSpecification>& files,
-    ad_utility::MemorySize bufferSize) {
+    ad_utility::MemorySize bufferSize)
+    : parsingQueue_{QUEUE_SIZE_BEFORE_PARALLEL_PARSING,
+                    getNumConcurrentFiles(files.size(), getThreadBudget())} {
   using namespace qlever;
   // This lambda parses a single file and pushes the results and all occurring
   // exceptions to the `finishedBatchQueue_`.
-  auto parseFile = [this](const InputFileSpecification& file,
-                          ad_utility::MemorySize bufferSize) {
+  size_t numThreadsPerParser = getNumThreadsPerParser(
+      files.size(),
+      static_cast<size_t>(ql::ranges::count_if(
+          files, &InputFileSpecification::parseInParallel_)),
+      getThreadBudget());
+  auto parseFile = [this, numThreadsPerParser](
+                       const InputFileSpecification& file,
+                       ad_utility::MemorySize bufferSize) {
     try {
-      auto parser = makeSingleRdfParser<Tokenizer>(file, bufferSize);
+      auto parser =
+          makeSingleRdfParser<Tokenizer>(file, bufferSize, numThreadsPerParser);
       while (auto batch = parser->getBatch()) {
         bool active = finishedBatchQueue_.push(std::move(batch.value()));
         if (!active) {
@@ -1368,6 +1381,30 @@ RdfMultifileParser::~RdfMultifileParser() {
       "During the destruction of an RdfMultifileParser");
 }
 
+// _____________________________________________________________________________
+size_t RdfMultifileParser::getThreadBudget() {
+  return std::max(NUM_PARALLEL_PARSER_THREADS,
+                  size_t{std::thread::hardware_concurrency()});
+}
+
+// _____________________________________________________________________________
+size_t RdfMultifileParser::getNumConcurrentFiles(size_t numFiles,
+                                                 size_t threadBudget) {
+  return std::clamp(numFiles, size_t{1}, std::max(size_t{1}, threadBudget));
+}
+
+// _____________________________________________________________________________
+size_t RdfMultifileParser::getNumThreadsPerParser(size_t numFiles,
+                                                  size_t numParallelFiles,
+                                                  size_t threadBudget) {
+  // Only the parallel parsers that run at the same time share the budget.
+  size_t numConcurrentParallelFiles =
+      std::clamp(numParallelFiles, size_t{1},
+                 getNumConcurrentFiles(numFiles, threadBudget));
+  return std::clamp(threadBudget / numConcurrentParallelFiles, size_t{1},
+                    NUM_PARALLEL_PARSER_THREADS);
+}
+
 //______________________________________________________________________________
 bool RdfMultifileParser::getLineImpl(TurtleTriple*) { AD_FAIL(); }
 
@@ -593,11 +593,18 @@ class RdfParallelParser : public Parser {
     initialize(filename, bufferSize);
   }
 
-  // Construct a parser from a file and a given default graph iri.
+  // Construct a parser from a file and a given default graph iri. The
+  // `numParserThreads` can be reduced when several files are parsed at the
+  // same time (see `RdfMultifileParser`), s.t. the total number of threads
+  // stays bounded.
   RdfParallelParser(const std::string& filename,
                     ad_utility::MemorySize bufferSize,
-                    const TripleComponent& defaultGraphIri)
-      : Parser{defaultGraphIri}, defaultGraphIri_{defaultGraphIri} {
+                    const TripleComponent& defaultGraphIri,
+                    size_t numParserThreads = NUM_PARALLEL_PARSER_THREADS)
+      : Parser{defaultGraphIri},
+        parallelParser_{QUEUE_SIZE_BEFORE_PARALLEL_PARSING, numParserThreads,
+                        "parallel parser"},
+        defaultGraphIri_{defaultGraphIri} {
     initialize(filename, bufferSize);
   }
 
@@ -672,7 +679,14 @@ class RdfParallelParser : public Parser {
 };
 
 // This class is an RDF parser that parses multiple files in parallel. Each
-// file is specified by an  `InputFileSpecification`.
+// file is specified by an  `InputFileSpecification`. The number of threads
+// for parsing is bounded by a budget (see `getThreadBudget`). Up to this many
+// files are parsed at the same time, each by its own parser. The files for
+// which parallel parsing is enabled additionally get their own pool of parser
+// threads. The budget is evenly distributed among the parallel parsers that
+// run at the same time (but each gets at most `NUM_PARALLEL_PARSER_THREADS`
+// threads, like a single file), s.t. a few large files are parsed with many
+// threads each, and many files don't oversubscribe the CPUs.
 class RdfMultifileParser : public RdfParserBase {
  public:
   // Default construction needed for tests
@@ -706,6 +720,20 @@ class RdfMultifileParser : public RdfParserBase {
   // the parser).
   ~RdfMultifileParser() override;
 
+  // The total number of threads for parsing: the number of hardware threads,
+  // but at least `NUM_PARALLEL_PARSER_THREADS`.
+  static size_t getThreadBudget();
+
+  // Return the number of files that are parsed at the same time, when
+  // `numFiles` files are parsed with the given `threadBudget`.
+  static size_t getNumConcurrentFiles(size_t numFiles, size_t threadBudget);
+
+  // Return the number of threads for each of the parallel parsers, when
+  // `numFiles` files are parsed, `numParallelFiles` of which are parsed with a
+  // parallel parser (see above).
+  static size_t getNumThreadsPerParser(size_t numFiles, size_t numParallelFiles,
+                                       size_t threadBudget);
+
  private:
   // A thread that feeds the file specifications to the actual parser threads.
   ad_utility::JThread feederThread_;
@@ -717,7 +745,8 @@ class RdfMultifileParser : public RdfParserBase {
   // `finishedBatchQueue_` above. Note: It is important, that the
   // `parsingQueue_` is declared *after* the `finishedBatchQueue_`, s.t. when
   // destroying the parser, the threads from the `parsingQueue_` are all joined
-  // before the `finishedBatchQueue_` (which they are using!) is destroyed.
+  // before the `finishedBatchQueue_` (which they are using!) is destroyed. The
+  // constructor sets the number of threads to `getNumConcurrentFiles`.
   ad_utility::TaskQueue<false> parsingQueue_{QUEUE_SIZE_BEFORE_PARALLEL_PARSING,
                                              NUM_PARALLEL_PARSER_THREADS};
 
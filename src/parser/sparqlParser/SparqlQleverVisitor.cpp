@@ -1234,6 +1234,31 @@ GraphPatternOperation Visitor::visitTextSearchQuery(
   return textSearchQuery;
 }
 
+GraphPatternOperation Visitor::visitMaterializedViewQuery(
+    Parser::ServiceGraphPatternContext* ctx) {
+  parsedQuery::GraphPattern graphPattern = visit(ctx->groupGraphPattern());
+  parsedQuery::MaterializedViewQuery viewQuery;
+  for (const auto& op : graphPattern._graphPatterns) {
+    if (!std::holds_alternative<parsedQuery::BasicGraphPattern>(op)) {
+      reportError(ctx,
+                  "Unsupported element in materialized view query. A "
+                  "materialized view query may only consist of triples for "
+                  "configuration");
+    }
+    try {
+      viewQuery.addBasicPattern(std::get<parsedQuery::BasicGraphPattern>(op));
+    } catch (const std::exception& ex) {
+      reportError(ctx, ex.what());
+    }
+  }
+  try {
+    viewQuery.getName();
+  } catch (const std::exception& ex) {
+    reportError(ctx, ex.what());
+  }
+  return viewQuery;
+}
+
 // Parsing for the `serviceGraphPattern` rule.
 GraphPatternOperation Visitor::visit(Parser::ServiceGraphPatternContext* ctx) {
   // Get the IRI and if a variable is specified, report that we do not support
@@ -1263,6 +1288,8 @@ GraphPatternOperation Visitor::visit(Parser::ServiceGraphPatternContext* ctx) {
     return visitSpatialQuery(ctx);
   } else if (serviceIri.toStringRepresentation() == TEXT_SEARCH_IRI) {
     return visitTextSearchQuery(ctx);
+  } else if (serviceIri.toStringRepresentation() == MATERIALIZED_VIEW_IRI) {
+    return visitMaterializedViewQuery(ctx);
   }
   // Parse the body of the SERVICE query. Add the visible variables from the
   // SERVICE clause to the visible variables so far, but also remember them
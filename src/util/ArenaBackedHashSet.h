@@ -0,0 +1,216 @@
+// Copyright 2025 The QLever Authors
+
+#ifndef QLEVER_SRC_UTIL_ARENABACKEDHASHSET_H
+#define QLEVER_SRC_UTIL_ARENABACKEDHASHSET_H
+
+#include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "util/Exception.h"
+#include "util/Forward.h"
+
+namespace ad_utility {
+
+// A hash set of `T`s with the following properties:
+// 1. The addresses of the contained elements are stable for the lifetime of
+//    the set (also when the set is moved), so pointers to the elements can be
+//    handed out. In this respect it behaves like an `absl::node_hash_set`.
+// 2. The elements are not allocated one by one, but placed into large chunks
+//    of memory (an "arena") that grow geometrically. This saves one heap
+//    allocation per element and keeps elements that are inserted together
+//    close together in memory.
+// 3. The deduplication is done via an `absl::flat_hash_set` of pointers into
+//    the arena which also stores the hash of each element. This means that
+//    the elements never have to be rehashed when the index grows.
+// 4. Iteration visits the elements in the order of their insertion.
+// Elements can only be inserted, but never erased.
+template <typename T, typename Hash = absl::Hash<T>,
+          typename Equal = std::equal_to<T>>
+class ArenaBackedHashSet {
+ public:
+  // The number of elements in the first chunk of the arena. Subsequent chunks
+  // double in size until `maxChunkSize` is reached.
+  static constexpr size_t minChunkSize = 64;
+  static constexpr size_t maxChunkSize = 1UL << 16;
+
+ private:
+  // A single contiguous block of memory in the arena with room for `capacity_`
+  // elements, the first `size_` of which are constructed.
+  class Chunk {
+    T* data_;
+    size_t capacity_;
+    size_t size_ = 0;
+
+   public:
+    explicit Chunk(size_t capacity)
+        : data_{std::allocator<T>{}.allocate(capacity)}, capacity_{capacity} {}
+    Chunk(Chunk&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          capacity_{std::exchange(other.capacity_, 0)},
+          size_{std::exchange(other.size_, 0)} {}
+    Chunk& operator=(Chunk&& other) noexcept {
+      std::swap(data_, other.data_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+      return *this;
+    }
+    ~Chunk() {
+      if (data_ == nullptr) {
+        return;
+      }
+      std::destroy_n(data_, size_);
+      std::allocator<T>{}.deallocate(data_, capacity_);
+    }
+
+    bool full() const { return size_ == capacity_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    // Construct a new element at the end of this chunk. The chunk must not be
+    // full.
+    template <typename... Args>
+    const T* emplace(Args&&... args) {
+      AD_EXPENSIVE_CHECK(!full());
+      T* ptr = std::construct_at(data_ + size_, AD_FWD(args)...);
+      ++size_;
+      return ptr;
+    }
+  };
+
+  // The entries of the hash index: a pointer into the arena together with the
+  // precomputed hash of the pointee.
+  struct Slot {
+    size_t hash_;
+    const T* ptr_;
+  };
+  struct SlotHash {
+    size_t operator()(const Slot& slot) const { return slot.hash_; }
+  };
+  struct SlotEqual {
+    bool operator()(const Slot& a, const Slot& b) const {
+      return a.ptr_ == b.ptr_ ||
+             (a.hash_ == b.hash_ && Equal{}(*a.ptr_, *b.ptr_));
+    }
+  };
+
+  std::vector<Chunk> chunks_;
+  absl::flat_hash_set<Slot, SlotHash, SlotEqual> index_;
+
+ public:
+  // Iterator that visits all elements in the order of their insertion.
+  class Iterator {
+    const std::vector<Chunk>* chunks_ = nullptr;
+    size_t chunkIdx_ = 0;
+    size_t idx_ = 0;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    Iterator() = default;
+    Iterator(const std::vector<Chunk>* chunks, size_t chunkIdx)
+        : chunks_{chunks}, chunkIdx_{chunkIdx} {
+      skipEmptyChunks();
+    }
+
+    reference operator*() const { return (*chunks_)[chunkIdx_][idx_]; }
+    pointer operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      ++idx_;
+      if (idx_ == (*chunks_)[chunkIdx_].size()) {
+        ++chunkIdx_;
+        idx_ = 0;
+        skipEmptyChunks();
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+    bool operator==(const Iterator&) const = default;
+
+   private:
+    // A chunk can only be empty if the construction of its first element
+    // threw an exception, but we still have to handle this case correctly.
+    void skipEmptyChunks() {
+      while (chunkIdx_ < chunks_->size() && (*chunks_)[chunkIdx_].size() == 0) {
+        ++chunkIdx_;
+      }
+    }
+  };
+
+  ArenaBackedHashSet() = default;
+
+  // The set can be moved (the addresses of the elements remain stable), but
+  // not copied, because a copy would silently invalidate the pointers that
+  // have been handed out.
+  ArenaBackedHashSet(ArenaBackedHashSet&&) noexcept = default;
+  ArenaBackedHashSet& operator=(ArenaBackedHashSet&&) noexcept = default;
+  ArenaBackedHashSet(const ArenaBackedHashSet&) = delete;
+  ArenaBackedHashSet& operator=(const ArenaBackedHashSet&) = delete;
+
+  // Insert the `value` if no equal element is contained yet. Return a pointer
+  // to the (newly inserted or previously contained) element and a bool that
+  // is true iff the element was newly inserted.
+  template <typename U>
+  std::pair<const T*, bool> insert(U&& value) {
+    const T& valueRef = value;
+    size_t hash = Hash{}(valueRef);
+    if (auto it = index_.find(Slot{hash, &valueRef}); it != index_.end()) {
+      return {it->ptr_, false};
+    }
+    // Make sure that the insertion into the `index_` below can't throw, so
+    // that the arena and the index always contain the same elements.
+    index_.reserve(index_.size() + 1);
+    const T* ptr = emplaceInArena(AD_FWD(value));
+    index_.insert(Slot{hash, ptr});
+    return {ptr, true};
+  }
+
+  // Return a pointer to the element that is equal to `value`, or `nullptr` if
+  // no such element exists.
+  const T* find(const T& value) const {
+    auto it = index_.find(Slot{Hash{}(value), &value});
+    return it == index_.end() ? nullptr : it->ptr_;
+  }
+
+  bool contains(const T& value) const { return find(value) != nullptr; }
+
+  size_t size() const { return index_.size(); }
+  bool empty() const { return index_.empty(); }
+
+  Iterator begin() const { return Iterator{&chunks_, 0}; }
+  Iterator end() const { return Iterator{&chunks_, chunks_.size()}; }
+
+ private:
+  // Construct a new element at the end of the arena and return its address.
+  template <typename U>
+  const T* emplaceInArena(U&& value) {
+    if (chunks_.empty() || chunks_.back().full()) {
+      size_t capacity =
+          chunks_.empty()
+              ? minChunkSize
+              : std::min(2 * chunks_.back().capacity(), maxChunkSize);
+      chunks_.emplace_back(capacity);
+    }
+    return chunks_.back().emplace(AD_FWD(value));
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_ARENABACKEDHASHSET_H
@@ -7,13 +7,20 @@
 #ifndef QLEVER_SRC_UTIL_CACHE_H
 #define QLEVER_SRC_UTIL_CACHE_H
 
+#include <absl/strings/str_cat.h>
+
 #include <cassert>
 #include <concepts>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "backports/algorithm.h"
+#include "util/Exception.h"
 #include "util/HashMap.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/PriorityQueue.h"
@@ -111,6 +118,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
         _maxSize(maxSize),
         _maxSizeSingleEntry(maxSizeSingleEntry),
         _entries(scoreComparator),
+        _scoreComparator(scoreComparator),
         _accessUpdater(accessUpdater),
         _scoreCalculator(scoreCalculator),
         _valueSizeGetter(valueSizeGetter) {}
@@ -227,6 +235,15 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return _maxSizeSingleEntry;
   }
 
+  // Set a function that is called for each entry that is removed from the
+  // cache to make room for other entries (e.g. to move it to a second tier of
+  // the cache). It is not called when entries are explicitly erased or when
+  // the cache is cleared.
+  void setOnRemoval(
+      std::function<void(const Key&, const ValuePtr&)> onRemoval) {
+    _onRemoval = std::move(onRemoval);
+  }
+
   //! Checks if there is an entry with the given key.
   bool contains(const Key& key) const {
     return containsPinned(key) || containsNonPinned(key);
@@ -331,6 +348,27 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   /// Return the number of pinned entries
   [[nodiscard]] size_t numPinnedEntries() const { return _pinnedMap.size(); }
 
+  // Recompute the scores of all the non-pinned entries via
+  // `scoreUpdater(oldScore, entry)`, which has the same interface as the
+  // `AccessUpdater`. This is needed when the strategy that computes the scores
+  // is changed at runtime. The entries are updated in the order in which they
+  // currently would be removed from the cache.
+  template <typename ScoreUpdater>
+  void recomputeScores(const ScoreUpdater& scoreUpdater) {
+    std::vector<typename EntryList::Handle*> handles;
+    handles.reserve(_accessMap.size());
+    for (auto& [key, handle] : _accessMap) {
+      handles.push_back(&handle);
+    }
+    ql::ranges::sort(handles, [this](const auto* a, const auto* b) {
+      return _scoreComparator(a->score(), b->score());
+    });
+    for (auto* handle : handles) {
+      _entries.updateKey(scoreUpdater(handle->score(), handle->value()),
+                         handle);
+    }
+  }
+
   // Delete cache entries from the non-pinned area, until an element of size
   // `sizeToMakeRoomFor` can be inserted into the cache.
   // The special case `sizeToMakeRoomFor == 0_B`  means, that we do not need to
@@ -385,6 +423,14 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   void removeOneEntry() {
     AD_CONTRACT_CHECK(!_entries.empty());
     auto handle = _entries.pop();
+    // Some strategies (e.g. `CostAwareCache` below) keep track of the scores
+    // of the removed entries.
+    if constexpr (requires { _scoreCalculator.onRemoval(handle.score()); }) {
+      _scoreCalculator.onRemoval(handle.score());
+    }
+    if (_onRemoval) {
+      _onRemoval(handle.value().key(), handle.value().value());
+    }
     _totalSizeNonPinned =
         _totalSizeNonPinned - _valueSizeGetter(*handle.value().value());
     _accessMap.erase(handle.value().key());
@@ -397,11 +443,13 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   MemorySize _totalSizePinned;
 
   EntryList _entries;
+  ScoreComparator _scoreComparator;
   AccessUpdater _accessUpdater;
   ScoreCalculator _scoreCalculator;
   ValueSizeGetterT _valueSizeGetter;
   PinnedMap _pinnedMap;
   AccessMap _accessMap;
+  std::function<void(const Key&, const ValuePtr&)> _onRemoval;
 };
 
 // Partial instantiation of FlexibleCache using the heap-based priority queue
@@ -491,6 +539,159 @@ CPP_template(typename Key, typename Value, typename ValueSizeGetterT)(
     HeapBasedLRUCache<Key, Value, ValueSizeGetterT>;
 #endif
 
+// The strategies that a `CostAwareCache` can use to determine which entry is
+// removed next.
+enum class EvictionPolicy {
+  // Remove the least recently used entry.
+  LRU,
+  // GreedyDual-Size-Frequency: Remove the entry with the lowest value of
+  // `L + numAccesses * cost / size`, where `cost` is the time that it took to
+  // compute the value, and `L` is the score of the most recently removed entry
+  // (which makes entries that haven't been accessed for a long time age out).
+  // This keeps small results that are expensive to compute and frequently
+  // accessed, even if there are many large results that are cheap to compute.
+  GDSF
+};
+
+// Convert the name of a policy (`lru` or `gdsf`) to the `EvictionPolicy`.
+// Throw if the name is unknown.
+inline EvictionPolicy evictionPolicyFromString(std::string_view name) {
+  if (name == "lru") {
+    return EvictionPolicy::LRU;
+  } else if (name == "gdsf") {
+    return EvictionPolicy::GDSF;
+  }
+  throw std::runtime_error{absl::StrCat(
+      "Unknown cache eviction policy \"", name,
+      "\", the supported policies are \"lru\" and \"gdsf\"")};
+}
+
+namespace detail {
+// The score of an entry in a `CostAwareCache`. Entries with a lower `priority_`
+// are removed first.
+struct CostAwareScore {
+  double priority_;
+  size_t numAccesses_;
+  bool operator==(const CostAwareScore&) const = default;
+};
+
+struct CostAwareScoreComparator {
+  bool operator()(const CostAwareScore& a, const CostAwareScore& b) const {
+    return a.priority_ < b.priority_;
+  }
+};
+
+// The state that is shared by the access updater and the score calculator of a
+// `CostAwareCache`.
+struct CostAwareState {
+  EvictionPolicy policy_ = EvictionPolicy::LRU;
+  // For `LRU`: A logical clock that is incremented on each access.
+  double clock_ = 0;
+  // For `GDSF`: The inflation value `L` (see `EvictionPolicy::GDSF`).
+  double inflation_ = 0;
+};
+
+// Implements both the `AccessUpdater` and the `ScoreCalculator` for the
+// `CostAwareCache`. The `ValueCostGetterT` maps a value to the cost of its
+// computation as a `double` (the unit doesn't matter, as long as it is the same
+// for all values).
+template <typename ValueSizeGetterT, typename ValueCostGetterT>
+struct CostAwareScoring {
+  std::shared_ptr<CostAwareState> state_;
+  ValueSizeGetterT sizeGetter_;
+  ValueCostGetterT costGetter_;
+
+  // Compute the score of `value` with the given number of accesses according
+  // to the current policy.
+  template <typename Value>
+  CostAwareScore computeScore(const Value& value, size_t numAccesses) const {
+    if (state_->policy_ == EvictionPolicy::LRU) {
+      return {++state_->clock_, numAccesses};
+    }
+    // Empty values still count as one byte to avoid a division by zero.
+    auto size = static_cast<double>(
+        std::max(sizeGetter_(value).getBytes(), size_t{1}));
+    auto cost = static_cast<double>(costGetter_(value));
+    return {state_->inflation_ + static_cast<double>(numAccesses) * cost / size,
+            numAccesses};
+  }
+
+  // The `ScoreCalculator` for newly inserted values.
+  template <typename Value>
+  CostAwareScore operator()(const Value& value) const {
+    return computeScore(value, 1);
+  }
+
+  // The `AccessUpdater`, the `entry` is the entry of the `FlexibleCache`.
+  template <typename Entry>
+  CostAwareScore operator()(const CostAwareScore& score,
+                            const Entry& entry) const {
+    return computeScore(*entry.value(), score.numAccesses_ + 1);
+  }
+
+  // Called by the `FlexibleCache` when an entry is removed to make room.
+  void onRemoval(const CostAwareScore& score) const {
+    if (state_->policy_ == EvictionPolicy::GDSF) {
+      state_->inflation_ = std::max(state_->inflation_, score.priority_);
+    }
+  }
+};
+}  // namespace detail
+
+// A cache that supports the `EvictionPolicy`s from above, the policy can be
+// changed at runtime via `setEvictionPolicy`. The `ValueCostGetterT` maps a
+// value to the cost of its computation (see `detail::CostAwareScoring`). The
+// default policy is `LRU`.
+CPP_template(typename Key, typename Value, typename ValueSizeGetterT,
+             typename ValueCostGetterT)(
+    requires ValueSizeGetter<ValueSizeGetterT, Value>) class CostAwareCache
+    : public HeapBasedCache<
+          Key, Value, detail::CostAwareScore, detail::CostAwareScoreComparator,
+          detail::CostAwareScoring<ValueSizeGetterT, ValueCostGetterT>,
+          detail::CostAwareScoring<ValueSizeGetterT, ValueCostGetterT>,
+          ValueSizeGetterT> {
+  using Scoring = detail::CostAwareScoring<ValueSizeGetterT, ValueCostGetterT>;
+  using Base = HeapBasedCache<Key, Value, detail::CostAwareScore,
+                              detail::CostAwareScoreComparator, Scoring,
+                              Scoring, ValueSizeGetterT>;
+
+  std::shared_ptr<detail::CostAwareState> state_;
+  Scoring scoring_;
+
+  CostAwareCache(size_t capacityNumEls, MemorySize capacitySize,
+                 MemorySize maxSizeSingleEl,
+                 std::shared_ptr<detail::CostAwareState> state)
+      : Base(capacityNumEls, capacitySize, maxSizeSingleEl,
+             detail::CostAwareScoreComparator{}, Scoring{state, {}, {}},
+             Scoring{state, {}, {}}, ValueSizeGetterT{}),
+        state_{state},
+        scoring_{std::move(state), {}, {}} {}
+
+ public:
+  explicit CostAwareCache(size_t capacityNumEls = size_t_max,
+                          MemorySize capacitySize = MemorySize::max(),
+                          MemorySize maxSizeSingleEl = MemorySize::max())
+      : CostAwareCache(capacityNumEls, capacitySize, maxSizeSingleEl,
+                       std::make_shared<detail::CostAwareState>()) {}
+
+  // Change the `EvictionPolicy`. The scores of the existing entries are
+  // recomputed according to the new policy, the number of accesses of each
+  // entry is kept.
+  void setEvictionPolicy(EvictionPolicy policy) {
+    if (policy == state_->policy_) {
+      return;
+    }
+    state_->policy_ = policy;
+    state_->inflation_ = 0;
+    this->recomputeScores(
+        [this](const detail::CostAwareScore& score, const auto& entry) {
+          return scoring_.computeScore(*entry.value(), score.numAccesses_);
+        });
+  }
+
+  EvictionPolicy getEvictionPolicy() const { return state_->policy_; }
+};
+
 }  // namespace ad_utility
 
 #endif  // QLEVER_SRC_UTIL_CACHE_H
@@ -37,6 +37,9 @@ class WaitedForResultWhichThenFailedException : public std::exception {
 enum struct CacheStatus {
   cachedNotPinned,
   cachedPinned,
+  // The result was read from the second tier of the cache (see
+  // `CacheSecondTier` below).
+  cachedInSecondTier,
   // TODO<RobinTF> Rename to notCached, the name is just confusing. Can
   // potentially be merged with notInCacheAndNotComputed.
   computed,
@@ -51,6 +54,8 @@ constexpr std::string_view toString(CacheStatus status) {
       return "cached_not_pinned";
     case CacheStatus::cachedPinned:
       return "cached_pinned";
+    case CacheStatus::cachedInSecondTier:
+      return "cached_in_second_tier";
     case CacheStatus::computed:
       return "computed";
     case CacheStatus::notInCacheAndNotComputed:
@@ -74,6 +79,26 @@ CacheStatus getCacheStatus(const Cache& cache, const Key& key) {
   }
 }
 
+// An optional second tier of a `ConcurrentCache` (e.g. on disk), which is
+// typically larger but slower than the underlying cache. The entries that are
+// removed from the underlying cache to make room for other entries, as well as
+// the pinned entries, are passed to `store`. When a key is neither contained in
+// the underlying cache nor currently being computed, `load` is called before
+// the value is computed.
+template <typename Key, typename Value>
+class CacheSecondTier {
+ public:
+  virtual ~CacheSecondTier() = default;
+
+  // Store the `value` for the `key`. This function is called while the
+  // `ConcurrentCache` is locked, so it must not block for long (e.g. by doing
+  // the actual work asynchronously).
+  virtual void store(const Key& key, std::shared_ptr<const Value> value) = 0;
+
+  // Return the value for the `key` or `nullptr` if it is not stored.
+  virtual std::shared_ptr<Value> load(const Key& key) = 0;
+};
+
 // Implementation details, do not call them from outside this module.
 namespace ConcurrentCacheDetail {
 
@@ -242,6 +267,9 @@ class ConcurrentCache {
                              std::shared_ptr<Value> value) {
     auto lockPtr = _cacheAndInProgressMap.wlock();
     auto& cache = lockPtr->_cache;
+    if (pinned && lockPtr->_secondTier) {
+      lockPtr->_secondTier->store(key, value);
+    }
     if (pinned) {
       if (!cache.containsAndMakePinnedIfExists(key)) {
         cache.insertPinned(key, std::move(value));
@@ -321,6 +349,27 @@ class ConcurrentCache {
     _cacheAndInProgressMap.wlock()->_cache.setMaxSizeSingleEntry(maxSize);
   }
 
+  // Set the eviction policy of the underlying cache. Only supported if the
+  // underlying cache supports several policies (see `CostAwareCache`).
+  template <typename Policy>
+  void setEvictionPolicy(Policy policy) {
+    _cacheAndInProgressMap.wlock()->_cache.setEvictionPolicy(policy);
+  }
+
+  // Set the `CacheSecondTier` (`nullptr` means that there is no second tier).
+  void setSecondTier(std::shared_ptr<CacheSecondTier<Key, Value>> secondTier) {
+    auto lockPtr = _cacheAndInProgressMap.wlock();
+    if (secondTier) {
+      lockPtr->_cache.setOnRemoval(
+          [secondTier](const Key& key, const shared_ptr<const Value>& value) {
+            secondTier->store(key, value);
+          });
+    } else {
+      lockPtr->_cache.setOnRemoval({});
+    }
+    lockPtr->_secondTier = std::move(secondTier);
+  }
+
   MemorySize getMaxSizeSingleEntry() const {
     return _cacheAndInProgressMap.wlock()->_cache.getMaxSizeSingleEntry();
   }
@@ -336,6 +385,8 @@ class ConcurrentCache {
     // Values that are currently being computed. The bool tells us whether this
     // result will be pinned in the cache.
     HashMap<Key, std::pair<bool, shared_ptr<ResultInProgress>>> _inProgress;
+    // The optional second tier of the cache.
+    shared_ptr<CacheSecondTier<Key, Value>> _secondTier;
 
     CacheAndInProgressMap() = default;
     CPP_template_2(typename Arg, typename... Args)(
@@ -357,6 +408,9 @@ class ConcurrentCache {
     auto lockPtr = _cacheAndInProgressMap.wlock();
     AD_CONTRACT_CHECK(lockPtr->_inProgress.contains(key));
     bool pinned = lockPtr->_inProgress[key].first;
+    if (pinned && lockPtr->_secondTier) {
+      lockPtr->_secondTier->store(key, computationResult);
+    }
     if (pinned) {
       lockPtr->_cache.insertPinned(std::move(key),
                                    std::move(computationResult));
@@ -379,6 +433,7 @@ class ConcurrentCache {
     using std::make_shared;
     bool mustCompute;
     shared_ptr<ResultInProgress> resultInProgress;
+    shared_ptr<CacheSecondTier<Key, Value>> secondTier;
     // first determine whether we have to compute the result,
     // this is done atomically by locking the storage for the whole time
     {
@@ -409,6 +464,7 @@ class ConcurrentCache {
         // we are the first to compute this result, setup a blank
         // result to which we can write.
         mustCompute = true;
+        secondTier = lockPtr->_secondTier;
         resultInProgress = make_shared<ResultInProgress>();
         lockPtr->_inProgress[key] = std::pair(pinned, resultInProgress);
       }
@@ -416,8 +472,14 @@ class ConcurrentCache {
     if (mustCompute) {
       LOG(TRACE) << "Not in the cache, need to compute result" << std::endl;
       try {
-        // The actual computation
-        shared_ptr<Value> result = make_shared<Value>(computeFunction());
+        // Try the second tier of the cache, and only if the result is not
+        // found there, do the actual computation.
+        shared_ptr<Value> result = secondTier ? secondTier->load(key) : nullptr;
+        auto cacheStatus = CacheStatus::cachedInSecondTier;
+        if (!result) {
+          result = make_shared<Value>(computeFunction());
+          cacheStatus = CacheStatus::computed;
+        }
         if (suitableForCache(*result)) {
           moveFromInProgressToCache(key, result);
           // Signal other threads who are waiting for the results.
@@ -427,8 +489,7 @@ class ConcurrentCache {
           _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
           resultInProgress->finish(nullptr);
         }
-        // result was not cached
-        return {std::move(result), CacheStatus::computed};
+        return {std::move(result), cacheStatus};
       } catch (...) {
         // Other threads may try this computation again in the future
         _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
@@ -0,0 +1,69 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include "util/ArenaBackedHashSet.h"
+
+using ad_utility::ArenaBackedHashSet;
+
+// _____________________________________________________________________________
+TEST(ArenaBackedHashSet, insertAndFind) {
+  ArenaBackedHashSet<std::string> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(set.find("hello"), nullptr);
+
+  auto [ptr, isNew] = set.insert(std::string{"hello"});
+  EXPECT_TRUE(isNew);
+  EXPECT_EQ(*ptr, "hello");
+  EXPECT_EQ(set.size(), 1u);
+
+  std::string hello = "hello";
+  auto [ptr2, isNew2] = set.insert(hello);
+  EXPECT_FALSE(isNew2);
+  EXPECT_EQ(ptr, ptr2);
+  EXPECT_EQ(set.size(), 1u);
+
+  EXPECT_EQ(set.find("hello"), ptr);
+  EXPECT_TRUE(set.contains("hello"));
+  EXPECT_FALSE(set.contains("bye"));
+}
+
+// _____________________________________________________________________________
+TEST(ArenaBackedHashSet, addressesAreStable) {
+  ArenaBackedHashSet<std::string> set;
+  std::vector<const std::string*> pointers;
+  // Insert enough elements to fill several chunks.
+  const size_t numElements = 5 * ArenaBackedHashSet<std::string>::minChunkSize +
+                             ArenaBackedHashSet<std::string>::maxChunkSize;
+  for (size_t i = 0; i < numElements; ++i) {
+    pointers.push_back(set.insert(std::to_string(i)).first);
+  }
+  EXPECT_EQ(set.size(), numElements);
+
+  // Moving the set doesn't invalidate the pointers.
+  auto moved = std::move(set);
+  for (size_t i = 0; i < numElements; ++i) {
+    EXPECT_EQ(*pointers[i], std::to_string(i));
+    EXPECT_EQ(moved.find(std::to_string(i)), pointers[i]);
+    EXPECT_EQ(moved.insert(std::to_string(i)).first, pointers[i]);
+  }
+  EXPECT_EQ(moved.size(), numElements);
+}
+
+// _____________________________________________________________________________
+TEST(ArenaBackedHashSet, iterationInInsertionOrder) {
+  ArenaBackedHashSet<std::string> set;
+  EXPECT_EQ(set.begin(), set.end());
+  std::vector<std::string> expected;
+  for (size_t i = 0; i < 1000; ++i) {
+    auto s = std::to_string(i % 700);
+    if (set.insert(s).second) {
+      expected.push_back(s);
+    }
+  }
+  std::vector<std::string> actual{set.begin(), set.end()};
+  EXPECT_EQ(actual, expected);
+}
@@ -0,0 +1,113 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "backports/algorithm.h"
+#include "util/BitPackingCode.h"
+
+using ad_utility::BitPackingCode;
+
+namespace {
+// Encode and decode the `values` and check that the result is the same.
+template <bool isDeltaEncoded>
+void testRoundTrip(const std::vector<uint64_t>& values) {
+  auto encoded =
+      BitPackingCode::encode<isDeltaEncoded>(values.data(), values.size());
+  std::vector<uint64_t> decoded(BitPackingCode::decodedSize(values.size()));
+  BitPackingCode::decode<isDeltaEncoded>(encoded.data(), values.size(),
+                                         decoded.data());
+  decoded.resize(values.size());
+  EXPECT_EQ(decoded, values);
+}
+
+// Return `numValues` random values with at most `maxBits` bits each.
+std::vector<uint64_t> randomValues(size_t numValues, size_t maxBits) {
+  std::mt19937_64 gen{numValues + maxBits};
+  std::vector<uint64_t> values(numValues);
+  for (auto& value : values) {
+    value = maxBits == 64 ? gen() : gen() % (uint64_t{1} << maxBits);
+  }
+  return values;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BitPackingCode, roundTrip) {
+  for (size_t numValues : {0, 1, 3, 255, 256, 257, 1000, 5000}) {
+    for (size_t maxBits : {0, 1, 5, 17, 32, 63, 64}) {
+      auto values = randomValues(numValues, maxBits);
+      testRoundTrip<false>(values);
+      ql::ranges::sort(values);
+      testRoundTrip<false>(values);
+      testRoundTrip<true>(values);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(BitPackingCode, compression) {
+  // Small gaps need only a few bits per value, and a block of zeros only needs
+  // its entry in the skip index.
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0; i < 10 * BitPackingCode::BLOCK_SIZE; ++i) {
+    values.push_back(1'000'000'000 + 3 * i);
+  }
+  auto encoded = BitPackingCode::encode<true>(values.data(), values.size());
+  size_t skipIndexSize = 10 * BitPackingCode::SKIP_ENTRY_WORDS;
+  // The first block contains the large absolute values, all other blocks only
+  // the gaps of at most 12.
+  EXPECT_EQ(encoded.size() - skipIndexSize,
+            (30 + 9 * 4) * BitPackingCode::NUM_LANES);
+  EXPECT_EQ(BitPackingCode::getSkipEntry(encoded.data(), 0).bitWidth_, 30);
+  EXPECT_EQ(BitPackingCode::getSkipEntry(encoded.data(), 1).bitWidth_, 4);
+
+  std::vector<uint64_t> zeros(1000, 0);
+  EXPECT_EQ(BitPackingCode::encode<false>(zeros.data(), zeros.size()).size(),
+            BitPackingCode::numBlocks(1000) * BitPackingCode::SKIP_ENTRY_WORDS);
+  testRoundTrip<false>(zeros);
+  testRoundTrip<true>(zeros);
+
+  // Delta encoding requires sorted values.
+  std::vector<uint64_t> unsorted{3, 2};
+  EXPECT_ANY_THROW(BitPackingCode::encode<true>(unsorted.data(), 2));
+}
+
+// _____________________________________________________________________________
+TEST(BitPackingCode, skipIndex) {
+  auto values = randomValues(3000, 40);
+  ql::ranges::sort(values);
+  ASSERT_EQ(std::adjacent_find(values.begin(), values.end()), values.end());
+  auto encoded = BitPackingCode::encode<true>(values.data(), values.size());
+  size_t numBlocks = BitPackingCode::numBlocks(values.size());
+  ASSERT_EQ(numBlocks, 12);
+
+  std::vector<uint64_t> block(BitPackingCode::BLOCK_SIZE);
+  for (size_t i = 0; i < numBlocks; ++i) {
+    size_t begin = i * BitPackingCode::BLOCK_SIZE;
+    size_t end = std::min(begin + BitPackingCode::BLOCK_SIZE, values.size());
+    EXPECT_EQ(BitPackingCode::getSkipEntry(encoded.data(), i).maxValue_,
+              values[end - 1]);
+    // Each block can be decoded on its own.
+    BitPackingCode::decodeBlock<true>(encoded.data(), i, block.data());
+    EXPECT_TRUE(std::equal(values.begin() + begin, values.begin() + end,
+                           block.begin()));
+    // The first and the last value of a block are found in this block, the
+    // values in between two blocks in the second block.
+    EXPECT_EQ(BitPackingCode::findBlock(encoded.data(), values.size(),
+                                        values[begin]),
+              i);
+    EXPECT_EQ(BitPackingCode::findBlock(encoded.data(), values.size(),
+                                        values[end - 1]),
+              i);
+    EXPECT_EQ(BitPackingCode::findBlock(encoded.data(), values.size(),
+                                        values[begin] - 1),
+              i);
+  }
+  EXPECT_EQ(BitPackingCode::findBlock(encoded.data(), values.size(), 0), 0);
+  EXPECT_EQ(BitPackingCode::findBlock(encoded.data(), values.size(),
+                                      values.back() + 1),
+            numBlocks);
+}
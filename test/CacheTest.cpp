@@ -139,4 +139,91 @@ TEST(LRUCacheTest, testDecreasingCapacity) {
   ASSERT_FALSE(cache["3"]);
   ASSERT_FALSE(cache["4"]);
 }
+
+namespace {
+// A `ValueCostGetter` for the `CostAwareCache`: Strings that start with `e` are
+// expensive to compute, all other strings are cheap.
+struct ExpensiveIfStartsWithE {
+  double operator()(const string& s) const {
+    return s.starts_with('e') ? 1000.0 : 1.0;
+  }
+};
+using CostAwareStringCache =
+    CostAwareCache<string, string, StringSizeGetter<string>,
+                   ExpensiveIfStartsWithE>;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, lruIsDefault) {
+  CostAwareStringCache cache(10, 20_B, 20_B);
+  EXPECT_EQ(cache.getEvictionPolicy(), EvictionPolicy::LRU);
+  cache.insert("expensive", "ex");
+  cache.insert("cheap1", "cccccccccc");
+  cache.insert("cheap2", "cccccccccc");
+  // The least recently used entry was removed.
+  EXPECT_FALSE(cache.contains("expensive"));
+  EXPECT_TRUE(cache.contains("cheap1"));
+  EXPECT_TRUE(cache.contains("cheap2"));
+}
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, gdsf) {
+  CostAwareStringCache cache(10, 20_B, 20_B);
+  cache.setEvictionPolicy(EvictionPolicy::GDSF);
+  EXPECT_EQ(cache.getEvictionPolicy(), EvictionPolicy::GDSF);
+  cache.insert("expensive", "ex");
+  cache.insert("cheap1", "cccccccccc");
+  cache.insert("cheap2", "cccccccccc");
+  // The large entry that is cheap to compute was removed, although the small
+  // and expensive entry is older.
+  EXPECT_TRUE(cache.contains("expensive"));
+  EXPECT_FALSE(cache.contains("cheap1"));
+  EXPECT_TRUE(cache.contains("cheap2"));
+
+  // Entries that are accessed more frequently are kept.
+  cache.clearAll();
+  cache.insert("cheap1", "cccccccc");
+  cache.insert("cheap2", "cccccccc");
+  EXPECT_TRUE(cache["cheap1"]);
+  EXPECT_TRUE(cache["cheap1"]);
+  cache.insert("cheap3", "cccccccc");
+  EXPECT_TRUE(cache.contains("cheap1"));
+  EXPECT_FALSE(cache.contains("cheap2"));
+  EXPECT_TRUE(cache.contains("cheap3"));
+
+  // The scores of the removed entries are added to the scores of the new
+  // entries, s.t. entries that were frequently accessed long ago eventually
+  // are removed.
+  for (size_t i = 4; i < 10; ++i) {
+    cache.insert(absl::StrCat("cheap", i), "cccccccc");
+  }
+  EXPECT_FALSE(cache.contains("cheap1"));
+}
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, changePolicy) {
+  CostAwareStringCache cache(10, 20_B, 20_B);
+  cache.insert("expensive", "ex");
+  cache.insert("cheap1", "cccccccccc");
+  // The scores of the existing entries are recomputed when the policy changes.
+  cache.setEvictionPolicy(EvictionPolicy::GDSF);
+  cache.insert("cheap2", "cccccccccc");
+  EXPECT_TRUE(cache.contains("expensive"));
+  EXPECT_FALSE(cache.contains("cheap1"));
+
+  // When switching back to LRU, the entries are ordered by their previous
+  // scores.
+  cache.setEvictionPolicy(EvictionPolicy::LRU);
+  cache.insert("cheap3", "cccccccccc");
+  EXPECT_TRUE(cache.contains("expensive"));
+  EXPECT_FALSE(cache.contains("cheap2"));
+  EXPECT_TRUE(cache.contains("cheap3"));
+}
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, evictionPolicyFromString) {
+  EXPECT_EQ(evictionPolicyFromString("lru"), EvictionPolicy::LRU);
+  EXPECT_EQ(evictionPolicyFromString("gdsf"), EvictionPolicy::GDSF);
+  EXPECT_ANY_THROW(evictionPolicyFromString("fifo"));
+}
 }  // namespace ad_utility
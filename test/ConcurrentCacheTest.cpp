@@ -14,6 +14,7 @@
 #include "util/ConcurrentCache.h"
 #include "util/DefaultValueSizeGetter.h"
 #include "util/GTestHelpers.h"
+#include "util/HashMap.h"
 #include "util/Parameters.h"
 #include "util/Timer.h"
 #include "util/jthread.h"
@@ -322,6 +323,7 @@ TEST(ConcurrentCache, cacheStatusToString) {
   using enum ad_utility::CacheStatus;
   EXPECT_EQ(toString(cachedNotPinned), "cached_not_pinned");
   EXPECT_EQ(toString(cachedPinned), "cached_pinned");
+  EXPECT_EQ(toString(cachedInSecondTier), "cached_in_second_tier");
   EXPECT_EQ(toString(computed), "computed");
   EXPECT_EQ(toString(notInCacheAndNotComputed), "not_in_cache_not_computed");
 
@@ -566,3 +568,68 @@ TEST(ConcurrentCache, computeButDontStore) {
       42, []() { return "blubb"; }, true, alwaysSuitable);
   EXPECT_EQ(res._resultPointer, nullptr);
 }
+
+namespace {
+// A `CacheSecondTier` that simply stores the values in a map.
+class MapSecondTier : public ad_utility::CacheSecondTier<int, std::string> {
+ public:
+  ad_utility::HashMap<int, std::string> values_;
+  void store(const int& key,
+             std::shared_ptr<const std::string> value) override {
+    values_[key] = *value;
+  }
+  std::shared_ptr<std::string> load(const int& key) override {
+    auto it = values_.find(key);
+    return it == values_.end() ? nullptr
+                               : std::make_shared<std::string>(it->second);
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ConcurrentCache, secondTier) {
+  SimpleConcurrentLruCache cache{2ul};
+  auto secondTier = std::make_shared<MapSecondTier>();
+  cache.setSecondTier(secondTier);
+  auto computeFunction = [](int key) {
+    return [key]() { return std::to_string(key); };
+  };
+  auto compute = [&](int key) {
+    return cache.computeOnce(key, computeFunction(key), false, returnTrue);
+  };
+
+  // Entries that are removed from the cache to make room for other entries are
+  // moved to the second tier.
+  EXPECT_EQ(compute(1)._cacheStatus, ad_utility::CacheStatus::computed);
+  EXPECT_EQ(compute(2)._cacheStatus, ad_utility::CacheStatus::computed);
+  EXPECT_TRUE(secondTier->values_.empty());
+  EXPECT_EQ(compute(3)._cacheStatus, ad_utility::CacheStatus::computed);
+  EXPECT_THAT(secondTier->values_,
+              ::testing::UnorderedElementsAre(::testing::Pair(1, "1")));
+
+  // Pinned entries are stored in the second tier immediately.
+  EXPECT_EQ(
+      cache.computeOncePinned(4, computeFunction(4), false, returnTrue)
+          ._cacheStatus,
+      ad_utility::CacheStatus::computed);
+  EXPECT_EQ(secondTier->values_.at(4), "4");
+
+  // A value that is only contained in the second tier is read from there
+  // instead of being computed, and then added to the cache again.
+  secondTier->values_[5] = "fromSecondTier";
+  auto result = compute(5);
+  EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::cachedInSecondTier);
+  EXPECT_EQ(*result._resultPointer, "fromSecondTier");
+  EXPECT_EQ(compute(5)._cacheStatus,
+            ad_utility::CacheStatus::cachedNotPinned);
+
+  // Erased and cleared entries are not moved to the second tier.
+  secondTier->values_.clear();
+  cache.clearAll();
+  EXPECT_TRUE(secondTier->values_.empty());
+
+  // Without a second tier, everything is computed again.
+  cache.setSecondTier(nullptr);
+  secondTier->values_[6] = "fromSecondTier";
+  EXPECT_EQ(*compute(6)._resultPointer, "6");
+}
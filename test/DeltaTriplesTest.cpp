@@ -439,6 +439,60 @@ TEST_F(DeltaTriplesTest, DeltaTriplesManager) {
                                      3 * numThreads + 2));
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, recentChanges) {
+  DeltaTriples deltaTriples{testQec->getIndex()};
+  auto& vocab = testQec->getIndex().getVocab();
+  LocalVocab localVocab;
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto getId = ad_utility::testing::makeGetId(testQec->getIndex());
+  auto range = [&getId](Permutation::Enum permutation, std::string word) {
+    IndexRanges ranges;
+    ranges.add(permutation, getId(word));
+    return ranges;
+  };
+
+  // The first snapshot is not created by a modification.
+  EXPECT_TRUE(deltaTriples.getSnapshot()->recentChanges_.empty());
+
+  deltaTriples.insertTriples(
+      cancellationHandle, makeIdTriples(vocab, localVocab, {"<a> <upp> <C>"}));
+  auto snapshot = deltaTriples.getSnapshot();
+  ASSERT_EQ(snapshot->recentChanges_.size(), 1);
+  const auto& change = *snapshot->recentChanges_.back();
+  EXPECT_EQ(change.snapshotIndex_, snapshot->index_);
+  ASSERT_TRUE(change.ranges_.has_value());
+  EXPECT_EQ(change.ranges_->size(), 3);
+  EXPECT_TRUE(change.ranges_->intersects(range(Permutation::PSO, "<upp>")));
+  EXPECT_TRUE(change.ranges_->intersects(range(Permutation::POS, "<upp>")));
+  EXPECT_TRUE(change.ranges_->intersects(range(Permutation::SPO, "<a>")));
+  EXPECT_TRUE(change.ranges_->intersects(range(Permutation::OSP, "<C>")));
+  EXPECT_FALSE(change.ranges_->intersects(range(Permutation::PSO, "<low>")));
+  EXPECT_FALSE(change.ranges_->intersects(range(Permutation::SPO, "<C>")));
+
+  // Inserting the same triple again doesn't change anything.
+  deltaTriples.insertTriples(
+      cancellationHandle, makeIdTriples(vocab, localVocab, {"<a> <upp> <C>"}));
+  snapshot = deltaTriples.getSnapshot();
+  ASSERT_EQ(snapshot->recentChanges_.size(), 2);
+  ASSERT_TRUE(snapshot->recentChanges_.back()->ranges_.has_value());
+  EXPECT_EQ(snapshot->recentChanges_.back()->ranges_->size(), 0);
+
+  // After `clear()`, any part of the index might have changed.
+  deltaTriples.clear();
+  snapshot = deltaTriples.getSnapshot();
+  EXPECT_FALSE(snapshot->recentChanges_.back()->ranges_.has_value());
+
+  // The number of recent changes is bounded.
+  for (size_t i = 0; i < 2 * DeltaTriples::MAX_NUM_RECENT_CHANGES; ++i) {
+    snapshot = deltaTriples.getSnapshot();
+  }
+  EXPECT_EQ(snapshot->recentChanges_.size(),
+            DeltaTriples::MAX_NUM_RECENT_CHANGES);
+  EXPECT_EQ(snapshot->recentChanges_.back()->snapshotIndex_, snapshot->index_);
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, restoreFromNonExistingFile) {
   DeltaTriples deltaTriples{testQec->getIndex()};
@@ -0,0 +1,158 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "engine/DiskResultCache.h"
+#include "util/AllocatorTestHelpers.h"
+#include "util/IdTableHelpers.h"
+#include "util/IdTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+using ad_utility::testing::IntId;
+using ad_utility::triple_component::LiteralOrIri;
+using ::testing::ElementsAre;
+
+namespace {
+// A directory for the tests that is deleted at the end of the test.
+struct TestDirectory {
+  std::string name_;
+  explicit TestDirectory(std::string name)
+      : name_{(std::filesystem::temp_directory_path() / name).string()} {
+    std::filesystem::remove_all(name_);
+  }
+  ~TestDirectory() { std::filesystem::remove_all(name_); }
+};
+
+auto makeCache(const std::string& directory,
+               ad_utility::MemorySize maxSize = 1_MB,
+               std::string buildId = "index", size_t snapshotIndex = 0) {
+  return std::make_shared<DiskResultCache>(
+      directory, maxSize, std::move(buildId), snapshotIndex,
+      ad_utility::testing::makeAllocator());
+}
+
+// A cache value with two columns, the second of which contains words from the
+// local vocab of the result.
+std::shared_ptr<const CacheValue> makeValue(size_t numRows = 3) {
+  LocalVocab localVocab;
+  auto word = [&localVocab](std::string_view s) {
+    return Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+        LiteralOrIri::fromStringRepresentation(absl::StrCat("\"", s, "\""))));
+  };
+  IdTable table{2, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < numRows; ++i) {
+    table.push_back({IntId(static_cast<int64_t>(i)),
+                     word(i % 2 == 0 ? "even" : "odd")});
+  }
+  RuntimeInformation runtimeInfo;
+  runtimeInfo.descriptor_ = "test";
+  runtimeInfo.columnNames_ = {"?x", "?y"};
+  runtimeInfo.totalTime_ = std::chrono::milliseconds{42};
+  runtimeInfo.details_["foo"] = "bar";
+  return std::make_shared<const CacheValue>(
+      Result{std::move(table), {0}, std::move(localVocab)},
+      std::move(runtimeInfo));
+}
+
+// Return the string representations of the words in column 1 of the `value`.
+std::vector<std::string> wordsOfSecondColumn(const CacheValue& value) {
+  std::vector<std::string> words;
+  for (Id id : value.resultTable().idTable().getColumn(1)) {
+    words.push_back(id.getLocalVocabIndex()->toStringRepresentation());
+  }
+  return words;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, storeAndLoad) {
+  TestDirectory dir{"diskResultCacheTest.storeAndLoad"};
+  QueryCacheKey key{"someKey", 0};
+  {
+    auto cache = makeCache(dir.name_);
+    EXPECT_EQ(cache->load(key), nullptr);
+    cache->store(key, makeValue());
+    cache->waitForPendingWrites();
+    EXPECT_EQ(cache->numEntries(), 1);
+    auto loaded = cache->load(key);
+    ASSERT_NE(loaded, nullptr);
+    const auto& result = loaded->resultTable();
+    EXPECT_THAT(result.idTable().getColumn(0),
+                ElementsAre(IntId(0), IntId(1), IntId(2)));
+    EXPECT_THAT(wordsOfSecondColumn(*loaded),
+                ElementsAre("\"even\"", "\"odd\"", "\"even\""));
+    EXPECT_EQ(result.localVocab().size(), 2);
+    EXPECT_THAT(result.sortedBy(), ElementsAre(0));
+    const auto& runtimeInfo = loaded->runtimeInfo();
+    EXPECT_EQ(runtimeInfo.descriptor_, "test");
+    EXPECT_THAT(runtimeInfo.columnNames_, ElementsAre("?x", "?y"));
+    EXPECT_EQ(runtimeInfo.totalTime_, std::chrono::milliseconds{42});
+    EXPECT_EQ(runtimeInfo.details_["foo"], "bar");
+    EXPECT_EQ(runtimeInfo.numRows_, 3);
+
+    // Keys for other snapshots and other keys are not contained.
+    EXPECT_EQ(cache->load(QueryCacheKey{"someKey", 1}), nullptr);
+    EXPECT_EQ(cache->load(QueryCacheKey{"otherKey", 0}), nullptr);
+    cache->store(QueryCacheKey{"otherKey", 1}, makeValue());
+    cache->waitForPendingWrites();
+    EXPECT_EQ(cache->numEntries(), 1);
+  }
+
+  // The results survive a restart, but only for the same index.
+  EXPECT_NE(makeCache(dir.name_)->load(key), nullptr);
+  EXPECT_EQ(makeCache(dir.name_, 1_MB, "otherIndex")->load(key), nullptr);
+
+  auto cache = makeCache(dir.name_);
+  cache->clear();
+  EXPECT_EQ(cache->numEntries(), 0);
+  EXPECT_EQ(cache->load(key), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, sizeIsBounded) {
+  TestDirectory dir{"diskResultCacheTest.sizeIsBounded"};
+  // Each value has 2 columns with 1000 rows, so roughly 16 kB.
+  auto cache = makeCache(dir.name_, 40_kB);
+  auto key = [](size_t i) { return QueryCacheKey{absl::StrCat("key", i), 0}; };
+  for (size_t i = 0; i < 3; ++i) {
+    cache->store(key(i), makeValue(1000));
+    cache->waitForPendingWrites();
+  }
+  EXPECT_EQ(cache->numEntries(), 2);
+  EXPECT_LE(cache->totalSize(), 40_kB);
+  // The least recently used file was deleted.
+  EXPECT_EQ(cache->load(key(0)), nullptr);
+  EXPECT_NE(cache->load(key(1)), nullptr);
+  EXPECT_NE(cache->load(key(2)), nullptr);
+
+  // Values that are larger than the cache are not stored.
+  cache->store(key(3), makeValue(10'000));
+  cache->waitForPendingWrites();
+  EXPECT_EQ(cache->load(key(3)), nullptr);
+
+  // A smaller limit after a restart deletes the least recently used files.
+  cache.reset();
+  cache = makeCache(dir.name_, 20_kB);
+  EXPECT_EQ(cache->numEntries(), 1);
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, localBlankNodesAreNotStored) {
+  TestDirectory dir{"diskResultCacheTest.localBlankNodesAreNotStored"};
+  auto cache = makeCache(dir.name_);
+  LocalVocab localVocab;
+  ad_utility::BlankNodeManager blankNodeManager;
+  auto blankNode = localVocab.getBlankNodeIndex(&blankNodeManager);
+  auto table = makeIdTableFromVector({{Id::makeFromBlankNodeIndex(blankNode)}});
+  auto value = std::make_shared<const CacheValue>(
+      Result{std::move(table), {}, std::move(localVocab)},
+      RuntimeInformation{});
+  QueryCacheKey key{"blankNodes", 0};
+  cache->store(key, value);
+  cache->waitForPendingWrites();
+  EXPECT_EQ(cache->numEntries(), 0);
+  EXPECT_EQ(cache->load(key), nullptr);
+}
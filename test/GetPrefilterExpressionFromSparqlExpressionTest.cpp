@@ -5,6 +5,7 @@
 #include "./PrefilterExpressionTestHelpers.h"
 #include "./SparqlExpressionTestHelpers.h"
 #include "util/GTestHelpers.h"
+#include "util/GeoSparqlHelpers.h"
 
 using ad_utility::testing::BlankNodeId;
 using ad_utility::testing::BoolId;
@@ -603,6 +604,64 @@ TEST(GetPrefilterExpressionFromSparqlExpression, tryGetPrefilterExprForDate) {
                     "an integer value as reference year.");
 }
 
+//______________________________________________________________________________
+// Test PrefilterExpression creation for the expression:
+// `geof:distance(?var, POINT) op NUMBER`.
+TEST(GetPrefilterExpressionFromSparqlExpression,
+     tryGetPrefilterExprForGeoDistance) {
+  using prefilterExpressions::detail::makePrefilterExpressionGeoDistanceImpl;
+  const auto var = Variable{"?x"};
+  const GeoPoint point{48.0, 7.8};
+  const Id pointId = Id::makeFromGeoPoint(point);
+  auto dist = [](auto child1, auto child2) {
+    return makeDistExpression(makeOptLiteralSparqlExpr(child1),
+                              makeOptLiteralSparqlExpr(child2));
+  };
+  auto expected = [&](double maxDistInKilometers) {
+    return pr(makePrefilterExpressionGeoDistanceImpl(point,
+                                                     maxDistInKilometers),
+              var);
+  };
+
+  // Test SparqlExpression for which we expect a PrefilterExpression.
+  evalAndEqualityCheck(ltSprql(dist(var, pointId), IntId(5)), expected(5));
+  evalAndEqualityCheck(leSprql(dist(pointId, var), DoubleId(0.5)),
+                       expected(0.5));
+  evalAndEqualityCheck(gtSprql(IntId(5), dist(var, pointId)), expected(5));
+  evalAndEqualityCheck(geSprql(DoubleId(2.5), dist(pointId, var)),
+                       expected(2.5));
+  evalAndEqualityCheck(
+      ltSprql(makeMetricDistExpression(makeOptLiteralSparqlExpr(var),
+                                       makeOptLiteralSparqlExpr(pointId)),
+              IntId(500)),
+      expected(0.5));
+  auto miles = makeOptLiteralSparqlExpr(I("<http://qudt.org/vocab/unit/MI>"));
+  evalAndEqualityCheck(
+      ltSprql(makeDistWithUnitExpression(makeOptLiteralSparqlExpr(var),
+                                         makeOptLiteralSparqlExpr(pointId),
+                                         std::move(miles)),
+              IntId(10)),
+      expected(ad_utility::detail::valueInUnitToKilometer(
+          10, UnitOfMeasurement::MILES)));
+  // The prefilter is combined with other prefilters as usual.
+  evalAndEqualityCheck(
+      andSprqlExpr(ltSprql(dist(var, pointId), IntId(5)),
+                   ltSprql(Variable{"?y"}, IntId(10))),
+      expected(5), pr(lt(IntId(10)), Variable{"?y"}));
+
+  // For the following expressions no pre-filter should be available.
+  // The prefilter only selects a superset of the relevant blocks, so the
+  // negation can't be prefiltered.
+  evalAndEqualityCheck(notSprqlExpr(ltSprql(dist(var, pointId), IntId(5))));
+  evalAndEqualityCheck(gtSprql(dist(var, pointId), IntId(5)));
+  evalAndEqualityCheck(eqSprql(dist(var, pointId), IntId(5)));
+  evalAndEqualityCheck(ltSprql(IntId(5), dist(var, pointId)));
+  evalAndEqualityCheck(ltSprql(dist(var, Variable{"?y"}), IntId(5)));
+  evalAndEqualityCheck(ltSprql(dist(var, IntId(3)), IntId(5)));
+  evalAndEqualityCheck(ltSprql(dist(var, pointId), IntId(-5)));
+  evalAndEqualityCheck(ltSprql(dist(var, pointId), L("\"5\"")));
+}
+
 // Test that the conditions required for a correct merge of child
 // PrefilterExpressions are properly checked during the PrefilterExpression
 // construction procedure. This check is applied in the SparqlExpression (for
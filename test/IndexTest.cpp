@@ -297,6 +297,59 @@ TEST(IndexTest, indexIdAndGitHash) {
   ASSERT_EQ(index.getGitShortHash(), "git short hash not set");
 }
 
+// _____________________________________________________________________________
+TEST(IndexTest, buildId) {
+  // Two builds of the same input have the same `indexId`, but a different
+  // `buildId`.
+  std::string kb = "<a> <b> <c> .";
+  auto getIds = [&kb](bool createTextIndex) {
+    TestIndexConfig config{kb};
+    config.createTextIndex = createTextIndex;
+    auto index = makeTestIndex("IndexTest.buildId", std::move(config));
+    return std::pair{index.getIndexId(), index.getBuildId()};
+  };
+  auto [indexId1, buildId1] = getIds(false);
+  auto [indexId2, buildId2] = getIds(false);
+  EXPECT_EQ(indexId1, indexId2);
+  EXPECT_NE(buildId1, buildId2);
+  EXPECT_FALSE(buildId1.empty());
+
+  // The `buildId` also identifies the text index.
+  auto [indexId3, buildId3] = getIds(true);
+  EXPECT_THAT(buildId3, ::testing::HasSubstr(".text."));
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, sortKeyPrefixes) {
+  std::string kb =
+      "<a> <b> \"alpha\" . <a> <b> \"Alpha\" . <a> <b> \"beta\" . "
+      "<a> <b> \"gamma\"@en .";
+  std::vector<std::string> words{"\"alpha\"", "\"Alpha\"", "\"beta\"",
+                                 "\"gamma\"@en", "\"delta\"", "<b>"};
+  // Return for each of the `words` whether it is contained in the vocabulary
+  // and its index (or the index at which it would be inserted).
+  auto lookUpWords = [&kb, &words](bool buildSortKeyPrefixes) {
+    TestIndexConfig config{kb};
+    config.buildSortKeyPrefixes = buildSortKeyPrefixes;
+    const auto& vocab = getQec(std::move(config))->getIndex().getVocab();
+    // The prefixes are only stored if requested.
+    EXPECT_EQ(vocab.hasSortKeyPrefixes(), buildSortKeyPrefixes);
+    std::vector<std::pair<bool, VocabIndex>> result;
+    for (const auto& word : words) {
+      VocabIndex index;
+      bool contained = vocab.getId(word, &index);
+      result.emplace_back(contained,
+                          contained ? index : vocab.lower_bound(word));
+    }
+    return result;
+  };
+  // The lookups give the same results with and without the prefixes.
+  auto withoutPrefixes = lookUpWords(false);
+  EXPECT_EQ(lookUpWords(true), withoutPrefixes);
+  EXPECT_TRUE(withoutPrefixes.at(0).first);
+  EXPECT_FALSE(withoutPrefixes.at(4).first);
+}
+
 TEST(IndexTest, scanTest) {
   auto testWithAndWithoutPrefixCompression = [](bool useCompression) {
     using enum Permutation::Enum;
@@ -613,8 +666,9 @@ TEST(IndexTest, updateInputFileSpecificationsAndLog) {
   }
 
   // Parallel parsing not specified on the command line, but explicitly set in
-  // the `settings.json` file. This is deprecated for a single input
-  // stream and forbidden for multiple input streams.
+  // the `settings.json` file. This is deprecated, and only applies to the
+  // input streams for which parallel parsing is not specified on the command
+  // line.
   {
     singleFileSpec.at(0).parseInParallelSetExplicitly_ = false;
     testing::internal::CaptureStdout();
@@ -624,11 +678,18 @@ TEST(IndexTest, updateInputFileSpecificationsAndLog) {
     EXPECT_TRUE(singleFileSpec.at(0).parseInParallel_);
   }
   {
+    twoFilesSpec.at(0).parseInParallel_ = false;
+    twoFilesSpec.at(1).parseInParallel_ = false;
     twoFilesSpec.at(0).parseInParallelSetExplicitly_ = false;
-    twoFilesSpec.at(1).parseInParallelSetExplicitly_ = false;
-    AD_EXPECT_THROW_WITH_MESSAGE(
-        IndexImpl::updateInputFileSpecificationsAndLog(twoFilesSpec, true),
-        AllOf(Not(HasSubstr("from 2 input streams")), HasSubstr("forbidden")));
+    twoFilesSpec.at(1).parseInParallelSetExplicitly_ = true;
+    testing::internal::CaptureStdout();
+    IndexImpl::updateInputFileSpecificationsAndLog(twoFilesSpec, true);
+    EXPECT_THAT(testing::internal::GetCapturedStdout(),
+                AllOf(HasSubstr("from 2 input streams (2 at the same time, 1 "
+                                "of them in parallel with 8 threads each)"),
+                      HasSubstr("deprecated")));
+    EXPECT_TRUE(twoFilesSpec.at(0).parseInParallel_);
+    EXPECT_FALSE(twoFilesSpec.at(1).parseInParallel_);
   }
 }
 
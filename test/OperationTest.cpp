@@ -9,6 +9,7 @@
 
 #include "engine/IndexScan.h"
 #include "engine/NeutralElementOperation.h"
+#include "engine/Sort.h"
 #include "engine/ValuesForTesting.h"
 #include "global/RuntimeParameters.h"
 #include "util/GTestHelpers.h"
@@ -16,6 +17,7 @@
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
 #include "util/RuntimeParametersTestHelpers.h"
+#include "util/TripleComponentTestHelpers.h"
 
 using namespace ad_utility::testing;
 using namespace ::testing;
@@ -224,16 +226,14 @@ TEST_F(OperationTestFixture, verifyCachePreventsInProgressState) {
 
 // _____________________________________________________________________________
 
-TEST_F(OperationTestFixture, getPrecomputedResultBecauseSiblingOfService) {
+TEST_F(OperationTestFixture, getPrecomputedResult) {
   // If a precomputedResult is set, it will be returned by `getResult`
   auto idTable = makeIdTableFromVector({{1, 6, 0}, {2, 5, 0}, {3, 4, 0}});
   auto result = std::make_shared<const Result>(
       idTable.clone(), std::vector<ColumnIndex>{0}, LocalVocab{});
-  operation.precomputedResultBecauseSiblingOfService() =
-      std::make_optional(result);
+  operation.precomputedResult() = std::make_optional(result);
   EXPECT_EQ(operation.getResult(), result);
-  EXPECT_FALSE(
-      operation.precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(operation.precomputedResult().has_value());
 }
 
 // _____________________________________________________________________________
@@ -801,3 +801,153 @@ TEST(OperationTest, disableCaching) {
   valuesForTesting.getResult(false);
   EXPECT_FALSE(qec->getQueryTreeCache().cacheContains(cacheKey));
 }
+
+// _____________________________________________________________________________
+TEST(OperationTest, resultIsDerivedFromMoreGeneralCachedResult) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto cleanup =
+      setRuntimeParameterForTest<"cache-derive-from-general-results">(true);
+  auto isDerived = [](const Operation& operation) {
+    return operation.runtimeInfo().details_.contains(
+        "derived-from-cached-result");
+  };
+
+  // A cached result without a limit serves requests with a limit, and a cached
+  // result with a limit serves requests with a smaller limit.
+  auto table = makeIdTableFromVector({{1}, {2}, {3}, {4}, {5}, {6}, {7}});
+  auto makeValues = [&](LimitOffsetClause limitOffset) {
+    auto values = std::make_unique<ValuesForTesting>(
+        qec, table.clone(), std::vector{std::optional{Variable{"?x"}}});
+    values->applyLimitOffset(limitOffset);
+    return values;
+  };
+  makeValues({})->getResult();
+  auto limited = makeValues({4, 2});
+  EXPECT_EQ(limited->getResult()->idTable(),
+            makeIdTableFromVector({{3}, {4}, {5}, {6}}));
+  EXPECT_TRUE(isDerived(*limited));
+
+  qec->getQueryTreeCache().clearAll();
+  makeValues({4, 2})->getResult();
+  auto smallerLimit = makeValues({2, 3});
+  EXPECT_EQ(smallerLimit->getResult()->idTable(),
+            makeIdTableFromVector({{4}, {5}}));
+  EXPECT_TRUE(isDerived(*smallerLimit));
+  // The rows of a larger limit are not contained in the cached result.
+  auto largerLimit = makeValues({5, 2});
+  EXPECT_EQ(largerLimit->getResult()->idTable().numRows(), 5);
+  EXPECT_FALSE(isDerived(*largerLimit));
+
+  // A cached scan with fewer bound constants serves the more specific scan.
+  using V = Variable;
+  using ad_utility::testing::iri;
+  SparqlTripleSimple specificTriple{V{"?s"}, iri("<is-a>"), iri("<x>")};
+  qec->getQueryTreeCache().clearAll();
+  auto expected =
+      IndexScan{qec, Permutation::POS, specificTriple}.getResult()->idTable()
+          .clone();
+  EXPECT_EQ(expected.numRows(), 1);
+  qec->getQueryTreeCache().clearAll();
+  IndexScan{qec, Permutation::POS,
+            SparqlTripleSimple{V{"?s"}, iri("<is-a>"), V{"?o"}}}
+      .getResult();
+  IndexScan specific{qec, Permutation::POS, specificTriple};
+  EXPECT_EQ(specific.getResult()->idTable(), expected);
+  EXPECT_TRUE(isDerived(specific));
+
+  // Scans with an internal constant like `@en@<label>` read the internal
+  // permutation, so they can't be derived from the more general scan.
+  qec->getQueryTreeCache().clearAll();
+  IndexScan{qec, Permutation::PSO,
+            SparqlTripleSimple{V{"?s"}, V{"?p"}, V{"?o"}}}
+      .getResult();
+  IndexScan languageScan{qec, Permutation::PSO,
+                         SparqlTripleSimple{V{"?s"}, iri("@en@<label>"),
+                                            V{"?o"}}};
+  EXPECT_EQ(languageScan.getResult()->idTable().numRows(), 1);
+  EXPECT_FALSE(isDerived(languageScan));
+
+  // The children of a derived result are not computed, its runtime
+  // information contains the children of the cached result instead.
+  qec->getQueryTreeCache().clearAll();
+  auto makeSort = [&](LimitOffsetClause limitOffset) {
+    auto sort = std::make_unique<Sort>(
+        qec,
+        ad_utility::makeExecutionTree<ValuesForTesting>(
+            qec, table.clone(), std::vector{std::optional{Variable{"?x"}}}),
+        std::vector<ColumnIndex>{0});
+    sort->applyLimitOffset(limitOffset);
+    return sort;
+  };
+  makeSort({})->getResult();
+  auto limitedSort = makeSort({2});
+  EXPECT_EQ(limitedSort->getResult()->idTable(),
+            makeIdTableFromVector({{1}, {2}}));
+  EXPECT_TRUE(isDerived(*limitedSort));
+  const auto& children = limitedSort->runtimeInfo().children_;
+  ASSERT_EQ(children.size(), 1);
+  EXPECT_EQ(children.at(0)->status_,
+            RuntimeInformation::Status::fullyMaterialized);
+  EXPECT_EQ(children.at(0)->numRows_, 7);
+}
+
+// _____________________________________________________________________________
+TEST(OperationTest, cachedResultsSurviveUnrelatedUpdates) {
+  Index index = ad_utility::testing::makeTestIndex(
+      "OperationTest_cachedResultsSurviveUnrelatedUpdates",
+      "<s1> <p1> <o1> . <s2> <p2> <o2> . <s3> <p1> <o3> .");
+  QueryResultCache cache;
+  QueryExecutionContext qec{index, &cache, makeAllocator(),
+                            SortPerformanceEstimator{}};
+  auto getId = makeGetId(index);
+  auto insert = [&](std::string s, std::string p, std::string o) {
+    index.deltaTriplesManager().modify<void>([&](DeltaTriples& deltaTriples) {
+      deltaTriples.insertTriples(
+          std::make_shared<ad_utility::CancellationHandle<>>(),
+          {IdTriple<0>{std::array{getId(s), getId(p), getId(o),
+                                  getId(std::string{DEFAULT_GRAPH_IRI})}}});
+    });
+    qec.updateLocatedTriplesSnapshot();
+  };
+  // The scans for `?s <p1> ?o` and `?s <p2> ?o`, and their join.
+  auto scan = [&](std::string predicate) {
+    return ad_utility::makeExecutionTree<IndexScan>(
+        &qec, Permutation::PSO,
+        SparqlTripleSimple{Variable{"?s"}, iri(predicate), Variable{"?o"}});
+  };
+  auto getResult = [](QueryExecutionTree& tree) {
+    auto result = tree.getResult();
+    return std::pair{result->idTable().numRows(),
+                     tree.getRootOperation()->runtimeInfo().cacheStatus_};
+  };
+  auto p1 = scan("<p1>");
+  auto p2 = scan("<p2>");
+  EXPECT_EQ(getResult(*p1), std::pair(2ul, CacheStatus::computed));
+  EXPECT_EQ(getResult(*p2), std::pair(1ul, CacheStatus::computed));
+
+  // An update that only affects `<p2>`. The result for `<p1>` is still valid.
+  insert("<s1>", "<p2>", "<o3>");
+  EXPECT_EQ(getResult(*scan("<p1>")),
+            std::pair(2ul, CacheStatus::cachedNotPinned));
+  EXPECT_EQ(getResult(*scan("<p2>")), std::pair(2ul, CacheStatus::computed));
+
+  // Two more updates, the first of which affects `<p1>`.
+  insert("<s2>", "<p1>", "<o2>");
+  insert("<s3>", "<p2>", "<o1>");
+  EXPECT_EQ(getResult(*scan("<p1>")), std::pair(3ul, CacheStatus::computed));
+  EXPECT_EQ(getResult(*scan("<p2>")), std::pair(3ul, CacheStatus::computed));
+  insert("<s3>", "<p2>", "<o2>");
+  EXPECT_EQ(getResult(*scan("<p1>")),
+            std::pair(3ul, CacheStatus::cachedNotPinned));
+
+  // Full index scans depend on the complete index.
+  auto fullScan = [&]() {
+    return ad_utility::makeExecutionTree<IndexScan>(
+        &qec, Permutation::SPO,
+        SparqlTripleSimple{Variable{"?s"}, Variable{"?p"}, Variable{"?o"}});
+  };
+  EXPECT_EQ(getResult(*fullScan()).second, CacheStatus::computed);
+  insert("<s1>", "<p1>", "<o2>");
+  EXPECT_EQ(getResult(*fullScan()).second, CacheStatus::computed);
+}
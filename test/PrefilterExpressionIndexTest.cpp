@@ -48,6 +48,12 @@ const auto makeIdForLYearDate = [](int year, DateT type = DateT::Date) {
   return Id::makeFromDate(DateYearOrDuration(year, type));
 };
 
+//______________________________________________________________________________
+// Helper to create GeoPoint-ValueIds.
+const auto makeIdForGeoPoint = [](double lat, double lng) {
+  return Id::makeFromGeoPoint(GeoPoint{lat, lng});
+};
+
 //______________________________________________________________________________
 using IdxPair = std::pair<size_t, size_t>;
 using IdxPairRanges = std::vector<IdxPair>;
@@ -250,6 +256,18 @@ class PrefilterExpressionOnMetadataTest : public ::testing::Test {
   const CompressedBlockMetadata b12Date =
       makeBlock(makeIdForLYearDate(14579), makeIdForLYearDate(38263));
 
+  // GeoPoint related blocks, the points are sorted by their latitude first.
+  const CompressedBlockMetadata b1Geo =
+      makeBlock(makeIdForGeoPoint(10, 0), makeIdForGeoPoint(40, 50));
+  const CompressedBlockMetadata b2Geo =
+      makeBlock(makeIdForGeoPoint(47, 5), makeIdForGeoPoint(47.9, 179));
+  const CompressedBlockMetadata b3Geo =
+      makeBlock(makeIdForGeoPoint(47.9, -170), makeIdForGeoPoint(48.1, -160));
+  const CompressedBlockMetadata b4Geo =
+      makeBlock(makeIdForGeoPoint(48.1, 10), makeIdForGeoPoint(49, 10));
+  const CompressedBlockMetadata b5Geo =
+      makeBlock(makeIdForGeoPoint(60, 0), makeIdForGeoPoint(80, 0));
+
   // VocabId and LocalVocabId blocks.
   // "B" to "Be"
   const CompressedBlockMetadata bRegexTest = makeBlock(idB, vocabIdBe);
@@ -320,6 +338,10 @@ class PrefilterExpressionOnMetadataTest : public ::testing::Test {
       b1Date, b2Date, b3Date, b4Date,  b5Date,  b6Date,
       b7Date, b8Date, b9Date, b10Date, b11Date, b12Date};
 
+  // Selection of GeoPoint related blocks.
+  const std::vector<CompressedBlockMetadata> geoBlocks = {b1Geo, b2Geo, b3Geo,
+                                                          b4Geo, b5Geo};
+
   const std::vector<CompressedBlockMetadata> blocksIncomplete = {
       bFirstIncomplete,
       b2,
@@ -1153,6 +1175,31 @@ TEST_F(PrefilterExpressionOnMetadataTest, testRelationalPrefilteringDates) {
                {b1Date, b2Date, b8Date, b9Date, b10Date, b11Date, b12Date});
 }
 
+//______________________________________________________________________________
+// Test the PrefilterExpression for `geof:distance(?x, point) < maxDist`. Only
+// the latitudes of the blocks can be used for the prefiltering.
+TEST_F(PrefilterExpressionOnMetadataTest, testGeoDistancePrefiltering) {
+  using detail::makePrefilterExpressionGeoDistanceImpl;
+  auto makeTestGeo = [this](GeoPoint point, double maxDistInKilometers,
+                            std::vector<CompressedBlockMetadata> expected) {
+    auto expr =
+        makePrefilterExpressionGeoDistanceImpl(point, maxDistInKilometers);
+    EXPECT_EQ(expr->evaluate(indexVocab, geoBlocks, 2), expected);
+  };
+  // One degree of latitude is about 111 km.
+  makeTestGeo(GeoPoint{48, 7.8}, 1, {b3Geo});
+  makeTestGeo(GeoPoint{48, 7.8}, 20, {b2Geo, b3Geo, b4Geo});
+  makeTestGeo(GeoPoint{48, 7.8}, 1000, {b1Geo, b2Geo, b3Geo, b4Geo});
+  makeTestGeo(GeoPoint{55, 0}, 700, {b4Geo, b5Geo});
+  makeTestGeo(GeoPoint{89.9, 0}, 100, {});
+  makeTestGeo(GeoPoint{-89.9, 0}, 30000, geoBlocks);
+  // Non-GeoPoint blocks are never relevant.
+  auto expr = makePrefilterExpressionGeoDistanceImpl(GeoPoint{0, 0}, 30000);
+  EXPECT_EQ(expr->evaluate(indexVocab, dateBlocks, 2),
+            std::vector<CompressedBlockMetadata>{});
+  EXPECT_ANY_THROW(makePrefilterExpressionGeoDistanceImpl(GeoPoint{0, 0}, -1));
+}
+
 //______________________________________________________________________________
 // Test that correct errors are thrown for invalid input (condition)
 TEST_F(PrefilterExpressionOnMetadataTest, testInputConditionCheck) {
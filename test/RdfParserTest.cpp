@@ -1261,6 +1261,34 @@ TEST(RdfParserTest, multifileParser) {
   forAllMultifileParsers(impl);
 }
 
+// _____________________________________________________________________________
+TEST(RdfParserTest, multifileParserNumThreadsPerParser) {
+  EXPECT_GE(RdfMultifileParser::getThreadBudget(),
+            NUM_PARALLEL_PARSER_THREADS);
+
+  // Up to `threadBudget` files are parsed at the same time.
+  auto concurrent = &RdfMultifileParser::getNumConcurrentFiles;
+  EXPECT_EQ(concurrent(0, 16), 1);
+  EXPECT_EQ(concurrent(5, 16), 5);
+  EXPECT_EQ(concurrent(40, 16), 16);
+
+  auto get = &RdfMultifileParser::getNumThreadsPerParser;
+  // A single parallel file gets `NUM_PARALLEL_PARSER_THREADS`, also when the
+  // budget is larger.
+  EXPECT_EQ(get(1, 1, 64), NUM_PARALLEL_PARSER_THREADS);
+  EXPECT_EQ(get(0, 0, 64), NUM_PARALLEL_PARSER_THREADS);
+  // The budget is shared only among the parallel parsers that run at the same
+  // time, the files that are not parsed in parallel don't count.
+  EXPECT_EQ(get(8, 8, 64), 8);
+  EXPECT_EQ(get(16, 16, 64), 4);
+  EXPECT_EQ(get(16, 2, 64), NUM_PARALLEL_PARSER_THREADS);
+  EXPECT_EQ(get(16, 8, 16), 2);
+  // With more parallel files than the budget, only `threadBudget` of them
+  // run at the same time, each with at least one thread.
+  EXPECT_EQ(get(100, 100, 64), 1);
+  EXPECT_EQ(get(100, 100, 200), 2);
+}
+
 // _____________________________________________________________________________
 
 TEST(RdfParserTest, specialPredicateA) {
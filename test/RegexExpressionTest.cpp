@@ -9,7 +9,9 @@
 
 #include "./SparqlExpressionTestHelpers.h"
 #include "./util/GTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
+#include "engine/sparqlExpressions/DistinctIdFilterExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RegexExpression.h"
@@ -389,6 +391,236 @@ TEST(RegexExpression, prefixRegexOrderedColumn) {
   test("?mixed", "^x", {{{2, 3}}}, true);
 }
 
+// _____________________________________________________________________________
+TEST(RegexExpression, evaluatePerDistinctId) {
+  TestContext ctx;
+  ctx.varToColMap.clear();
+  ctx.varToColMap[Variable{"?string"}] = makeAlwaysDefinedColumn(0);
+  ctx.table.clear();
+  ctx.table.setNumColumns(1);
+  // The column contains each of the `Id`s several times in an unsorted order.
+  std::vector<Id> column{ctx.alpha,       ctx.Beta,  ctx.alpha, ctx.notInVocabA,
+                         ctx.notInVocabA, IntId(42), ctx.Beta,  ctx.alpha};
+  for (Id id : column) {
+    ctx.table.push_back({id});
+  }
+  ctx.context._endIndex = column.size();
+
+  // The column is too small to contain many duplicates, so we have to allow
+  // arbitrary distinct ratios to test the evaluation per distinct `Id`.
+  auto cleanupEnabled =
+      setRuntimeParameterForTest<"evaluate-filters-per-distinct-id">(true);
+  auto cleanupRatio =
+      setRuntimeParameterForTest<"distinct-id-filter-max-distinct-ratio">(1.0);
+  auto expr = makeRegexExpression("?string", "[lo].*A?$");
+  EXPECT_TRUE(dynamic_cast<DistinctIdFilterExpression*>(expr.get()));
+  std::vector<Id> expected{T, F, T, T, T, U, F, T};
+
+  auto evaluate = [&ctx, &expr]() {
+    auto result = expr->evaluate(&ctx.context);
+    EXPECT_TRUE(std::holds_alternative<VectorWithMemoryLimit<Id>>(result));
+    return std::move(std::get<VectorWithMemoryLimit<Id>>(result));
+  };
+  EXPECT_THAT(evaluate(), ::testing::ElementsAreArray(expected));
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<"evaluate-filters-per-distinct-id">(false);
+    EXPECT_THAT(evaluate(), ::testing::ElementsAreArray(expected));
+  }
+  {
+    // Too many distinct `Id`s, the expression is evaluated row by row.
+    auto cleanup =
+        setRuntimeParameterForTest<"distinct-id-filter-max-distinct-ratio">(
+            0.1);
+    EXPECT_THAT(evaluate(), ::testing::ElementsAreArray(expected));
+  }
+
+  // Only evaluate a subrange of the input.
+  ctx.context._beginIndex = 2;
+  ctx.context._endIndex = 6;
+  EXPECT_THAT(evaluate(),
+              ::testing::ElementsAreArray(expected.begin() + 2,
+                                          expected.begin() + 6));
+
+  // If the input is sorted by the variable, and all results are boolean, then
+  // the result is a `SetOfIntervals`.
+  ctx.table.erase(ctx.table.begin() + 5);
+  std::sort(ctx.table.begin(), ctx.table.end(),
+            [](const auto& a, const auto& b) {
+              return a[0].getBits() < b[0].getBits();
+            });
+  ctx.context._beginIndex = 0;
+  ctx.context._endIndex = ctx.table.size();
+  ctx.context._columnsByWhichResultIsSorted.push_back(0);
+  auto sortedResult = expr->evaluate(&ctx.context);
+  ASSERT_TRUE(std::holds_alternative<ad_utility::SetOfIntervals>(sortedResult));
+  ad_utility::SetOfIntervals expectedIntervals;
+  for (size_t i = 0; i < ctx.table.size(); ++i) {
+    if (ctx.table(i, 0) == ctx.Beta) {
+      continue;
+    }
+    if (!expectedIntervals._intervals.empty() &&
+        expectedIntervals._intervals.back().second == i) {
+      ++expectedIntervals._intervals.back().second;
+    } else {
+      expectedIntervals._intervals.emplace_back(i, i + 1);
+    }
+  }
+  EXPECT_EQ(std::get<ad_utility::SetOfIntervals>(sortedResult),
+            expectedIntervals);
+
+  // Expressions with more than one variable are evaluated row by row.
+  ctx.varToColMap[Variable{"?regex"}] = makeAlwaysDefinedColumn(0);
+  auto twoVariables =
+      makeTestRegexExpression(variable("?string"), variable("?regex"));
+  EXPECT_TRUE(std::holds_alternative<VectorWithMemoryLimit<Id>>(
+      twoVariables->evaluate(&ctx.context)));
+}
+
+// _____________________________________________________________________________
+TEST(RegexExpression, hasFewDistinctIds) {
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto hasFewDistinctIds = [&handle](const std::vector<Id>& column,
+                                     bool isSorted, double maxDistinctRatio) {
+    return sparqlExpression::detail::hasFewDistinctIds(
+        column, isSorted, maxDistinctRatio, handle);
+  };
+  std::vector<Id> empty;
+  EXPECT_TRUE(hasFewDistinctIds(empty, false, 0.0));
+
+  // 4 distinct `Id`s in 8 rows.
+  std::vector<Id> column{IntId(1), IntId(2), IntId(1), IntId(3),
+                         IntId(4), IntId(2), IntId(3), IntId(4)};
+  EXPECT_TRUE(hasFewDistinctIds(column, false, 0.5));
+  EXPECT_FALSE(hasFewDistinctIds(column, false, 0.4));
+  ql::ranges::sort(column, {}, &Id::getBits);
+  EXPECT_TRUE(hasFewDistinctIds(column, true, 0.5));
+  EXPECT_FALSE(hasFewDistinctIds(column, true, 0.4));
+
+  // Only every second row of a large column is part of the sample.
+  std::vector<Id> large;
+  for (int64_t i = 0; i < 20'000; ++i) {
+    large.push_back(IntId(i % 2 == 0 ? 0 : i));
+  }
+  EXPECT_TRUE(hasFewDistinctIds(large, false, 0.01));
+  EXPECT_FALSE(hasFewDistinctIds(large, true, 0.01));
+
+  // The sample is spread over the whole column, not only its first rows:
+  // 10'000 rows with the same `Id` are followed by 5'000 distinct `Id`s.
+  std::vector<Id> skewed;
+  for (int64_t i = 0; i < 15'000; ++i) {
+    skewed.push_back(IntId(i < 10'000 ? 0 : i));
+  }
+  EXPECT_FALSE(hasFewDistinctIds(skewed, false, 0.01));
+  EXPECT_TRUE(hasFewDistinctIds(skewed, false, 0.4));
+  EXPECT_FALSE(hasFewDistinctIds(skewed, true, 0.3));
+  EXPECT_TRUE(hasFewDistinctIds(skewed, true, 0.4));
+
+  // The exact count for sorted columns can be cancelled.
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_THROW(hasFewDistinctIds(large, true, 0.01),
+               ad_utility::CancellationException);
+}
+
+// _____________________________________________________________________________
+TEST(RegexExpression, distinctIdFilterIsTransparent) {
+  using namespace sparqlExpression;
+  auto var = []() {
+    return std::make_unique<VariableExpression>(Variable{"?x"});
+  };
+  // The wrapped expression is the only child.
+  auto str = makeStrExpression(var());
+  const SparqlExpression* strPtr = str.get();
+  DistinctIdFilterExpression wrappedStr{std::move(str)};
+  ASSERT_EQ(wrappedStr.children().size(), 1);
+  EXPECT_EQ(wrappedStr.children()[0].get(), strPtr);
+  EXPECT_TRUE(wrappedStr.isStrExpression());
+  EXPECT_FALSE(wrappedStr.containsAggregate());
+  auto variables = wrappedStr.containedVariables();
+  ASSERT_EQ(variables.size(), 1);
+  EXPECT_EQ(*variables[0], Variable{"?x"});
+
+  // The properties of the wrapped expression are forwarded.
+  DistinctIdFilterExpression wrappedLang{makeLangExpression(var())};
+  EXPECT_TRUE(wrappedLang.containsLangExpression());
+  EXPECT_FALSE(wrappedLang.isStrExpression());
+  DistinctIdFilterExpression wrappedVariable{var()};
+  EXPECT_EQ(wrappedVariable.getVariableOrNullopt(), Variable{"?x"});
+}
+
+// _____________________________________________________________________________
+TEST(RegexExpression, trigramIndex) {
+  ad_utility::testing::TestIndexConfig config{TestContext::turtleInput};
+  config.buildTrigramIndex = true;
+  auto* qec = ad_utility::testing::getQec(std::move(config));
+  ASSERT_NE(qec->getIndex().getTrigramIndex(), nullptr);
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  LocalVocab localVocab;
+  Id localAlpha =
+      Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+          ad_utility::triple_component::LiteralOrIri::literalWithoutQuotes(
+              "xalphax")));
+  std::vector<Id> column{getId("\"alpha\""), getId("\"Alpha\""),
+                         getId("\"Beta\""),  getId("<x>"),
+                         getId("\"zz\"@en"), localAlpha,
+                         IntId(42)};
+  IdTable table{1, qec->getAllocator()};
+  for (Id id : column) {
+    table.push_back({id});
+  }
+  VariableToColumnMap varToColMap;
+  varToColMap[Variable{"?x"}] = makeAlwaysDefinedColumn(0);
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  EvaluationContext context{*qec,
+                            varToColMap,
+                            table,
+                            qec->getAllocator(),
+                            localVocab,
+                            handle,
+                            EvaluationContext::TimePoint::max()};
+  context._endIndex = table.size();
+  auto cleanup =
+      setRuntimeParameterForTest<"evaluate-filters-per-distinct-id">(true);
+
+  auto evaluate = [&context](const SparqlExpression::Ptr& expr) {
+    auto result = expr->evaluate(&context);
+    EXPECT_TRUE(std::holds_alternative<VectorWithMemoryLimit<Id>>(result));
+    const auto& ids = std::get<VectorWithMemoryLimit<Id>>(result);
+    return std::vector<Id>(ids.begin(), ids.end());
+  };
+  // Check the results for the literals (the other entries are not affected by
+  // the trigram index), and that the result is the same when the trigram
+  // index is not used.
+  auto check = [&evaluate](const SparqlExpression::Ptr& expr,
+                           std::array<Id, 5> expected,
+                           ad_utility::source_location l =
+                               ad_utility::source_location::current()) {
+    auto trace = generateLocationTrace(l);
+    auto result = evaluate(expr);
+    ASSERT_EQ(result.size(), 7u);
+    EXPECT_THAT((std::array{result[0], result[1], result[2], result[4],
+                            result[5]}),
+                ::testing::ElementsAreArray(expected));
+    auto cleanup = setRuntimeParameterForTest<"use-trigram-index">(false);
+    EXPECT_EQ(evaluate(expr), result);
+  };
+  check(makeRegexExpression("?x", "lph"), {T, T, F, F, T});
+  check(makeRegexExpression("?x", "^alp"), {T, F, F, F, F});
+  check(makeRegexExpression("?x", "al+pha$"), {T, F, F, F, F});
+  check(makeRegexExpression("?x", "(?:lp)ha"), {T, T, F, F, T});
+  check(makeRegexExpression("?x", "Bet?a"), {F, F, T, F, F});
+  check(makeRegexExpression("?x", "lph", std::nullopt, true), {T, T, F, F, T});
+  check(makeRegexExpression("?x", "LPH", "i"), {T, T, F, F, T});
+  check(makeRegexExpression("?x", "alpha|Beta"), {T, F, T, F, T});
+  check(makeContainsExpression(variable("?x"), literal("\"lph\"")),
+        {T, T, F, F, T});
+  check(makeContainsExpression(makeStrExpression(variable("?x")),
+                               literal("\"eta\"")),
+        {F, F, T, F, F});
+  check(makeStrStartsExpression(variable("?x"), literal("\"Alp\"")),
+        {F, T, F, F, F});
+}
+
 // _____________________________________________________________________________
 TEST(RegexExpression, getCacheKey) {
   using namespace ::testing;
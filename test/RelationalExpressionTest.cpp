@@ -13,6 +13,7 @@
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressions.h"
+#include "engine/sparqlExpressions/VectorizedNumericKernels.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "index/Index.h"
@@ -780,6 +781,74 @@ TEST(RelationalExpression, VariableAndVariable) {
   testWithExplicitIdResult<LT>(vocab, mixed, {U, U, B(true)});
 }
 
+namespace {
+// Check that the vectorized kernel for the comparison of two columns yields
+// the same result as `compareIds` for all pairs of `values`.
+template <Comparison Comp>
+void testVectorizedComparison(const std::vector<Id>& values,
+                              source_location l = source_location::current()) {
+  auto trace =
+      generateLocationTrace(l, "testVectorizedComparison was called here");
+  TestContext ctx;
+  VectorWithMemoryLimit<Id> left{ctx.context._allocator};
+  VectorWithMemoryLimit<Id> right{ctx.context._allocator};
+  std::vector<Id> expected;
+  for (Id a : values) {
+    for (Id b : values) {
+      left.push_back(a);
+      right.push_back(b);
+      expected.push_back(valueIdComparators::toValueId(
+          valueIdComparators::compareIds(a, b, Comp)));
+    }
+  }
+  ctx.context._endIndex = left.size();
+  auto result = makeExpression<Comp>(left.clone(), right.clone())
+                    .evaluate(&ctx.context);
+  ASSERT_TRUE(std::holds_alternative<VectorWithMemoryLimit<Id>>(result));
+  EXPECT_THAT(std::get<VectorWithMemoryLimit<Id>>(result),
+              ::testing::ElementsAreArray(expected));
+
+  // A column and a constant.
+  for (size_t i = 0; i < values.size(); ++i) {
+    auto withConstant = sparqlExpression::detail::vectorized::compare<Comp>(
+        left, values[i], &ctx.context);
+    for (size_t j = 0; j < left.size(); ++j) {
+      EXPECT_EQ(withConstant[j],
+                valueIdComparators::toValueId(
+                    valueIdComparators::compareIds(left[j], values[i], Comp)));
+    }
+  }
+}
+}  // namespace
+
+TEST(RelationalExpression, vectorizedComparison) {
+  TestContext ctx;
+  std::vector<Id> values{IntId(0),
+                         IntId(-1),
+                         IntId(3),
+                         IntId(Id::maxInt),
+                         IntId(-Id::maxInt - 1),
+                         DoubleId(3.0),
+                         DoubleId(-0.0),
+                         DoubleId(-2.5),
+                         DoubleId(NaN),
+                         DoubleId(inf),
+                         DoubleId(-inf),
+                         ad_utility::testing::BoolId(true),
+                         ad_utility::testing::BoolId(false),
+                         Id::makeUndefined(),
+                         ctx.alpha,
+                         ctx.Beta,
+                         ctx.x,
+                         ctx.notInVocabA};
+  testVectorizedComparison<LT>(values);
+  testVectorizedComparison<LE>(values);
+  testVectorizedComparison<EQ>(values);
+  testVectorizedComparison<NE>(values);
+  testVectorizedComparison<GE>(values);
+  testVectorizedComparison<GT>(values);
+}
+
 // `rightValue` must be a constant. Sort the `IdTable` of the `TestContext`
 // `ctx` by the variable `leftValue` and then check that the expression
 // `leftValue Comparator rightValue`, when evaluated on this sortest `IdTable`
@@ -805,44 +805,40 @@ TEST_F(ServiceTest, precomputeSiblingResult) {
   // Reset the computed results, to reuse the mock-operations.
   auto reset = [&]() {
     service->siblingInfo_.reset();
-    service2->precomputedResultBecauseSiblingOfService().reset();
-    siblingOperation->precomputedResultBecauseSiblingOfService().reset();
+    service2->precomputedResult().reset();
+    siblingOperation->precomputedResult().reset();
     testQec->clearCacheUnpinnedOnly();
   };
 
   // Right requested but it is not a Service -> no computation
   Service::precomputeSiblingResult(service, sibling, true, false);
-  EXPECT_FALSE(
-      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(siblingOperation->precomputedResult().has_value());
   EXPECT_FALSE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   reset();
 
   // Two Service operations -> no computation
   Service::precomputeSiblingResult(service, service2, false, false);
-  EXPECT_FALSE(
-      service2->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service2->precomputedResult().has_value());
   EXPECT_FALSE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   reset();
 
   // Right requested and two Service operations -> compute
   Service::precomputeSiblingResult(service, service2, true, false);
-  EXPECT_TRUE(service2->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_TRUE(service2->precomputedResult().has_value());
   EXPECT_TRUE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   reset();
 
   // Right requested and it is a service -> sibling result is computed and
   // shared with service
   Service::precomputeSiblingResult(sibling, service, true, false);
-  ASSERT_TRUE(
-      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
-  EXPECT_TRUE(siblingOperation->precomputedResultBecauseSiblingOfService()
-                  .value()
-                  ->isFullyMaterialized());
+  ASSERT_TRUE(siblingOperation->precomputedResult().has_value());
+  EXPECT_TRUE(
+      siblingOperation->precomputedResult().value()->isFullyMaterialized());
   EXPECT_TRUE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   reset();
 
   // Compute (large) sibling -> sibling result is computed
@@ -850,46 +846,38 @@ TEST_F(ServiceTest, precomputeSiblingResult) {
       RuntimeParameters().get<"service-max-value-rows">();
   RuntimeParameters().set<"service-max-value-rows">(0);
   Service::precomputeSiblingResult(sibling, service, true, false);
-  ASSERT_TRUE(
-      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
-  EXPECT_TRUE(siblingOperation->precomputedResultBecauseSiblingOfService()
-                  .value()
-                  ->isFullyMaterialized());
+  ASSERT_TRUE(siblingOperation->precomputedResult().has_value());
+  EXPECT_TRUE(
+      siblingOperation->precomputedResult().value()->isFullyMaterialized());
   EXPECT_FALSE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   RuntimeParameters().set<"service-max-value-rows">(maxValueRowsDefault);
   reset();
 
   // Lazy compute (small) sibling -> sibling result is fully materialized and
   // shared with service
   Service::precomputeSiblingResult(service, sibling, false, true);
-  ASSERT_TRUE(
-      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
-  EXPECT_TRUE(siblingOperation->precomputedResultBecauseSiblingOfService()
-                  .value()
-                  ->isFullyMaterialized());
+  ASSERT_TRUE(siblingOperation->precomputedResult().has_value());
+  EXPECT_TRUE(
+      siblingOperation->precomputedResult().value()->isFullyMaterialized());
   EXPECT_TRUE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   reset();
 
   // Lazy compute (large) sibling -> partially materialized result is passed
   // back to sibling
   RuntimeParameters().set<"service-max-value-rows">(0);
   Service::precomputeSiblingResult(service, sibling, false, true);
-  ASSERT_TRUE(
-      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
-  EXPECT_FALSE(siblingOperation->precomputedResultBecauseSiblingOfService()
-                   .value()
-                   ->isFullyMaterialized());
+  ASSERT_TRUE(siblingOperation->precomputedResult().has_value());
+  EXPECT_FALSE(
+      siblingOperation->precomputedResult().value()->isFullyMaterialized());
   EXPECT_FALSE(service->siblingInfo_.has_value());
-  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_FALSE(service->precomputedResult().has_value());
   RuntimeParameters().set<"service-max-value-rows">(maxValueRowsDefault);
 
   // consume the sibling result-generator
   for ([[maybe_unused]] auto& _ :
-       siblingOperation->precomputedResultBecauseSiblingOfService()
-           .value()
-           ->idTables()) {
+       siblingOperation->precomputedResult().value()->idTables()) {
   }
 }
 
@@ -453,6 +453,12 @@ TEST(SparqlExpression, arithmeticOperators) {
   testMultiply(by2, mixed, D(0.5));
   testDivide(times13, mixed, D(1.0 / 1.3));
 
+  // Integer results that don't fit into the 60 bits of an `Id` wrap around.
+  V<Id> extremeInts{{I(Id::maxInt), I(-Id::maxInt - 1)}, alloc};
+  V<Id> extremeIntsPlus1{{I(-Id::maxInt - 1), I(-Id::maxInt)}, alloc};
+  testPlus(extremeIntsPlus1, extremeInts, I(1));
+  testMinus(extremeInts, extremeIntsPlus1, I(1));
+
   // Division by zero is either `UNDEF` or `NaN/infinity`, depending on a
   // runtime parameter.
   V<Id> undef{{U, U, U, U}, alloc};
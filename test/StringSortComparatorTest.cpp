@@ -278,3 +278,61 @@ TEST(LocaleManager, PrefixSortKey) {
   ASSERT_FALSE(comp("vivæ", "vivae", LocaleManager::Level::PRIMARY));
   ASSERT_FALSE(comp("vivæ", "vivae", LocaleManager::Level::PRIMARY));
 }
+
+// _____________________________________________________________________________
+TEST(StringSortComparatorTest, SortKeyPrefix) {
+  using L = TripleComponentComparator::Level;
+  std::vector<std::string> words{
+      "\"\"",
+      "\"alpha\"",
+      "\"ALPHA\"",
+      "\"älpha\"",
+      "\"alphabet\"",
+      "\"alphabetical order\"@en",
+      "\"alphabetical order\"@de",
+      "\"alphabetical-order\"",
+      "\"a.l.p.h.a\"",
+      "\"  spaces\"",
+      "\"151\"",
+      "\"१५१\"",
+      "\"vivæ\"",
+      "\"vivae\"",
+      "\"Hannibal Hamlin\"@en",
+      "\"Hannibal\"@en",
+      "<http://example.org/a>",
+      "<http://example.org/b>",
+      "<http://example.org/abcdefghijklmnop>",
+      "<http://example.org/abcdefghijklmnopq>",
+      "@en@<label>",
+      "\"incomplete"};
+  for (bool ignorePunctuation : {false, true}) {
+    TripleComponentComparator comparator("en", "US", ignorePunctuation);
+    for (const auto& a : words) {
+      auto prefixA = comparator.getSortKeyPrefix(a);
+      // The prefix is the same when computed from a `SplitVal`.
+      EXPECT_EQ(prefixA,
+                TripleComponentComparator::getSortKeyPrefix(
+                    comparator.extractAndTransformComparable(a, L::TOTAL)));
+      for (const auto& b : words) {
+        auto prefixB = comparator.getSortKeyPrefix(b);
+        if (prefixA == prefixB) {
+          continue;
+        }
+        // Different prefixes decide the comparison on every level.
+        for (auto level : {L::PRIMARY, L::SECONDARY, L::TERTIARY,
+                           L::QUARTERNARY, L::IDENTICAL, L::TOTAL}) {
+          EXPECT_EQ(comparator(a, b, level), prefixA < prefixB)
+              << a << ' ' << b << ' ' << static_cast<int>(level);
+        }
+      }
+    }
+    // Words that only differ after the prefix have the same prefix.
+    EXPECT_EQ(
+        comparator.getSortKeyPrefix("<http://example.org/abcdefghijklmnop>"),
+        comparator.getSortKeyPrefix("<http://example.org/abcdefghijklmnopq>"));
+    // The highest byte is the first character.
+    EXPECT_EQ(comparator.getSortKeyPrefix("<a>") >> 56, uint64_t{'<'});
+    EXPECT_NE(comparator.getSortKeyPrefix("\"alpha\""),
+              comparator.getSortKeyPrefix("\"beta\""));
+  }
+}
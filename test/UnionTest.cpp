@@ -17,6 +17,7 @@
 #include "global/Id.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 namespace {
 auto V = ad_utility::testing::VocabId;
@@ -711,3 +712,57 @@ TEST(Union, columnOriginatesFromGraphOrUndef) {
   EXPECT_THROW(union4.columnOriginatesFromGraphOrUndef(Var{"?notExisting"}),
                ad_utility::Exception);
 }
+
+// _____________________________________________________________________________
+TEST(Union, childrenAreComputedInParallel) {
+  auto* qec = ad_utility::testing::getQec();
+  auto makeUnion = [qec]() {
+    auto leftT = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{V(1)}, {V(2)}}), Vars{Variable{"?x"}});
+    auto rightT = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{V(3)}}), Vars{Variable{"?x"}});
+    return Union{qec, std::move(leftT), std::move(rightT)};
+  };
+  auto expected = makeIdTableFromVector({{V(1)}, {V(2)}, {V(3)}});
+
+  // By default, the children are computed one after the other.
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto u = makeUnion();
+    EXPECT_EQ(u.getResult()->idTable(), expected);
+    EXPECT_FALSE(u.runtimeInfo().details_.contains(
+        "num-children-computed-in-parallel"));
+  }
+
+  auto cleanup = setRuntimeParameterForTest<"parallel-subtrees-max-threads">(1);
+  qec->getQueryTreeCache().clearAll();
+  auto u = makeUnion();
+  EXPECT_EQ(u.getResult()->idTable(), expected);
+  const auto& details = u.runtimeInfo().details_;
+  EXPECT_EQ(details["num-children-computed-in-parallel"], 2);
+  EXPECT_TRUE(details.contains("time-for-parallel-children"));
+  EXPECT_TRUE(details.contains("sum-of-times-of-parallel-children"));
+  // The precomputed results of the children have been consumed.
+  for (const auto* child : u.getChildren()) {
+    EXPECT_FALSE(
+        child->getRootOperation()->precomputedResult().has_value());
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Union, failingChildCancelsSiblingsComputedInParallel) {
+  auto* qec = ad_utility::testing::getQec();
+  auto cleanup = setRuntimeParameterForTest<"parallel-subtrees-max-threads">(1);
+  // The left child runs on the calling thread until it is cancelled, the
+  // right child fails immediately on the thread pool.
+  Union u{qec, ad_utility::makeExecutionTree<StallForeverOperation>(qec),
+          ad_utility::makeExecutionTree<AlwaysFailOperation>(
+              qec, Variable{"?x"})};
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  u.recursivelySetCancellationHandle(handle);
+  // The exception of the failing child is rethrown, not the one of the
+  // cancelled sibling.
+  AD_EXPECT_THROW_WITH_MESSAGE(u.getResult(),
+                               ::testing::HasSubstr("AlwaysFailOperation"));
+  EXPECT_TRUE(handle->isCancelled());
+}
@@ -3,15 +3,18 @@
 // Authors: Johannes Kalmbach <kalmbacj@cs.uni-freiburg.de>
 //          Christoph Ullinger <ullingec@cs.uni-freiburg.de>
 
+#include <absl/strings/str_cat.h>
 #include <gmock/gmock.h>
 
 #include <cstdlib>
 #include <ctime>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string>
 
 #include "./util/IdTestHelpers.h"
+#include "backports/algorithm.h"
 #include "global/Constants.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/Index.h"
@@ -21,6 +24,7 @@
 #include "index/vocabulary/SplitVocabulary.h"
 #include "index/vocabulary/VocabularyInternalExternal.h"
 #include "util/Algorithm.h"
+#include "util/File.h"
 
 using namespace ad_utility::vocabulary_merger;
 namespace {
@@ -134,6 +138,9 @@ class MergeVocabularyTest : public ::testing::Test {
             auto globalId = w.index_;
             w.index_ = localIdx;
             partialVocab << w;
+            // The `SortKeyPrefix`, which is the same for all words here, so
+            // the words are only ordered by the comparator.
+            partialVocab << uint64_t{0};
             if (mapping) {
               if (w.isBlankNode()) {
                 mapping->emplace_back(
@@ -255,3 +262,69 @@ TEST(VocabularyGeneratorTest, createInternalMapping) {
   ASSERT_EQ(3u, res[38]);
   ASSERT_EQ(4u, res[0]);
 }
+
+// _____________________________________________________________________________
+TEST(VocabularyGeneratorTest, mergeVocabularyInParallelRanges) {
+  std::string basename = "vocabularyGeneratorTest.parallelRanges";
+  size_t numFiles = 3;
+  // The partial vocabularies contain overlapping ranges of words, some of which
+  // are externalized in one partial vocabulary but not in another.
+  std::vector<std::vector<std::string>> words(numFiles);
+  for (size_t i = 0; i < numFiles; ++i) {
+    for (size_t j = 500 * i; j < 500 * i + 2000; j += i + 1) {
+      words[i].push_back(absl::StrCat("<word", 10'000 + j, ">"));
+    }
+    ItemVec items;
+    for (size_t j = 0; j < words[i].size(); ++j) {
+      TripleComponentComparator::SplitValNonOwningWithSortKey splitVal;
+      splitVal.isExternalized_ = (i + j) % 7 == 0;
+      items.emplace_back(words[i][j], LocalVocabIndexAndSplitVal{j, splitVal});
+    }
+    writePartialVocabularyToFile(
+        items, absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, i), 10);
+  }
+
+  // Merge the partial vocabularies and return the merged words and the
+  // mappings from the local to the global IDs.
+  using Result = std::pair<std::vector<std::pair<std::string, bool>>,
+                           std::vector<std::vector<std::pair<Id, Id>>>>;
+  auto merge = [&](size_t numRanges) {
+    Result result;
+    auto callback = [&result](const auto& word, bool isExternal) -> uint64_t {
+      result.first.emplace_back(word, isExternal);
+      return result.first.size() - 1;
+    };
+    mergeVocabulary(basename, numFiles, std::less<std::string_view>{},
+                    callback, 1_GB, numRanges);
+    for (size_t i = 0; i < numFiles; ++i) {
+      auto filename = absl::StrCat(basename, PARTIAL_MMAP_IDS, i);
+      IdPairMMapVecView mapping{filename};
+      result.second.emplace_back(mapping.begin(), mapping.end());
+      ad_utility::deleteFile(filename);
+    }
+    return result;
+  };
+
+  auto expected = merge(1);
+  ASSERT_EQ(expected.first.size(), 2500);
+  EXPECT_TRUE(ql::ranges::is_sorted(expected.first));
+  for (size_t numRanges : {2, 4, 17}) {
+    EXPECT_EQ(merge(numRanges), expected);
+    for (size_t i = 0; i < numRanges; ++i) {
+      EXPECT_FALSE(std::filesystem::exists(
+          absl::StrCat(basename, MERGED_VOCAB_RANGE_FILE_NAME, i)));
+    }
+  }
+
+  // Without the samples, there is only a single range.
+  ad_utility::deleteFile(absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, 1,
+                                      PARTIAL_VOCAB_SAMPLES_SUFFIX));
+  EXPECT_EQ(merge(4), expected);
+
+  for (size_t i = 0; i < numFiles; ++i) {
+    ad_utility::deleteFile(absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, i));
+    ad_utility::deleteFile(absl::StrCat(basename, PARTIAL_VOCAB_FILE_NAME, i,
+                                        PARTIAL_VOCAB_SAMPLES_SUFFIX),
+                           false);
+  }
+}
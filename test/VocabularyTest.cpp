@@ -125,3 +125,52 @@ TEST(Vocabulary, PrefixFilter) {
   ASSERT_EQ(ranges, expectedRanges);
   ad_utility::deleteFile(filename);
 }
+
+// _____________________________________________________________________________
+TEST(Vocabulary, SortKeyPrefixes) {
+  using L = RdfsVocabulary::SortLevel;
+  ad_utility::HashSet<string> words{
+      "\"alpha\"",         "\"ALPHA\"",         "\"älpha\"",
+      "\"alphabet\"",      "\"alphabets\"",     "\"alphabetical\"@en",
+      "\"beta\"",          "\"Beta\"@en",       "\"gamma-ray\"",
+      "\"gamma ray\"",     "\"151\"",           "\"१५१\"",
+      "<http://a.org/x>",  "<http://a.org/y>",  "<http://b.org/x>",
+      "<http://a.org/xx>", "@en@<label>",       "\"\""};
+  auto filename = "vocTest6.dat";
+  auto prefixFilename = "vocTest6.sortKeyPrefixes.dat";
+  RdfsVocabulary expected;
+  expected.setLocale("en", "US", true);
+  expected.createFromSet(words, filename);
+  RdfsVocabulary vocabulary;
+  vocabulary.setLocale("en", "US", true);
+  vocabulary.readFromFile(filename);
+  {
+    SortKeyPrefixes::Builder builder{prefixFilename};
+    for (size_t i = 0; i < vocabulary.size(); ++i) {
+      builder.addWord(i, vocabulary.getCaseComparator().getSortKeyPrefix(
+                             vocabulary[VocabIndex::make(i)]));
+    }
+    ASSERT_TRUE(std::move(builder).finish());
+  }
+  vocabulary.readSortKeyPrefixes(prefixFilename);
+
+  // The bounds are the same with and without the prefixes.
+  std::vector<string> queries{words.begin(), words.end()};
+  queries.insert(queries.end(),
+                 {"\"a\"", "\"alphabetically\"", "\"zzz\"", "\"gamma",
+                  "<http://a.org/", "<", "\"", "", "<zzz>", "\"ALPHABET\""});
+  for (const auto& query : queries) {
+    for (auto level :
+         {L::PRIMARY, L::SECONDARY, L::TERTIARY, L::QUARTERNARY, L::TOTAL}) {
+      EXPECT_EQ(vocabulary.lower_bound(query, level),
+                expected.lower_bound(query, level))
+          << query;
+      EXPECT_EQ(vocabulary.upper_bound(query, level),
+                expected.upper_bound(query, level))
+          << query;
+    }
+  }
+  EXPECT_EQ(vocabulary.lower_bound("@zzz"), VocabIndex::make(words.size()));
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(prefixFilename);
+}
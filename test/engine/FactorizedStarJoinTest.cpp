@@ -0,0 +1,237 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../engine/ValuesForTesting.h"
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/Distinct.h"
+#include "engine/FactorizedStarJoin.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ad_utility::testing::VocabId;
+
+namespace {
+using Vars = std::vector<std::optional<Variable>>;
+
+// Create a child with the given `table` (which must be sorted) and
+// `variables`.
+std::shared_ptr<QueryExecutionTree> makeChild(QueryExecutionContext* qec,
+                                              const VectorTable& table,
+                                              Vars variables) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(table), std::move(variables), false,
+      std::vector<ColumnIndex>{0, 1});
+}
+
+// The star `?s ?a . ?s ?b . ?s ?c`. Only the values 1 and 3 of `?s` are
+// contained in all three children.
+std::shared_ptr<FactorizedStarJoin> makeStarJoin(QueryExecutionContext* qec) {
+  FactorizedStarJoin::Children children{
+      makeChild(qec, {{1, 10}, {1, 11}, {2, 12}, {3, 13}},
+                Vars{Variable{"?s"}, Variable{"?a"}}),
+      makeChild(qec, {{1, 20}, {1, 21}, {3, 22}, {4, 23}},
+                Vars{Variable{"?s"}, Variable{"?b"}}),
+      makeChild(qec, {{1, 30}, {3, 31}, {3, 32}},
+                Vars{Variable{"?s"}, Variable{"?c"}})};
+  return std::make_shared<FactorizedStarJoin>(qec, std::move(children),
+                                              Variable{"?s"});
+}
+
+// Parse, plan, and evaluate the `query`. Return the rows of the selected
+// columns in sorted order and whether the plan contains a
+// `FactorizedStarJoin`.
+std::pair<std::vector<std::vector<Id>>, bool> evaluate(
+    QueryExecutionContext* qec, std::string query) {
+  auto parsedQuery = SparqlParser::parseQuery(std::move(query));
+  QueryPlanner planner{qec,
+                       std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = planner.createExecutionTree(parsedQuery);
+  auto containsStarJoin = [](const auto& self, QueryExecutionTree& tree) {
+    auto operation = tree.getRootOperation();
+    if (std::dynamic_pointer_cast<FactorizedStarJoin>(operation)) {
+      return true;
+    }
+    return ql::ranges::any_of(operation->getChildren(),
+                              [&self](QueryExecutionTree* child) {
+                                return self(self, *child);
+                              });
+  };
+  auto result = qet.getResult();
+  const auto& variables = parsedQuery.selectClause().getSelectedVariables();
+  std::vector<std::vector<Id>> rows;
+  for (size_t row = 0; row < result->idTable().numRows(); ++row) {
+    auto& values = rows.emplace_back();
+    for (const auto& variable : variables) {
+      values.push_back(result->idTable()(row, qet.getVariableColumn(variable)));
+    }
+  }
+  ql::ranges::sort(rows);
+  return {std::move(rows), containsStarJoin(containsStarJoin, qet)};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(FactorizedStarJoin, expandedResult) {
+  auto qec = ad_utility::testing::getQec();
+  auto joinPointer = makeStarJoin(qec);
+  auto& join = *joinPointer;
+  EXPECT_EQ(join.getDescriptor(), "Factorized star join on ?s");
+  EXPECT_EQ(join.getResultWidth(), 4);
+  EXPECT_THAT(join.getResultSortedOn(), ElementsAre(0, 1));
+  EXPECT_EQ(
+      join.getExternallyVisibleVariableColumns().at(Variable{"?c"}),
+      (ColumnIndexAndTypeInfo{3, ColumnIndexAndTypeInfo::AlwaysDefined}));
+  auto expected = makeIdTableFromVector({{1, 10, 20, 30},
+                                         {1, 10, 21, 30},
+                                         {1, 11, 20, 30},
+                                         {1, 11, 21, 30},
+                                         {3, 13, 22, 31},
+                                         {3, 13, 22, 32}});
+  EXPECT_EQ(join.computeResultOnlyForTesting().idTable(), expected);
+
+  // The lazy result contains the same rows.
+  IdTable lazyRows{4, qec->getAllocator()};
+  for (const auto& [idTable, localVocab] :
+       join.computeResultOnlyForTesting(true).idTables()) {
+    lazyRows.insertAtEnd(idTable);
+  }
+  EXPECT_EQ(lazyRows, expected);
+
+  // A clone has the same cache key.
+  EXPECT_EQ(join.clone()->getCacheKey(), join.getCacheKey());
+}
+
+// _____________________________________________________________________________
+TEST(FactorizedStarJoin, factorizedResult) {
+  auto qec = ad_utility::testing::getQec();
+  auto joinPointer = makeStarJoin(qec);
+  auto& join = *joinPointer;
+  auto factorized = join.computeFactorizedResult();
+  ASSERT_EQ(factorized.numGroups(), 2);
+  EXPECT_EQ(factorized.key(0), VocabId(1));
+  EXPECT_EQ(factorized.key(1), VocabId(3));
+  EXPECT_EQ(factorized.numRows(0), 4);
+  EXPECT_EQ(factorized.numRows(1), 2);
+  EXPECT_EQ(factorized.numRows(), 6);
+  EXPECT_EQ(factorized.range(0, 1), (std::pair<size_t, size_t>{0, 2}));
+  EXPECT_EQ(factorized.numDefinedValues(0, 2, 1), 4);
+  EXPECT_THAT(factorized.distinctValues(0, 0, 1),
+              ElementsAre(VocabId(10), VocabId(11)));
+  EXPECT_EQ(join.runtimeInfo().status_,
+            RuntimeInformation::Status::optimizedOut);
+  EXPECT_EQ(join.runtimeInfo().details_["num-groups"], 2);
+
+  // UNDEF values are not counted.
+  FactorizedStarJoin withUndef{
+      qec,
+      {makeChild(qec, {{1, 10}, {1, 11}}, Vars{Variable{"?s"}, Variable{"?a"}}),
+       ad_utility::makeExecutionTree<ValuesForTesting>(
+           qec, makeIdTableFromVector({{1, Id::makeUndefined()}, {1, 20}}),
+           Vars{Variable{"?s"}, Variable{"?b"}})},
+      Variable{"?s"}};
+  auto factorizedWithUndef = withUndef.computeFactorizedResult();
+  EXPECT_EQ(factorizedWithUndef.numRows(0), 4);
+  EXPECT_EQ(factorizedWithUndef.numDefinedValues(0, 1, 1), 2);
+  EXPECT_THAT(factorizedWithUndef.distinctValues(0, 1, 1),
+              ElementsAre(VocabId(20)));
+}
+
+// _____________________________________________________________________________
+TEST(FactorizedStarJoin, distinct) {
+  auto qec = ad_utility::testing::getQec();
+  auto join = makeStarJoin(qec);
+  auto tree = std::make_shared<QueryExecutionTree>(qec, join);
+  // Distinct on `?s ?b`, the other columns are taken from the first row.
+  Distinct distinct{qec, tree, {0, 2}};
+  // No sort is needed.
+  EXPECT_EQ(distinct.getChildren().at(0)->getRootOperation(), join);
+  EXPECT_EQ(distinct.computeResultOnlyForTesting().idTable(),
+            makeIdTableFromVector(
+                {{1, 10, 20, 30}, {1, 10, 21, 30}, {3, 13, 22, 31}}));
+  IdTable lazyRows{4, qec->getAllocator()};
+  for (const auto& [idTable, localVocab] :
+       distinct.computeResultOnlyForTesting(true).idTables()) {
+    lazyRows.insertAtEnd(idTable);
+  }
+  EXPECT_EQ(lazyRows.numRows(), 3);
+
+  // Without the join column, equal rows can come from different groups, so
+  // the rows are sorted and the `FactorizedStarJoin` computes all the rows.
+  Distinct withoutJoinColumn{qec, tree, {3}};
+  EXPECT_NE(withoutJoinColumn.getChildren().at(0)->getRootOperation(), join);
+  EXPECT_EQ(withoutJoinColumn.computeResultOnlyForTesting().idTable().numRows(),
+            3);
+  EXPECT_ANY_THROW(join->computeDistinctResult({3}, false));
+}
+
+// _____________________________________________________________________________
+TEST(FactorizedStarJoin, contractChecks) {
+  auto qec = ad_utility::testing::getQec();
+  auto child = makeChild(qec, {{1, 2}}, Vars{Variable{"?s"}, Variable{"?a"}});
+  EXPECT_ANY_THROW((FactorizedStarJoin{qec, {child}, Variable{"?s"}}));
+  auto otherJoinVariable =
+      makeChild(qec, {{1, 2}}, Vars{Variable{"?x"}, Variable{"?b"}});
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      (FactorizedStarJoin{qec, {child, otherJoinVariable}, Variable{"?s"}}),
+      HasSubstr("must contain the join variable"));
+  auto sharedVariable =
+      makeChild(qec, {{1, 2}}, Vars{Variable{"?s"}, Variable{"?a"}});
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      (FactorizedStarJoin{qec, {child, sharedVariable}, Variable{"?s"}}),
+      HasSubstr("no common variables"));
+}
+
+// _____________________________________________________________________________
+TEST(FactorizedStarJoin, chosenByQueryPlannerForStars) {
+  auto qec = ad_utility::testing::getQec(
+      "<s1> <p1> <a1> . <s1> <p1> <a2> . <s1> <p2> <b1> . <s1> <p2> <b2> . "
+      "<s1> <p3> <c1> . <s2> <p1> <a1> . <s2> <p2> <b1> . <s2> <p3> <c1> . "
+      "<s2> <p3> <c2> . <s3> <p1> <a3> .");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  std::string star = "{ ?s <p1> ?a . ?s <p2> ?b . ?s <p3> ?c }";
+  std::vector<std::string> queries{
+      "SELECT ?s ?a ?b ?c " + star,
+      "SELECT DISTINCT ?s ?a " + star,
+      "SELECT DISTINCT ?a " + star,
+      "SELECT ?s (COUNT(*) AS ?n) (COUNT(DISTINCT ?a) AS ?d) "
+      "(COUNT(?c) AS ?m) (COUNT(?unbound) AS ?u) " +
+          star + " GROUP BY ?s",
+      "SELECT (COUNT(*) AS ?n) (COUNT(DISTINCT ?a) AS ?d) " + star};
+
+  std::vector<std::vector<std::vector<Id>>> expected;
+  for (const auto& query : queries) {
+    auto [rows, usesStarJoin] = evaluate(qec, query);
+    EXPECT_FALSE(usesStarJoin);
+    expected.push_back(std::move(rows));
+  }
+  auto cleanup = setRuntimeParameterForTest<"use-factorized-star-join">(true);
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto [rows, usesStarJoin] = evaluate(qec, queries[i]);
+    EXPECT_TRUE(usesStarJoin) << queries[i];
+    EXPECT_EQ(rows, expected[i]) << queries[i];
+  }
+
+  // Check the counts explicitly.
+  auto I = [](int64_t i) { return Id::makeFromInt(i); };
+  using Rows = std::vector<std::vector<Id>>;
+  EXPECT_EQ(evaluate(qec, queries[3]).first,
+            (Rows{{getId("<s1>"), I(4), I(2), I(4), I(0)},
+                  {getId("<s2>"), I(2), I(1), I(2), I(0)}}));
+  // `<a1>` occurs in both groups, but is counted only once.
+  EXPECT_EQ(evaluate(qec, queries[4]).first, (Rows{{I(6), I(2)}}));
+  // The same holds for `DISTINCT ?a` without the join variable.
+  EXPECT_EQ(evaluate(qec, queries[2]).first,
+            (Rows{{getId("<a1>")}, {getId("<a2>")}}));
+
+  // Paths are not stars.
+  EXPECT_FALSE(
+      evaluate(qec, "SELECT ?s { ?s <p1> ?a . ?a <p2> ?b . ?b <p3> ?c }")
+          .second);
+}
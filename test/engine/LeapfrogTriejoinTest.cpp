@@ -0,0 +1,146 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../engine/ValuesForTesting.h"
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/LeapfrogTriejoin.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+namespace {
+using Vars = std::vector<std::optional<Variable>>;
+
+// Create a child of a join with the given `table` and `variables`. The rows
+// are not sorted, s.t. the join has to sort them.
+std::shared_ptr<QueryExecutionTree> makeChild(QueryExecutionContext* qec,
+                                              const VectorTable& table,
+                                              Vars variables) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(table), std::move(variables));
+}
+
+// Parse, plan, and evaluate the `query`. Return the selected columns in the
+// order of the selection and whether the plan contains a `LeapfrogTriejoin`.
+std::pair<IdTable, bool> evaluate(QueryExecutionContext* qec,
+                                  std::string query) {
+  auto parsedQuery = SparqlParser::parseQuery(std::move(query));
+  QueryPlanner planner{qec,
+                       std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = planner.createExecutionTree(parsedQuery);
+  auto containsTriejoin = [](const auto& self, QueryExecutionTree& tree) {
+    auto operation = tree.getRootOperation();
+    if (std::dynamic_pointer_cast<LeapfrogTriejoin>(operation)) {
+      return true;
+    }
+    return ql::ranges::any_of(operation->getChildren(),
+                              [&self](QueryExecutionTree* child) {
+                                return self(self, *child);
+                              });
+  };
+  auto result = qet.getResult();
+  const auto& variables = parsedQuery.selectClause().getSelectedVariables();
+  IdTable table{variables.size(), qec->getAllocator()};
+  table.resize(result->idTable().numRows());
+  for (size_t i = 0; i < variables.size(); ++i) {
+    ql::ranges::copy(
+        result->idTable().getColumn(qet.getVariableColumn(variables[i])),
+        table.getColumn(i).begin());
+  }
+  return {std::move(table), containsTriejoin(containsTriejoin, qet)};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, triangle) {
+  auto qec = ad_utility::testing::getQec();
+  VectorTable edges{{3, 4}, {1, 2}, {2, 4}, {1, 3}, {2, 3}};
+  LeapfrogTriejoin join{qec,
+                        {makeChild(qec, edges, Vars{Variable{"?a"},
+                                                    Variable{"?b"}}),
+                         makeChild(qec, edges, Vars{Variable{"?b"},
+                                                    Variable{"?c"}}),
+                         makeChild(qec, edges, Vars{Variable{"?a"},
+                                                    Variable{"?c"}})}};
+  EXPECT_EQ(join.getDescriptor(), "Leapfrog Triejoin on ?a ?b ?c");
+  EXPECT_EQ(join.getResultWidth(), 3);
+  EXPECT_THAT(join.getResultSortedOn(), ElementsAre(0, 1, 2));
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{1, 2, 3}, {2, 3, 4}}));
+
+  // A clone has the same cache key.
+  EXPECT_EQ(join.clone()->getCacheKey(), join.getCacheKey());
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, duplicatesAndUnsharedVariables) {
+  auto qec = ad_utility::testing::getQec();
+  LeapfrogTriejoin join{
+      qec,
+      {makeChild(qec, {{1, 1}, {2, 1}, {1, 1}},
+                 Vars{Variable{"?x"}, Variable{"?y"}}),
+       makeChild(qec, {{1, 6}, {1, 5}}, Vars{Variable{"?y"}, Variable{"?z"}}),
+       makeChild(qec, {{3, 8}, {1, 7}}, Vars{Variable{"?x"}, Variable{"?w"}})}};
+  // The variables that are bound by two children come first.
+  EXPECT_EQ(join.getDescriptor(), "Leapfrog Triejoin on ?x ?y ?w ?z");
+  EXPECT_EQ(
+      join.getExternallyVisibleVariableColumns().at(Variable{"?z"}),
+      (ColumnIndexAndTypeInfo{3, ColumnIndexAndTypeInfo::AlwaysDefined}));
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector(
+                {{1, 1, 7, 5}, {1, 1, 7, 5}, {1, 1, 7, 6}, {1, 1, 7, 6}}));
+
+  // An empty child leads to an empty result.
+  LeapfrogTriejoin emptyJoin{
+      qec,
+      {makeChild(qec, {{1, 1}}, Vars{Variable{"?x"}, Variable{"?y"}}),
+       ad_utility::makeExecutionTree<ValuesForTesting>(
+           qec, IdTable{2, qec->getAllocator()},
+           Vars{Variable{"?y"}, Variable{"?z"}})}};
+  EXPECT_TRUE(emptyJoin.knownEmptyResult());
+  EXPECT_EQ(emptyJoin.computeResultOnlyForTesting().idTable().numRows(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, contractChecks) {
+  auto qec = ad_utility::testing::getQec();
+  auto child = makeChild(qec, {{1, 2}}, Vars{Variable{"?x"}, Variable{"?y"}});
+  EXPECT_ANY_THROW((LeapfrogTriejoin{qec, {child}}));
+  auto withUndef =
+      makeChild(qec, {{1, Id::makeUndefined()}},
+                Vars{Variable{"?y"}, Variable{"?z"}});
+  AD_EXPECT_THROW_WITH_MESSAGE((LeapfrogTriejoin{qec, {child, withUndef}}),
+                               HasSubstr("must not contain UNDEF"));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, chosenByQueryPlannerForCyclicPatterns) {
+  auto qec = ad_utility::testing::getQec(
+      "<1> <e> <2> . <2> <e> <3> . <1> <e> <3> . <3> <e> <4> . <2> <e> <4> .");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  std::string triangle =
+      "SELECT ?a ?b ?c { ?a <e> ?b . ?b <e> ?c . ?a <e> ?c } "
+      "ORDER BY ?a ?b ?c";
+  std::string path = "SELECT ?a ?b ?c { ?a <e> ?b . ?b <e> ?c } ORDER BY ?a ?c";
+
+  auto [expected, usesTriejoin] = evaluate(qec, triangle);
+  EXPECT_FALSE(usesTriejoin);
+  auto cleanup =
+      setRuntimeParameterForTest<"use-worst-case-optimal-join">(true);
+  auto [table, usesTriejoinNow] = evaluate(qec, triangle);
+  EXPECT_TRUE(usesTriejoinNow);
+  EXPECT_EQ(table, expected);
+  EXPECT_THAT(table.getColumn(0), ElementsAre(getId("<1>"), getId("<2>")));
+  EXPECT_THAT(table.getColumn(2), ElementsAre(getId("<3>"), getId("<4>")));
+
+  // Acyclic patterns are still planned with binary joins.
+  EXPECT_FALSE(evaluate(qec, path).second);
+}
@@ -0,0 +1,294 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/TripleComponentTestHelpers.h"
+#include "engine/MaterializedViewScan.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+using ad_utility::testing::IntId;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+namespace {
+constexpr std::string_view kg =
+    "<a> <label> \"A\" . <b> <label> \"B\" . <a> <is-a> <x> . "
+    "<b> <is-a> <x> . <c> <is-a> <y> .";
+
+auto handle() { return std::make_shared<ad_utility::CancellationHandle<>>(); }
+
+// Parse, plan, and evaluate the `query` with the `views`. Return the selected
+// columns in the order of the selection.
+IdTable evaluate(QueryExecutionContext* qec, const MaterializedViews& views,
+                 std::string query) {
+  qec->setMaterializedViews(&views);
+  absl::Cleanup reset{[qec]() { qec->setMaterializedViews(nullptr); }};
+  auto parsedQuery = SparqlParser::parseQuery(std::move(query));
+  QueryPlanner planner{qec, handle()};
+  auto qet = planner.createExecutionTree(parsedQuery);
+  auto result = qet.getResult();
+  const auto& variables = parsedQuery.selectClause().getSelectedVariables();
+  IdTable table{variables.size(), qec->getAllocator()};
+  table.resize(result->idTable().numRows());
+  for (size_t i = 0; i < variables.size(); ++i) {
+    ql::ranges::copy(
+        result->idTable().getColumn(qet.getVariableColumn(variables[i])),
+        table.getColumn(i).begin());
+  }
+  return table;
+}
+
+// All the rows of the `view`, read block by block.
+IdTable allRows(const MaterializedView& view,
+                const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  IdTable table{view.numColumns(), allocator};
+  for (size_t i = 0; i < view.blocks().size(); ++i) {
+    table.insertAtEnd(view.readBlock(i, allocator));
+  }
+  return table;
+}
+
+// The string representations of the words of the given column.
+std::vector<std::string> wordsOfColumn(const IdTable& table, size_t col) {
+  std::vector<std::string> words;
+  for (Id id : table.getColumn(col)) {
+    words.push_back(id.getLocalVocabIndex()->toStringRepresentation());
+  }
+  return words;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(MaterializedView, computeWriteAndLoad) {
+  auto qec = ad_utility::testing::getQec(std::string{kg});
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto view = MaterializedView::compute(
+      "labels",
+      "SELECT ?s (CONCAT(?label, \"!\") AS ?excl) WHERE { ?s <label> ?label }",
+      qec, handle());
+  EXPECT_EQ(view.name(), "labels");
+  EXPECT_THAT(view.variables(),
+              ElementsAre(Variable{"?s"}, Variable{"?excl"}));
+  const auto& allocator = qec->getAllocator();
+  auto table = allRows(view, allocator);
+  EXPECT_EQ(view.numRows(), 2);
+  EXPECT_THAT(table.getColumn(0), ElementsAre(getId("<a>"), getId("<b>")));
+  EXPECT_THAT(wordsOfColumn(table, 1), ElementsAre("\"A!\"", "\"B!\""));
+  EXPECT_EQ(view.getColumnIndex("excl"), 1);
+  AD_EXPECT_THROW_WITH_MESSAGE(view.getColumnIndex("label"),
+                               HasSubstr("has no column ?label"));
+
+  auto basename = (std::filesystem::temp_directory_path() /
+                   "materializedViewTest.computeWriteAndLoad")
+                      .string();
+  const auto& buildId = qec->getIndex().getBuildId();
+  EXPECT_EQ(view.writeToDisk(basename, buildId),
+            MaterializedView::getFilename(basename, "labels"));
+  MaterializedViews views;
+  views.loadFromDisk(basename, buildId);
+  EXPECT_THAT(views.getNames(), ElementsAre("labels"));
+  auto loaded = views.get("labels");
+  EXPECT_EQ(loaded->query(), view.query());
+  EXPECT_EQ(loaded->version(), view.version());
+  EXPECT_EQ(loaded->variables(), view.variables());
+  EXPECT_EQ(loaded->numRows(), 2);
+  EXPECT_EQ(allRows(*loaded, allocator), table);
+  EXPECT_THAT(wordsOfColumn(allRows(*loaded, allocator), 1),
+              ElementsAre("\"A!\"", "\"B!\""));
+  // Only the views that were computed can be written.
+  AD_EXPECT_THROW_WITH_MESSAGE(loaded->writeToDisk(basename, buildId),
+                               HasSubstr("already been written"));
+  AD_EXPECT_THROW_WITH_MESSAGE(views.get("other"),
+                               HasSubstr("no materialized view"));
+
+  // Views of other builds of the index are not loaded.
+  MaterializedViews otherViews;
+  otherViews.loadFromDisk(basename, "otherBuild");
+  EXPECT_TRUE(otherViews.getNames().empty());
+  std::filesystem::remove(MaterializedView::getFilename(basename, "labels"));
+
+  // Invalid names and queries.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      MaterializedView::compute("../x", "SELECT * { ?s ?p ?o }", qec,
+                                handle()),
+      HasSubstr("letters, digits"));
+  EXPECT_ANY_THROW(
+      MaterializedView::compute("ask", "ASK { ?s ?p ?o }", qec, handle()));
+}
+
+// _____________________________________________________________________________
+TEST(MaterializedViewScan, scanViaService) {
+  auto qec = ad_utility::testing::getQec(std::string{kg});
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  MaterializedViews views;
+  views.add(std::make_shared<const MaterializedView>(MaterializedView::compute(
+      "counts",
+      "SELECT ?class (COUNT(?s) AS ?count) WHERE { ?s <is-a> ?class } "
+      "GROUP BY ?class",
+      qec, handle())));
+  std::string prefix =
+      "PREFIX view: <https://qlever.cs.uni-freiburg.de/materializedView/> ";
+
+  // All columns.
+  auto table = evaluate(
+      qec, views,
+      prefix + "SELECT ?c ?n { SERVICE view: { [] view:name \"counts\" ; "
+               "view:column-class ?c ; view:column-count ?n } }");
+  EXPECT_THAT(table.getColumn(0), ElementsAre(getId("<x>"), getId("<y>")));
+  EXPECT_THAT(table.getColumn(1), ElementsAre(IntId(2), IntId(1)));
+
+  // A join with a triple.
+  table = evaluate(
+      qec, views,
+      prefix + "SELECT ?s ?n { ?s <is-a> ?c . SERVICE view: { [] view:name "
+               "\"counts\" ; view:column-class ?c ; view:column-count ?n } } "
+               "ORDER BY ?s");
+  EXPECT_THAT(table.getColumn(0),
+              ElementsAre(getId("<a>"), getId("<b>"), getId("<c>")));
+  EXPECT_THAT(table.getColumn(1), ElementsAre(IntId(2), IntId(2), IntId(1)));
+
+  // Constants for the first and the second column.
+  table = evaluate(
+      qec, views,
+      prefix + "SELECT ?n { SERVICE view: { [] view:name \"counts\" ; "
+               "view:column-class <y> ; view:column-count ?n } }");
+  EXPECT_THAT(table.getColumn(0), ElementsAre(IntId(1)));
+  table = evaluate(
+      qec, views,
+      prefix + "SELECT ?c { SERVICE view: { [] view:name \"counts\" ; "
+               "view:column-class ?c ; view:column-count 2 } }");
+  EXPECT_THAT(table.getColumn(0), ElementsAre(getId("<x>")));
+
+  // Errors.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      evaluate(qec, views,
+               prefix + "SELECT * { SERVICE view: { [] view:name \"other\" ; "
+                        "view:column-class ?c } }"),
+      HasSubstr("no materialized view"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      evaluate(qec, views,
+               prefix + "SELECT * { SERVICE view: { [] view:column-class ?c "
+                        "} }"),
+      HasSubstr("requires the parameter <name>"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      evaluate(qec, views,
+               prefix + "SELECT * { SERVICE view: { [] view:name \"counts\" ; "
+                        "view:foo ?c } }"),
+      HasSubstr("Unsupported argument <foo>"));
+}
+
+// _____________________________________________________________________________
+TEST(MaterializedViewScan, sortedOnAndCacheKey) {
+  auto qec = ad_utility::testing::getQec(std::string{kg});
+  auto view = std::make_shared<const MaterializedView>(
+      MaterializedView::compute("triples", "SELECT ?s ?p ?o { ?s ?p ?o }", qec,
+                                handle()));
+  using Columns = MaterializedViewScan::Columns;
+  auto var = [](std::string name) {
+    return TripleComponent{Variable{std::move(name)}};
+  };
+  MaterializedViewScan full{qec, view,
+                            Columns{{"o", var("?z")}, {"s", var("?x")}}};
+  EXPECT_THAT(full.getResultSortedOn(), ElementsAre(0));
+  EXPECT_EQ(full.getResultWidth(), 2);
+  EXPECT_EQ(full.getSizeEstimate(), 5);
+  EXPECT_EQ(full.getExternallyVisibleVariableColumns().at(Variable{"?x"})
+                .columnIndex_,
+            0);
+
+  // Constants don't break the sorting, but they are part of the cache key.
+  MaterializedViewScan withConstant{
+      qec, view,
+      Columns{{"s", var("?x")},
+              {"p", TripleComponent{ad_utility::testing::iri("<is-a>")}},
+              {"o", var("?z")}}};
+  EXPECT_THAT(withConstant.getResultSortedOn(), ElementsAre(0, 1));
+  EXPECT_EQ(withConstant.getSizeEstimate(), 5);
+  EXPECT_EQ(withConstant.computeResultOnlyForTesting().idTable().numRows(), 3);
+  EXPECT_NE(full.getCacheKey(), withConstant.getCacheKey());
+  EXPECT_THAT(withConstant.getCacheKey(), HasSubstr("<is-a>"));
+  MaterializedViewScan renamed{qec, view,
+                               Columns{{"o", var("?a")}, {"s", var("?b")}}};
+  EXPECT_EQ(full.getCacheKey(), renamed.getCacheKey());
+
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      (MaterializedViewScan{qec, view,
+                            Columns{{"s", var("?x")}, {"o", var("?x")}}}),
+      HasSubstr("only be bound to one column"));
+}
+
+// _____________________________________________________________________________
+TEST(MaterializedViewScan, multipleBlocks) {
+  auto qec = ad_utility::testing::getQec(std::string{kg});
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto basename = (std::filesystem::temp_directory_path() /
+                   "materializedViewTest.multipleBlocks")
+                      .string();
+  const auto& buildId = qec->getIndex().getBuildId();
+  // Two rows per block, the rows are sorted by `?s ?p ?o`.
+  auto filename =
+      MaterializedView::compute("triples", "SELECT ?s ?p ?o { ?s ?p ?o }", qec,
+                                handle(), 2)
+          .writeToDisk(basename, buildId);
+  auto view = std::make_shared<const MaterializedView>(
+      MaterializedView::readFromDisk(filename, buildId));
+  ASSERT_EQ(view->blocks().size(), 3);
+  EXPECT_EQ(view->numRows(), 5);
+  EXPECT_THAT(view->blocks()[1].firstRow_,
+              ElementsAre(getId("<b>"), getId("<is-a>"), getId("<x>")));
+
+  using Columns = MaterializedViewScan::Columns;
+  auto var = [](std::string name) {
+    return TripleComponent{Variable{std::move(name)}};
+  };
+  auto iri = [](std::string_view s) {
+    return TripleComponent{ad_utility::testing::iri(s)};
+  };
+
+  // A constant for the first column only reads the second block.
+  MaterializedViewScan subject{
+      qec, view, Columns{{"s", iri("<b>")}, {"o", var("?o")}}};
+  EXPECT_EQ(subject.getSizeEstimate(), 2);
+  EXPECT_FALSE(subject.knownEmptyResult());
+  auto result = subject.computeResultOnlyForTesting();
+  EXPECT_THAT(result.idTable().getColumn(0),
+              ElementsAre(getId("<x>"), getId("\"B\"")));
+
+  // The first and the last row of a block are matched, too.
+  MaterializedViewScan lastRow{
+      qec, view,
+      Columns{{"s", iri("<a>")}, {"p", iri("<label>")}, {"o", var("?o")}}};
+  EXPECT_EQ(lastRow.getSizeEstimate(), 2);
+  EXPECT_THAT(lastRow.computeResultOnlyForTesting().idTable().getColumn(0),
+              ElementsAre(getId("\"A\"")));
+
+  // No block can contain the constant.
+  MaterializedViewScan empty{qec, view,
+                             Columns{{"s", iri("<x>")}, {"o", var("?o")}}};
+  EXPECT_TRUE(empty.knownEmptyResult());
+  EXPECT_EQ(empty.computeResultOnlyForTesting().idTable().numRows(), 0);
+
+  // A constant for a later column reads all the blocks, lazily one block
+  // after the other.
+  MaterializedViewScan predicate{
+      qec, view, Columns{{"s", var("?s")}, {"p", iri("<is-a>")}}};
+  EXPECT_EQ(predicate.getSizeEstimate(), 5);
+  auto lazyResult = predicate.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(lazyResult.isFullyMaterialized());
+  std::vector<Id> subjects;
+  size_t numTables = 0;
+  for (auto& [table, localVocab] : lazyResult.idTables()) {
+    ql::ranges::copy(table.getColumn(0), std::back_inserter(subjects));
+    ++numTables;
+  }
+  EXPECT_EQ(numTables, 3);
+  EXPECT_THAT(subjects, ElementsAre(getId("<a>"), getId("<b>"), getId("<c>")));
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,148 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../engine/ValuesForTesting.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "../util/TripleComponentTestHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/Join.h"
+#include "engine/RuntimeFilter.h"
+#include "engine/Sort.h"
+#include "parser/SparqlTriple.h"
+
+using namespace ad_utility::testing;
+using ::testing::ElementsAre;
+using Tc = TripleComponent;
+using Var = Variable;
+
+namespace {
+constexpr std::string_view kg =
+    "<a> <p> <x1> . <b> <p> <x2> . <c> <p> <x3> . <d> <p> <x4> . "
+    "<x1> <q> <z1> . <x2> <q> <z2> . <x3> <q> <z3> . <x4> <q> <z4> .";
+
+std::shared_ptr<const RuntimeFilter> makeFilter(std::vector<Id> ids) {
+  return std::make_shared<const RuntimeFilter>(
+      RuntimeFilter::fromSortedColumn(ids, ids.size()).value());
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(RuntimeFilter, fromSortedColumn) {
+  std::vector<Id> column{VocabId(1), VocabId(1), VocabId(3), VocabId(7),
+                         VocabId(7)};
+  auto filter = RuntimeFilter::fromSortedColumn(column, 3);
+  ASSERT_TRUE(filter.has_value());
+  EXPECT_THAT(filter->ids(), ElementsAre(VocabId(1), VocabId(3), VocabId(7)));
+  EXPECT_TRUE(filter->contains(VocabId(3)));
+  EXPECT_FALSE(filter->contains(VocabId(4)));
+
+  // Too many distinct values.
+  EXPECT_FALSE(RuntimeFilter::fromSortedColumn(column, 2).has_value());
+  // UNDEF matches every value.
+  std::vector<Id> withUndef{Id::makeUndefined(), VocabId(1)};
+  EXPECT_FALSE(RuntimeFilter::fromSortedColumn(withUndef, 5).has_value());
+  // An empty column leads to a filter that matches nothing.
+  EXPECT_EQ(RuntimeFilter::fromSortedColumn({}, 5)->size(), 0);
+
+  auto table = makeIdTableFromVector({{3, 0}, {4, 1}, {1, 2}, {5, 3}});
+  filter->filterRows(table, 0);
+  EXPECT_EQ(table, makeIdTableFromVector({{3, 0}, {1, 2}}));
+}
+
+// _____________________________________________________________________________
+TEST(RuntimeFilter, pushDownIntoIndexScan) {
+  auto qec = getQec(std::string{kg});
+  auto getId = makeGetId(qec->getIndex());
+  SparqlTripleSimple spx{Tc{Var{"?s"}}, iri("<p>"), Tc{Var{"?x"}}};
+  auto filter = makeFilter({getId("<x2>"), getId("<x4>")});
+
+  // A filter on the first column (which is used to skip blocks) and on the
+  // second column.
+  for (auto permutation : {Permutation::POS, Permutation::PSO}) {
+    IndexScan scan{qec, permutation, spx};
+    EXPECT_FALSE(scan.pushDownRuntimeFilter(Var{"?notContained"}, filter));
+    EXPECT_TRUE(scan.canResultBeCached());
+    EXPECT_TRUE(scan.pushDownRuntimeFilter(Var{"?x"}, filter));
+    EXPECT_FALSE(scan.canResultBeCached());
+    auto result = scan.computeResultOnlyForTesting();
+    auto xColumn = scan.getExternallyVisibleVariableColumns()
+                       .at(Var{"?x"})
+                       .columnIndex_;
+    EXPECT_THAT(result.idTable().getColumn(xColumn),
+                ::testing::UnorderedElementsAre(getId("<x2>"), getId("<x4>")));
+
+    // Lazy results are filtered as well.
+    auto lazyScan = scan.clone();
+    ASSERT_TRUE(lazyScan->pushDownRuntimeFilter(Var{"?x"}, filter));
+    size_t numRows = 0;
+    for (const auto& [idTable, localVocab] :
+         lazyScan->computeResultOnlyForTesting(true).idTables()) {
+      numRows += idTable.numRows();
+    }
+    EXPECT_EQ(numRows, 2);
+  }
+
+  // No filter is applied to a scan with a LIMIT.
+  IndexScan withLimit{qec, Permutation::POS, spx};
+  withLimit.applyLimitOffset({1});
+  EXPECT_FALSE(withLimit.pushDownRuntimeFilter(Var{"?x"}, filter));
+
+  // The filter is passed through a sort.
+  auto sortedScan = QueryExecutionTree::createSortedTree(
+      ad_utility::makeExecutionTree<IndexScan>(qec, Permutation::PSO, spx),
+      {1});
+  EXPECT_TRUE(
+      sortedScan->getRootOperation()->pushDownRuntimeFilter(Var{"?x"}, filter));
+  EXPECT_FALSE(sortedScan->getRootOperation()->canResultBeCached());
+  EXPECT_EQ(sortedScan->getResult()->idTable().numRows(), 2);
+}
+
+// _____________________________________________________________________________
+TEST(RuntimeFilter, pushDownByJoin) {
+  auto qec = getQec(std::string{kg});
+  auto getId = makeGetId(qec->getIndex());
+  auto cleanup = setRuntimeParameterForTest<"runtime-filter-max-size">(10);
+
+  // `VALUES ?s { <b> <d> }` joined with `?s <p> ?x . ?x <q> ?z`. The right
+  // child is a join, so the filter for `?s` has to be pushed into it.
+  auto makeJoin = [&]() {
+    auto scanP = ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::PSO,
+        SparqlTripleSimple{Tc{Var{"?s"}}, iri("<p>"), Tc{Var{"?x"}}});
+    auto scanQ = ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::PSO,
+        SparqlTripleSimple{Tc{Var{"?x"}}, iri("<q>"), Tc{Var{"?z"}}});
+    auto inner = ad_utility::makeExecutionTree<Join>(qec, scanP, scanQ, 1, 0);
+    IdTable values{1, qec->getAllocator()};
+    values.push_back(std::vector{getId("<b>")});
+    values.push_back(std::vector{getId("<d>")});
+    auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(values), std::vector<std::optional<Var>>{Var{"?s"}},
+        false, std::vector<ColumnIndex>{0});
+    return std::make_pair(
+        std::make_shared<Join>(qec, left, inner, 0,
+                               inner->getVariableColumn(Var{"?s"}), false),
+        inner);
+  };
+
+  auto [join, inner] = makeJoin();
+  auto result = join->computeResultOnlyForTesting();
+  auto zColumn = join->getExternallyVisibleVariableColumns()
+                     .at(Var{"?z"})
+                     .columnIndex_;
+  EXPECT_THAT(result.idTable().getColumn(zColumn),
+              ::testing::UnorderedElementsAre(getId("<z2>"), getId("<z4>")));
+  EXPECT_EQ(join->runtimeInfo().details_["runtime-filter-size"], 2);
+  EXPECT_FALSE(inner->getRootOperation()->canResultBeCached());
+
+  // Without the runtime parameter, nothing is pushed down.
+  auto cleanup2 = setRuntimeParameterForTest<"runtime-filter-max-size">(0);
+  auto [join2, inner2] = makeJoin();
+  EXPECT_EQ(join2->computeResultOnlyForTesting().idTable().numRows(), 2);
+  EXPECT_FALSE(join2->runtimeInfo().details_.contains("runtime-filter-size"));
+  EXPECT_TRUE(inner2->getRootOperation()->canResultBeCached());
+}
@@ -9,12 +9,15 @@
 #include <variant>
 
 #include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "./../../src/util/GeoSparqlHelpers.h"
 #include "./SpatialJoinTestHelpers.h"
 #include "engine/IndexScan.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/SpatialJoin.h"
 #include "engine/SpatialJoinAlgorithms.h"
+#include "global/Constants.h"
+#include "index/SpatialIndex.h"
 #include "rdfTypes/Variable.h"
 
 namespace {  // anonymous namespace to avoid linker problems
@@ -1664,6 +1667,133 @@ TEST(SpatialJoin, mixedDataSet) {
   testDist(qec, 10000000, 25);
 }
 
+// The bounding box algorithm yields the same results with and without the
+// spatial index of the vocabulary.
+TEST(SpatialJoin, boundingBoxWithSpatialIndex) {
+  // The areas of the dataset are additionally stored with the predicate
+  // `<asAreaWKT>`.
+  TestIndexConfig config{absl::StrCat(
+      createTrueDistanceDataset(), "<geometryArea2> <asAreaWKT> ",
+      areaMuenster, " .\n<geometryArea4> <asAreaWKT> ", areaStatueOfLiberty,
+      " .\n<geometryArea6> <asAreaWKT> ", approximatedAreaGermany, " .\n")};
+  config.blocksizePermutations = 16_MB;
+  config.parserBufferSize = 10_kB;
+  config.buildSpatialIndex = true;
+  auto qec = getQec(std::move(config));
+  // Only the areas are WKT literals in the vocabulary, the points are stored
+  // directly in their `Id`s.
+  ASSERT_NE(qec->getIndex().getSpatialIndex(), nullptr);
+  EXPECT_EQ(qec->getIndex().getSpatialIndex()->size(), 3);
+
+  auto compute = [qec](size_t maxDist, bool useMidpointForAreas,
+                       bool useSpatialIndex) {
+    auto cleanup =
+        setRuntimeParameterForTest<"use-spatial-index">(useSpatialIndex);
+    auto leftChild =
+        buildIndexScan(qec, {"?obj1", std::string{"<asWKT>"}, "?geo1"});
+    auto rightChild =
+        buildIndexScan(qec, {"?obj2", std::string{"<asAreaWKT>"}, "?geo2"});
+    auto spatialJoinTree = ad_utility::makeExecutionTree<SpatialJoin>(
+        qec,
+        SpatialJoinConfiguration{MaxDistanceConfig(maxDist),
+                                 Variable{"?geo1"}, Variable{"?geo2"}},
+        leftChild, rightChild);
+    auto* spatialJoin =
+        static_cast<SpatialJoin*>(spatialJoinTree->getRootOperation().get());
+    spatialJoin->selectAlgorithm(SpatialJoinAlgorithm::BOUNDING_BOX);
+    SpatialJoinAlgorithms algorithms{
+        qec, spatialJoin->onlyForTestingGetPrepareJoin(),
+        spatialJoin->onlyForTestingGetConfig(), spatialJoin};
+    algorithms.setUseMidpointForAreas_(useMidpointForAreas);
+    auto result = algorithms.BoundingBoxAlgorithm();
+    const auto& table = result.idTable();
+    std::vector<std::vector<Id>> rows;
+    for (size_t row = 0; row < table.numRows(); ++row) {
+      auto& values = rows.emplace_back();
+      for (size_t col = 0; col < table.numColumns(); ++col) {
+        values.push_back(table(row, col));
+      }
+    }
+    ql::ranges::sort(rows);
+    bool usedIndex =
+        spatialJoin->runtimeInfo().details_.contains("uses-spatial-index");
+    return std::pair{std::move(rows), usedIndex};
+  };
+
+  for (size_t maxDist : {1, 5000, 500000, 1000000, 10000000}) {
+    for (bool useMidpointForAreas : {true, false}) {
+      auto [expected, usedIndexWithoutParameter] =
+          compute(maxDist, useMidpointForAreas, false);
+      EXPECT_FALSE(usedIndexWithoutParameter);
+      EXPECT_FALSE(expected.empty());
+      // The left side contains points, which are not covered by the index,
+      // but the right side only contains areas.
+      auto [rows, usedIndex] = compute(maxDist, useMidpointForAreas, true);
+      EXPECT_TRUE(usedIndex);
+      EXPECT_EQ(rows, expected) << maxDist << ' ' << useMidpointForAreas;
+    }
+  }
+}
+
 }  // namespace boundingBox
 
+// The spatial join algorithms yield the same results, no matter on how many
+// threads they are run.
+TEST(SpatialJoin, multipleThreads) {
+  // A grid of points that is large enough to be split into several chunks,
+  // and some areas.
+  std::string kg = createTrueDistanceDataset();
+  for (size_t x = 0; x < 60; ++x) {
+    for (size_t y = 0; y < 60; ++y) {
+      absl::StrAppend(&kg, "<grid", x, "_", y, "> <asWKT> \"POINT(",
+                      7.0 + 0.1 * x, " ", 47.0 + 0.1 * y, ")\"^^<",
+                      GEO_WKT_LITERAL, "> .\n");
+    }
+  }
+  auto qec = buildQec(kg);
+
+  auto compute = [qec](SpatialJoinAlgorithm algorithm,
+                       bool useMidpointForAreas, size_t numThreads) {
+    auto cleanup =
+        setRuntimeParameterForTest<"spatial-join-num-threads">(numThreads);
+    auto leftChild =
+        buildIndexScan(qec, {"?obj1", std::string{"<asWKT>"}, "?geo1"});
+    auto rightChild =
+        buildIndexScan(qec, {"?obj2", std::string{"<asWKT>"}, "?geo2"});
+    auto spatialJoinTree = ad_utility::makeExecutionTree<SpatialJoin>(
+        qec,
+        SpatialJoinConfiguration{MaxDistanceConfig(15000), Variable{"?geo1"},
+                                 Variable{"?geo2"}},
+        leftChild, rightChild);
+    auto* spatialJoin =
+        static_cast<SpatialJoin*>(spatialJoinTree->getRootOperation().get());
+    spatialJoin->selectAlgorithm(algorithm);
+    SpatialJoinAlgorithms algorithms{
+        qec, spatialJoin->onlyForTestingGetPrepareJoin(),
+        spatialJoin->onlyForTestingGetConfig(), spatialJoin};
+    algorithms.setUseMidpointForAreas_(useMidpointForAreas);
+    auto result = algorithm == SpatialJoinAlgorithm::S2_GEOMETRY
+                      ? algorithms.S2geometryAlgorithm()
+                      : algorithms.BoundingBoxAlgorithm();
+    size_t usedThreads =
+        spatialJoin->runtimeInfo().details_["num-threads"].get<size_t>();
+    return std::pair{result.idTable().clone(), usedThreads};
+  };
+
+  for (auto algorithm : {SpatialJoinAlgorithm::BOUNDING_BOX,
+                         SpatialJoinAlgorithm::S2_GEOMETRY}) {
+    for (bool useMidpointForAreas : {true, false}) {
+      auto [expected, singleThread] =
+          compute(algorithm, useMidpointForAreas, 1);
+      EXPECT_EQ(singleThread, 1);
+      EXPECT_GT(expected.numRows(), 3600);
+      // The results of the chunks are concatenated in order, so even the
+      // order of the rows is the same.
+      auto [result, numThreads] = compute(algorithm, useMidpointForAreas, 4);
+      EXPECT_GT(numThreads, 1);
+      EXPECT_EQ(result, expected);
+    }
+  }
+}
+
 }  // namespace
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <boost/iostreams/filter/zlib.hpp>
+#include <fstream>
 
 #include "../WordsAndDocsFileLineCreator.h"
 #include "../printers/VariablePrinters.h"
@@ -90,12 +91,17 @@ std::pair<std::string, std::string> contentsOfWordsFileAndDocsFile = {
 // Return a `QueryExecutionContext` from the turtle `kg` (see above) that has a
 // text index that contains the literals from the `kg` as well as the
 // `contentsOfWordsFileAndDocsFile` (also above). The metrics used for the text
-// scores can be specified.
+// scores, the number of threads for building the text index, and the codec of
+// the posting lists can be specified.
 auto getQecWithTextIndex(
-    std::optional<TextScoringMetric> textScoring = std::nullopt) {
+    std::optional<TextScoringMetric> textScoring = std::nullopt,
+    size_t numThreadsTextIndex = 2,
+    TextPostingCodec codec = TextPostingCodec::BIT_PACKING) {
   using namespace ad_utility::testing;
   TestIndexConfig config{kg};
   config.createTextIndex = true;
+  config.numThreadsTextIndex = numThreadsTextIndex;
+  config.textPostingCodec = codec;
   config.contentsOfWordsFileAndDocsfile = contentsOfWordsFileAndDocsFile;
   if (textScoring.has_value()) {
     config.scoringMetric = textScoring;
@@ -347,6 +353,39 @@ TEST(TextIndexScanForWord, KnownEmpty) {
   ASSERT_TRUE(!s5.knownEmptyResult());
 }
 
+// _____________________________________________________________________________
+TEST(TextIndexScanForWord, parallelBuildIsDeterministic) {
+  auto readTextIndexFile = [](const QueryExecutionContext* qec) {
+    std::ifstream file{qec->getIndex().getOnDiskBase() + ".text.index",
+                       std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, {}};
+  };
+  for (auto metric : {TextScoringMetric::EXPLICIT, TextScoringMetric::BM25}) {
+    auto sequential = readTextIndexFile(getQecWithTextIndex(metric, 1));
+    EXPECT_FALSE(sequential.empty());
+    EXPECT_EQ(readTextIndexFile(getQecWithTextIndex(metric, 4)), sequential);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(TextIndexScanForWord, bothPostingCodecs) {
+  // Indices with the old `SIMPLE8B` codec can still be read, and both codecs
+  // yield the same postings.
+  for (auto metric : {TextScoringMetric::EXPLICIT, TextScoringMetric::BM25}) {
+    const auto& simple8b =
+        getQecWithTextIndex(metric, 2, TextPostingCodec::SIMPLE8B)->getIndex();
+    const auto& bitPacked = getQecWithTextIndex(metric, 2)->getIndex();
+    for (std::string term : {"test", "test*", "testing", "friday", "he*"}) {
+      auto allocator = makeAllocator();
+      auto expected = simple8b.getWordPostingsForTerm(term, allocator);
+      EXPECT_GT(expected.numRows(), 0);
+      EXPECT_EQ(bitPacked.getWordPostingsForTerm(term, allocator), expected);
+      EXPECT_EQ(bitPacked.getEntityMentionsForWord(term, allocator),
+                simple8b.getEntityMentionsForWord(term, allocator));
+    }
+  }
+}
+
 // _____________________________________________________________________________
 TEST(TextIndexScanForWord, clone) {
   auto qec = getQec();
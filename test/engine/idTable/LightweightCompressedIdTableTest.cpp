@@ -0,0 +1,143 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../../util/AllocatorTestHelpers.h"
+#include "../../util/IdTableHelpers.h"
+#include "../../util/IdTestHelpers.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/idTable/LightweightCompressedIdTable.h"
+
+using ad_utility::LightweightCompressedIdTable;
+using Encoding = LightweightCompressedIdTable::Encoding;
+using ad_utility::testing::IntId;
+using ad_utility::testing::VocabId;
+
+namespace {
+// Create an `IdTable` with `numRows` rows, where the `i`-th column is filled
+// via `columnGenerators[i](row)`.
+IdTable makeTable(size_t numRows,
+                  const std::vector<std::function<Id(size_t)>>& generators) {
+  IdTable table{generators.size(), ad_utility::testing::makeAllocator()};
+  table.resize(numRows);
+  for (size_t col = 0; col < generators.size(); ++col) {
+    for (size_t row = 0; row < numRows; ++row) {
+      table(row, col) = generators[col](row);
+    }
+  }
+  return table;
+}
+
+// Pseudo-random distinct `Id`s of different datatypes, which can't be
+// compressed.
+Id randomId(size_t row) {
+  auto bits = std::hash<size_t>{}(row) * 0x9E3779B97F4A7C15ULL;
+  if (row % 2 == 0) {
+    return Id::makeFromInt(static_cast<int64_t>(bits));
+  }
+  return Id::makeFromBlankNodeIndex(
+      BlankNodeIndex::make(bits & ad_utility::bitMaskForLowerBits(50)));
+}
+
+// Concatenate the blocks of the `compressed` table.
+IdTable decompressBlockwise(const LightweightCompressedIdTable& compressed) {
+  IdTable result{compressed.numColumns(), ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < compressed.numBlocks(); ++i) {
+    result.insertAtEnd(compressed.decompressBlock(i));
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LightweightCompressedIdTable, encodingsAndRoundTrip) {
+  constexpr size_t blockSize = LightweightCompressedIdTable::BLOCK_SIZE;
+  size_t numRows = 2 * blockSize + 17;
+  auto table = makeTable(
+      numRows,
+      {// Sorted with long runs.
+       [](size_t row) { return VocabId(row / 1000); },
+       // Few distinct values that are far apart.
+       [](size_t row) { return VocabId((row * 7 % 5) << 40); },
+       // Values that are close to each other, but not sorted.
+       [](size_t row) { return IntId(static_cast<int64_t>(row * 31 % 999)); },
+       // Random values.
+       randomId});
+  LightweightCompressedIdTable compressed{table};
+  EXPECT_EQ(compressed.numRows(), numRows);
+  EXPECT_EQ(compressed.numColumns(), 4);
+  EXPECT_EQ(compressed.numBlocks(), 3);
+  // Note: In the last (small) block, the first column is constant.
+  for (size_t block = 0; block < 2; ++block) {
+    EXPECT_EQ(compressed.getEncoding(block, 0), Encoding::RunLength);
+    EXPECT_EQ(compressed.getEncoding(block, 1), Encoding::Dictionary);
+    EXPECT_EQ(compressed.getEncoding(block, 2), Encoding::FrameOfReference);
+  }
+  EXPECT_EQ(compressed.getEncoding(0, 3), Encoding::Raw);
+  EXPECT_EQ(compressed.getEncoding(2, 0), Encoding::FrameOfReference);
+  EXPECT_LT(compressed.size(), CacheValue::getSize(table));
+
+  EXPECT_EQ(compressed.decompress(), table);
+  EXPECT_EQ(decompressBlockwise(compressed), table);
+}
+
+// _____________________________________________________________________________
+TEST(LightweightCompressedIdTable, cornerCases) {
+  // Empty table.
+  auto empty = makeTable(0, {[](size_t) { return IntId(0); }});
+  LightweightCompressedIdTable compressedEmpty{empty};
+  EXPECT_EQ(compressedEmpty.numBlocks(), 0);
+  EXPECT_EQ(compressedEmpty.decompress(), empty);
+
+  // Constant columns (which need zero bits per row) and values that use all
+  // the 64 bits.
+  auto table = makeTable(
+      100, {[](size_t) { return Id::fromBits(~uint64_t{0}); },
+            [](size_t row) { return Id::fromBits(row % 2 == 0 ? 0 : ~0ULL); },
+            [](size_t row) { return Id::fromBits((row % 4) << 62); }});
+  LightweightCompressedIdTable compressed{table};
+  EXPECT_EQ(compressed.getEncoding(0, 0), Encoding::FrameOfReference);
+  EXPECT_EQ(compressed.getEncoding(0, 1), Encoding::Dictionary);
+  EXPECT_LT(compressed.size(), CacheValue::getSize(table));
+  EXPECT_EQ(compressed.decompress(), table);
+}
+
+// _____________________________________________________________________________
+TEST(LightweightCompressedIdTable, compressedCacheValue) {
+  auto table = makeTable(10'000, {[](size_t row) { return IntId(row / 10); },
+                                  [](size_t) { return IntId(42); }});
+  auto expected = table.clone();
+  CacheValue value{Result{std::move(table), {0}, LocalVocab{}},
+                   RuntimeInformation{}};
+  auto uncompressedSize = CacheValue::SizeGetter{}(value);
+  EXPECT_FALSE(value.isCompressed());
+  EXPECT_TRUE(value.compress());
+  EXPECT_TRUE(value.isCompressed());
+  EXPECT_FALSE(value.compress());
+  EXPECT_TRUE(value.isFullyMaterialized());
+  EXPECT_LT(CacheValue::SizeGetter{}(value), uncompressedSize / 10);
+  EXPECT_EQ(value.numRows(), 10'000);
+  EXPECT_EQ(value.numColumns(), 2);
+  EXPECT_ANY_THROW(value.resultTable());
+
+  auto result = value.resultTablePtr();
+  ASSERT_TRUE(result->isFullyMaterialized());
+  EXPECT_EQ(result->idTable(), expected);
+  EXPECT_THAT(result->sortedBy(), ::testing::ElementsAre(0));
+
+  auto lazyResult = value.resultTablePtr(true);
+  ASSERT_FALSE(lazyResult->isFullyMaterialized());
+  IdTable concatenated{2, ad_utility::testing::makeAllocator()};
+  for (const auto& [idTable, localVocab] : lazyResult->idTables()) {
+    concatenated.insertAtEnd(idTable);
+  }
+  EXPECT_EQ(concatenated, expected);
+
+  // Results that don't become smaller are not compressed.
+  auto random = makeTable(100, {randomId});
+  CacheValue randomValue{Result{std::move(random), {}, LocalVocab{}},
+                         RuntimeInformation{}};
+  EXPECT_FALSE(randomValue.compress());
+  EXPECT_FALSE(randomValue.isCompressed());
+}
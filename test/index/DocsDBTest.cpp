@@ -0,0 +1,114 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "index/DocsDB.h"
+#include "util/File.h"
+
+using namespace ::testing;
+
+namespace {
+auto T = [](uint64_t index) { return TextRecordIndex::make(index); };
+
+// Write the `records` (pairs of record index and text) to a docs file, build
+// a `DocsDB` from it, and read it again.
+DocsDB makeDocsDB(const std::vector<std::pair<uint64_t, std::string>>& records,
+                  const std::string& filename) {
+  std::string docsFile;
+  for (const auto& [index, text] : records) {
+    absl::StrAppend(&docsFile, index, "\t", text, "\n");
+  }
+  {
+    ad_utility::File file{filename + ".docsfile", "w"};
+    file.write(docsFile.data(), docsFile.size());
+  }
+  DocsDB::writeFromDocsFile(filename + ".docsfile", filename);
+  ad_utility::deleteFile(filename + ".docsfile");
+  DocsDB docsDB;
+  docsDB.init(filename);
+  return docsDB;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DocsDB, fewRecords) {
+  std::string filename = "docsDBTest.fewRecords.dat";
+  // The records 1 and 4 are missing.
+  auto docsDB = makeDocsDB(
+      {{0, "the first record"}, {2, "the third record"}, {3, ""}, {5, "last"}},
+      filename);
+  EXPECT_EQ(docsDB._size, 6);
+  EXPECT_EQ(docsDB.getTextExcerpt(T(0)), "the first record");
+  EXPECT_EQ(docsDB.getTextExcerpt(T(1)), "");
+  EXPECT_EQ(docsDB.getTextExcerpt(T(2)), "the third record");
+  EXPECT_EQ(docsDB.getTextExcerpt(T(3)), "");
+  EXPECT_EQ(docsDB.getTextExcerpt(T(5)), "last");
+  EXPECT_ANY_THROW(docsDB.getTextExcerpt(T(6)));
+  EXPECT_THAT(docsDB.getTextExcerpts({T(5), T(0), T(5), T(1)}),
+              ElementsAre("last", "the first record", "last", ""));
+  EXPECT_THAT(docsDB.getTextExcerpts({}), IsEmpty());
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(DocsDB, manyBlocks) {
+  std::string filename = "docsDBTest.manyBlocks.dat";
+  std::vector<std::pair<uint64_t, std::string>> records;
+  size_t totalSize = 0;
+  for (uint64_t i = 0; i < 20'000; ++i) {
+    records.emplace_back(
+        i, absl::StrCat("This is record number ", i, " of a text that ",
+                        i % 7 == 0 ? "is about cats" : "is about dogs", "."));
+    totalSize += records.back().second.size();
+  }
+  // A single record that is larger than a block.
+  records.emplace_back(20'000, std::string(2 * DocsDB::BLOCK_SIZE, 'x'));
+  ASSERT_GT(totalSize, 10 * DocsDB::BLOCK_SIZE);
+  auto docsDB = makeDocsDB(records, filename);
+  ASSERT_EQ(docsDB._size, records.size());
+  // The dictionary and the compression pay off.
+  EXPECT_LT(ad_utility::File{filename, "r"}.sizeOfFile(), totalSize / 2);
+
+  std::vector<TextRecordIndex> cids;
+  std::vector<std::string> expected;
+  for (uint64_t i = 0; i < records.size(); i += 97) {
+    EXPECT_EQ(docsDB.getTextExcerpt(T(i)), records[i].second);
+    cids.push_back(T(records.size() - 1 - i));
+    expected.push_back(records[records.size() - 1 - i].second);
+  }
+  EXPECT_EQ(docsDB.getTextExcerpts(cids), expected);
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(DocsDB, oldUncompressedFormat) {
+  // The text of the records, followed by the offsets of all the records.
+  std::string filename = "docsDBTest.oldUncompressedFormat.dat";
+  {
+    ad_utility::File file{filename, "w"};
+    std::string text = "firstsecond";
+    file.write(text.data(), text.size());
+    std::vector<off_t> offsets{0, 5, 11};
+    file.write(offsets.data(), offsets.size() * sizeof(off_t));
+  }
+  DocsDB docsDB;
+  docsDB.init(filename);
+  EXPECT_EQ(docsDB._size, 2);
+  EXPECT_EQ(docsDB.getTextExcerpt(T(0)), "first");
+  EXPECT_EQ(docsDB.getTextExcerpt(T(1)), "second");
+  EXPECT_THAT(docsDB.getTextExcerpts({T(1), T(0)}),
+              ElementsAre("second", "first"));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(DocsDB, empty) {
+  std::string filename = "docsDBTest.empty.dat";
+  auto docsDB = makeDocsDB({}, filename);
+  EXPECT_EQ(docsDB._size, 0);
+  EXPECT_ANY_THROW(docsDB.getTextExcerpt(T(0)));
+  EXPECT_THAT(docsDB.getTextExcerpts({}), IsEmpty());
+  ad_utility::deleteFile(filename);
+}
@@ -0,0 +1,124 @@
+// Copyright 2025 The QLever Authors
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "backports/algorithm.h"
+#include "global/Constants.h"
+#include "index/SpatialIndex.h"
+#include "util/File.h"
+
+using namespace ::testing;
+
+namespace {
+using Box = SpatialIndex::Box;
+
+// Build a `SpatialIndex` from the given `words` (the index of each word is its
+// position in the vector), write it to disk and read it again.
+SpatialIndex makeIndex(const std::vector<std::string>& words,
+                       const std::string& filename) {
+  SpatialIndex::Builder builder;
+  for (size_t i = 0; i < words.size(); ++i) {
+    builder.addWord(words[i], i);
+  }
+  std::move(builder).writeToFile(filename);
+  SpatialIndex index;
+  index.readFromFile(filename);
+  return index;
+}
+
+std::string wkt(std::string_view geometry) {
+  return absl::StrCat("\"", geometry, "\"^^<", GEO_WKT_LITERAL, ">");
+}
+
+auto V = [](uint64_t index) { return VocabIndex::make(index); };
+
+// Return the sorted result of `getIntersecting`.
+std::vector<VocabIndex> intersecting(const SpatialIndex& index,
+                                     const Box& box) {
+  std::vector<VocabIndex> result;
+  index.getIntersecting(box, result);
+  ql::ranges::sort(result);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SpatialIndex, hilbertIndexAndLevels) {
+  // The curve starts and ends in the two lower corners.
+  EXPECT_EQ(SpatialIndex::hilbertIndex(0, 0), 0);
+  EXPECT_EQ(SpatialIndex::hilbertIndex(65535, 0), 65536u * 65536u - 1);
+  // Neighboring cells on the curve are neighbors in the grid.
+  EXPECT_EQ(SpatialIndex::hilbertIndex(1, 0), 1);
+  EXPECT_EQ(SpatialIndex::hilbertIndex(1, 1), 2);
+  EXPECT_EQ(SpatialIndex::hilbertIndex(0, 1), 3);
+  EXPECT_ANY_THROW(SpatialIndex::hilbertIndex(65536, 0));
+
+  EXPECT_THAT(SpatialIndex::computeLevelOffsets(0), ElementsAre(0, 0));
+  EXPECT_THAT(SpatialIndex::computeLevelOffsets(1), ElementsAre(0, 1));
+  EXPECT_THAT(SpatialIndex::computeLevelOffsets(16), ElementsAre(0, 16, 17));
+  EXPECT_THAT(SpatialIndex::computeLevelOffsets(300),
+              ElementsAre(0, 300, 319, 321, 322));
+}
+
+// _____________________________________________________________________________
+TEST(SpatialIndex, getBoxAndIntersecting) {
+  std::string filename = "spatialIndexTest.getBoxAndIntersecting.dat";
+  auto index =
+      makeIndex({"<http://foo.bar>", wkt("POLYGON((1 1, 3 1, 3 2, 1 1))"),
+                 "\"POINT(1 2)\"", wkt("LINESTRING(10 20, 12 25)"),
+                 wkt("invalid"), wkt("POINT(-170 -80)")},
+                filename);
+  EXPECT_EQ(index.size(), 3);
+
+  // Only valid WKT literals are indexed.
+  EXPECT_FALSE(index.getBox(V(0)).has_value());
+  EXPECT_EQ(index.getBox(V(1)), (Box{1, 1, 3, 2}));
+  EXPECT_FALSE(index.getBox(V(2)).has_value());
+  EXPECT_EQ(index.getBox(V(3)), (Box{10, 20, 12, 25}));
+  EXPECT_FALSE(index.getBox(V(4)).has_value());
+  EXPECT_EQ(index.getBox(V(5)), (Box{-170, -80, -170, -80}));
+  EXPECT_FALSE(index.getBox(V(6)).has_value());
+  auto boundingBox = index.getBox(V(3)).value().toBoundingBox();
+  EXPECT_EQ(boundingBox.lowerLeft_.getLng(), 10);
+  EXPECT_EQ(boundingBox.upperRight_.getLat(), 25);
+
+  EXPECT_THAT(intersecting(index, {0, 0, 1, 1}), ElementsAre(V(1)));
+  EXPECT_THAT(intersecting(index, {2, 1.5, 11, 21}), ElementsAre(V(1), V(3)));
+  EXPECT_THAT(intersecting(index, {-180, -90, 180, 90}),
+              ElementsAre(V(1), V(3), V(5)));
+  EXPECT_THAT(intersecting(index, {50, 50, 60, 60}), IsEmpty());
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(filename + ".tree");
+}
+
+// _____________________________________________________________________________
+TEST(SpatialIndex, manyEntries) {
+  // Points on a grid, s.t. the tree has several levels.
+  std::string filename = "spatialIndexTest.manyEntries.dat";
+  std::vector<std::string> words;
+  for (size_t x = 0; x < 30; ++x) {
+    for (size_t y = 0; y < 30; ++y) {
+      words.push_back(wkt(absl::StrCat("POINT(", x, " ", y, ")")));
+    }
+  }
+  auto index = makeIndex(words, filename);
+  EXPECT_EQ(index.size(), 900);
+
+  // Compare with a linear scan over all the points.
+  for (const Box& queryBox : std::vector<Box>{{2.5, 3.5, 7.5, 4.5},
+                                              {-10, -10, 0, 0},
+                                              {28.5, 0, 100, 100},
+                                              {10, 10, 10, 10}}) {
+    std::vector<VocabIndex> expected;
+    for (uint64_t i = 0; i < words.size(); ++i) {
+      if (index.getBox(V(i)).value().intersects(queryBox)) {
+        expected.push_back(V(i));
+      }
+    }
+    EXPECT_EQ(intersecting(index, queryBox), expected);
+  }
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(filename + ".tree");
+}
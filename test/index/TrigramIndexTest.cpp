@@ -0,0 +1,145 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include <absl/strings/str_cat.h>
+
+#include "index/TrigramIndex.h"
+
+using namespace ::testing;
+using namespace ad_utility::memory_literals;
+
+namespace {
+// Build a `TrigramIndex` from the given `words` (the index of each word is its
+// position in the vector), write it to disk and read it again. The
+// `memoryLimit` is used for the external sorter of the builder.
+TrigramIndex makeIndex(const std::vector<std::string>& words,
+                       const std::string& filename,
+                       ad_utility::MemorySize memoryLimit = 1_MB) {
+  TrigramIndex::Builder builder{filename + ".sorter.dat", memoryLimit,
+                                ad_utility::makeUnlimitedAllocator<Id>()};
+  for (size_t i = 0; i < words.size(); ++i) {
+    builder.addWord(words[i], i);
+  }
+  std::move(builder).writeToFile(filename);
+  TrigramIndex index;
+  index.readFromFile(filename);
+  return index;
+}
+
+auto V = [](uint64_t index) { return VocabIndex::make(index); };
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getTrigrams) {
+  EXPECT_THAT(TrigramIndex::getTrigrams(""), IsEmpty());
+  EXPECT_THAT(TrigramIndex::getTrigrams("ab"), IsEmpty());
+  EXPECT_THAT(TrigramIndex::getTrigrams("abc"), ElementsAre(0x616263));
+  // Duplicates are removed and the result is sorted.
+  EXPECT_THAT(TrigramIndex::getTrigrams("bcabca"),
+              ElementsAre(0x616263, 0x626361, 0x636162));
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getCandidates) {
+  std::string filename = "trigramIndexTest.getCandidates.dat";
+  auto index =
+      makeIndex({"<http://foo.bar>", "\"foobar\"", "\"barbaz\"@en",
+                 "\"bazfoo\"^^<http://www.w3.org/2001/XMLSchema#string>",
+                 "<http://xyz>", "\"xyz\"", "\"\""},
+                filename);
+
+  // IRIs are not part of the index.
+  EXPECT_FALSE(index.isIndexedLiteral(V(0)));
+  EXPECT_TRUE(index.isIndexedLiteral(V(1)));
+  EXPECT_TRUE(index.isIndexedLiteral(V(3)));
+  EXPECT_FALSE(index.isIndexedLiteral(V(4)));
+  EXPECT_TRUE(index.isIndexedLiteral(V(5)));
+  EXPECT_TRUE(index.isIndexedLiteral(V(6)));
+  EXPECT_FALSE(index.isIndexedLiteral(V(7)));
+
+  auto candidates = [&index](std::vector<std::string> substrings) {
+    return index.getCandidates(substrings);
+  };
+  EXPECT_THAT(candidates({"foo"}), Optional(ElementsAre(V(1), V(3))));
+  EXPECT_THAT(candidates({"bar"}), Optional(ElementsAre(V(1), V(2))));
+  EXPECT_THAT(candidates({"foob"}), Optional(ElementsAre(V(1))));
+  // The language tag and the datatype are not part of the index.
+  EXPECT_THAT(candidates({"@en"}), Optional(IsEmpty()));
+  EXPECT_THAT(candidates({"XMLSchema"}), Optional(IsEmpty()));
+  // The IRIs are not part of the index.
+  EXPECT_THAT(candidates({"http"}), Optional(IsEmpty()));
+  // All the substrings are required.
+  EXPECT_THAT(candidates({"foo", "baz"}), Optional(ElementsAre(V(3))));
+  EXPECT_THAT(candidates({"foo", "xyz"}), Optional(IsEmpty()));
+  EXPECT_THAT(candidates({"bazf"}), Optional(ElementsAre(V(3))));
+  EXPECT_THAT(candidates({"azba"}), Optional(IsEmpty()));
+  // The result is only a superset of the actual matches: "barbaz" contains
+  // all the trigrams of "barbar", but not the string itself.
+  EXPECT_THAT(candidates({"barbar"}), Optional(ElementsAre(V(2))));
+  // Substrings without trigrams can't be used to restrict the candidates.
+  EXPECT_EQ(candidates({}), std::nullopt);
+  EXPECT_EQ(candidates({"fo", "o"}), std::nullopt);
+  EXPECT_THAT(candidates({"fo", "xyz"}), Optional(ElementsAre(V(5))));
+  std::remove(filename.c_str());
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getCandidatesExternalSort) {
+  // With a small memory limit, the builder has to sort externally. The
+  // result has to be the same as with an in-memory sort.
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 2'000; ++i) {
+    words.push_back(absl::StrCat("\"word", i % 7, "x", i, "\""));
+  }
+  std::string filename = "trigramIndexTest.externalSort.dat";
+  auto index = makeIndex(words, filename, 10_kB);
+  auto candidates = index.getCandidates({"word3x"});
+  ASSERT_TRUE(candidates.has_value());
+  std::vector<VocabIndex> expected;
+  for (size_t i = 3; i < words.size(); i += 7) {
+    expected.push_back(V(i));
+  }
+  EXPECT_THAT(candidates.value(), ElementsAreArray(expected));
+  EXPECT_THAT(index.getCandidates({"x1999"}), Optional(ElementsAre(V(1999))));
+  std::remove(filename.c_str());
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getRequiredSubstringsOfRegex) {
+  auto get = &TrigramIndex::getRequiredSubstringsOfRegex;
+  EXPECT_THAT(get("foo"), ElementsAre("foo"));
+  EXPECT_THAT(get("^foo$"), ElementsAre("foo"));
+  EXPECT_THAT(get("ab.*cd?e"), ElementsAre("ab", "c", "e"));
+  EXPECT_THAT(get("ab+c"), ElementsAre("ab", "c"));
+  EXPECT_THAT(get("abc{0,2}d"), ElementsAre("ab", "d"));
+  EXPECT_THAT(get("ab[cd]ef"), ElementsAre("ab", "ef"));
+  EXPECT_THAT(get("ab[]|)]ef"), ElementsAre("ab", "ef"));
+  // The `]` of nested POSIX classes doesn't close the character class.
+  EXPECT_THAT(get("[[:alpha:]]foo"), ElementsAre("foo"));
+  EXPECT_THAT(get("ab[^[:digit:]x]cd"), ElementsAre("ab", "cd"));
+  EXPECT_THAT(get("[[.-.][=e=]]foo"), ElementsAre("foo"));
+  EXPECT_THAT(get("[[:alpha:]"), IsEmpty());
+  EXPECT_THAT(get("[[:alpha]foo"), IsEmpty());
+  EXPECT_THAT(get("a\\.b\\d+c"), ElementsAre("a.b", "c"));
+  // Groups.
+  EXPECT_THAT(get("ab(cd)ef"), ElementsAre("ab", "cd", "ef"));
+  EXPECT_THAT(get("ab(cd)?ef"), ElementsAre("ab", "ef"));
+  EXPECT_THAT(get("ab(c(d)e)*ef"), ElementsAre("ab", "ef"));
+  EXPECT_THAT(get("ab(?:cd)ef"), ElementsAre("ab", "cd", "ef"));
+  EXPECT_THAT(get("(?P<name>abc)"), ElementsAre("abc"));
+  // A quantifier after a multi-byte UTF-8 character removes the whole
+  // character.
+  EXPECT_THAT(get("aäö?"), ElementsAre("aä"));
+  // Unsupported constructs lead to an empty result.
+  EXPECT_THAT(get("foo|bar"), IsEmpty());
+  EXPECT_THAT(get("(?i)foo"), IsEmpty());
+  EXPECT_THAT(get("\\x{41}foo"), IsEmpty());
+  EXPECT_THAT(get("\\pLfoo"), IsEmpty());
+  EXPECT_THAT(get("ab(cd"), IsEmpty());
+  EXPECT_THAT(get("ab[cd"), IsEmpty());
+  EXPECT_THAT(get("foo\\"), IsEmpty());
+}
@@ -0,0 +1,48 @@
+// Copyright 2025 The QLever Authors
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "index/vocabulary/SortKeyPrefixes.h"
+#include "util/File.h"
+
+// _____________________________________________________________________________
+TEST(SortKeyPrefixes, buildAndRead) {
+  std::string filename = "sortKeyPrefixesTest.buildAndRead.dat";
+  {
+    SortKeyPrefixes::Builder builder{filename};
+    builder.addWord(0, 3);
+    builder.addWord(1, 5);
+    // A word from another vocabulary of a `SplitVocabulary` is ignored.
+    builder.addWord(1ull << 59, 1);
+    builder.addWord(2, 5);
+    builder.addWord(3, 5);
+    builder.addWord(4, 8);
+    // Indices must not be skipped.
+    EXPECT_ANY_THROW(builder.addWord(4, 8));
+    EXPECT_TRUE(std::move(builder).finish());
+  }
+  SortKeyPrefixes prefixes;
+  prefixes.readFromFile(filename);
+  EXPECT_EQ(prefixes.size(), 5);
+  using P = std::pair<uint64_t, uint64_t>;
+  EXPECT_EQ(prefixes.getRange(0), P(0, 0));
+  EXPECT_EQ(prefixes.getRange(3), P(0, 1));
+  EXPECT_EQ(prefixes.getRange(4), P(1, 1));
+  EXPECT_EQ(prefixes.getRange(5), P(1, 4));
+  EXPECT_EQ(prefixes.getRange(8), P(4, 5));
+  EXPECT_EQ(prefixes.getRange(9), P(5, 5));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(SortKeyPrefixes, unsorted) {
+  std::string filename = "sortKeyPrefixesTest.unsorted.dat";
+  SortKeyPrefixes::Builder builder{filename};
+  builder.addWord(0, 5);
+  builder.addWord(1, 3);
+  EXPECT_FALSE(std::move(builder).finish());
+  EXPECT_FALSE(std::filesystem::exists(filename));
+}
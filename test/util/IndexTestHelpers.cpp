@@ -53,6 +53,10 @@ std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".vocabulary.internal",
           indexBasename + ".vocabulary.external",
           indexBasename + ".vocabulary.external.offsets",
+          indexBasename + ".vocabulary.trigrams",
+          indexBasename + ".vocabulary.spatial",
+          indexBasename + ".vocabulary.spatial.tree",
+          indexBasename + ".vocabulary.sort-key-prefixes",
           indexBasename + ".wordsfile",
           indexBasename + ".docsfile",
           indexBasename + ".text.index",
@@ -183,6 +187,9 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
     index.usePatterns() = c.usePatterns;
     index.setSettingsFile(inputFilename + ".settings.json");
     index.loadAllPermutations() = c.loadAllPermutations;
+    index.buildTrigramIndex() = c.buildTrigramIndex;
+    index.buildSpatialIndex() = c.buildSpatialIndex;
+    index.buildSortKeyPrefixes() = c.buildSortKeyPrefixes;
     qlever::InputFileSpecification spec{inputFilename, c.indexType,
                                         std::nullopt};
     // randomly choose one of the vocabulary implementations
@@ -193,6 +200,9 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
     if (c.createTextIndex) {
       TextIndexBuilder textIndexBuilder = TextIndexBuilder(
           ad_utility::makeUnlimitedAllocator<Id>(), index.getOnDiskBase());
+      textIndexBuilder.setNumThreads(c.numThreadsTextIndex);
+      textIndexBuilder.setNumLinesPerShard(3);
+      textIndexBuilder.setPostingCodec(c.textPostingCodec);
       // First test the case of invalid b and k parameters for BM25, it should
       // throw
       AD_EXPECT_THROW_WITH_MESSAGE(
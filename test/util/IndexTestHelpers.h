@@ -13,6 +13,7 @@
 #include "engine/idTable/CompressedExternalIdTable.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/Index.h"
+#include "index/TextMetaData.h"
 #include "util/MemorySize/MemorySize.h"
 
 // Several useful functions to quickly set up an `Index` and a
@@ -63,6 +64,13 @@ struct TestIndexConfig {
   std::optional<std::pair<float, float>> bAndKParam = std::nullopt;
   qlever::Filetype indexType = qlever::Filetype::Turtle;
   std::optional<VocabularyType> vocabularyType = std::nullopt;
+  bool buildTrigramIndex = false;
+  bool buildSpatialIndex = false;
+  bool buildSortKeyPrefixes = false;
+  // The text index is built with tiny shards, s.t. the postings of even the
+  // small test inputs are built in parallel.
+  size_t numThreadsTextIndex = 2;
+  TextPostingCodec textPostingCodec = TextPostingCodec::BIT_PACKING;
 
   // A very typical use case is to only specify the turtle input, and leave all
   // the other members as the default. We therefore have a dedicated constructor
@@ -78,7 +86,9 @@ struct TestIndexConfig {
         std::move(h), c.turtleInput, c.loadAllPermutations, c.usePatterns,
         c.usePrefixCompression, c.blocksizePermutations, c.createTextIndex,
         c.addWordsFromLiterals, c.contentsOfWordsFileAndDocsfile,
-        c.parserBufferSize, c.scoringMetric, c.bAndKParam, c.indexType);
+        c.parserBufferSize, c.scoringMetric, c.bAndKParam, c.indexType,
+        c.buildTrigramIndex, c.buildSpatialIndex, c.buildSortKeyPrefixes,
+        c.numThreadsTextIndex, c.textPostingCodec);
   }
   bool operator==(const TestIndexConfig&) const = default;
 };